@@ -25,12 +25,15 @@
 // Simple implementation of triangle counting, through graph pattern matching,
 // using CSR graph representation.
 
+#include <algorithm>
 #include <atomic>
 #include <fstream>
 #include <iostream>
 #include <utility>
+#include <vector>
 
 #include "shad/data_structures/array.h"
+#include "shad/extensions/graph_library/intersection.h"
 #include "shad/runtime/runtime.h"
 #include "shad/util/measure.h"
 
@@ -58,6 +61,18 @@ struct CSRGraph {
 // This is one for each Locality.
 static std::atomic<size_t> TriangleCounter(0);
 
+// Copy the neighbors of v in res, sorted and without duplicates.
+void Neighbors(const CSRGraph &G, size_t v, std::vector<size_t> *res) {
+  auto vertexPtr = G.vertexPtr();
+  size_t edgeListStart = vertexPtr->At(v);
+  size_t edgeListEnd = vertexPtr->At(v + 1);
+  res->resize(edgeListEnd - edgeListStart);
+  if (res->empty()) return;
+  G.edgePtr()->AtRange(edgeListStart, res->size(), res->data());
+  std::sort(res->begin(), res->end());
+  res->erase(std::unique(res->begin(), res->end()), res->end());
+}
+
 size_t TriangleCount(CSRGraph &G) {
   // Triangle counting loops:
   // 1 - For each vertex in the graph i
@@ -65,49 +80,27 @@ size_t TriangleCount(CSRGraph &G) {
 
   shad::rt::asyncForEachOnAll(
       handle,
-      [](shad::rt::Handle &handle, const CSRGraph &G, size_t i) {
-        auto vertexPtr = G.vertexPtr();
-
-        size_t edgeListStart = vertexPtr->At(i);
-        size_t edgeListEnd = vertexPtr->At(i + 1);
+      [](shad::rt::Handle &, const CSRGraph &G, size_t i) {
+        std::vector<size_t> iNeighbors, jNeighbors;
+        Neighbors(G, i, &iNeighbors);
 
         // 2 - Visit all the neighboors j of i such that: j < i
-        G.edgePtr()->AsyncForEachInRange(
-            handle, edgeListStart, edgeListEnd,
-            [](shad::rt::Handle &handle, size_t, size_t &j, size_t &i,
-               const CSRGraph &G) {
-              if (j >= i) return;
-
-              auto vertexPtr = G.vertexPtr();
-              size_t edgeListStart = vertexPtr->At(j);
-              size_t edgeListEnd = vertexPtr->At(j + 1);
-
-              // 3 - Visit all the neighboors k of j such that k < j
-              G.edgePtr()->AsyncForEachInRange(
-                  handle, edgeListStart, edgeListEnd,
-                  [](shad::rt::Handle &handle, size_t, size_t &k, size_t &j,
-                     size_t &i, const CSRGraph &G) {
-                    if (k >= j) return;
-
-                    auto vertexPtr = G.vertexPtr();
-                    size_t edgeListStart = vertexPtr->At(k);
-                    size_t edgeListEnd = vertexPtr->At(k + 1);
-
-                    // 4 - Visit all the neighboors w of k and if w == i
-                    //     increment the counter.
-                    G.edgePtr()->AsyncForEachInRange(
-                        handle, edgeListStart, edgeListEnd,
-                        [](shad::rt::Handle &handle, size_t, size_t &w,
-                           size_t &i) {
-                          if (w != i) return;
-
-                          TriangleCounter++;
-                        },
-                        i);
-                  },
-                  j, i, G);
-            },
-            i, G);
+        for (size_t j : iNeighbors) {
+          if (j >= i) break;
+          Neighbors(G, j, &jNeighbors);
+
+          // 3 - Count the common neighbors k of i and j such that k < j
+          size_t iPrefix =
+              std::lower_bound(iNeighbors.begin(), iNeighbors.end(), j) -
+              iNeighbors.begin();
+          size_t jPrefix =
+              std::lower_bound(jNeighbors.begin(), jNeighbors.end(), j) -
+              jNeighbors.begin();
+          TriangleCounter +=
+              shad::IntersectSorted(iNeighbors.data(), iPrefix,
+                                    jNeighbors.data(), jPrefix,
+                                    [](const size_t &) {});
+        }
       },
       G, G.vertexNumber);
 
@@ -44,7 +44,8 @@ size_t TriangleCount(shad::EdgeIndex<size_t, size_t>::ObjectID &eid) {
   using DestT = shad::EdgeIndex<size_t, size_t>::DestType;
 
   // Triangle counting loops:
-  // 1 - For each vertex in the graph i
+  // 1 - For each edge (i, j) in the graph, with j < i
+  // 2 - Count the common neighbors k of i and j (k < j by construction)
   shad::rt::Handle handle;
   auto elPtr = shad::EdgeIndex<size_t, size_t>::GetPtr(eid);
   elPtr->AsyncForEachEdge(
@@ -52,25 +53,10 @@ size_t TriangleCount(shad::EdgeIndex<size_t, size_t>::ObjectID &eid) {
       [](shad::rt::Handle &handle, const SrcT &i, const DestT &j,
          ELObjectID &eid) {
         auto GraphPtr = shad::EdgeIndex<size_t, size_t>::GetPtr(eid);
-        // 3 - Visit all the neighbors k of j such that k < j
-        GraphPtr->AsyncForEachNeighbor(
-            handle, j,
-            [](shad::rt::Handle &handle, const SrcT &j, const DestT &k,
-               ELObjectID &eid, const SrcT &v) {
-              auto GraphPtr = shad::EdgeIndex<size_t, size_t>::GetPtr(eid);
-
-              // 4 - Visit all the neighbors w of k and if w == i
-              //     increment the counter.
-              GraphPtr->AsyncForEachNeighbor(
-                  handle, v,
-                  [](shad::rt::Handle &handle, const SrcT &i, const DestT &w,
-                     const SrcT &k) {
-                    if (w != k) return;
-                    TriangleCounter++;
-                  },
-                  k);
-            },
-            eid, i);
+        GraphPtr->AsyncIntersectNeighbors(
+            handle, i, j,
+            [](shad::rt::Handle &, const SrcT &, const SrcT &,
+               const DestT &) { TriangleCounter++; });
       },
       eid);
   shad::rt::waitForCompletion(handle);
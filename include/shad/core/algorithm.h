@@ -34,10 +34,17 @@
 #include <vector>
 
 #include "shad/core/execution.h"
+#include "shad/core/impl/binary_search_ops.h"
 #include "shad/core/impl/comparison_ops.h"
+#include "shad/core/impl/heap_ops.h"
 #include "shad/core/impl/minimum_maximum_ops.h"
 #include "shad/core/impl/modifyng_sequence_ops.h"
 #include "shad/core/impl/non_modifyng_sequence_ops.h"
+#include "shad/core/impl/other_ops_on_sorted_ranges.h"
+#include "shad/core/impl/partitioning_ops.h"
+#include "shad/core/impl/permutation_ops.h"
+#include "shad/core/impl/set_ops.h"
+#include "shad/core/impl/sorting_ops.h"
 #include "shad/distributed_iterator_traits.h"
 #include "shad/runtime/runtime.h"
 
@@ -258,6 +265,673 @@ void replace_if(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last,
                    new_value);
 }
 
+// ---------------------------------------------//
+//                                              //
+//               partitioning_ops               //
+//                                              //
+// ---------------------------------------------//
+
+template <class ForwardIt, class UnaryPredicate>
+bool is_partitioned(ForwardIt first, ForwardIt last, UnaryPredicate p) {
+  return impl::is_partitioned(distributed_sequential_tag{}, first, last, p);
+}
+
+template <class ExecutionPolicy, class ForwardIt, class UnaryPredicate>
+bool is_partitioned(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last,
+                    UnaryPredicate p) {
+  return impl::is_partitioned(std::forward<ExecutionPolicy>(policy), first,
+                              last, p);
+}
+
+template <class ForwardIt, class UnaryPredicate>
+ForwardIt partition(ForwardIt first, ForwardIt last, UnaryPredicate p) {
+  return impl::partition(distributed_sequential_tag{}, first, last, p);
+}
+
+template <class ExecutionPolicy, class ForwardIt, class UnaryPredicate>
+ForwardIt partition(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last,
+                    UnaryPredicate p) {
+  return impl::partition(std::forward<ExecutionPolicy>(policy), first, last,
+                         p);
+}
+
+template <class ForwardIt, class UnaryPredicate>
+ForwardIt stable_partition(ForwardIt first, ForwardIt last, UnaryPredicate p) {
+  return impl::stable_partition(distributed_sequential_tag{}, first, last, p);
+}
+
+template <class ExecutionPolicy, class ForwardIt, class UnaryPredicate>
+ForwardIt stable_partition(ExecutionPolicy&& policy, ForwardIt first,
+                           ForwardIt last, UnaryPredicate p) {
+  return impl::stable_partition(std::forward<ExecutionPolicy>(policy), first,
+                                last, p);
+}
+
+/// @brief Copies the elements of a range in two output ranges, depending on
+/// the value returned by a predicate.
+///
+/// The relative order of the elements is preserved.  The output ranges must
+/// have random-access distributed iterators (e.g., from shad::array).
+template <class InputIt, class OutputIt1, class OutputIt2,
+          class UnaryPredicate>
+std::pair<OutputIt1, OutputIt2> partition_copy(InputIt first, InputIt last,
+                                               OutputIt1 d_first_true,
+                                               OutputIt2 d_first_false,
+                                               UnaryPredicate p) {
+  return impl::partition_copy(distributed_sequential_tag{}, first, last,
+                              d_first_true, d_first_false, p);
+}
+
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class ForwardIt3, class UnaryPredicate>
+std::pair<ForwardIt2, ForwardIt3> partition_copy(
+    ExecutionPolicy&& policy, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first_true, ForwardIt3 d_first_false, UnaryPredicate p) {
+  return impl::partition_copy(std::forward<ExecutionPolicy>(policy), first,
+                              last, d_first_true, d_first_false, p);
+}
+
+// ---------------------------------------------//
+//                                              //
+//                  sorting_ops                 //
+//                                              //
+// ---------------------------------------------//
+
+template <class RandomIt>
+void sort(RandomIt first, RandomIt last) {
+  impl::sort(distributed_sequential_tag{}, first, last, std::less<>());
+}
+
+template <class ExecutionPolicy, class RandomIt>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value> sort(
+    ExecutionPolicy&& policy, RandomIt first, RandomIt last) {
+  impl::sort(std::forward<ExecutionPolicy>(policy), first, last,
+             std::less<>());
+}
+
+template <class RandomIt, class Compare>
+std::enable_if_t<!shad::is_execution_policy<RandomIt>::value> sort(
+    RandomIt first, RandomIt last, Compare comp) {
+  impl::sort(distributed_sequential_tag{}, first, last, comp);
+}
+
+template <class ExecutionPolicy, class RandomIt, class Compare>
+void sort(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+          Compare comp) {
+  impl::sort(std::forward<ExecutionPolicy>(policy), first, last, comp);
+}
+
+template <class RandomIt>
+void stable_sort(RandomIt first, RandomIt last) {
+  impl::stable_sort(distributed_sequential_tag{}, first, last, std::less<>());
+}
+
+template <class ExecutionPolicy, class RandomIt>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value>
+stable_sort(ExecutionPolicy&& policy, RandomIt first, RandomIt last) {
+  impl::stable_sort(std::forward<ExecutionPolicy>(policy), first, last,
+                    std::less<>());
+}
+
+template <class RandomIt, class Compare>
+std::enable_if_t<!shad::is_execution_policy<RandomIt>::value> stable_sort(
+    RandomIt first, RandomIt last, Compare comp) {
+  impl::stable_sort(distributed_sequential_tag{}, first, last, comp);
+}
+
+template <class ExecutionPolicy, class RandomIt, class Compare>
+void stable_sort(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+                 Compare comp) {
+  impl::stable_sort(std::forward<ExecutionPolicy>(policy), first, last, comp);
+}
+
+template <class RandomIt>
+void partial_sort(RandomIt first, RandomIt middle, RandomIt last) {
+  impl::partial_sort(distributed_sequential_tag{}, first, middle, last,
+                     std::less<>());
+}
+
+template <class ExecutionPolicy, class RandomIt>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value>
+partial_sort(ExecutionPolicy&& policy, RandomIt first, RandomIt middle,
+             RandomIt last) {
+  impl::partial_sort(std::forward<ExecutionPolicy>(policy), first, middle,
+                     last, std::less<>());
+}
+
+template <class RandomIt, class Compare>
+std::enable_if_t<!shad::is_execution_policy<RandomIt>::value> partial_sort(
+    RandomIt first, RandomIt middle, RandomIt last, Compare comp) {
+  impl::partial_sort(distributed_sequential_tag{}, first, middle, last, comp);
+}
+
+template <class ExecutionPolicy, class RandomIt, class Compare>
+void partial_sort(ExecutionPolicy&& policy, RandomIt first, RandomIt middle,
+                  RandomIt last, Compare comp) {
+  impl::partial_sort(std::forward<ExecutionPolicy>(policy), first, middle,
+                     last, comp);
+}
+
+/// @brief Copies the smallest elements of a range, sorted, into a
+/// random-access distributed range.
+///
+/// The elements are selected with bounded heaps, as in top_k(); the input
+/// range is neither sorted nor modified.
+template <class InputIt, class RandomIt>
+RandomIt partial_sort_copy(InputIt first, InputIt last, RandomIt d_first,
+                           RandomIt d_last) {
+  return impl::partial_sort_copy(distributed_sequential_tag{}, first, last,
+                                 d_first, d_last, std::less<>());
+}
+
+template <class ExecutionPolicy, class ForwardIt, class RandomIt>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value, RandomIt>
+partial_sort_copy(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last,
+                  RandomIt d_first, RandomIt d_last) {
+  return impl::partial_sort_copy(std::forward<ExecutionPolicy>(policy), first,
+                                 last, d_first, d_last, std::less<>());
+}
+
+template <class InputIt, class RandomIt, class Compare>
+std::enable_if_t<!shad::is_execution_policy<InputIt>::value, RandomIt>
+partial_sort_copy(InputIt first, InputIt last, RandomIt d_first,
+                  RandomIt d_last, Compare comp) {
+  return impl::partial_sort_copy(distributed_sequential_tag{}, first, last,
+                                 d_first, d_last, comp);
+}
+
+template <class ExecutionPolicy, class ForwardIt, class RandomIt,
+          class Compare>
+RandomIt partial_sort_copy(ExecutionPolicy&& policy, ForwardIt first,
+                           ForwardIt last, RandomIt d_first, RandomIt d_last,
+                           Compare comp) {
+  return impl::partial_sort_copy(std::forward<ExecutionPolicy>(policy), first,
+                                 last, d_first, d_last, comp);
+}
+
+/// @brief Rearranges a range so that nth holds the element that would be
+/// there if the range were sorted, with no greater element before it and no
+/// smaller element after it.
+///
+/// The value of nth is found with a distributed selection on a copy of the
+/// candidates, then the range is partitioned around it.
+template <class RandomIt>
+void nth_element(RandomIt first, RandomIt nth, RandomIt last) {
+  impl::nth_element(distributed_sequential_tag{}, first, nth, last,
+                    std::less<>());
+}
+
+template <class ExecutionPolicy, class RandomIt>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value>
+nth_element(ExecutionPolicy&& policy, RandomIt first, RandomIt nth,
+            RandomIt last) {
+  impl::nth_element(std::forward<ExecutionPolicy>(policy), first, nth, last,
+                    std::less<>());
+}
+
+template <class RandomIt, class Compare>
+std::enable_if_t<!shad::is_execution_policy<RandomIt>::value> nth_element(
+    RandomIt first, RandomIt nth, RandomIt last, Compare comp) {
+  impl::nth_element(distributed_sequential_tag{}, first, nth, last, comp);
+}
+
+template <class ExecutionPolicy, class RandomIt, class Compare>
+void nth_element(ExecutionPolicy&& policy, RandomIt first, RandomIt nth,
+                 RandomIt last, Compare comp) {
+  impl::nth_element(std::forward<ExecutionPolicy>(policy), first, nth, last,
+                    comp);
+}
+
+/// @brief The k smallest elements of a range, in ascending order.
+///
+/// Each task keeps a bounded heap of k elements, the heaps are merged on
+/// each locality and then pairwise across localities; the range is neither
+/// sorted nor modified.  Use std::greater<>() to get the k largest.
+///
+/// @return A std::vector with min(k, std::distance(first, last)) elements.
+template <class ForwardIt>
+std::vector<typename ForwardIt::value_type> top_k(ForwardIt first,
+                                                  ForwardIt last, size_t k) {
+  return impl::top_k(distributed_sequential_tag{}, first, last, k,
+                     std::less<>());
+}
+
+template <class ExecutionPolicy, class ForwardIt>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value,
+                 std::vector<typename ForwardIt::value_type>>
+top_k(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last, size_t k) {
+  return impl::top_k(std::forward<ExecutionPolicy>(policy), first, last, k,
+                     std::less<>());
+}
+
+template <class ForwardIt, class Compare>
+std::enable_if_t<!shad::is_execution_policy<ForwardIt>::value,
+                 std::vector<typename ForwardIt::value_type>>
+top_k(ForwardIt first, ForwardIt last, size_t k, Compare comp) {
+  return impl::top_k(distributed_sequential_tag{}, first, last, k, comp);
+}
+
+template <class ExecutionPolicy, class ForwardIt, class Compare>
+std::vector<typename ForwardIt::value_type> top_k(ExecutionPolicy&& policy,
+                                                  ForwardIt first,
+                                                  ForwardIt last, size_t k,
+                                                  Compare comp) {
+  return impl::top_k(std::forward<ExecutionPolicy>(policy), first, last, k,
+                     comp);
+}
+
+/// @brief Stable sort of a range of integral values, or of values with an
+/// integral key, in ascending order of the keys.
+///
+/// The key extractor, when given, must be a trivially copyable function
+/// object returning an integral value.
+template <class RandomIt>
+void radix_sort(RandomIt first, RandomIt last) {
+  impl::radix_sort(distributed_sequential_tag{}, first, last,
+                   impl::sort_impl::identity_key());
+}
+
+template <class ExecutionPolicy, class RandomIt>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value>
+radix_sort(ExecutionPolicy&& policy, RandomIt first, RandomIt last) {
+  impl::radix_sort(std::forward<ExecutionPolicy>(policy), first, last,
+                   impl::sort_impl::identity_key());
+}
+
+template <class RandomIt, class KeyFn>
+std::enable_if_t<!shad::is_execution_policy<RandomIt>::value> radix_sort(
+    RandomIt first, RandomIt last, KeyFn key) {
+  impl::radix_sort(distributed_sequential_tag{}, first, last, key);
+}
+
+template <class ExecutionPolicy, class RandomIt, class KeyFn>
+void radix_sort(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+                KeyFn key) {
+  impl::radix_sort(std::forward<ExecutionPolicy>(policy), first, last, key);
+}
+
+// ---------------------------------------------//
+//                                              //
+//          other_ops_on_sorted_ranges          //
+//                                              //
+// ---------------------------------------------//
+
+/// @brief Merges two sorted ranges into a third one.
+///
+/// The inputs are split with co-ranking (merge path) in balanced
+/// sub-problems, one for each task of the localities owning the output.  The
+/// output range must have random-access distributed iterators (e.g., from
+/// shad::array) and it must not overlap the inputs.
+template <class InputIt1, class InputIt2, class OutputIt>
+OutputIt merge(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+               InputIt2 last2, OutputIt d_first) {
+  return impl::merge(distributed_sequential_tag{}, first1, last1, first2,
+                     last2, d_first, std::less<>());
+}
+
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class ForwardIt3>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value, ForwardIt3>
+merge(ExecutionPolicy&& policy, ForwardIt1 first1, ForwardIt1 last1,
+      ForwardIt2 first2, ForwardIt2 last2, ForwardIt3 d_first) {
+  return impl::merge(std::forward<ExecutionPolicy>(policy), first1, last1,
+                     first2, last2, d_first, std::less<>());
+}
+
+template <class InputIt1, class InputIt2, class OutputIt, class Compare>
+std::enable_if_t<!shad::is_execution_policy<InputIt1>::value, OutputIt> merge(
+    InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+    OutputIt d_first, Compare comp) {
+  return impl::merge(distributed_sequential_tag{}, first1, last1, first2,
+                     last2, d_first, comp);
+}
+
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class ForwardIt3, class Compare>
+ForwardIt3 merge(ExecutionPolicy&& policy, ForwardIt1 first1,
+                 ForwardIt1 last1, ForwardIt2 first2, ForwardIt2 last2,
+                 ForwardIt3 d_first, Compare comp) {
+  return impl::merge(std::forward<ExecutionPolicy>(policy), first1, last1,
+                     first2, last2, d_first, comp);
+}
+
+template <class BidirIt>
+void inplace_merge(BidirIt first, BidirIt middle, BidirIt last) {
+  impl::inplace_merge(distributed_sequential_tag{}, first, middle, last,
+                      std::less<>());
+}
+
+template <class ExecutionPolicy, class BidirIt>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value>
+inplace_merge(ExecutionPolicy&& policy, BidirIt first, BidirIt middle,
+              BidirIt last) {
+  impl::inplace_merge(std::forward<ExecutionPolicy>(policy), first, middle,
+                      last, std::less<>());
+}
+
+template <class BidirIt, class Compare>
+std::enable_if_t<!shad::is_execution_policy<BidirIt>::value> inplace_merge(
+    BidirIt first, BidirIt middle, BidirIt last, Compare comp) {
+  impl::inplace_merge(distributed_sequential_tag{}, first, middle, last, comp);
+}
+
+template <class ExecutionPolicy, class BidirIt, class Compare>
+void inplace_merge(ExecutionPolicy&& policy, BidirIt first, BidirIt middle,
+                   BidirIt last, Compare comp) {
+  impl::inplace_merge(std::forward<ExecutionPolicy>(policy), first, middle,
+                      last, comp);
+}
+
+// ---------------------------------------------//
+//                                              //
+//                    set_ops                   //
+//                                              //
+// ---------------------------------------------//
+
+template <class InputIt1, class InputIt2>
+bool includes(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+              InputIt2 last2) {
+  return impl::includes(distributed_sequential_tag{}, first1, last1, first2,
+                        last2, std::less<>());
+}
+
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value, bool>
+includes(ExecutionPolicy&& policy, ForwardIt1 first1, ForwardIt1 last1,
+         ForwardIt2 first2, ForwardIt2 last2) {
+  return impl::includes(std::forward<ExecutionPolicy>(policy), first1, last1,
+                        first2, last2, std::less<>());
+}
+
+template <class InputIt1, class InputIt2, class Compare>
+std::enable_if_t<!shad::is_execution_policy<InputIt1>::value, bool> includes(
+    InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+    Compare comp) {
+  return impl::includes(distributed_sequential_tag{}, first1, last1, first2,
+                        last2, comp);
+}
+
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class Compare>
+bool includes(ExecutionPolicy&& policy, ForwardIt1 first1, ForwardIt1 last1,
+              ForwardIt2 first2, ForwardIt2 last2, Compare comp) {
+  return impl::includes(std::forward<ExecutionPolicy>(policy), first1, last1,
+                        first2, last2, comp);
+}
+
+/// @brief Computes the union of two sorted ranges.
+///
+/// Sub-problems are computed in parallel and their results written with one
+/// more pass, so the output range must have random-access distributed
+/// iterators (e.g., from shad::array).  The same holds for set_intersection.
+template <class InputIt1, class InputIt2, class OutputIt>
+OutputIt set_union(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                   InputIt2 last2, OutputIt d_first) {
+  return impl::set_union(distributed_sequential_tag{}, first1, last1, first2,
+                         last2, d_first, std::less<>());
+}
+
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class ForwardIt3>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value, ForwardIt3>
+set_union(ExecutionPolicy&& policy, ForwardIt1 first1, ForwardIt1 last1,
+          ForwardIt2 first2, ForwardIt2 last2, ForwardIt3 d_first) {
+  return impl::set_union(std::forward<ExecutionPolicy>(policy), first1, last1,
+                         first2, last2, d_first, std::less<>());
+}
+
+template <class InputIt1, class InputIt2, class OutputIt, class Compare>
+std::enable_if_t<!shad::is_execution_policy<InputIt1>::value, OutputIt>
+set_union(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+          OutputIt d_first, Compare comp) {
+  return impl::set_union(distributed_sequential_tag{}, first1, last1, first2,
+                         last2, d_first, comp);
+}
+
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class ForwardIt3, class Compare>
+ForwardIt3 set_union(ExecutionPolicy&& policy, ForwardIt1 first1,
+                     ForwardIt1 last1, ForwardIt2 first2, ForwardIt2 last2,
+                     ForwardIt3 d_first, Compare comp) {
+  return impl::set_union(std::forward<ExecutionPolicy>(policy), first1, last1,
+                         first2, last2, d_first, comp);
+}
+
+template <class InputIt1, class InputIt2, class OutputIt>
+OutputIt set_intersection(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                          InputIt2 last2, OutputIt d_first) {
+  return impl::set_intersection(distributed_sequential_tag{}, first1, last1,
+                                first2, last2, d_first, std::less<>());
+}
+
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class ForwardIt3>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value, ForwardIt3>
+set_intersection(ExecutionPolicy&& policy, ForwardIt1 first1, ForwardIt1 last1,
+                 ForwardIt2 first2, ForwardIt2 last2, ForwardIt3 d_first) {
+  return impl::set_intersection(std::forward<ExecutionPolicy>(policy), first1,
+                                last1, first2, last2, d_first, std::less<>());
+}
+
+template <class InputIt1, class InputIt2, class OutputIt, class Compare>
+std::enable_if_t<!shad::is_execution_policy<InputIt1>::value, OutputIt>
+set_intersection(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                 InputIt2 last2, OutputIt d_first, Compare comp) {
+  return impl::set_intersection(distributed_sequential_tag{}, first1, last1,
+                                first2, last2, d_first, comp);
+}
+
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class ForwardIt3, class Compare>
+ForwardIt3 set_intersection(ExecutionPolicy&& policy, ForwardIt1 first1,
+                            ForwardIt1 last1, ForwardIt2 first2,
+                            ForwardIt2 last2, ForwardIt3 d_first,
+                            Compare comp) {
+  return impl::set_intersection(std::forward<ExecutionPolicy>(policy), first1,
+                                last1, first2, last2, d_first, comp);
+}
+
+// ---------------------------------------------//
+//                                              //
+//               binary_search_ops              //
+//                                              //
+// ---------------------------------------------//
+
+/// @brief Searches a sorted range.
+///
+/// The owner of the portion of the range that contains the answer, found
+/// through an index of the largest element of each portion, completes the
+/// search locally.  The same holds for upper_bound, binary_search and
+/// equal_range.
+template <class ForwardIt, class T>
+ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T& value) {
+  return impl::lower_bound(distributed_sequential_tag{}, first, last, value,
+                           std::less<>());
+}
+
+template <class ExecutionPolicy, class ForwardIt, class T>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value, ForwardIt>
+lower_bound(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last,
+            const T& value) {
+  return impl::lower_bound(std::forward<ExecutionPolicy>(policy), first, last,
+                           value, std::less<>());
+}
+
+template <class ForwardIt, class T, class Compare>
+std::enable_if_t<!shad::is_execution_policy<ForwardIt>::value, ForwardIt>
+lower_bound(ForwardIt first, ForwardIt last, const T& value, Compare comp) {
+  return impl::lower_bound(distributed_sequential_tag{}, first, last, value,
+                           comp);
+}
+
+template <class ExecutionPolicy, class ForwardIt, class T, class Compare>
+ForwardIt lower_bound(ExecutionPolicy&& policy, ForwardIt first,
+                      ForwardIt last, const T& value, Compare comp) {
+  return impl::lower_bound(std::forward<ExecutionPolicy>(policy), first, last,
+                           value, comp);
+}
+
+template <class ForwardIt, class T>
+ForwardIt upper_bound(ForwardIt first, ForwardIt last, const T& value) {
+  return impl::upper_bound(distributed_sequential_tag{}, first, last, value,
+                           std::less<>());
+}
+
+template <class ExecutionPolicy, class ForwardIt, class T>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value, ForwardIt>
+upper_bound(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last,
+            const T& value) {
+  return impl::upper_bound(std::forward<ExecutionPolicy>(policy), first, last,
+                           value, std::less<>());
+}
+
+template <class ForwardIt, class T, class Compare>
+std::enable_if_t<!shad::is_execution_policy<ForwardIt>::value, ForwardIt>
+upper_bound(ForwardIt first, ForwardIt last, const T& value, Compare comp) {
+  return impl::upper_bound(distributed_sequential_tag{}, first, last, value,
+                           comp);
+}
+
+template <class ExecutionPolicy, class ForwardIt, class T, class Compare>
+ForwardIt upper_bound(ExecutionPolicy&& policy, ForwardIt first,
+                      ForwardIt last, const T& value, Compare comp) {
+  return impl::upper_bound(std::forward<ExecutionPolicy>(policy), first, last,
+                           value, comp);
+}
+
+template <class ForwardIt, class T>
+bool binary_search(ForwardIt first, ForwardIt last, const T& value) {
+  return impl::binary_search(distributed_sequential_tag{}, first, last, value,
+                             std::less<>());
+}
+
+template <class ExecutionPolicy, class ForwardIt, class T>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value, bool>
+binary_search(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last,
+              const T& value) {
+  return impl::binary_search(std::forward<ExecutionPolicy>(policy), first,
+                             last, value, std::less<>());
+}
+
+template <class ForwardIt, class T, class Compare>
+std::enable_if_t<!shad::is_execution_policy<ForwardIt>::value, bool>
+binary_search(ForwardIt first, ForwardIt last, const T& value, Compare comp) {
+  return impl::binary_search(distributed_sequential_tag{}, first, last, value,
+                             comp);
+}
+
+template <class ExecutionPolicy, class ForwardIt, class T, class Compare>
+bool binary_search(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last,
+                   const T& value, Compare comp) {
+  return impl::binary_search(std::forward<ExecutionPolicy>(policy), first,
+                             last, value, comp);
+}
+
+template <class ForwardIt, class T>
+std::pair<ForwardIt, ForwardIt> equal_range(ForwardIt first, ForwardIt last,
+                                            const T& value) {
+  return impl::equal_range(distributed_sequential_tag{}, first, last, value,
+                           std::less<>());
+}
+
+template <class ExecutionPolicy, class ForwardIt, class T>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value,
+                 std::pair<ForwardIt, ForwardIt>>
+equal_range(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last,
+            const T& value) {
+  return impl::equal_range(std::forward<ExecutionPolicy>(policy), first, last,
+                           value, std::less<>());
+}
+
+template <class ForwardIt, class T, class Compare>
+std::enable_if_t<!shad::is_execution_policy<ForwardIt>::value,
+                 std::pair<ForwardIt, ForwardIt>>
+equal_range(ForwardIt first, ForwardIt last, const T& value, Compare comp) {
+  return impl::equal_range(distributed_sequential_tag{}, first, last, value,
+                           comp);
+}
+
+template <class ExecutionPolicy, class ForwardIt, class T, class Compare>
+std::pair<ForwardIt, ForwardIt> equal_range(ExecutionPolicy&& policy,
+                                            ForwardIt first, ForwardIt last,
+                                            const T& value, Compare comp) {
+  return impl::equal_range(std::forward<ExecutionPolicy>(policy), first, last,
+                           value, comp);
+}
+
+/// @brief Batched lower_bound.
+///
+/// Writes to d_first[i] the position, relative to first, of the lower bound
+/// of q_first[i] in the sorted range [first, last).  Each locality owning
+/// queries ships them in bulk to the owners of the answers.  The range, the
+/// queries and the output must have random-access distributed iterators
+/// (e.g., from shad::array).
+///
+/// @return The end of the output range.
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class ForwardIt3>
+ForwardIt3 batch_lower_bound(ExecutionPolicy&& policy, ForwardIt1 first,
+                             ForwardIt1 last, ForwardIt2 q_first,
+                             ForwardIt2 q_last, ForwardIt3 d_first) {
+  return impl::batch_lower_bound(std::forward<ExecutionPolicy>(policy), first,
+                                 last, q_first, q_last, d_first,
+                                 std::less<>());
+}
+
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class ForwardIt3, class Compare>
+ForwardIt3 batch_lower_bound(ExecutionPolicy&& policy, ForwardIt1 first,
+                             ForwardIt1 last, ForwardIt2 q_first,
+                             ForwardIt2 q_last, ForwardIt3 d_first,
+                             Compare comp) {
+  return impl::batch_lower_bound(std::forward<ExecutionPolicy>(policy), first,
+                                 last, q_first, q_last, d_first, comp);
+}
+
+/// @brief Batched upper_bound (see batch_lower_bound).
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class ForwardIt3>
+ForwardIt3 batch_upper_bound(ExecutionPolicy&& policy, ForwardIt1 first,
+                             ForwardIt1 last, ForwardIt2 q_first,
+                             ForwardIt2 q_last, ForwardIt3 d_first) {
+  return impl::batch_upper_bound(std::forward<ExecutionPolicy>(policy), first,
+                                 last, q_first, q_last, d_first,
+                                 std::less<>());
+}
+
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class ForwardIt3, class Compare>
+ForwardIt3 batch_upper_bound(ExecutionPolicy&& policy, ForwardIt1 first,
+                             ForwardIt1 last, ForwardIt2 q_first,
+                             ForwardIt2 q_last, ForwardIt3 d_first,
+                             Compare comp) {
+  return impl::batch_upper_bound(std::forward<ExecutionPolicy>(policy), first,
+                                 last, q_first, q_last, d_first, comp);
+}
+
+/// @brief Batched binary_search: d_first[i] is set to whether q_first[i] is
+/// found in [first, last) (see batch_lower_bound).
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class ForwardIt3>
+ForwardIt3 batch_binary_search(ExecutionPolicy&& policy, ForwardIt1 first,
+                               ForwardIt1 last, ForwardIt2 q_first,
+                               ForwardIt2 q_last, ForwardIt3 d_first) {
+  return impl::batch_binary_search(std::forward<ExecutionPolicy>(policy),
+                                   first, last, q_first, q_last, d_first,
+                                   std::less<>());
+}
+
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class ForwardIt3, class Compare>
+ForwardIt3 batch_binary_search(ExecutionPolicy&& policy, ForwardIt1 first,
+                               ForwardIt1 last, ForwardIt2 q_first,
+                               ForwardIt2 q_last, ForwardIt3 d_first,
+                               Compare comp) {
+  return impl::batch_binary_search(std::forward<ExecutionPolicy>(policy),
+                                   first, last, q_first, q_last, d_first,
+                                   comp);
+}
+
 // ---------------------------------------------//
 //                                              //
 //                 comparison_ops               //
@@ -376,6 +1050,151 @@ bool lexicographical_compare(ExecutionPolicy&& policy, ForwardIt1 first1,
   return impl::lexicographical_compare(std::forward<ExecutionPolicy>(policy),
                                        first1, last1, first2, last2, comp);
 }
+
+// ---------------------------------------------//
+//                                              //
+//               permutation_ops                //
+//                                              //
+// ---------------------------------------------//
+
+/// @brief Reverses a range.
+///
+/// Each locality fetches the elements of its portion of the result with bulk
+/// transfers.  The range must have random-access distributed iterators.
+template <class BidirIt>
+void reverse(BidirIt first, BidirIt last) {
+  impl::reverse(distributed_sequential_tag{}, first, last);
+}
+
+template <class ExecutionPolicy, class BidirIt>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value> reverse(
+    ExecutionPolicy&& policy, BidirIt first, BidirIt last) {
+  impl::reverse(std::forward<ExecutionPolicy>(policy), first, last);
+}
+
+template <class BidirIt, class OutputIt>
+OutputIt reverse_copy(BidirIt first, BidirIt last, OutputIt d_first) {
+  return impl::reverse_copy(distributed_sequential_tag{}, first, last,
+                            d_first);
+}
+
+template <class ExecutionPolicy, class BidirIt, class ForwardIt>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value, ForwardIt>
+reverse_copy(ExecutionPolicy&& policy, BidirIt first, BidirIt last,
+             ForwardIt d_first) {
+  return impl::reverse_copy(std::forward<ExecutionPolicy>(policy), first,
+                            last, d_first);
+}
+
+/// @brief Rotates a range, so that middle becomes its first element.
+///
+/// @return An iterator to the new position of the element pointed by first.
+template <class ForwardIt>
+ForwardIt rotate(ForwardIt first, ForwardIt middle, ForwardIt last) {
+  return impl::rotate(distributed_sequential_tag{}, first, middle, last);
+}
+
+template <class ExecutionPolicy, class ForwardIt>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value, ForwardIt>
+rotate(ExecutionPolicy&& policy, ForwardIt first, ForwardIt middle,
+       ForwardIt last) {
+  return impl::rotate(std::forward<ExecutionPolicy>(policy), first, middle,
+                      last);
+}
+
+template <class ForwardIt, class OutputIt>
+OutputIt rotate_copy(ForwardIt first, ForwardIt middle, ForwardIt last,
+                     OutputIt d_first) {
+  return impl::rotate_copy(distributed_sequential_tag{}, first, middle, last,
+                           d_first);
+}
+
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value, ForwardIt2>
+rotate_copy(ExecutionPolicy&& policy, ForwardIt1 first, ForwardIt1 middle,
+            ForwardIt1 last, ForwardIt2 d_first) {
+  return impl::rotate_copy(std::forward<ExecutionPolicy>(policy), first,
+                           middle, last, d_first);
+}
+
+/// @brief Randomly permutes a range.
+///
+/// Every element is sent to a random portion of the range, chosen with a
+/// counter-based generator, in a single bulk exchange, and each portion
+/// shuffles the elements it receives.  The generator is only used to draw a
+/// seed: given its state and the distribution of the range, the result is
+/// reproducible and does not depend on the execution policy.
+template <class RandomIt, class URBG>
+void shuffle(RandomIt first, RandomIt last, URBG&& g) {
+  impl::shuffle(distributed_sequential_tag{}, first, last,
+                std::forward<URBG>(g));
+}
+
+template <class ExecutionPolicy, class RandomIt, class URBG>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value> shuffle(
+    ExecutionPolicy&& policy, RandomIt first, RandomIt last, URBG&& g) {
+  impl::shuffle(std::forward<ExecutionPolicy>(policy), first, last,
+                std::forward<URBG>(g));
+}
+
+/// @brief Transforms a range into the next permutation in lexicographical
+/// order.
+///
+/// @return false if the range was the last permutation, in that case it is
+/// transformed into the first one.
+template <class BidirIt>
+bool next_permutation(BidirIt first, BidirIt last) {
+  return impl::next_permutation(distributed_sequential_tag{}, first, last,
+                                std::less<>());
+}
+
+template <class ExecutionPolicy, class BidirIt>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value, bool>
+next_permutation(ExecutionPolicy&& policy, BidirIt first, BidirIt last) {
+  return impl::next_permutation(std::forward<ExecutionPolicy>(policy), first,
+                                last, std::less<>());
+}
+
+template <class BidirIt, class Compare>
+std::enable_if_t<!shad::is_execution_policy<BidirIt>::value, bool>
+next_permutation(BidirIt first, BidirIt last, Compare comp) {
+  return impl::next_permutation(distributed_sequential_tag{}, first, last,
+                                comp);
+}
+
+template <class ExecutionPolicy, class BidirIt, class Compare>
+bool next_permutation(ExecutionPolicy&& policy, BidirIt first, BidirIt last,
+                      Compare comp) {
+  return impl::next_permutation(std::forward<ExecutionPolicy>(policy), first,
+                                last, comp);
+}
+
+template <class BidirIt>
+bool prev_permutation(BidirIt first, BidirIt last) {
+  return impl::prev_permutation(distributed_sequential_tag{}, first, last,
+                                std::less<>());
+}
+
+template <class ExecutionPolicy, class BidirIt>
+std::enable_if_t<shad::is_execution_policy<ExecutionPolicy>::value, bool>
+prev_permutation(ExecutionPolicy&& policy, BidirIt first, BidirIt last) {
+  return impl::prev_permutation(std::forward<ExecutionPolicy>(policy), first,
+                                last, std::less<>());
+}
+
+template <class BidirIt, class Compare>
+std::enable_if_t<!shad::is_execution_policy<BidirIt>::value, bool>
+prev_permutation(BidirIt first, BidirIt last, Compare comp) {
+  return impl::prev_permutation(distributed_sequential_tag{}, first, last,
+                                comp);
+}
+
+template <class ExecutionPolicy, class BidirIt, class Compare>
+bool prev_permutation(ExecutionPolicy&& policy, BidirIt first, BidirIt last,
+                      Compare comp) {
+  return impl::prev_permutation(std::forward<ExecutionPolicy>(policy), first,
+                                last, comp);
+}
 }  // namespace shad
 
 #endif /* INCLUDE_SHAD_CORE_ALGORITHM_H */
@@ -28,13 +28,431 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "shad/core/execution.h"
+#include "shad/core/impl/impl_patterns.h"
 #include "shad/distributed_iterator_traits.h"
 #include "shad/runtime/runtime.h"
 
 namespace shad {
 namespace impl {
 
+namespace search_impl {
+
+// Searches work on the portions of the sorted range (one for each locality
+// for block distributed containers).  A single query bisects the portions:
+// each probe runs the search locally on the owner of a portion, and tells
+// whether the answer lies before, in or after it, so a query costs O(log P)
+// remote calls for P portions instead of one remote probe for each bisection
+// step over the elements.  Batched searches first build an index holding the
+// largest element of each portion, replicate it on the localities owning the
+// queries, and ship the queries to the owners of the data in bulk.
+
+enum class search_op { lower_bound, upper_bound, binary_search };
+
+template <typename T>
+struct search_piece {
+  rt::Locality locality;
+  size_t offset;
+  size_t size;
+  T max;
+};
+
+template <typename Q>
+struct search_request {
+  Q value;
+  size_t offset;  // the portion of the range containing the answer
+  size_t size;
+};
+
+// the non-empty portions of the range, without their largest element
+template <typename ForwardIt>
+std::vector<search_piece<typename ForwardIt::value_type>> search_pieces(
+    ForwardIt first, ForwardIt last) {
+  using T = typename ForwardIt::value_type;
+  using itr_traits = distributed_random_access_iterator_trait<ForwardIt>;
+  std::vector<search_piece<T>> pieces;
+  if (first == last) return pieces;
+
+  size_t offset = 0;
+  for (auto& piece : itr_traits::distribution(first, last)) {
+    if (piece.second != 0)
+      pieces.push_back(search_piece<T>{piece.first, offset, piece.second, T{}});
+    offset += piece.second;
+  }
+  return pieces;
+}
+
+template <typename ForwardIt>
+std::vector<search_piece<typename ForwardIt::value_type>> search_index(
+    ForwardIt first, ForwardIt last) {
+  using T = typename ForwardIt::value_type;
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  auto index = search_pieces(first, last);
+
+  rt::Handle h;
+  for (auto& piece : index) {
+    auto p_first = std::next(first, piece.offset);
+    rt::asyncExecuteAtWithRet(
+        h, piece.locality,
+        [](rt::Handle&, const std::pair<ForwardIt, ForwardIt>& range,
+           T* res) {
+          auto lrange = itr_traits::local_range(range.first, range.second);
+          auto size = std::distance(lrange.begin(), lrange.end());
+          *res = (&*lrange.begin())[size - 1];
+        },
+        std::make_pair(p_first, std::next(p_first, piece.size)), &piece.max);
+  }
+  rt::waitForCompletion(h);
+  return index;
+}
+
+// the position, in the index, of the portion containing the answer
+template <typename T, typename Q, typename Compare>
+size_t find_piece(const search_piece<T>* index, size_t size, const Q& value,
+                  Compare comp, search_op op) {
+  if (op == search_op::upper_bound)
+    return std::partition_point(
+               index, index + size,
+               [&](const search_piece<T>& p) { return !comp(value, p.max); }) -
+           index;
+  return std::partition_point(
+             index, index + size,
+             [&](const search_piece<T>& p) { return comp(p.max, value); }) -
+         index;
+}
+
+// Answers queries on the local portions selected by the index.  Batches
+// mostly target the same portion, whose memory is resolved once.
+template <typename ForwardIt>
+class local_searcher {
+ public:
+  using T = typename ForwardIt::value_type;
+
+  explicit local_searcher(ForwardIt first) : first_(first) {}
+
+  template <typename Q, typename Compare>
+  size_t operator()(const search_request<Q>& request, Compare comp,
+                    search_op op) {
+    if (request.offset != offset_) {
+      using itr_traits = distributed_iterator_traits<ForwardIt>;
+      auto p_first = std::next(first_, request.offset);
+      auto lrange =
+          itr_traits::local_range(p_first, std::next(p_first, request.size));
+      offset_ = request.offset;
+      base_ = &*lrange.begin();
+    }
+    auto b = base_, e = base_ + request.size;
+    if (op == search_op::upper_bound)
+      return offset_ + (std::upper_bound(b, e, request.value, comp) - b);
+    auto it = std::lower_bound(b, e, request.value, comp);
+    if (op == search_op::binary_search)
+      return it != e && !comp(request.value, *it);
+    return offset_ + (it - b);
+  }
+
+ private:
+  ForwardIt first_;
+  size_t offset_ = std::numeric_limits<size_t>::max();
+  const T* base_ = nullptr;
+};
+
+// answer when no portion contains the answer
+inline size_t answer_past_end(size_t n, search_op op) {
+  return op == search_op::binary_search ? 0 : n;
+}
+
+// the answer of a query within a portion of the range
+struct search_probe {
+  size_t pos;  // relative to the portion
+  bool match;
+};
+
+template <typename ForwardIt, typename Q, typename Compare>
+void probe_piece(
+    const std::tuple<ForwardIt, search_request<Q>, Compare, search_op>& args,
+    search_probe* res) {
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  auto& request = std::get<1>(args);
+  auto comp = std::get<2>(args);
+  auto p_first = std::next(std::get<0>(args), request.offset);
+  auto lrange =
+      itr_traits::local_range(p_first, std::next(p_first, request.size));
+  auto b = &*lrange.begin(), e = b + request.size;
+  auto it = std::get<3>(args) == search_op::upper_bound
+                ? std::upper_bound(b, e, request.value, comp)
+                : std::lower_bound(b, e, request.value, comp);
+  res->pos = it - b;
+  res->match = it != e && !comp(request.value, *it);
+}
+
+// Answers a query by bisecting the portions from pieces[lo], and returns
+// the answer with the position of the portion containing it.  The answer is
+// in the first portion whose probe does not run past its end; a probe that
+// stops strictly inside its portion ends the bisection early.
+template <typename ForwardIt, typename T, typename Q, typename Compare>
+std::pair<size_t, size_t> search(ForwardIt first, size_t n,
+                                 const std::vector<search_piece<T>>& pieces,
+                                 size_t lo, const Q& value, Compare comp,
+                                 search_op op) {
+  size_t hi = pieces.size();
+  search_probe found{0, false};
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    auto& piece = pieces[mid];
+    search_probe probe;
+    rt::executeAtWithRet(
+        piece.locality, probe_piece<ForwardIt, Q, Compare>,
+        std::make_tuple(first,
+                        search_request<Q>{value, piece.offset, piece.size},
+                        comp, op),
+        &probe);
+    if (probe.pos == piece.size) {
+      lo = mid + 1;
+      continue;
+    }
+    hi = mid;
+    found = probe;
+    if (probe.pos != 0) break;
+  }
+  if (hi == pieces.size())
+    return std::make_pair(answer_past_end(n, op), hi);
+  if (op == search_op::binary_search)
+    return std::make_pair(static_cast<size_t>(found.match), hi);
+  return std::make_pair(pieces[hi].offset + found.pos, hi);
+}
+
+template <typename ForwardIt, typename Q, typename Compare>
+size_t search(ForwardIt first, ForwardIt last, const Q& value, Compare comp,
+              search_op op) {
+  return search(first, std::distance(first, last), search_pieces(first, last),
+                0, value, comp, op)
+      .first;
+}
+
+// answer a batch of queries shipped by another locality
+template <typename ForwardIt, typename Q, typename Compare>
+void answer_batch(
+    rt::Handle&,
+    const std::tuple<ForwardIt, const search_request<Q>*, size_t*, size_t,
+                     rt::Locality, Compare, search_op>& args) {
+  auto size = std::get<3>(args);
+  auto src = std::get<4>(args);
+  std::vector<search_request<Q>> requests(size);
+  std::vector<size_t> answers(size);
+  rt::dma(requests.data(), src, std::get<1>(args), size);
+  local_searcher<ForwardIt> searcher(std::get<0>(args));
+  for (size_t i = 0; i < size; ++i)
+    answers[i] = searcher(requests[i], std::get<5>(args), std::get<6>(args));
+  rt::dma(src, std::get<2>(args), answers.data(), size);
+}
+
+template <typename ForwardIt, typename InputIt, typename OutputIt,
+          typename Compare>
+struct batch_args {
+  using T = typename ForwardIt::value_type;
+  ForwardIt first;
+  size_t n;
+  InputIt q_first;
+  size_t q_offset;  // the portion of the queries processed by a locality
+  size_t q_size;
+  OutputIt d_first;
+  Compare comp;
+  search_op op;
+  const search_piece<T>* index;
+  size_t index_size;
+  rt::Locality root;
+  size_t num_tasks;
+};
+
+// Answer the queries of a local portion.  Each task groups its queries by
+// the locality owning their answer, answers the local ones, and ships the
+// others to their owners in one batch for each locality.
+template <typename ForwardIt, typename InputIt, typename OutputIt,
+          typename Compare>
+void search_batch(
+    rt::Handle&,
+    const batch_args<ForwardIt, InputIt, OutputIt, Compare>& args) {
+  using T = typename ForwardIt::value_type;
+  using Q = typename InputIt::value_type;
+  using R = typename OutputIt::value_type;
+  using itr_traits = distributed_iterator_traits<InputIt>;
+
+  // replicate the index
+  std::vector<search_piece<T>> index(args.index_size);
+  if (args.root == rt::thisLocality())
+    std::copy(args.index, args.index + args.index_size, index.begin());
+  else
+    rt::dma(index.data(), args.root, args.index, args.index_size);
+
+  auto q_first = std::next(args.q_first, args.q_offset);
+  auto lrange =
+      itr_traits::local_range(q_first, std::next(q_first, args.q_size));
+  std::vector<size_t> answers(args.q_size);
+  auto num_tasks = std::min(args.num_tasks, args.q_size);
+
+  auto map_args = std::make_tuple(args, index.data(), &*lrange.begin(),
+                                  answers.data(), num_tasks);
+  rt::forEachAt(
+      rt::thisLocality(),
+      [](const decltype(map_args)& map_args, size_t t) {
+        auto& args = std::get<0>(map_args);
+        auto index = std::get<1>(map_args);
+        auto queries = std::get<2>(map_args);
+        auto answers = std::get<3>(map_args);
+        auto num_tasks = std::get<4>(map_args);
+
+        auto num_localities = rt::numLocalities();
+        local_searcher<ForwardIt> searcher(args.first);
+        std::vector<std::vector<search_request<Q>>> requests(num_localities);
+        std::vector<std::vector<size_t>> positions(num_localities);
+        for (size_t i = t * args.q_size / num_tasks,
+                    e = (t + 1) * args.q_size / num_tasks;
+             i < e; ++i) {
+          auto p = find_piece(index, args.index_size, queries[i], args.comp,
+                              args.op);
+          if (p == args.index_size) {
+            answers[i] = answer_past_end(args.n, args.op);
+            continue;
+          }
+          search_request<Q> request{queries[i], index[p].offset,
+                                    index[p].size};
+          if (index[p].locality == rt::thisLocality()) {
+            answers[i] = searcher(request, args.comp, args.op);
+          } else {
+            auto l = static_cast<uint32_t>(index[p].locality);
+            requests[l].push_back(request);
+            positions[l].push_back(i);
+          }
+        }
+
+        std::vector<std::vector<size_t>> remote_answers(num_localities);
+        rt::Handle h;
+        for (uint32_t l = 0; l < num_localities; ++l) {
+          if (requests[l].empty()) continue;
+          remote_answers[l].resize(requests[l].size());
+          const search_request<Q>* batch = requests[l].data();
+          rt::asyncExecuteAt(
+              h, rt::Locality(l), answer_batch<ForwardIt, Q, Compare>,
+              std::make_tuple(args.first, batch, remote_answers[l].data(),
+                              requests[l].size(), rt::thisLocality(),
+                              args.comp, args.op));
+        }
+        rt::waitForCompletion(h);
+        for (uint32_t l = 0; l < num_localities; ++l)
+          for (size_t i = 0; i < positions[l].size(); ++i)
+            answers[positions[l][i]] = remote_answers[l][i];
+      },
+      map_args, num_tasks);
+
+  std::vector<R> results(answers.begin(), answers.end());
+  write_to_range(results.data(), results.size(),
+                 std::next(args.d_first, args.q_offset));
+}
+
+template <typename ExecutionPolicy, typename ForwardIt, typename InputIt,
+          typename OutputIt, typename Compare>
+OutputIt search_batch(ExecutionPolicy&& policy, ForwardIt first,
+                      ForwardIt last, InputIt q_first, InputIt q_last,
+                      OutputIt d_first, Compare comp, search_op op) {
+  using q_traits = distributed_random_access_iterator_trait<InputIt>;
+  if (q_first == q_last) return d_first;
+
+  auto index = search_index(first, last);
+  size_t n = std::distance(first, last);
+  auto pieces = q_traits::distribution(q_first, q_last);
+  rt::Handle h;
+  size_t q_offset = 0;
+  for (auto& piece : pieces) {
+    batch_args<ForwardIt, InputIt, OutputIt, Compare> args{
+        first, n, q_first, q_offset, piece.second, d_first, comp, op,
+        index.data(), index.size(), rt::thisLocality(), num_tasks(policy)};
+    rt::asyncExecuteAt(h, piece.first,
+                       search_batch<ForwardIt, InputIt, OutputIt, Compare>,
+                       args);
+    q_offset += piece.second;
+  }
+  rt::waitForCompletion(h);
+  return std::next(d_first, q_offset);
+}
+
+}  // namespace search_impl
+
+template <typename ExecutionPolicy, typename ForwardIt, typename T,
+          typename Compare>
+ForwardIt lower_bound(ExecutionPolicy&&, ForwardIt first, ForwardIt last,
+                      const T& value, Compare comp) {
+  return std::next(first,
+                   search_impl::search(first, last, value, comp,
+                                       search_impl::search_op::lower_bound));
+}
+
+template <typename ExecutionPolicy, typename ForwardIt, typename T,
+          typename Compare>
+ForwardIt upper_bound(ExecutionPolicy&&, ForwardIt first, ForwardIt last,
+                      const T& value, Compare comp) {
+  return std::next(first,
+                   search_impl::search(first, last, value, comp,
+                                       search_impl::search_op::upper_bound));
+}
+
+template <typename ExecutionPolicy, typename ForwardIt, typename T,
+          typename Compare>
+bool binary_search(ExecutionPolicy&&, ForwardIt first, ForwardIt last,
+                   const T& value, Compare comp) {
+  return search_impl::search(first, last, value, comp,
+                             search_impl::search_op::binary_search);
+}
+
+template <typename ExecutionPolicy, typename ForwardIt, typename T,
+          typename Compare>
+std::pair<ForwardIt, ForwardIt> equal_range(ExecutionPolicy&&,
+                                            ForwardIt first, ForwardIt last,
+                                            const T& value, Compare comp) {
+  // the upper bound is never in a portion before the lower bound
+  size_t n = std::distance(first, last);
+  auto pieces = search_impl::search_pieces(first, last);
+  auto lower = search_impl::search(first, n, pieces, 0, value, comp,
+                                   search_impl::search_op::lower_bound);
+  auto upper = search_impl::search(first, n, pieces, lower.second, value, comp,
+                                   search_impl::search_op::upper_bound);
+  return std::make_pair(std::next(first, lower.first),
+                        std::next(first, upper.first));
+}
+
+template <typename ExecutionPolicy, typename ForwardIt, typename InputIt,
+          typename OutputIt, typename Compare>
+OutputIt batch_lower_bound(ExecutionPolicy&& policy, ForwardIt first,
+                           ForwardIt last, InputIt q_first, InputIt q_last,
+                           OutputIt d_first, Compare comp) {
+  return search_impl::search_batch(
+      std::forward<ExecutionPolicy>(policy), first, last, q_first, q_last,
+      d_first, comp, search_impl::search_op::lower_bound);
+}
+
+template <typename ExecutionPolicy, typename ForwardIt, typename InputIt,
+          typename OutputIt, typename Compare>
+OutputIt batch_upper_bound(ExecutionPolicy&& policy, ForwardIt first,
+                           ForwardIt last, InputIt q_first, InputIt q_last,
+                           OutputIt d_first, Compare comp) {
+  return search_impl::search_batch(
+      std::forward<ExecutionPolicy>(policy), first, last, q_first, q_last,
+      d_first, comp, search_impl::search_op::upper_bound);
+}
+
+template <typename ExecutionPolicy, typename ForwardIt, typename InputIt,
+          typename OutputIt, typename Compare>
+OutputIt batch_binary_search(ExecutionPolicy&& policy, ForwardIt first,
+                             ForwardIt last, InputIt q_first, InputIt q_last,
+                             OutputIt d_first, Compare comp) {
+  return search_impl::search_batch(
+      std::forward<ExecutionPolicy>(policy), first, last, q_first, q_last,
+      d_first, comp, search_impl::search_op::binary_search);
+}
 
 }  // namespace impl
 }  // namespace shad
@@ -28,13 +28,415 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "shad/core/execution.h"
+#include "shad/core/impl/impl_patterns.h"
+#include "shad/core/impl/partitioning_ops.h"
 #include "shad/distributed_iterator_traits.h"
 #include "shad/runtime/runtime.h"
 
 namespace shad {
 namespace impl {
 
+namespace heap_impl {
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// top-k: each task keeps the k smallest elements of its partition in a
+// bounded heap, the per-task heaps are merged into one sorted list for each
+// locality, and the lists are merged pairwise across localities in a tree.
+//
+////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+struct top_k_list {
+  std::vector<T>* values;
+  const T* data;
+  size_t size;
+};
+
+template <typename T, typename Compare>
+void push_bounded(std::vector<T>& heap, size_t k, const T& x, Compare comp) {
+  if (heap.size() < k) {
+    heap.push_back(x);
+    std::push_heap(heap.begin(), heap.end(), comp);
+  } else if (comp(x, heap.front())) {
+    std::pop_heap(heap.begin(), heap.end(), comp);
+    heap.back() = x;
+    std::push_heap(heap.begin(), heap.end(), comp);
+  }
+}
+
+template <typename ForwardIt, typename Compare>
+void local_top_k(
+    rt::Handle&,
+    const std::tuple<ForwardIt, ForwardIt, size_t, Compare, size_t>& args,
+    top_k_list<typename ForwardIt::value_type>* res) {
+  using T = typename ForwardIt::value_type;
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
+  auto lrange = itr_traits::local_range(std::get<0>(args), std::get<1>(args));
+  auto k = std::get<2>(args);
+  auto parts = local_iterator_traits<local_iterator_t>::partitions(
+      lrange.begin(), lrange.end(), std::get<4>(args));
+
+  std::vector<std::vector<T>> heaps(parts.size());
+  if (parts.size()) {
+    auto map_args = std::make_tuple(parts.data(), heaps.data(), k,
+                                    std::get<3>(args));
+    rt::forEachAt(
+        rt::thisLocality(),
+        [](const decltype(map_args)& map_args, size_t i) {
+          auto& part = std::get<0>(map_args)[i];
+          auto& heap = std::get<1>(map_args)[i];
+          auto k = std::get<2>(map_args);
+          auto comp = std::get<3>(map_args);
+          // small partitions are kept whole
+          if (size_t(std::distance(part.begin(), part.end())) <= k) {
+            heap.assign(part.begin(), part.end());
+            return;
+          }
+          heap.reserve(k);
+          for (auto it = part.begin(); it != part.end(); ++it)
+            push_bounded(heap, k, *it, comp);
+        },
+        map_args, parts.size());
+  }
+
+  auto values = new std::vector<T>();
+  for (auto& heap : heaps)
+    values->insert(values->end(), heap.begin(), heap.end());
+  auto middle = values->begin() + std::min(k, values->size());
+  std::partial_sort(values->begin(), middle, values->end(), std::get<3>(args));
+  values->erase(middle, values->end());
+  *res = top_k_list<T>{values, values->data(), values->size()};
+}
+
+// merge the list of another locality into the one of the calling locality
+template <typename T, typename Compare>
+void merge_top_k(rt::Handle&,
+                 const std::tuple<std::vector<T>*, rt::Locality, top_k_list<T>,
+                                  size_t, Compare>& args,
+                 top_k_list<T>* res) {
+  auto values = std::get<0>(args);
+  auto other = std::get<2>(args);
+  std::vector<T> remote(other.size);
+  rt::dma(remote.data(), std::get<1>(args), other.data, other.size);
+  rt::executeAt(
+      std::get<1>(args),
+      [](std::vector<T>* const& values) { delete values; }, other.values);
+
+  std::vector<T> merged(values->size() + remote.size());
+  std::merge(values->begin(), values->end(), remote.begin(), remote.end(),
+             merged.begin(), std::get<4>(args));
+  merged.resize(std::min(merged.size(), std::get<3>(args)));
+  values->swap(merged);
+  *res = top_k_list<T>{values, values->data(), values->size()};
+}
+
+template <typename ExecutionPolicy, typename ForwardIt, typename Compare>
+std::vector<typename ForwardIt::value_type> top_k(ExecutionPolicy&& policy,
+                                                  ForwardIt first,
+                                                  ForwardIt last, size_t k,
+                                                  Compare comp) {
+  using T = typename ForwardIt::value_type;
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  if (first == last || k == 0) return std::vector<T>();
+
+  auto localities = itr_traits::localities(first, last);
+  std::vector<rt::Locality> owners;
+  for (auto locality = localities.begin(), end = localities.end();
+       locality != end; ++locality)
+    owners.push_back(locality);
+  std::vector<top_k_list<T>> lists(owners.size());
+  rt::Handle h;
+  for (size_t i = 0; i < owners.size(); ++i)
+    rt::asyncExecuteAtWithRet(
+        h, owners[i], local_top_k<ForwardIt, Compare>,
+        std::make_tuple(first, last, k, comp, num_tasks(policy)), &lists[i]);
+  rt::waitForCompletion(h);
+
+  for (size_t stride = 1; stride < owners.size(); stride *= 2) {
+    for (size_t i = 0; i + stride < owners.size(); i += 2 * stride)
+      rt::asyncExecuteAtWithRet(
+          h, owners[i], merge_top_k<T, Compare>,
+          std::make_tuple(lists[i].values, owners[i + stride],
+                          lists[i + stride], k, comp),
+          &lists[i]);
+    rt::waitForCompletion(h);
+  }
+
+  std::vector<T> res(lists[0].size);
+  rt::dma(res.data(), owners[0], lists[0].data, lists[0].size);
+  rt::executeAt(
+      owners[0], [](std::vector<T>* const& values) { delete values; },
+      lists[0].values);
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// selection: each locality keeps a copy of the candidates of its local
+// portion.  At every round a pivot is picked from a weighted sample of the
+// candidates, near the rank of the searched element; the candidates are
+// counted against the pivot and the ones on the wrong side are dropped.
+// Once few candidates are left, they are gathered and selected locally.
+//
+////////////////////////////////////////////////////////////////////////////////
+constexpr size_t kSelectSamples = 16;
+constexpr size_t kSelectGatherSize = 1 << 14;
+
+template <typename T>
+struct select_sample {
+  std::vector<T>* candidates;
+  size_t size;
+  T samples[kSelectSamples];
+};
+
+template <typename ForwardIt>
+void select_init(rt::Handle&, const std::pair<ForwardIt, ForwardIt>& range,
+                 select_sample<typename ForwardIt::value_type>* res) {
+  using T = typename ForwardIt::value_type;
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  auto lrange = itr_traits::local_range(range.first, range.second);
+  res->candidates = new std::vector<T>(lrange.begin(), lrange.end());
+}
+
+template <typename T>
+void select_draw(rt::Handle&, const std::pair<std::vector<T>*, size_t>& args,
+                 select_sample<T>* res) {
+  auto candidates = args.first;
+  res->candidates = candidates;
+  res->size = candidates->size();
+  if (candidates->empty()) return;
+  std::mt19937_64 gen(args.second);
+  std::uniform_int_distribution<size_t> dist(0, candidates->size() - 1);
+  for (auto& sample : res->samples) sample = (*candidates)[dist(gen)];
+}
+
+template <typename T>
+void candidate_list(rt::Handle&, std::vector<T>* const& candidates,
+                    top_k_list<T>* res) {
+  *res = top_k_list<T>{candidates, candidates->data(), candidates->size()};
+}
+
+// the number of candidates that are less than or equivalent to the pivot
+template <typename T, typename Compare>
+void select_count(
+    rt::Handle&,
+    const std::tuple<std::vector<T>*, T, Compare, size_t>& args,
+    std::pair<size_t, size_t>* res) {
+  auto& candidates = *std::get<0>(args);
+  auto num_tasks =
+      std::max<size_t>(1, std::min(std::get<3>(args), candidates.size()));
+  std::vector<std::pair<size_t, size_t>> counts(num_tasks);
+  auto map_args = std::make_tuple(std::get<0>(args), std::get<1>(args),
+                                  std::get<2>(args), counts.data(), num_tasks);
+  rt::forEachAt(
+      rt::thisLocality(),
+      [](const decltype(map_args)& map_args, size_t t) {
+        auto& candidates = *std::get<0>(map_args);
+        auto& pivot = std::get<1>(map_args);
+        auto comp = std::get<2>(map_args);
+        auto num_tasks = std::get<4>(map_args);
+        size_t less = 0, equal = 0;
+        for (size_t i = t * candidates.size() / num_tasks,
+                    e = (t + 1) * candidates.size() / num_tasks;
+             i < e; ++i) {
+          if (comp(candidates[i], pivot))
+            ++less;
+          else if (!comp(pivot, candidates[i]))
+            ++equal;
+        }
+        std::get<3>(map_args)[t] = std::make_pair(less, equal);
+      },
+      map_args, num_tasks);
+
+  *res = std::make_pair(0, 0);
+  for (auto& c : counts) {
+    res->first += c.first;
+    res->second += c.second;
+  }
+}
+
+// keep the candidates that are less (or greater) than the pivot
+template <typename T, typename Compare>
+void select_filter(rt::Handle&,
+                   const std::tuple<std::vector<T>*, T, Compare, bool>& args) {
+  auto& candidates = *std::get<0>(args);
+  auto& pivot = std::get<1>(args);
+  auto comp = std::get<2>(args);
+  auto keep_less = std::get<3>(args);
+  auto last = std::remove_if(
+      candidates.begin(), candidates.end(), [&](const T& x) {
+        return keep_less ? !comp(x, pivot) : !comp(pivot, x);
+      });
+  candidates.erase(last, candidates.end());
+}
+
+template <typename T, typename Compare>
+struct less_than_pivot {
+  bool operator()(const T& x) const { return comp(x, pivot); }
+  T pivot;
+  Compare comp;
+};
+
+template <typename T, typename Compare>
+struct not_greater_than_pivot {
+  bool operator()(const T& x) const { return !comp(pivot, x); }
+  T pivot;
+  Compare comp;
+};
+
+// the value of the element of rank k in [first, last)
+template <typename ExecutionPolicy, typename ForwardIt, typename Compare>
+typename ForwardIt::value_type select(ExecutionPolicy&& policy,
+                                      ForwardIt first, ForwardIt last,
+                                      size_t k, Compare comp) {
+  using T = typename ForwardIt::value_type;
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  auto localities = itr_traits::localities(first, last);
+  std::vector<rt::Locality> owners;
+  for (auto locality = localities.begin(), end = localities.end();
+       locality != end; ++locality)
+    owners.push_back(locality);
+  std::vector<select_sample<T>> samples(owners.size());
+  rt::Handle h;
+  for (size_t i = 0; i < owners.size(); ++i)
+    rt::asyncExecuteAtWithRet(h, owners[i], select_init<ForwardIt>,
+                              std::make_pair(first, last), &samples[i]);
+  rt::waitForCompletion(h);
+
+  size_t total = std::distance(first, last);
+  for (size_t round = 0; total > kSelectGatherSize; ++round) {
+    for (size_t i = 0; i < owners.size(); ++i)
+      rt::asyncExecuteAtWithRet(
+          h, owners[i], select_draw<T>,
+          std::make_pair(samples[i].candidates, round * owners.size() + i),
+          &samples[i]);
+    rt::waitForCompletion(h);
+
+    // the sample closest to rank k, each weighted by its locality size
+    std::vector<std::pair<T, double>> weighted;
+    for (auto& s : samples)
+      for (size_t j = 0; s.size && j < kSelectSamples; ++j)
+        weighted.emplace_back(s.samples[j], double(s.size) / kSelectSamples);
+    std::sort(weighted.begin(), weighted.end(),
+              [&](const std::pair<T, double>& a,
+                  const std::pair<T, double>& b) {
+                return comp(a.first, b.first);
+              });
+    T pivot = weighted.back().first;
+    double rank = 0;
+    for (auto& w : weighted) {
+      rank += w.second;
+      if (rank > k) {
+        pivot = w.first;
+        break;
+      }
+    }
+
+    std::vector<std::pair<size_t, size_t>> counts(owners.size());
+    for (size_t i = 0; i < owners.size(); ++i)
+      rt::asyncExecuteAtWithRet(
+          h, owners[i], select_count<T, Compare>,
+          std::make_tuple(samples[i].candidates, pivot, comp,
+                          num_tasks(policy)),
+          &counts[i]);
+    rt::waitForCompletion(h);
+    size_t less = 0, equal = 0;
+    for (auto& c : counts) {
+      less += c.first;
+      equal += c.second;
+    }
+
+    bool keep_less = k < less;
+    if (!keep_less && k < less + equal) {
+      for (size_t i = 0; i < owners.size(); ++i)
+        rt::asyncExecuteAt(
+            h, owners[i],
+            [](rt::Handle&, std::vector<T>* const& values) { delete values; },
+            samples[i].candidates);
+      rt::waitForCompletion(h);
+      return pivot;
+    }
+    if (!keep_less) k -= less + equal;
+    total = keep_less ? less : total - less - equal;
+    for (size_t i = 0; i < owners.size(); ++i)
+      rt::asyncExecuteAt(
+          h, owners[i], select_filter<T, Compare>,
+          std::make_tuple(samples[i].candidates, pivot, comp, keep_less));
+    rt::waitForCompletion(h);
+  }
+
+  // gather the remaining candidates
+  std::vector<top_k_list<T>> lists(owners.size());
+  for (size_t i = 0; i < owners.size(); ++i)
+    rt::asyncExecuteAtWithRet(h, owners[i], candidate_list<T>,
+                              samples[i].candidates, &lists[i]);
+  rt::waitForCompletion(h);
+  std::vector<T> candidates;
+  for (size_t i = 0; i < owners.size(); ++i) {
+    auto offset = candidates.size();
+    candidates.resize(offset + lists[i].size);
+    rt::dma(candidates.data() + offset, owners[i], lists[i].data,
+            lists[i].size);
+    rt::executeAt(
+        owners[i], [](std::vector<T>* const& values) { delete values; },
+        lists[i].values);
+  }
+  std::nth_element(candidates.begin(), candidates.begin() + k,
+                   candidates.end(), comp);
+  return candidates[k];
+}
+
+}  // namespace heap_impl
+
+template <typename ExecutionPolicy, typename ForwardIt, typename Compare>
+std::vector<typename ForwardIt::value_type> top_k(ExecutionPolicy&& policy,
+                                                  ForwardIt first,
+                                                  ForwardIt last, size_t k,
+                                                  Compare comp) {
+  return heap_impl::top_k(std::forward<ExecutionPolicy>(policy), first, last,
+                          k, comp);
+}
+
+// the range is split in three parts around the selected value, the elements
+// equivalent to it include nth.  Only the side of the first partition that
+// holds nth is partitioned again: the lower side when nth is in the first
+// half of the range.
+template <typename ExecutionPolicy, typename RandomIt, typename Compare>
+void nth_element(ExecutionPolicy&& policy, RandomIt first, RandomIt nth,
+                 RandomIt last, Compare comp) {
+  using T = typename RandomIt::value_type;
+  using less_t = heap_impl::less_than_pivot<T, Compare>;
+  using not_greater_t = heap_impl::not_greater_than_pivot<T, Compare>;
+  if (nth == last) return;
+  size_t k = std::distance(first, nth);
+  auto pivot = heap_impl::select(policy, first, last, k, comp);
+  if (2 * k < static_cast<size_t>(std::distance(first, last))) {
+    auto upper =
+        impl::partition(policy, first, last, not_greater_t{pivot, comp});
+    impl::partition(policy, first, upper, less_t{pivot, comp});
+  } else {
+    auto lower = impl::partition(policy, first, last, less_t{pivot, comp});
+    impl::partition(policy, lower, last, not_greater_t{pivot, comp});
+  }
+}
+
+template <typename ExecutionPolicy, typename InputIt, typename RandomIt,
+          typename Compare>
+RandomIt partial_sort_copy(ExecutionPolicy&& policy, InputIt first,
+                           InputIt last, RandomIt d_first, RandomIt d_last,
+                           Compare comp) {
+  auto values = heap_impl::top_k(std::forward<ExecutionPolicy>(policy), first,
+                                 last, std::distance(d_first, d_last), comp);
+  write_to_range(values.data(), values.size(), d_first);
+  return std::next(d_first, values.size());
+}
 
 }  // namespace impl
 }  // namespace shad
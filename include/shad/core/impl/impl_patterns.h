@@ -25,6 +25,8 @@
 #ifndef INCLUDE_SHAD_CORE_IMPL_IMPL_PATTERNS_H
 #define INCLUDE_SHAD_CORE_IMPL_IMPL_PATTERNS_H
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <iterator>
 #include <tuple>
@@ -32,6 +34,7 @@
 #include <utility>
 #include <vector>
 
+#include "shad/core/execution.h"
 #include "shad/distributed_iterator_traits.h"
 #include "shad/runtime/runtime.h"
 
@@ -378,6 +381,409 @@ void local_map_void_offset(ForwardIt first, ForwardIt last, MapF&& map_kernel) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// distributed_map_reduce is the reduction engine shared by the parallel
+// algorithms.  Partial results are combined in the order of the range, so the
+// reduce operation must be associative, but it does not need to be
+// commutative.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// minimum number of pairs of partial results combined in parallel
+constexpr size_t kMinParallelCombine = 32;
+
+/// @brief combines a collection of partial results
+///
+/// Partial results are combined pairwise in a tree; each level of the tree is
+/// processed in parallel when it combines at least kMinParallelCombine pairs.
+///
+/// @tparam S the type of the partial results
+/// @tparam ReduceF the type of the reduce function object
+///
+/// @param partials the partial results, overwritten by the function
+/// @param n the number of partial results (at least one)
+/// @param reduce_kernel the associative operation combining two results
+///
+/// @return the combination of all the partial results
+template <typename S, typename ReduceF>
+S local_reduce(S* partials, size_t n, ReduceF reduce_kernel) {
+  for (size_t stride = 1; stride < n; stride *= 2) {
+    size_t num_pairs = (n - stride + 2 * stride - 1) / (2 * stride);
+    if (num_pairs < kMinParallelCombine) {
+      for (size_t i = 0; i + stride < n; i += 2 * stride)
+        partials[i] = reduce_kernel(partials[i], partials[i + stride]);
+    } else {
+      auto map_args = std::make_tuple(partials, stride, reduce_kernel);
+      rt::forEachAt(
+          rt::thisLocality(),
+          [](const typeof(map_args)& map_args, size_t iter) {
+            auto partials = std::get<0>(map_args);
+            auto stride = std::get<1>(map_args);
+            auto reduce_kernel = std::get<2>(map_args);
+            auto i = 2 * stride * iter;
+            partials[i] = reduce_kernel(partials[i], partials[i + stride]);
+          },
+          map_args, num_pairs);
+    }
+  }
+  return partials[0];
+}
+
+// The reduction over the localities [lo, hi) that own portions of a range,
+// executed at locality lo.  Sub-trees [mid, hi), with halving mid, are
+// delegated to locality mid and processed concurrently with the local portion.
+template <typename ForwardIt, typename MapF, typename ReduceF, typename S,
+          typename... Args>
+struct map_reduce_tree {
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
+  using entry_t = typename optional_vector<S>::entry_t;
+  using args_t = std::tuple<uint32_t, uint32_t, MapF, ReduceF, ForwardIt,
+                            ForwardIt, Args...>;
+
+  static void subtree(rt::Handle&, const args_t& args, entry_t* res) {
+    uint32_t lo = std::get<0>(args), end = std::get<1>(args);
+    // one child for each bit of the locality identifiers, at most
+    std::vector<entry_t> children;
+    children.reserve(32);
+    rt::Handle h;
+    while (end - lo > 1) {
+      uint32_t mid = lo + (end - lo) / 2;
+      auto child_args = args;
+      std::get<0>(child_args) = mid;
+      std::get<1>(child_args) = end;
+      children.push_back(entry_t{S{}, false});
+      rt::asyncExecuteAtWithRet(h, rt::Locality(mid), subtree, child_args,
+                                &children.back());
+      end = mid;
+    }
+
+    res->valid = false;
+    auto lrange = itr_traits::local_range(std::get<4>(args), std::get<5>(args));
+    if (lrange.begin() != lrange.end()) {
+      res->value = local_map_reduce(args, lrange.begin(), lrange.end());
+      res->valid = true;
+    }
+
+    // children were spawned from the last localities backwards
+    rt::waitForCompletion(h);
+    auto reduce_kernel = std::get<3>(args);
+    for (auto child = children.rbegin(); child != children.rend(); ++child) {
+      if (!child->valid) continue;
+      res->value =
+          res->valid ? reduce_kernel(res->value, child->value) : child->value;
+      res->valid = true;
+    }
+  }
+
+  static void root(const args_t& args, entry_t* res) {
+    rt::Handle h;
+    subtree(h, args, res);
+  }
+
+  static S local_map_reduce(const args_t& args, local_iterator_t first,
+                            local_iterator_t last) {
+    auto parts = local_iterator_traits<local_iterator_t>::partitions(
+        first, last, rt::impl::getConcurrency());
+    std::vector<S> partials(parts.size());
+    auto map_args = std::make_tuple(parts.data(), partials.data(), &args);
+    shad::rt::forEachAt(
+        rt::thisLocality(),
+        [](const typeof(map_args)& map_args, size_t iter) {
+          auto part = std::get<0>(map_args) + iter;
+          auto& args = *std::get<2>(map_args);
+          auto map_kernel = std::get<2>(args);
+          std::get<1>(map_args)[iter] = apply_from<6>(
+              [&](const Args&... args_) {
+                return map_kernel(std::get<4>(args), std::get<5>(args),
+                                  part->begin(), part->end(), args_...);
+              },
+              args);
+        },
+        map_args, parts.size());
+    return local_reduce(partials.data(), partials.size(), std::get<3>(args));
+  }
+};
+
+/// @brief applies the map-reduce pattern over a distributed range
+///
+/// Each locality that owns a portion of the range applies an operation in
+/// parallel to the partitions of its portion, one for each task, and combines
+/// the partial results with local_reduce.  The results of the localities are
+/// combined along a binomial tree rooted at the first locality; every
+/// locality combines the results of at most log(#localities) sub-trees.
+///
+/// @tparam ForwardIt the type of the iterators in the input range
+/// @tparam MapF the type of the operation function object
+/// @tparam ReduceF the type of the reduce function object
+/// @tparam S the type of the solution
+/// @tparam Args the type of operation's arguments
+///
+/// @param[in] first,last the input range
+/// @param map_kernel the operation applied to each non-empty partition [b, e)
+/// of a local portion, as map_kernel(first, last, b, e, args...)
+/// @param reduce_kernel the associative operation combining two solutions
+/// @param init the solution for empty ranges
+/// @param args operation's arguments
+///
+/// @return the combination of the mapped values, in the order of the range
+template <typename ForwardIt, typename MapF, typename ReduceF, typename S,
+          typename... Args>
+S distributed_map_reduce(ForwardIt first, ForwardIt last, MapF&& map_kernel,
+                         ReduceF&& reduce_kernel, const S& init,
+                         Args&&... args) {
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  using tree_t = map_reduce_tree<ForwardIt, std::decay_t<MapF>,
+                                 std::decay_t<ReduceF>, S,
+                                 std::decay_t<Args>...>;
+  if (first == last) return init;
+
+  auto localities = itr_traits::localities(first, last);
+  typename tree_t::entry_t res{init, false};
+  rt::executeAtWithRet(
+      localities.begin(), tree_t::root,
+      typename tree_t::args_t(static_cast<uint32_t>(localities.begin()),
+                              static_cast<uint32_t>(localities.end()),
+                              map_kernel, reduce_kernel, first, last, args...),
+      &res);
+  return res.valid ? res.value : init;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// distributed_find_first searches a distributed range for the first element
+// satisfying a condition.  Localities search their portions concurrently and
+// stop as soon as a match is known at an earlier position of the range.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// number of chunks searched by each task, between two cancellation checks
+constexpr size_t kSearchChunksPerTask = 64;
+
+// The search of the portion of a range owned by a locality.  Tasks claim
+// chunks in the order of the range; a locality stops claiming chunks past
+// its first match, or when an earlier locality reports a match to the root.
+template <typename ForwardIt, typename SearchF, typename... Args>
+struct find_first_search {
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
+  // the first locality with a match, stored at the root
+  using bound_t = std::atomic<uint32_t>;
+  using args_t = std::tuple<rt::Locality, bound_t*, SearchF, ForwardIt,
+                            ForwardIt, Args...>;
+  static_assert(sizeof(bound_t) == sizeof(uint32_t),
+                "the search bound must be readable with rt::dma");
+
+  struct state_t {
+    explicit state_t(size_t num_chunks) : next(0), found(num_chunks) {}
+    std::atomic<size_t> next;
+    std::atomic<size_t> found;
+    std::atomic<bool> reported{false};
+  };
+
+  static uint32_t bound(const args_t& args) {
+    if (std::get<0>(args) == rt::thisLocality())
+      return std::get<1>(args)->load();
+    uint32_t res;
+    rt::dma(&res, std::get<0>(args),
+            reinterpret_cast<const uint32_t*>(std::get<1>(args)), 1);
+    return res;
+  }
+
+  static void report(const args_t& args, uint32_t locality) {
+    rt::executeAt(
+        std::get<0>(args),
+        [](const std::pair<bound_t*, uint32_t>& args) {
+          auto current = args.first->load();
+          while (args.second < current &&
+                 !args.first->compare_exchange_weak(current, args.second)) {
+          }
+        },
+        std::make_pair(std::get<1>(args), locality));
+  }
+
+  static void search(rt::Handle&, const args_t& args, ForwardIt* res) {
+    auto first = std::get<3>(args), last = std::get<4>(args);
+    auto lrange = itr_traits::local_range(first, last);
+    *res = last;
+    if (lrange.begin() == lrange.end()) return;
+
+    auto concurrency = rt::impl::getConcurrency();
+    auto parts = local_iterator_traits<local_iterator_t>::partitions(
+        lrange.begin(), lrange.end(), concurrency * kSearchChunksPerTask);
+    std::vector<local_iterator_t> matches;
+    matches.reserve(parts.size());
+    for (auto& part : parts) matches.push_back(part.end());
+    state_t state(parts.size());
+
+    auto map_args =
+        std::make_tuple(parts.data(), matches.data(), &state, &args,
+                        static_cast<uint32_t>(rt::thisLocality()));
+    rt::forEachAt(
+        rt::thisLocality(),
+        [](const typeof(map_args)& map_args, size_t) {
+          auto parts = std::get<0>(map_args);
+          auto matches = std::get<1>(map_args);
+          auto& state = *std::get<2>(map_args);
+          auto& args = *std::get<3>(map_args);
+          auto locality = std::get<4>(map_args);
+          auto search_kernel = std::get<2>(args);
+          while (bound(args) >= locality) {
+            auto chunk = state.next++;
+            if (chunk >= state.found) return;
+            auto part = parts + chunk;
+            auto match = apply_from<5>(
+                [&](const Args&... args_) {
+                  return search_kernel(part->begin(), part->end(), args_...);
+                },
+                args);
+            if (match == part->end()) continue;
+            matches[chunk] = match;
+            auto found = state.found.load();
+            while (chunk < found &&
+                   !state.found.compare_exchange_weak(found, chunk)) {
+            }
+            if (!state.reported.exchange(true)) report(args, locality);
+            return;
+          }
+        },
+        map_args, std::min(concurrency, parts.size()));
+
+    if (state.found < parts.size())
+      *res = itr_traits::iterator_from_local(first, last,
+                                             matches[state.found]);
+  }
+};
+
+/// @brief searches a distributed range for the first matching element
+///
+/// Each locality that owns a portion of the range searches it in parallel,
+/// in chunks.  Between two chunks, the tasks of a locality check whether a
+/// match has been found at an earlier position, either locally or by an
+/// earlier locality, and stop in that case.  Localities report their matches
+/// to the calling locality, that acts as the shared cancellation flag.
+///
+/// @tparam ForwardIt the type of the iterators in the input range
+/// @tparam SearchF the type of the search function object
+/// @tparam Args the type of search's arguments
+///
+/// @param[in] first,last the input range
+/// @param search_kernel the search of a non-empty chunk [b, e) of a local
+/// portion, as search_kernel(b, e, args...), returning the position of the
+/// first match in [b, e) or e
+/// @param args search's arguments
+///
+/// @return the iterator to the first match, last if there is none
+template <typename ForwardIt, typename SearchF, typename... Args>
+ForwardIt distributed_find_first(ForwardIt first, ForwardIt last,
+                                 SearchF&& search_kernel, Args&&... args) {
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  using search_t = find_first_search<ForwardIt, std::decay_t<SearchF>,
+                                     std::decay_t<Args>...>;
+  if (first == last) return last;
+
+  auto localities = itr_traits::localities(first, last);
+  typename search_t::bound_t bound(static_cast<uint32_t>(localities.end()));
+  std::vector<ForwardIt> res(localities.size(), last);
+  rt::Handle h;
+  size_t i = 0;
+  for (auto locality = localities.begin(), end = localities.end();
+       locality != end; ++locality, ++i) {
+    rt::asyncExecuteAtWithRet(
+        h, locality, search_t::search,
+        typename search_t::args_t(rt::thisLocality(), &bound, search_kernel,
+                                  first, last, args...),
+        &res[i]);
+  }
+  rt::waitForCompletion(h);
+
+  for (auto& match : res)
+    if (match != last) return match;
+  return last;
+}
+
+// number of tasks used by each locality to process its portion of a range
+inline size_t num_tasks(const distributed_sequential_tag&) { return 1; }
+
+inline size_t num_tasks(const distributed_parallel_tag&) {
+  return rt::impl::getConcurrency();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// write_to_range copies a buffer of the calling locality into a distributed
+// range, issuing one bulk transfer for each portion of the destination range
+// that is owned by a different locality.
+//
+// The destination must be a random-access range whose portions, as returned
+// by the distribution of its iterators, are contiguous in memory.
+//
+////////////////////////////////////////////////////////////////////////////////
+template <typename RandomIt>
+void write_to_range(const typename RandomIt::value_type* src, size_t n,
+                    RandomIt d_first) {
+  using T = typename RandomIt::value_type;
+  using itr_traits = distributed_random_access_iterator_trait<RandomIt>;
+  if (n == 0) return;
+
+  auto d_last = std::next(d_first, n);
+  rt::Handle h;
+  for (auto& piece : itr_traits::distribution(d_first, d_last)) {
+    auto p_last = std::next(d_first, piece.second);
+    if (piece.first == rt::thisLocality()) {
+      auto lrange = itr_traits::local_range(d_first, p_last);
+      std::copy(src, src + piece.second, lrange.begin());
+    } else {
+      T* dst = nullptr;
+      rt::executeAtWithRet(
+          piece.first,
+          [](const std::pair<RandomIt, RandomIt>& range, T** res) {
+            *res = &*itr_traits::local_range(range.first, range.second)
+                         .begin();
+          },
+          std::make_pair(d_first, p_last), &dst);
+      rt::asyncDma(h, piece.first, dst, src, piece.second);
+    }
+    src += piece.second;
+    d_first = p_last;
+  }
+  rt::waitForCompletion(h);
+}
+
+// read_from_range variant of write_to_range: it copies n elements of a
+// distributed range into a buffer of the calling locality
+template <typename RandomIt>
+void read_from_range(RandomIt first, size_t n,
+                     typename RandomIt::value_type* dst) {
+  using T = typename RandomIt::value_type;
+  using itr_traits = distributed_random_access_iterator_trait<RandomIt>;
+  if (n == 0) return;
+
+  auto last = std::next(first, n);
+  rt::Handle h;
+  for (auto& piece : itr_traits::distribution(first, last)) {
+    auto p_last = std::next(first, piece.second);
+    if (piece.first == rt::thisLocality()) {
+      auto lrange = itr_traits::local_range(first, p_last);
+      std::copy(lrange.begin(), lrange.end(), dst);
+    } else {
+      const T* src = nullptr;
+      rt::executeAtWithRet(
+          piece.first,
+          [](const std::pair<RandomIt, RandomIt>& range, const T** res) {
+            *res = &*itr_traits::local_range(range.first, range.second)
+                         .begin();
+          },
+          std::make_pair(first, p_last), &src);
+      rt::asyncDma(h, dst, piece.first, src, piece.second);
+    }
+    dst += piece.second;
+    first = p_last;
+  }
+  rt::waitForCompletion(h);
+}
+
 }  // namespace impl
 }  // namespace shad
 
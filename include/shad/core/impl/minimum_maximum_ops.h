@@ -41,6 +41,36 @@
 namespace shad {
 namespace impl {
 
+// Reduce operations of the parallel searches, on (iterator, value) pairs.
+// As in the standard library, they keep the first smallest and the first
+// largest element, or the last largest one for minmax_element.
+template <typename Sol, typename Compare>
+struct min_element_reduce {
+  Sol operator()(const Sol& x, const Sol& y) const {
+    return comp(y.second, x.second) ? y : x;
+  }
+  Compare comp;
+};
+
+template <typename Sol, typename Compare>
+struct max_element_reduce {
+  Sol operator()(const Sol& x, const Sol& y) const {
+    return comp(x.second, y.second) ? y : x;
+  }
+  Compare comp;
+};
+
+template <typename Sol, typename Compare>
+struct minmax_element_reduce {
+  Sol operator()(const Sol& x, const Sol& y) const {
+    return Sol{comp(y.min_val, x.min_val) ? y.min : x.min,
+               comp(y.max_val, x.max_val) ? x.max : y.max,
+               comp(y.min_val, x.min_val) ? y.min_val : x.min_val,
+               comp(y.max_val, x.max_val) ? x.max_val : y.max_val};
+  }
+  Compare comp;
+};
+
 template <class ForwardIt, class Compare>
 ForwardIt max_element(distributed_sequential_tag&& policy, ForwardIt first,
                       ForwardIt last, Compare comp) {
@@ -84,54 +114,32 @@ template <class ForwardIt, class Compare>
 ForwardIt max_element(distributed_parallel_tag&& policy, ForwardIt first,
                       ForwardIt last, Compare comp) {
   using itr_traits = distributed_iterator_traits<ForwardIt>;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
   using value_t = typename itr_traits::value_type;
+  using sol_t = std::pair<ForwardIt, value_t>;
   static_assert(std::is_default_constructible<value_t>::value,
                 "max_element requires DefaultConstructible value type");
 
   if (first == last) return last;
 
-  // distributed map
-  auto map_res = distributed_map(
+  // distributed map-reduce
+  auto res = distributed_map_reduce(
       // range
       first, last,
       // kernel
-      [](ForwardIt first, ForwardIt last, Compare comp) {
-        using local_iterator_t = typename itr_traits::local_iterator_type;
-
-        // local map
-        auto lrange = itr_traits::local_range(first, last);
-        auto map_res = local_map(
-            // range
-            lrange.begin(), lrange.end(),
-            // kernel
-            [&](local_iterator_t b, local_iterator_t e) {
-              return std::max_element(b, e, comp);
-            });
-
-        // local reduce
-        auto nil_val = itr_traits::local_range(first, last).end();
-        auto lmax_it = std::max_element(
-            map_res.begin(), map_res.end(),
-            [&](const local_iterator_t& x, const local_iterator_t& y) {
-              return y != nil_val && comp(*x, *y);
-            });
-
-        // local solution
-        auto lmax = lmax_it != map_res.end() ? *lmax_it : nil_val;
-        ForwardIt gres = itr_traits::iterator_from_local(first, last, lmax);
-        return std::make_pair(gres, lmax != nil_val ? *lmax : value_t{});
+      [](ForwardIt first, ForwardIt last, local_iterator_t b,
+         local_iterator_t e, Compare comp) {
+        auto res = std::max_element(b, e, comp);
+        return sol_t{itr_traits::iterator_from_local(first, last, res), *res};
       },
+      // reduce
+      max_element_reduce<sol_t, Compare>{comp},
+      // empty range
+      sol_t{last, value_t{}},
       // map arguments
       comp);
 
-  // reduce
-  using map_res_t = typeof(map_res);
-  using res_t = typename map_res_t::value_type;
-  auto res_it = std::max_element(
-      map_res.begin(), map_res.end(), [&](const res_t& x, const res_t& y) {
-        return y.first != last && comp(x.second, y.second);
-      });
-  return res_it->first;
+  return res.first;
 }
 
 template <class ForwardIt, class Compare>
@@ -177,54 +185,32 @@ template <class ForwardIt, class Compare>
 ForwardIt min_element(distributed_parallel_tag&& policy, ForwardIt first,
                       ForwardIt last, Compare comp) {
   using itr_traits = distributed_iterator_traits<ForwardIt>;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
   using value_t = typename itr_traits::value_type;
+  using sol_t = std::pair<ForwardIt, value_t>;
   static_assert(std::is_default_constructible<value_t>::value,
                 "min_element requires DefaultConstructible value type");
 
   if (first == last) return last;
 
-  // distributed map
-  auto map_res = distributed_map(
+  // distributed map-reduce
+  auto res = distributed_map_reduce(
       // range
       first, last,
       // kernel
-      [](ForwardIt first, ForwardIt last, Compare comp) {
-        using local_iterator_t = typename itr_traits::local_iterator_type;
-
-        // local map
-        auto lrange = itr_traits::local_range(first, last);
-        auto map_res = local_map(
-            // range
-            lrange.begin(), lrange.end(),
-            // kernel
-            [&](local_iterator_t b, local_iterator_t e) {
-              return std::min_element(b, e, comp);
-            });
-
-        // local reduce
-        auto nil_val = itr_traits::local_range(first, last).end();
-        auto lmin_it =
-            std::min_element(map_res.begin(), map_res.end(),
-                             [&](local_iterator_t x, local_iterator_t y) {
-                               return x != nil_val && comp(*x, *y);
-                             });
-
-        // local solution
-        auto lmin = lmin_it != map_res.end() ? *lmin_it : nil_val;
-        ForwardIt gres = itr_traits::iterator_from_local(first, last, lmin);
-        return std::make_pair(gres, lmin != nil_val ? *lmin : value_t{});
+      [](ForwardIt first, ForwardIt last, local_iterator_t b,
+         local_iterator_t e, Compare comp) {
+        auto res = std::min_element(b, e, comp);
+        return sol_t{itr_traits::iterator_from_local(first, last, res), *res};
       },
+      // reduce
+      min_element_reduce<sol_t, Compare>{comp},
+      // empty range
+      sol_t{last, value_t{}},
       // map arguments
       comp);
 
-  // reduce
-  using map_res_t = typeof(map_res);
-  using res_t = typename map_res_t::value_type;
-  auto res_it = std::min_element(
-      map_res.begin(), map_res.end(), [&](const res_t& x, const res_t& y) {
-        return x.first != last && comp(x.second, y.second);
-      });
-  return res_it->first;
+  return res.first;
 }
 
 template <class ForwardIt, class Compare>
@@ -288,8 +274,8 @@ template <class ForwardIt, class Compare>
 std::pair<ForwardIt, ForwardIt> minmax_element(
     distributed_parallel_tag&& policy, ForwardIt first, ForwardIt last,
     Compare comp) {
-  if (first == last) return std::make_pair(last, last);
   using itr_traits = distributed_iterator_traits<ForwardIt>;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
   using value_t = typename itr_traits::value_type;
   static_assert(std::is_default_constructible<value_t>::value,
                 "minmax_element requires DefaultConstructible value type");
@@ -301,60 +287,26 @@ std::pair<ForwardIt, ForwardIt> minmax_element(
 
   if (first == last) return std::make_pair(last, last);
 
-  // distributed map
-  auto map_res = distributed_map(
+  // distributed map-reduce
+  auto res = distributed_map_reduce(
       // range
       first, last,
       // kernel
-      [](ForwardIt first, ForwardIt last, Compare comp) {
-        using local_iterator_t = typename itr_traits::local_iterator_type;
-
-        // local map
-        auto lrange = itr_traits::local_range(first, last);
-        auto map_res = local_map(
-            // range
-            lrange.begin(), lrange.end(),
-            // kernel
-            [&](local_iterator_t b, local_iterator_t e) {
-              return std::minmax_element(b, e, comp);
-            });
-
-        // reduce
-        auto nil_val = itr_traits::local_range(first, last).end();
-        auto lmin_it = std::min_element(
-            map_res.begin(), map_res.end(),
-            [&](const std::pair<local_iterator_t, local_iterator_t>& x,
-                const std::pair<local_iterator_t, local_iterator_t>& y) {
-              return x.first != nil_val && comp(*x.first, *y.first);
-            });
-        auto lmax_it = std::max_element(
-            map_res.begin(), map_res.end(),
-            [&](const std::pair<local_iterator_t, local_iterator_t>& x,
-                const std::pair<local_iterator_t, local_iterator_t>& y) {
-              return y.second != nil_val && comp(*x.second, *y.second);
-            });
-
-        // local solution
-        auto lmin = lmin_it != map_res.end() ? lmin_it->first : nil_val;
-        auto lmax = lmax_it != map_res.end() ? lmax_it->second : nil_val;
-        return sol_t{itr_traits::iterator_from_local(first, last, lmin),
-                     itr_traits::iterator_from_local(first, last, lmax),
-                     lmin != nil_val ? *lmin : value_t{},
-                     lmax != nil_val ? *lmax : value_t{}};
+      [](ForwardIt first, ForwardIt last, local_iterator_t b,
+         local_iterator_t e, Compare comp) {
+        auto res = std::minmax_element(b, e, comp);
+        return sol_t{itr_traits::iterator_from_local(first, last, res.first),
+                     itr_traits::iterator_from_local(first, last, res.second),
+                     *res.first, *res.second};
       },
+      // reduce
+      minmax_element_reduce<sol_t, Compare>{comp},
+      // empty range
+      sol_t{last, last, value_t{}, value_t{}},
       // map arguments
       comp);
 
-  // reduce
-  auto res_min = std::min_element(
-      map_res.begin(), map_res.end(), [&](const sol_t& x, const sol_t& y) {
-        return x.min != last && comp(x.min_val, y.min_val);
-      });
-  auto res_max = std::max_element(
-      map_res.begin(), map_res.end(), [&](const sol_t& x, const sol_t& y) {
-        return y.max != last && comp(x.max_val, y.max_val);
-      });
-  return std::make_pair(res_min->min, res_max->max);
+  return std::make_pair(res.min, res.max);
 }
 
 }  // namespace impl
@@ -69,35 +69,18 @@ template <typename ForwardItr, typename UnaryPredicate>
 bool all_of(distributed_parallel_tag&& policy, ForwardItr first,
             ForwardItr last, UnaryPredicate p) {
   using itr_traits = distributed_iterator_traits<ForwardItr>;
-  using value_t = typename itr_traits::value_type;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
 
-  // distributed map
-  auto map_res = distributed_map(
+  // distributed search
+  return distributed_find_first(
       // range
       first, last,
       // kernel
-      [](ForwardItr first, ForwardItr last, UnaryPredicate p) -> uint8_t {
-        using local_iterator_t = typename itr_traits::local_iterator_type;
-
-        // local map
-        auto lrange = itr_traits::local_range(first, last);
-
-        auto map_res = local_map(
-            // range
-            lrange.begin(), lrange.end(),
-            // kernel
-            [&](const local_iterator_t& b, const local_iterator_t& e)
-                -> uint8_t { return std::all_of(b, e, p); });
-
-        // local reduce
-        return std::all_of(map_res.begin(), map_res.end(),
-                           [](bool x) { return x; });
+      [](local_iterator_t b, local_iterator_t e, UnaryPredicate p) {
+        return std::find_if_not(b, e, p);
       },
-      // map arguments
-      p);
-
-  // reduce
-  return std::all_of(map_res.begin(), map_res.end(), [](bool x) { return x; });
+      // search arguments
+      p) == last;
 }
 
 template <typename ForwardItr, typename UnaryPredicate>
@@ -129,36 +112,18 @@ template <typename ForwardItr, typename UnaryPredicate>
 bool any_of(distributed_parallel_tag&& policy, ForwardItr first,
             ForwardItr last, UnaryPredicate p) {
   using itr_traits = distributed_iterator_traits<ForwardItr>;
-  using value_t = typename itr_traits::value_type;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
 
-  // distributed map
-  auto map_res = distributed_map(
+  // distributed search
+  return distributed_find_first(
       // range
       first, last,
       // kernel
-      [](ForwardItr first, ForwardItr last, UnaryPredicate p) -> uint8_t {
-        using local_iterator_t = typename itr_traits::local_iterator_type;
-
-        // local map
-        auto lrange = itr_traits::local_range(first, last);
-
-        auto map_res = local_map(
-            // range
-            lrange.begin(), lrange.end(),
-            // kernel
-            [&](local_iterator_t b, local_iterator_t e) -> uint8_t {
-              return std::any_of(b, e, p);
-            });
-
-        // local reduce
-        return std::any_of(map_res.begin(), map_res.end(),
-                           [](bool x) { return x; });
+      [](local_iterator_t b, local_iterator_t e, UnaryPredicate p) {
+        return std::find_if(b, e, p);
       },
-      // map arguments
-      p);
-
-  // reduce
-  return std::any_of(map_res.begin(), map_res.end(), [](bool x) { return x; });
+      // search arguments
+      p) != last;
 }
 
 template <typename ForwardItr, typename T>
@@ -192,43 +157,18 @@ template <typename ForwardItr, typename T>
 ForwardItr find(distributed_parallel_tag&& policy, ForwardItr first,
                 ForwardItr last, const T& value) {
   using itr_traits = distributed_iterator_traits<ForwardItr>;
-  using value_t = typename itr_traits::value_type;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
 
-  // distributed map
-  auto map_res = distributed_map(
+  // distributed search
+  return distributed_find_first(
       // range
       first, last,
       // kernel
-      [](ForwardItr first, ForwardItr last, const T& value) {
-        using local_iterator_t = typename itr_traits::local_iterator_type;
-
-        // local map
-        auto lrange = itr_traits::local_range(first, last);
-
-        auto map_res = local_map(
-            // range
-            lrange.begin(), lrange.end(),
-            // kernel
-            [&](local_iterator_t b, local_iterator_t e) {
-              auto res = std::find(b, e, value);
-              return res != e ? res : lrange.end();
-            });
-
-        // local reduce
-        auto found = std::find_if(
-            map_res.begin(), map_res.end(),
-            [&](const local_iterator_t& i) { return i != lrange.end(); });
-        return found != map_res.end()
-                   ? itr_traits::iterator_from_local(first, last, *found)
-                   : last;
+      [](local_iterator_t b, local_iterator_t e, const T& value) {
+        return std::find(b, e, value);
       },
-      // map arguments
+      // search arguments
       value);
-
-  // reduce
-  auto found = std::find_if(map_res.begin(), map_res.end(),
-                            [&](ForwardItr i) { return i != last; });
-  return found != map_res.end() ? *found : last;
 }
 
 template <typename ForwardItr, typename UnaryPredicate>
@@ -262,43 +202,18 @@ template <typename ForwardItr, typename UnaryPredicate>
 ForwardItr find_if(distributed_parallel_tag&& policy, ForwardItr first,
                    ForwardItr last, UnaryPredicate p) {
   using itr_traits = distributed_iterator_traits<ForwardItr>;
-  using value_t = typename itr_traits::value_type;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
 
-  // distributed map
-  auto map_res = distributed_map(
+  // distributed search
+  return distributed_find_first(
       // range
       first, last,
       // kernel
-      [](ForwardItr first, ForwardItr last, UnaryPredicate p) {
-        using local_iterator_t = typename itr_traits::local_iterator_type;
-
-        // local map
-        auto lrange = itr_traits::local_range(first, last);
-
-        auto map_res = local_map(
-            // range
-            lrange.begin(), lrange.end(),
-            // kernel
-            [&](local_iterator_t b, local_iterator_t e) {
-              auto res = std::find_if(b, e, p);
-              return res != e ? res : lrange.end();
-            });
-
-        // local reduce
-        auto found = std::find_if(
-            map_res.begin(), map_res.end(),
-            [&](const local_iterator_t& i) { return i != lrange.end(); });
-        return found != map_res.end()
-                   ? itr_traits::iterator_from_local(first, last, *found)
-                   : last;
+      [](local_iterator_t b, local_iterator_t e, UnaryPredicate p) {
+        return std::find_if(b, e, p);
       },
-      // map arguments
+      // search arguments
       p);
-
-  // reduce
-  auto found = std::find_if(map_res.begin(), map_res.end(),
-                            [&](ForwardItr i) { return i != last; });
-  return found != map_res.end() ? *found : last;
 }
 
 template <typename ForwardItr, typename UnaryPredicate>
@@ -332,43 +247,18 @@ template <typename ForwardItr, typename UnaryPredicate>
 ForwardItr find_if_not(distributed_parallel_tag&& policy, ForwardItr first,
                        ForwardItr last, UnaryPredicate p) {
   using itr_traits = distributed_iterator_traits<ForwardItr>;
-  using value_t = typename itr_traits::value_type;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
 
-  // distributed map
-  auto map_res = distributed_map(
+  // distributed search
+  return distributed_find_first(
       // range
       first, last,
       // kernel
-      [](ForwardItr first, ForwardItr last, UnaryPredicate p) {
-        using local_iterator_t = typename itr_traits::local_iterator_type;
-
-        // local map
-        auto lrange = itr_traits::local_range(first, last);
-
-        auto map_res = local_map(
-            // range
-            lrange.begin(), lrange.end(),
-            // kernel
-            [&](local_iterator_t b, local_iterator_t e) {
-              auto res = std::find_if_not(b, e, p);
-              return res != e ? res : lrange.end();
-            });
-
-        // local reduce
-        auto found = std::find_if(
-            map_res.begin(), map_res.end(),
-            [&](const local_iterator_t& i) { return i != lrange.end(); });
-        return found != map_res.end()
-                   ? itr_traits::iterator_from_local(first, last, *found)
-                   : last;
+      [](local_iterator_t b, local_iterator_t e, UnaryPredicate p) {
+        return std::find_if_not(b, e, p);
       },
-      // map arguments
+      // search arguments
       p);
-
-  // reduce
-  auto found = std::find_if(map_res.begin(), map_res.end(),
-                            [&](ForwardItr i) { return i != last; });
-  return found != map_res.end() ? *found : last;
 }
 
 template <typename ForwardItr, typename UnaryPredicate>
@@ -447,40 +337,23 @@ typename shad::distributed_iterator_traits<InputItr>::difference_type count(
     distributed_parallel_tag&& policy, InputItr first, InputItr last,
     const T& value) {
   using itr_traits = distributed_iterator_traits<InputItr>;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
   using res_t =
       typename shad::distributed_iterator_traits<InputItr>::difference_type;
 
-  // distributed map
-  auto map_res = distributed_map(
+  // distributed map-reduce
+  return distributed_map_reduce(
       // range
       first, last,
       // kernel
-      [](InputItr first, InputItr last, const T& value) {
-        using local_iterator_t = typename itr_traits::local_iterator_type;
-
-        // local map
-        auto lrange = itr_traits::local_range(first, last);
-
-        auto map_res = local_map(
-            // range
-            lrange.begin(), lrange.end(),
-            // kernel
-            [&](local_iterator_t b, local_iterator_t e) {
-              return std::count(b, e, value);
-            });
-
-        // local reduce
-        return std::accumulate(
-            map_res.begin(), map_res.end(), res_t{0},
-            [](const res_t& acc, const res_t& x) { return acc + x; });
-      },
+      [](InputItr, InputItr, local_iterator_t b, local_iterator_t e,
+         const T& value) -> res_t { return std::count(b, e, value); },
+      // reduce
+      [](const res_t& x, const res_t& y) { return x + y; },
+      // empty range
+      res_t{0},
       // map arguments
       value);
-
-  // reduce
-  return std::accumulate(
-      map_res.begin(), map_res.end(), res_t{0},
-      [](const res_t& acc, const res_t& x) { return acc + x; });
 }
 
 template <typename InputItr, typename UnaryPredicate>
@@ -513,40 +386,23 @@ typename shad::distributed_iterator_traits<InputItr>::difference_type count_if(
     distributed_parallel_tag&& policy, InputItr first, InputItr last,
     UnaryPredicate p) {
   using itr_traits = distributed_iterator_traits<InputItr>;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
   using res_t =
       typename shad::distributed_iterator_traits<InputItr>::difference_type;
 
-  // distributed map
-  auto map_res = distributed_map(
+  // distributed map-reduce
+  return distributed_map_reduce(
       // range
       first, last,
       // kernel
-      [](InputItr first, InputItr last, UnaryPredicate p) {
-        using local_iterator_t = typename itr_traits::local_iterator_type;
-
-        // local map
-        auto lrange = itr_traits::local_range(first, last);
-
-        auto map_res = local_map(
-            // range
-            lrange.begin(), lrange.end(),
-            // kernel
-            [&](local_iterator_t b, local_iterator_t e) {
-              return std::count_if(b, e, p);
-            });
-
-        // local reduce
-        return std::accumulate(
-            map_res.begin(), map_res.end(), res_t{0},
-            [](const res_t& acc, const res_t& x) { return acc + x; });
-      },
+      [](InputItr, InputItr, local_iterator_t b, local_iterator_t e,
+         UnaryPredicate p) -> res_t { return std::count_if(b, e, p); },
+      // reduce
+      [](const res_t& x, const res_t& y) { return x + y; },
+      // empty range
+      res_t{0},
       // map arguments
       p);
-
-  // reduce
-  return std::accumulate(
-      map_res.begin(), map_res.end(), res_t{0},
-      [](const res_t& acc, const res_t& x) { return acc + x; });
 }
 
 }  // namespace impl
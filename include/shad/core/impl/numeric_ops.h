@@ -26,6 +26,8 @@
 #define INCLUDE_SHAD_CORE_IMPL_NUMERIC_OPS_H
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <numeric>
@@ -299,46 +301,258 @@ template <class InputIt, class T, class BinaryOperation>
 T reduce(distributed_parallel_tag&& policy, InputIt first, InputIt last, T init,
          BinaryOperation op) {
   using itr_traits = distributed_iterator_traits<InputIt>;
-  static_assert(std::is_default_constructible<T>::value,
-                "reduce requires DefaultConstructible value type");
+  using local_iterator_t = typename itr_traits::local_iterator_type;
+  if (first == last) return init;
 
-  // distributed map
-  auto map_res = distributed_map(
+  // distributed map-reduce
+  auto res = distributed_map_reduce(
       // range
       first, last,
       // kernel
-      [](InputIt first, InputIt last, BinaryOperation op) {
-        using local_iterator_t = typename itr_traits::local_iterator_type;
-
-        // local map
-        auto lrange = itr_traits::local_range(first, last);
-        auto map_res = local_map(
-            // range
-            lrange.begin(), lrange.end(),
-            // kernel
-            [&](local_iterator_t b, local_iterator_t e) {
-              auto res = *b;
-              while (++b != e) res = op(std::move(res), *b);
-              return res;
-            });
-
-        // local reduce
-        auto b = map_res.begin(), e = map_res.end();
-        T res;
-        if (b != e) {
-          res = *b++;
-          res = std::accumulate(b, e, std::move(res), op);
-        }
+      [](InputIt, InputIt, local_iterator_t b, local_iterator_t e,
+         BinaryOperation op) {
+        T res = *b;
+        while (++b != e) res = op(std::move(res), *b);
         return res;
       },
+      // reduce
+      op,
+      // empty range
+      init,
       // map arguments
       op);
 
-  // TODO parallel
-  // reduce
-  return std::accumulate(map_res.begin(), map_res.end(), init, op);
+  return op(std::move(init), std::move(res));
+}
+
+namespace scan_impl {
+
+// The parallel scans run in a single round across localities.  Each locality
+// reduces its portion in parallel, one part for each task, and publishes the
+// aggregate in a status table stored at the calling locality.  It then looks
+// back at the status of the preceding localities, combining their aggregates
+// until it finds one that has already published its inclusive prefix, and
+// publishes its own inclusive prefix.  Finally, each task scans its part,
+// starting from the combination of the locality prefix and the aggregates of
+// the preceding parts, and writes the result once, in blocks.
+
+// status of a locality in the look-back
+constexpr uint8_t kPending = 0;
+constexpr uint8_t kAggregate = 1;
+constexpr uint8_t kPrefix = 2;
+
+// number of elements buffered by a task between two writes to the output
+constexpr size_t kScanBlockSize = 1 << 12;
+
+struct identity {
+  template <typename U>
+  const U& operator()(const U& value) const {
+    return value;
+  }
+};
+
+template <typename T, typename BinaryOp>
+typename optional_vector<T>::entry_t combine(
+    const typename optional_vector<T>::entry_t& lhs,
+    const typename optional_vector<T>::entry_t& rhs, BinaryOp& op) {
+  if (!lhs.valid) return rhs;
+  if (!rhs.valid) return lhs;
+  return {op(lhs.value, rhs.value), true};
+}
+
+// The status table of the localities, read and written with rt::dma by
+// localities other than the root.
+template <typename T>
+struct lookback {
+  using entry_t = typename optional_vector<T>::entry_t;
+  using flag_t = std::atomic<uint8_t>;
+  static_assert(sizeof(flag_t) == sizeof(uint8_t),
+                "look-back flags must be accessible with rt::dma");
+
+  rt::Locality root;
+  flag_t* flags;
+  entry_t* aggregates;
+  entry_t* prefixes;
+
+  uint8_t flag(size_t i) const {
+    if (root == rt::thisLocality()) return flags[i].load();
+    uint8_t res;
+    rt::dma(&res, root, reinterpret_cast<const uint8_t*>(flags + i), 1);
+    return res;
+  }
+
+  entry_t value(uint8_t flag, size_t i) const {
+    auto src = (flag == kPrefix ? prefixes : aggregates) + i;
+    if (root == rt::thisLocality()) return *src;
+    entry_t res;
+    rt::dma(&res, root, src, 1);
+    return res;
+  }
+
+  // values are published before the flag that makes them visible
+  void publish(uint8_t flag, size_t i, const entry_t& value) const {
+    auto dst = (flag == kPrefix ? prefixes : aggregates) + i;
+    if (root == rt::thisLocality()) {
+      *dst = value;
+      flags[i].store(flag);
+      return;
+    }
+    rt::dma(root, dst, &value, 1);
+    rt::dma(root, reinterpret_cast<const uint8_t*>(flags + i), &flag, 1);
+  }
+
+  // the combination of init and the portions of localities [0, i)
+  template <typename BinaryOp>
+  entry_t exclusive_prefix(size_t i, const entry_t& init,
+                           BinaryOp& op) const {
+    entry_t res{init.value, false};
+    while (i-- > 0) {
+      uint8_t f;
+      while ((f = flag(i)) == kPending) rt::impl::yield();
+      res = combine<T>(value(f, i), res, op);
+      if (f == kPrefix) return res;
+    }
+    return combine<T>(init, res, op);
+  }
+};
+
+template <bool Inclusive, typename InputIt, typename OutputIt, typename T,
+          typename BinaryOp, typename UnaryOp>
+struct scan {
+  using itr_traits = distributed_iterator_traits<InputIt>;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
+  using out_t = typename OutputIt::value_type;
+  using entry_t = typename optional_vector<T>::entry_t;
+  using args_t = std::tuple<InputIt, InputIt, OutputIt, BinaryOp, UnaryOp,
+                            lookback<T>, entry_t, uint32_t>;
+
+  static void locality_scan(rt::Handle&, const args_t& args) {
+    auto first = std::get<0>(args), last = std::get<1>(args);
+    auto op = std::get<3>(args);
+    auto uop = std::get<4>(args);
+    auto& status = std::get<5>(args);
+    auto index = std::get<7>(args);
+    auto lrange = itr_traits::local_range(first, last);
+    auto parts = local_iterator_traits<local_iterator_t>::partitions(
+        lrange.begin(), lrange.end(), rt::impl::getConcurrency());
+
+    // reduce the parts
+    std::vector<entry_t> prefixes(parts.size() + 1, entry_t{T{}, false});
+    auto reduce_args = std::make_tuple(parts.data(), prefixes.data() + 1, op,
+                                       uop);
+    rt::forEachAt(
+        rt::thisLocality(),
+        [](const typeof(reduce_args)& reduce_args, size_t i) {
+          auto part = std::get<0>(reduce_args) + i;
+          auto op = std::get<2>(reduce_args);
+          auto uop = std::get<3>(reduce_args);
+          auto b = part->begin(), e = part->end();
+          T acc = uop(*b);
+          while (++b != e) acc = op(std::move(acc), uop(*b));
+          std::get<1>(reduce_args)[i] = entry_t{std::move(acc), true};
+        },
+        reduce_args, parts.size());
+    entry_t aggregate{T{}, false};
+    for (size_t i = 1; i < prefixes.size(); ++i)
+      aggregate = combine<T>(aggregate, prefixes[i], op);
+
+    // look back at the preceding localities
+    if (index > 0) status.publish(kAggregate, index, aggregate);
+    prefixes[0] = status.exclusive_prefix(index, std::get<6>(args), op);
+    status.publish(kPrefix, index, combine<T>(prefixes[0], aggregate, op));
+    if (parts.empty()) return;
+
+    // scan the parts
+    for (size_t i = 1; i < prefixes.size(); ++i)
+      prefixes[i] = combine<T>(prefixes[i - 1], prefixes[i], op);
+    auto d_first = std::next(
+        std::get<2>(args),
+        std::distance(first,
+                      itr_traits::iterator_from_local(first, last,
+                                                      lrange.begin())));
+    auto scan_args = std::make_tuple(parts.data(), prefixes.data(),
+                                     lrange.begin(), d_first, op, uop);
+    rt::forEachAt(
+        rt::thisLocality(),
+        [](const typeof(scan_args)& scan_args, size_t i) {
+          auto part = std::get<0>(scan_args) + i;
+          auto op = std::get<4>(scan_args);
+          auto uop = std::get<5>(scan_args);
+          auto d_first = std::next(
+              std::get<3>(scan_args),
+              std::distance(std::get<2>(scan_args), part->begin()));
+          auto acc = std::get<1>(scan_args)[i];
+          std::vector<out_t> buffer;
+          buffer.reserve(kScanBlockSize);
+          for (auto b = part->begin(), e = part->end(); b != e;) {
+            if (!acc.valid) {
+              // inclusive scan, first element, without initial value
+              acc = entry_t{uop(*b), true};
+              buffer.push_back(acc.value);
+              ++b;
+            }
+            for (; b != e && buffer.size() < kScanBlockSize; ++b) {
+              if (Inclusive) {
+                acc.value = op(std::move(acc.value), uop(*b));
+                buffer.push_back(acc.value);
+              } else {
+                buffer.push_back(acc.value);
+                acc.value = op(std::move(acc.value), uop(*b));
+              }
+            }
+            write_to_range(buffer.data(), buffer.size(), d_first);
+            std::advance(d_first, buffer.size());
+            buffer.clear();
+          }
+        },
+        scan_args, parts.size());
+  }
+};
+
+/// @brief applies the scan pattern over a distributed range
+///
+/// @tparam Inclusive true for inclusive scans, false for exclusive ones
+/// @tparam T the type of the accumulated values
+///
+/// @param[in] first,last the input range
+/// @param d_first the beginning of the output range
+/// @param op the associative operation combining two values
+/// @param uop the operation applied to each input element
+/// @param init the initial value, if valid
+///
+/// @return the end of the output range
+template <bool Inclusive, typename T, typename InputIt, typename OutputIt,
+          typename BinaryOp, typename UnaryOp>
+OutputIt distributed_scan(InputIt first, InputIt last, OutputIt d_first,
+                          BinaryOp op, UnaryOp uop,
+                          const typename optional_vector<T>::entry_t& init) {
+  using itr_traits = distributed_iterator_traits<InputIt>;
+  using scan_t = scan<Inclusive, InputIt, OutputIt, T, BinaryOp, UnaryOp>;
+  using entry_t = typename optional_vector<T>::entry_t;
+  if (first == last) return d_first;
+
+  auto localities = itr_traits::localities(first, last);
+  std::vector<typename lookback<T>::flag_t> flags(localities.size());
+  for (auto& flag : flags) flag.store(kPending);
+  std::vector<entry_t> aggregates(localities.size(), entry_t{T{}, false});
+  std::vector<entry_t> prefixes(localities.size(), entry_t{T{}, false});
+  lookback<T> status{rt::thisLocality(), flags.data(), aggregates.data(),
+                     prefixes.data()};
+
+  rt::Handle h;
+  uint32_t index = 0;
+  for (auto locality = localities.begin(), end = localities.end();
+       locality != end; ++locality, ++index) {
+    rt::asyncExecuteAt(h, locality, scan_t::locality_scan,
+                       typename scan_t::args_t(first, last, d_first, op, uop,
+                                               status, init, index));
+  }
+  rt::waitForCompletion(h);
+  return std::next(d_first, std::distance(first, last));
 }
 
+}  // namespace scan_impl
+
 template <class InputIt, class OutputIt, class BinaryOperation, class T>
 OutputIt exclusive_scan(distributed_sequential_tag&& policy, InputIt first,
                         InputIt last, OutputIt d_first, BinaryOperation op,
@@ -382,81 +596,9 @@ template <class InputIt, class OutputIt, class BinaryOperation, class T>
 OutputIt exclusive_scan(distributed_parallel_tag&& policy, InputIt first,
                         InputIt last, OutputIt d_first, BinaryOperation op,
                         T init) {
-  using itr_traits = distributed_iterator_traits<InputIt>;
-  auto localities = itr_traits::localities(first, last);
-  auto startingLoc = localities.begin();
-  uint32_t numLoc = localities.size();
-  std::vector<std::pair<OutputIt, T>> res(numLoc);
-  rt::Handle h;
-  size_t i = 0;
-  for (auto locality = startingLoc, end = localities.end(); locality != end;
-       ++locality, ++i) {
-    rt::asyncExecuteAtWithRet(
-        h, locality,
-        [](rt::Handle&,
-           const std::tuple<InputIt, InputIt, OutputIt, BinaryOperation>& args,
-           std::pair<OutputIt, T>* result) {
-          auto d_first = std::get<2>(args);
-          auto df = d_first;
-          auto gbegin = std::get<0>(args);
-          auto gend = std::get<1>(args);
-          auto local_range = itr_traits::local_range(gbegin, gend);
-          auto begin = local_range.begin();
-          auto end = local_range.end();
-          auto it = itr_traits::iterator_from_local(gbegin, gend, begin);
-          auto dist = std::distance(gbegin, it);
-          std::advance(d_first, dist);
-          if (begin == end) {
-            *result = std::make_pair(d_first, T{});
-            return;
-          }
-          BinaryOperation op = std::get<3>(args);
-          T acc = *begin;
-          *d_first = acc;
-          while (++begin != end) {
-            *++d_first = acc;
-            acc = op(std::move(acc), *begin);
-          }
-          *result = std::make_pair(++d_first, acc);
-        },
-        std::make_tuple(first, last, d_first, op), &res[i]);
-  }
-  rt::waitForCompletion(h);
-  auto d_f = d_first;
-  auto acc = init;
-  OutputIt chunk_end = d_first;
-  using outitr_traits = distributed_iterator_traits<OutputIt>;
-  for (i = 0; i < numLoc; ++i) {
-    chunk_end = res[i].first;
-    auto d_localities = outitr_traits::localities(d_f, chunk_end);
-    auto d_startingLoc = d_localities.begin();
-    for (auto locality = d_startingLoc, end = d_localities.end();
-         locality != end; ++locality) {
-      rt::asyncExecuteAt(
-          h, locality,
-          [](rt::Handle&,
-             const std::tuple<OutputIt, OutputIt, BinaryOperation, T>& args) {
-            auto gbegin = std::get<0>(args);
-            auto gend = std::get<1>(args);
-            auto local_range = outitr_traits::local_range(std::get<0>(args),
-                                                          std::get<1>(args));
-            auto begin = local_range.begin();
-            auto end = local_range.end();
-            if (begin == end) return;
-            BinaryOperation op = std::get<2>(args);
-            auto acc = std::get<3>(args);
-            *begin = acc;
-            for (++begin; begin != end; ++begin) {
-              *begin = op(std::move(acc), *begin);
-            }
-          },
-          std::make_tuple(d_f, chunk_end, op, acc));
-    }
-    d_f = chunk_end;
-    acc = op(std::move(acc), res[i].second);
-  }
-  rt::waitForCompletion(h);
-  return chunk_end;
+  using entry_t = typename optional_vector<T>::entry_t;
+  return scan_impl::distributed_scan<false, T>(
+      first, last, d_first, op, scan_impl::identity{}, entry_t{init, true});
 }
 
 template <class InputIt, class OutputIt, class BinaryOperation>
@@ -507,82 +649,11 @@ OutputIt inclusive_scan(distributed_sequential_tag&& policy, InputIt first,
 template <class InputIt, class OutputIt, class BinaryOperation>
 OutputIt inclusive_scan(distributed_parallel_tag&& policy, InputIt first,
                         InputIt last, OutputIt d_first, BinaryOperation op) {
-  using itr_traits = distributed_iterator_traits<InputIt>;
-  using value_t = typename itr_traits::value_type;
-  auto localities = itr_traits::localities(first, last);
-  auto startingLoc = localities.begin();
-  uint32_t numLoc = localities.size();
-  if (numLoc == 0) {
-    return d_first;
-  }
-  std::vector<std::pair<OutputIt, value_t>> res(numLoc);
-  rt::Handle h;
-  size_t i = 0;
-  for (auto locality = startingLoc, end = localities.end(); locality != end;
-       ++locality, ++i) {
-    rt::asyncExecuteAtWithRet(
-        h, locality,
-        [](rt::Handle&,
-           const std::tuple<InputIt, InputIt, OutputIt, BinaryOperation>& args,
-           std::pair<OutputIt, value_t>* result) {
-          auto d_first = std::get<2>(args);
-          auto df = d_first;
-          auto gbegin = std::get<0>(args);
-          auto gend = std::get<1>(args);
-          auto local_range = itr_traits::local_range(gbegin, gend);
-          auto begin = local_range.begin();
-          auto end = local_range.end();
-          auto it = itr_traits::iterator_from_local(gbegin, gend, begin);
-          auto dist = std::distance(gbegin, it);
-          std::advance(d_first, dist);
-          if (begin == end) {
-            *result = std::make_pair(d_first, value_t{});
-            return;
-          }
-          BinaryOperation op = std::get<3>(args);
-          value_t acc = *begin;
-          *d_first = acc;
-          while (++begin != end) {
-            acc = op(std::move(acc), *begin);
-            *++d_first = acc;
-          }
-          *result = std::make_pair(++d_first, acc);
-        },
-        std::make_tuple(first, last, d_first, op), &res[i]);
-  }
-  rt::waitForCompletion(h);
-  auto d_f = res[0].first;
-  value_t acc = res[0].second;
-  OutputIt chunk_end = d_first;
-  for (i = 1; i < numLoc; ++i) {
-    chunk_end = res[i].first;
-    auto d_localities = itr_traits::localities(d_f, chunk_end);
-    auto d_startingLoc = d_localities.begin();
-    for (auto locality = d_startingLoc, end = d_localities.end();
-         locality != end; ++locality) {
-      rt::asyncExecuteAt(
-          h, locality,
-          [](rt::Handle&, const std::tuple<OutputIt, OutputIt, BinaryOperation,
-                                           value_t>& args) {
-            auto gbegin = std::get<0>(args);
-            auto gend = std::get<1>(args);
-            auto local_range =
-                itr_traits::local_range(std::get<0>(args), std::get<1>(args));
-            auto begin = local_range.begin();
-            auto end = local_range.end();
-            BinaryOperation op = std::get<2>(args);
-            auto acc = std::get<3>(args);
-            for (auto it = begin; it != end; ++it) {
-              *it = op(*it, std::move(acc));
-            }
-          },
-          std::make_tuple(d_f, chunk_end, op, acc));
-    }
-    d_f = chunk_end;
-    acc = op(std::move(acc), res[i].second);
-  }
-  rt::waitForCompletion(h);
-  return chunk_end;
+  using value_t = typename distributed_iterator_traits<InputIt>::value_type;
+  using entry_t = typename optional_vector<value_t>::entry_t;
+  return scan_impl::distributed_scan<true, value_t>(
+      first, last, d_first, op, scan_impl::identity{},
+      entry_t{value_t{}, false});
 }
 
 template <class InputIt, class OutputIt, class BinaryOperation, class T>
@@ -627,79 +698,9 @@ template <class InputIt, class OutputIt, class BinaryOperation, class T>
 OutputIt inclusive_scan(distributed_parallel_tag&& policy, InputIt first,
                         InputIt last, OutputIt d_first, BinaryOperation op,
                         T init) {
-  using itr_traits = distributed_iterator_traits<InputIt>;
-  auto localities = itr_traits::localities(first, last);
-  auto startingLoc = localities.begin();
-  uint32_t numLoc = localities.size();
-  std::vector<std::pair<OutputIt, T>> res(numLoc);
-  rt::Handle h;
-  size_t i = 0;
-  for (auto locality = startingLoc, end = localities.end(); locality != end;
-       ++locality, ++i) {
-    rt::asyncExecuteAtWithRet(
-        h, locality,
-        [](rt::Handle&,
-           const std::tuple<InputIt, InputIt, OutputIt, BinaryOperation>& args,
-           std::pair<OutputIt, T>* result) {
-          auto d_first = std::get<2>(args);
-          auto df = d_first;
-          auto gbegin = std::get<0>(args);
-          auto gend = std::get<1>(args);
-          auto local_range = itr_traits::local_range(gbegin, gend);
-          auto begin = local_range.begin();
-          auto end = local_range.end();
-          auto it = itr_traits::iterator_from_local(gbegin, gend, begin);
-          auto dist = std::distance(gbegin, it);
-          std::advance(d_first, dist);
-          if (begin == end) {
-            *result = std::make_pair(d_first, T{});
-            return;
-          }
-          BinaryOperation op = std::get<3>(args);
-          T acc = *begin;
-          *d_first = acc;
-          while (++begin != end) {
-            acc = op(std::move(acc), *begin);
-            *++d_first = acc;
-          }
-          *result = std::make_pair(++d_first, acc);
-        },
-        std::make_tuple(first, last, d_first, op), &res[i]);
-  }
-  rt::waitForCompletion(h);
-  auto d_f = d_first;
-  auto acc = init;
-  OutputIt chunk_end = d_first;
-  using outitr_traits = distributed_iterator_traits<OutputIt>;
-  for (i = 0; i < numLoc; ++i) {
-    chunk_end = res[i].first;
-    auto d_localities = outitr_traits::localities(d_f, chunk_end);
-    auto d_startingLoc = d_localities.begin();
-    for (auto locality = d_startingLoc, end = d_localities.end();
-         locality != end; ++locality) {
-      rt::asyncExecuteAt(
-          h, locality,
-          [](rt::Handle&,
-             const std::tuple<OutputIt, OutputIt, BinaryOperation, T>& args) {
-            auto gbegin = std::get<0>(args);
-            auto gend = std::get<1>(args);
-            auto local_range =
-                itr_traits::local_range(std::get<0>(args), std::get<1>(args));
-            auto begin = local_range.begin();
-            auto end = local_range.end();
-            BinaryOperation op = std::get<2>(args);
-            auto acc = std::get<3>(args);
-            for (auto it = begin; it != end; ++it) {
-              *it = op(std::move(acc), *it);
-            }
-          },
-          std::make_tuple(d_f, chunk_end, op, acc));
-    }
-    d_f = chunk_end;
-    acc = op(std::move(acc), res[i].second);
-  }
-  rt::waitForCompletion(h);
-  return chunk_end;
+  using entry_t = typename optional_vector<T>::entry_t;
+  return scan_impl::distributed_scan<true, T>(
+      first, last, d_first, op, scan_impl::identity{}, entry_t{init, true});
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -736,45 +737,28 @@ template <class ForwardIt, class T, class BinaryOp, class UnaryOp>
 T transform_reduce(distributed_parallel_tag&& policy, ForwardIt first,
                    ForwardIt last, T init, BinaryOp op, UnaryOp uop) {
   using itr_traits = distributed_iterator_traits<ForwardIt>;
-  static_assert(
-      std::is_default_constructible<T>::value,
-      "transform_reduce requires DefaultConstructible transformed value type");
+  using local_iterator_t = typename itr_traits::local_iterator_type;
+  if (first == last) return init;
 
-  // distributed map
-  auto map_res = distributed_map(
+  // distributed map-reduce
+  auto res = distributed_map_reduce(
       // range
       first, last,
       // kernel
-      [](ForwardIt first, ForwardIt last, BinaryOp op, UnaryOp uop) {
-        using local_iterator_t = typename itr_traits::local_iterator_type;
-
-        // local map
-        auto lrange = itr_traits::local_range(first, last);
-        auto map_res = local_map(
-            // range
-            lrange.begin(), lrange.end(),
-            // kernel
-            [&](local_iterator_t b, local_iterator_t e) {
-              auto res = uop(*b++);
-              for (; b != e; b++) res = op(std::move(res), uop(*b));
-              return res;
-            });
-
-        // local reduce
-        auto b = map_res.begin(), e = map_res.end();
-        T res{};
-        if (b != e) {
-          res = *b++;
-          res = std::accumulate(b, e, std::move(res), op);
-        }
+      [](ForwardIt, ForwardIt, local_iterator_t b, local_iterator_t e,
+         BinaryOp op, UnaryOp uop) {
+        T res = uop(*b);
+        while (++b != e) res = op(std::move(res), uop(*b));
         return res;
       },
+      // reduce
+      op,
+      // empty range
+      init,
       // map arguments
       op, uop);
 
-  // TODO parallel
-  // reduce
-  return std::accumulate(map_res.begin(), map_res.end(), init, op);
+  return op(std::move(init), std::move(res));
 }
 
 // two ranges - sequential
@@ -818,42 +802,30 @@ T transform_reduce(distributed_parallel_tag&& policy, ForwardIt1 first1,
                    ForwardIt1 last1, ForwardIt2 first2, T init, BinaryOp1 op1,
                    BinaryOp2 op2) {
   using itr_traits = distributed_iterator_traits<ForwardIt1>;
-  auto localities = itr_traits::localities(first1, last1);
-  rt::Handle h;
-  std::vector<T> results(localities.size());
-  size_t i = 0;
-  for (auto locality = localities.begin(), end = localities.end();
-       locality != end; ++locality, ++i) {
-    rt::asyncExecuteAtWithRet(
-        h, locality,
-        [](rt::Handle& h,
-           const std::tuple<ForwardIt1, ForwardIt1, ForwardIt2, BinaryOp1,
-                            BinaryOp2>& args,
-           T* result) {
-          auto gbegin = std::get<0>(args);
-          auto gend = std::get<1>(args);
-          auto local_range = itr_traits::local_range(gbegin, gend);
-          auto begin = local_range.begin();
-          auto end = local_range.end();
-          auto it = itr_traits::iterator_from_local(gbegin, gend, begin);
-          auto first2 = std::get<2>(args);
-          size_t dist = std::distance(gbegin, it);
-          std::advance(first2, dist);
-          auto op1 = std::get<3>(args);
-          auto op2 = std::get<4>(args);
-          T acc = op2(*begin, *first2);
-          while (++begin != end) {
-            acc = op1(std::move(acc), op2(*begin, *(++first2)));
-          }
-          *result = acc;
-        },
-        std::make_tuple(first1, last1, first2, op1, op2), &results[i]);
-  }
-  rt::waitForCompletion(h);
-  for (auto lval : results) {
-    init = op1(std::move(init), lval);
-  }
-  return init;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
+  if (first1 == last1) return init;
+
+  // distributed map-reduce
+  auto res = distributed_map_reduce(
+      // range
+      first1, last1,
+      // kernel
+      [](ForwardIt1 first1, ForwardIt1 last1, local_iterator_t b,
+         local_iterator_t e, ForwardIt2 first2, BinaryOp1 op1, BinaryOp2 op2) {
+        auto it = itr_traits::iterator_from_local(first1, last1, b);
+        std::advance(first2, std::distance(first1, it));
+        T res = op2(*b, *first2);
+        while (++b != e) res = op1(std::move(res), op2(*b, *(++first2)));
+        return res;
+      },
+      // reduce
+      op1,
+      // empty range
+      init,
+      // map arguments
+      first2, op1, op2);
+
+  return op1(std::move(init), std::move(res));
 }
 
 template <class InputIt, class OutputIt, class T, class BinaryOperation,
@@ -904,84 +876,9 @@ OutputIt transform_exclusive_scan(distributed_parallel_tag&& policy,
                                   InputIt first, InputIt last, OutputIt d_first,
                                   T init, BinaryOperation op,
                                   UnaryOperation uop) {
-  using itr_traits = distributed_iterator_traits<InputIt>;
-  auto localities = itr_traits::localities(first, last);
-  auto startingLoc = localities.begin();
-  uint32_t numLoc = localities.size();
-  std::vector<std::pair<OutputIt, T>> res(numLoc);
-  rt::Handle h;
-  size_t i = 0;
-  for (auto locality = startingLoc, end = localities.end(); locality != end;
-       ++locality, ++i) {
-    rt::asyncExecuteAtWithRet(
-        h, locality,
-        [](rt::Handle&,
-           const std::tuple<InputIt, InputIt, OutputIt, BinaryOperation,
-                            UnaryOperation>& args,
-           std::pair<OutputIt, T>* result) {
-          auto d_first = std::get<2>(args);
-          auto df = d_first;
-          auto gbegin = std::get<0>(args);
-          auto gend = std::get<1>(args);
-          auto local_range = itr_traits::local_range(gbegin, gend);
-          auto begin = local_range.begin();
-          auto end = local_range.end();
-          auto it = itr_traits::iterator_from_local(gbegin, gend, begin);
-          auto dist = std::distance(gbegin, it);
-          std::advance(d_first, dist);
-          if (begin == end) {
-            *result = std::make_pair(d_first, T{});
-            return;
-          }
-          auto op = std::get<3>(args);
-          auto uop = std::get<4>(args);
-          T acc = *begin;
-          *d_first = acc;
-          acc = uop(acc);
-          while (++begin != end) {
-            *++d_first = acc;
-            acc = op(std::move(acc), uop(*begin));
-          }
-          *result = std::make_pair(++d_first, acc);
-        },
-        std::make_tuple(first, last, d_first, op, uop), &res[i]);
-  }
-  rt::waitForCompletion(h);
-  auto d_f = d_first;
-  auto acc = init;
-  OutputIt chunk_end = d_first;
-  using outitr_traits = distributed_iterator_traits<OutputIt>;
-  for (i = 0; i < numLoc; ++i) {
-    chunk_end = res[i].first;
-    auto d_localities = outitr_traits::localities(d_f, chunk_end);
-    auto d_startingLoc = d_localities.begin();
-    for (auto locality = d_startingLoc, end = d_localities.end();
-         locality != end; ++locality) {
-      rt::asyncExecuteAt(
-          h, locality,
-          [](rt::Handle&,
-             const std::tuple<OutputIt, OutputIt, BinaryOperation, T>& args) {
-            auto gbegin = std::get<0>(args);
-            auto gend = std::get<1>(args);
-            auto local_range =
-                itr_traits::local_range(std::get<0>(args), std::get<1>(args));
-            auto begin = local_range.begin();
-            auto end = local_range.end();
-            if (begin == end) return;
-            BinaryOperation op = std::get<2>(args);
-            auto acc = std::get<3>(args);
-            *begin = acc;
-            for (++begin; begin != end; ++begin) {
-              *begin = op(std::move(acc), *begin);
-            }
-          },
-          std::make_tuple(d_f, chunk_end, op, acc));
-    }
-    d_f = chunk_end;
-    acc = op(std::move(acc), res[i].second);
-  }
-  rt::waitForCompletion(h);
-  return chunk_end;
+  using entry_t = typename optional_vector<T>::entry_t;
+  return scan_impl::distributed_scan<false, T>(
+      first, last, d_first, op, uop, entry_t{init, true});
 }
 
 template <class InputIt, class OutputIt, class BinaryOperation,
@@ -1038,85 +935,11 @@ template <class InputIt, class OutputIt, class BinaryOperation,
 OutputIt transform_inclusive_scan(distributed_parallel_tag&& policy,
                                   InputIt first, InputIt last, OutputIt d_first,
                                   BinaryOperation op, UnaryOperation uop) {
-  using itr_traits = distributed_iterator_traits<InputIt>;
-  using value_t = typename itr_traits::value_type;
-  auto localities = itr_traits::localities(first, last);
-  auto startingLoc = localities.begin();
-  uint32_t numLoc = localities.size();
-  if (numLoc == 0) {
-    return d_first;
-  }
-  std::vector<std::pair<OutputIt, value_t>> res(numLoc);
-  rt::Handle h;
-  size_t i = 0;
-  for (auto locality = startingLoc, end = localities.end(); locality != end;
-       ++locality, ++i) {
-    rt::asyncExecuteAtWithRet(
-        h, locality,
-        [](rt::Handle&,
-           const std::tuple<InputIt, InputIt, OutputIt, BinaryOperation,
-                            UnaryOperation>& args,
-           std::pair<OutputIt, value_t>* result) {
-          auto d_first = std::get<2>(args);
-          auto df = d_first;
-          auto gbegin = std::get<0>(args);
-          auto gend = std::get<1>(args);
-          auto local_range = itr_traits::local_range(gbegin, gend);
-          auto begin = local_range.begin();
-          auto end = local_range.end();
-          auto it = itr_traits::iterator_from_local(gbegin, gend, begin);
-          auto dist = std::distance(gbegin, it);
-          std::advance(d_first, dist);
-          if (begin == end) {
-            *result = std::make_pair(d_first, value_t{});
-            return;
-          }
-          BinaryOperation op = std::get<3>(args);
-          UnaryOperation uop = std::get<4>(args);
-          value_t acc = uop(*begin);
-          *d_first = acc;
-          while (++begin != end) {
-            acc = op(std::move(acc), uop(*begin));
-            *++d_first = acc;
-          }
-          *result = std::make_pair(++d_first, acc);
-        },
-        std::make_tuple(first, last, d_first, op, uop), &res[i]);
-  }
-  rt::waitForCompletion(h);
-  auto d_f = res[0].first;
-  value_t acc = res[0].second;
-  OutputIt chunk_end = d_first;
-  using outitr_traits = distributed_iterator_traits<OutputIt>;
-  for (i = 1; i < numLoc; ++i) {
-    chunk_end = res[i].first;
-    auto d_localities = outitr_traits::localities(d_f, chunk_end);
-    auto d_startingLoc = d_localities.begin();
-    for (auto locality = d_startingLoc, end = d_localities.end();
-         locality != end; ++locality) {
-      rt::asyncExecuteAt(
-          h, locality,
-          [](rt::Handle&, const std::tuple<OutputIt, OutputIt, BinaryOperation,
-                                           value_t>& args) {
-            auto gbegin = std::get<0>(args);
-            auto gend = std::get<1>(args);
-            auto local_range =
-                itr_traits::local_range(std::get<0>(args), std::get<1>(args));
-            auto begin = local_range.begin();
-            auto end = local_range.end();
-            BinaryOperation op = std::get<2>(args);
-            auto acc = std::get<3>(args);
-            for (auto it = begin; it != end; ++it) {
-              *it = op(std::move(acc), *it);
-            }
-          },
-          std::make_tuple(d_f, chunk_end, op, acc));
-    }
-    d_f = chunk_end;
-    acc = op(std::move(acc), res[i].second);
-  }
-  rt::waitForCompletion(h);
-  return chunk_end;
+  using input_t = typename distributed_iterator_traits<InputIt>::value_type;
+  using value_t = std::decay_t<decltype(uop(std::declval<input_t>()))>;
+  using entry_t = typename optional_vector<value_t>::entry_t;
+  return scan_impl::distributed_scan<true, value_t>(
+      first, last, d_first, op, uop, entry_t{value_t{}, false});
 }
 
 template <class InputIt, class OutputIt, class BinaryOperation,
@@ -1166,84 +989,9 @@ OutputIt transform_inclusive_scan(distributed_parallel_tag&& policy,
                                   InputIt first, InputIt last, OutputIt d_first,
                                   BinaryOperation op, UnaryOperation uop,
                                   T init) {
-  using itr_traits = distributed_iterator_traits<InputIt>;
-  auto localities = itr_traits::localities(first, last);
-  auto startingLoc = localities.begin();
-  uint32_t numLoc = localities.size();
-  if (numLoc == 0) {
-    return d_first;
-  }
-  std::vector<std::pair<OutputIt, T>> res(numLoc);
-  rt::Handle h;
-  size_t i = 0;
-  for (auto locality = startingLoc, end = localities.end(); locality != end;
-       ++locality, ++i) {
-    rt::asyncExecuteAtWithRet(
-        h, locality,
-        [](rt::Handle&,
-           const std::tuple<InputIt, InputIt, OutputIt, BinaryOperation,
-                            UnaryOperation>& args,
-           std::pair<OutputIt, T>* result) {
-          auto d_first = std::get<2>(args);
-          auto df = d_first;
-          auto gbegin = std::get<0>(args);
-          auto gend = std::get<1>(args);
-          auto local_range = itr_traits::local_range(gbegin, gend);
-          auto begin = local_range.begin();
-          auto end = local_range.end();
-          auto it = itr_traits::iterator_from_local(gbegin, gend, begin);
-          auto dist = std::distance(gbegin, it);
-          std::advance(d_first, dist);
-          if (begin == end) {
-            *result = std::make_pair(d_first, T{});
-            return;
-          }
-          BinaryOperation op = std::get<3>(args);
-          UnaryOperation uop = std::get<4>(args);
-          T acc = uop(*begin);
-          *d_first = acc;
-          while (++begin != end) {
-            acc = op(std::move(acc), uop(*begin));
-            *++d_first = acc;
-          }
-          *result = std::make_pair(++d_first, acc);
-        },
-        std::make_tuple(first, last, d_first, op, uop), &res[i]);
-  }
-  rt::waitForCompletion(h);
-  auto d_f = res[0].first;
-  auto acc = res[0].second;
-  OutputIt chunk_end = d_first;
-  using outitr_traits = distributed_iterator_traits<OutputIt>;
-  for (i = 1; i < numLoc; ++i) {
-    chunk_end = res[i].first;
-    auto d_localities = outitr_traits::localities(d_f, chunk_end);
-    auto d_startingLoc = d_localities.begin();
-    for (auto locality = d_startingLoc, end = d_localities.end();
-         locality != end; ++locality) {
-      rt::asyncExecuteAt(
-          h, locality,
-          [](rt::Handle&,
-             const std::tuple<OutputIt, OutputIt, BinaryOperation, T>& args) {
-            auto gbegin = std::get<0>(args);
-            auto gend = std::get<1>(args);
-            auto local_range =
-                itr_traits::local_range(std::get<0>(args), std::get<1>(args));
-            auto begin = local_range.begin();
-            auto end = local_range.end();
-            BinaryOperation op = std::get<2>(args);
-            auto acc = std::get<3>(args);
-            for (auto it = begin; it != end; ++it) {
-              *it = op(std::move(acc), *it);
-            }
-          },
-          std::make_tuple(d_f, chunk_end, op, acc));
-    }
-    d_f = chunk_end;
-    acc = op(std::move(acc), res[i].second);
-  }
-  rt::waitForCompletion(h);
-  return chunk_end;
+  using entry_t = typename optional_vector<T>::entry_t;
+  return scan_impl::distributed_scan<true, T>(
+      first, last, d_first, op, uop, entry_t{init, true});
 }
 
 }  // namespace impl
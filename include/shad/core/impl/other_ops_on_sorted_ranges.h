@@ -28,13 +28,175 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <utility>
+#include <vector>
+
 #include "shad/core/execution.h"
+#include "shad/core/impl/impl_patterns.h"
 #include "shad/distributed_iterator_traits.h"
 #include "shad/runtime/runtime.h"
 
 namespace shad {
 namespace impl {
 
+namespace merge_impl {
+
+// The element at position i of a (possibly distributed) range.
+template <typename It>
+typename std::iterator_traits<It>::value_type read_at(It first, size_t i) {
+  auto it = std::next(first, i);
+  return *it;
+}
+
+// Co-rank on the merge path: the number of elements of [first1, first1 + n1)
+// among the first k elements of the stable merge of the two ranges.  It only
+// reads O(log(k)) elements of the inputs.
+template <typename It1, typename It2, typename Compare>
+size_t co_rank(size_t k, It1 first1, size_t n1, It2 first2, size_t n2,
+               Compare comp) {
+  size_t lo = k > n2 ? k - n2 : 0;
+  size_t hi = std::min(k, n1);
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (!comp(read_at(first2, k - 1 - mid), read_at(first1, mid)))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+// Sub-problem of a merge: the output positions [k, k + len) and the
+// iterators to the input ranges.
+template <typename It1, typename It2, typename OutputIt, typename Compare>
+struct merge_args {
+  It1 first1;
+  size_t n1;
+  It2 first2;
+  size_t n2;
+  OutputIt d_first;
+  size_t k;
+  size_t len;
+  Compare comp;
+  size_t num_tasks;
+  bool in_place;
+};
+
+// Merge the portion [k, k + len) of the output, owned by the calling
+// locality.  Each task computes the co-ranks delimiting its share of the
+// output, fetches the corresponding input elements with bulk transfers, and
+// merges them.  In-place merges return the merged buffer, that is written
+// back once all the localities have fetched their inputs.
+template <typename It1, typename It2, typename OutputIt, typename Compare>
+void merge_piece(rt::Handle&,
+                 const merge_args<It1, It2, OutputIt, Compare>& args,
+                 std::vector<typename OutputIt::value_type>** res) {
+  using T = typename OutputIt::value_type;
+  using args_t = merge_args<It1, It2, OutputIt, Compare>;
+  auto buffer = new std::vector<T>(args.len);
+  auto num_tasks = std::min(args.num_tasks, args.len);
+
+  auto map_args = std::make_tuple(args, buffer->data(), num_tasks);
+  rt::forEachAt(
+      rt::thisLocality(),
+      [](const std::tuple<args_t, T*, size_t>& map_args, size_t i) {
+        auto& args = std::get<0>(map_args);
+        auto num_tasks = std::get<2>(map_args);
+        size_t k0 = args.k + i * args.len / num_tasks;
+        size_t k1 = args.k + (i + 1) * args.len / num_tasks;
+        size_t i0 =
+            co_rank(k0, args.first1, args.n1, args.first2, args.n2, args.comp);
+        size_t i1 =
+            co_rank(k1, args.first1, args.n1, args.first2, args.n2, args.comp);
+        size_t j0 = k0 - i0, j1 = k1 - i1;
+
+        std::vector<typename It1::value_type> a(i1 - i0);
+        std::vector<typename It2::value_type> b(j1 - j0);
+        read_from_range(std::next(args.first1, i0), a.size(), a.data());
+        read_from_range(std::next(args.first2, j0), b.size(), b.data());
+        std::merge(a.begin(), a.end(), b.begin(), b.end(),
+                   std::get<1>(map_args) + (k0 - args.k), args.comp);
+      },
+      map_args, num_tasks);
+
+  if (args.in_place) {
+    *res = buffer;
+  } else {
+    write_to_range(buffer->data(), args.len,
+                   std::next(args.d_first, args.k));
+    delete buffer;
+    *res = nullptr;
+  }
+}
+
+template <typename OutputIt>
+void write_piece(
+    rt::Handle&,
+    const std::tuple<std::vector<typename OutputIt::value_type>*, OutputIt>&
+        args) {
+  auto buffer = std::get<0>(args);
+  write_to_range(buffer->data(), buffer->size(), std::get<1>(args));
+  delete buffer;
+}
+
+// The output range is split among the localities that own it, so that each
+// locality merges and writes a local portion of the output.
+template <typename ExecutionPolicy, typename It1, typename It2,
+          typename OutputIt, typename Compare>
+OutputIt merge(ExecutionPolicy&& policy, It1 first1, It1 last1, It2 first2,
+               It2 last2, OutputIt d_first, Compare comp, bool in_place) {
+  using T = typename OutputIt::value_type;
+  using itr_traits = distributed_random_access_iterator_trait<OutputIt>;
+  using args_t = merge_args<It1, It2, OutputIt, Compare>;
+
+  size_t n1 = std::distance(first1, last1);
+  size_t n2 = std::distance(first2, last2);
+  auto d_last = std::next(d_first, n1 + n2);
+  if (n1 + n2 == 0) return d_last;
+
+  auto pieces = itr_traits::distribution(d_first, d_last);
+  std::vector<std::vector<T>*> buffers(pieces.size());
+  rt::Handle h;
+  size_t k = 0;
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    args_t args{first1, n1, first2, n2, d_first, k, pieces[i].second, comp,
+                num_tasks(policy), in_place};
+    rt::asyncExecuteAtWithRet(h, pieces[i].first,
+                              merge_piece<It1, It2, OutputIt, Compare>, args,
+                              &buffers[i]);
+    k += pieces[i].second;
+  }
+  rt::waitForCompletion(h);
+
+  if (in_place) {
+    k = 0;
+    for (size_t i = 0; i < pieces.size(); ++i) {
+      rt::asyncExecuteAt(h, pieces[i].first, write_piece<OutputIt>,
+                         std::make_tuple(buffers[i], std::next(d_first, k)));
+      k += pieces[i].second;
+    }
+    rt::waitForCompletion(h);
+  }
+  return d_last;
+}
+
+}  // namespace merge_impl
+
+template <typename ExecutionPolicy, typename InputIt1, typename InputIt2,
+          typename OutputIt, typename Compare>
+OutputIt merge(ExecutionPolicy&& policy, InputIt1 first1, InputIt1 last1,
+               InputIt2 first2, InputIt2 last2, OutputIt d_first,
+               Compare comp) {
+  return merge_impl::merge(std::forward<ExecutionPolicy>(policy), first1,
+                           last1, first2, last2, d_first, comp, false);
+}
+
+template <typename ExecutionPolicy, typename BidirIt, typename Compare>
+void inplace_merge(ExecutionPolicy&& policy, BidirIt first, BidirIt middle,
+                   BidirIt last, Compare comp) {
+  merge_impl::merge(std::forward<ExecutionPolicy>(policy), first, middle,
+                    middle, last, first, comp, true);
+}
 
 }  // namespace impl
 }  // namespace shad
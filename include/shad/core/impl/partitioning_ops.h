@@ -28,13 +28,288 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "shad/core/execution.h"
+#include "shad/core/impl/impl_patterns.h"
 #include "shad/distributed_iterator_traits.h"
 #include "shad/runtime/runtime.h"
 
 namespace shad {
 namespace impl {
 
+namespace partition_impl {
+
+// The partitioning algorithms run in two passes.  The first pass copies each
+// local portion into a buffer, splitting it in parts that are stably
+// partitioned in parallel, and counts the elements satisfying the predicate.
+// The per-locality counts are then scanned to compute the output offsets, and
+// the second pass writes each partitioned part to its final position with one
+// bulk transfer for each destination locality.
+template <typename T>
+struct partition_state {
+  std::vector<T> buffer;
+  std::vector<size_t> bounds;    // parts are [bounds[i], bounds[i + 1])
+  std::vector<size_t> num_true;  // elements satisfying the predicate
+};
+
+template <typename T>
+struct partition_counts {
+  partition_state<T>* state;
+  size_t num_true;
+  size_t num_false;
+};
+
+template <typename ForwardIt, typename UnaryPredicate>
+void count_local_portion(
+    rt::Handle&,
+    const std::tuple<ForwardIt, ForwardIt, UnaryPredicate, size_t>& args,
+    partition_counts<typename ForwardIt::value_type>* res) {
+  using T = typename ForwardIt::value_type;
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
+  auto lrange = itr_traits::local_range(std::get<0>(args), std::get<1>(args));
+  auto parts = local_iterator_traits<local_iterator_t>::partitions(
+      lrange.begin(), lrange.end(), std::get<3>(args));
+
+  auto state = new partition_state<T>();
+  state->buffer.resize(std::distance(lrange.begin(), lrange.end()));
+  state->num_true.resize(parts.size());
+  for (auto& part : parts)
+    state->bounds.push_back(std::distance(lrange.begin(), part.begin()));
+  state->bounds.push_back(state->buffer.size());
+
+  if (parts.size()) {
+    auto map_args = std::make_tuple(parts.data(), state, std::get<2>(args));
+    rt::forEachAt(
+        rt::thisLocality(),
+        [](const decltype(map_args)& map_args, size_t i) {
+          auto& part = std::get<0>(map_args)[i];
+          auto state = std::get<1>(map_args);
+          auto p = std::get<2>(map_args);
+          auto out = state->buffer.begin() + state->bounds[i];
+          std::vector<T> rejected;
+          size_t num_true = 0;
+          for (auto it = part.begin(); it != part.end(); ++it) {
+            if (p(*it)) {
+              out[num_true++] = *it;
+            } else {
+              rejected.push_back(*it);
+            }
+          }
+          std::copy(rejected.begin(), rejected.end(), out + num_true);
+          state->num_true[i] = num_true;
+        },
+        map_args, parts.size());
+  }
+
+  res->state = state;
+  res->num_true = std::accumulate(state->num_true.begin(),
+                                  state->num_true.end(), size_t(0));
+  res->num_false = state->buffer.size() - res->num_true;
+}
+
+template <typename OutputIt1, typename OutputIt2>
+void write_local_portion(
+    rt::Handle&,
+    const std::tuple<partition_state<typename OutputIt1::value_type>*,
+                     OutputIt1, OutputIt2>& args) {
+  using T = typename OutputIt1::value_type;
+  auto state = std::get<0>(args);
+  auto num_parts = state->num_true.size();
+
+  // per-part output offsets
+  std::vector<size_t> offsets(2 * num_parts);
+  size_t true_offset = 0, false_offset = 0;
+  for (size_t i = 0; i < num_parts; ++i) {
+    offsets[2 * i] = true_offset;
+    offsets[2 * i + 1] = false_offset;
+    true_offset += state->num_true[i];
+    false_offset +=
+        state->bounds[i + 1] - state->bounds[i] - state->num_true[i];
+  }
+
+  if (num_parts) {
+    auto map_args = std::make_tuple(state, offsets.data(), std::get<1>(args),
+                                    std::get<2>(args));
+    rt::forEachAt(
+        rt::thisLocality(),
+        [](const decltype(map_args)& map_args, size_t i) {
+          auto state = std::get<0>(map_args);
+          auto offsets = std::get<1>(map_args);
+          const T* part = state->buffer.data() + state->bounds[i];
+          size_t num_true = state->num_true[i];
+          size_t num_false =
+              state->bounds[i + 1] - state->bounds[i] - num_true;
+          write_to_range(part, num_true,
+                         std::next(std::get<2>(map_args), offsets[2 * i]));
+          write_to_range(part + num_true, num_false,
+                         std::next(std::get<3>(map_args), offsets[2 * i + 1]));
+        },
+        map_args, num_parts);
+  }
+  delete state;
+}
+
+// stably partition [first, last) into the ranges starting at d_first_true and
+// d_first_false.  If d_first_true is unknown (i.e., in-place partitioning),
+// the elements that do not satisfy p follow the ones that do.
+template <typename ExecutionPolicy, typename ForwardIt, typename OutputIt1,
+          typename OutputIt2, typename UnaryPredicate>
+std::pair<size_t, size_t> partition_copy(ExecutionPolicy&& policy,
+                                         ForwardIt first, ForwardIt last,
+                                         OutputIt1 d_first_true,
+                                         OutputIt2 d_first_false,
+                                         UnaryPredicate p, bool in_place) {
+  using T = typename ForwardIt::value_type;
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+
+  // first pass: local partitioning and counting
+  auto localities = itr_traits::localities(first, last);
+  std::vector<partition_counts<T>> counts(localities.size());
+  rt::Handle h;
+  size_t i = 0;
+  for (auto l = localities.begin(); l != localities.end(); ++l, ++i)
+    rt::asyncExecuteAtWithRet(
+        h, l, count_local_portion<ForwardIt, UnaryPredicate>,
+        std::make_tuple(first, last, p, num_tasks(policy)), &counts[i]);
+  rt::waitForCompletion(h);
+
+  // exclusive scan of the counts
+  size_t num_true = 0, num_false = 0;
+  for (auto& c : counts) {
+    num_true += c.num_true;
+    num_false += c.num_false;
+  }
+  if (in_place) d_first_false = std::next(d_first_false, num_true);
+
+  // second pass: scatter
+  size_t true_offset = 0, false_offset = 0;
+  i = 0;
+  for (auto l = localities.begin(); l != localities.end(); ++l, ++i) {
+    rt::asyncExecuteAt(
+        h, l, write_local_portion<OutputIt1, OutputIt2>,
+        std::make_tuple(counts[i].state,
+                        std::next(d_first_true, true_offset),
+                        std::next(d_first_false, false_offset)));
+    true_offset += counts[i].num_true;
+    false_offset += counts[i].num_false;
+  }
+  rt::waitForCompletion(h);
+
+  return std::make_pair(num_true, num_false);
+}
+
+// summary of a sub-range, folded in range order
+struct partitioned_summary {
+  bool partitioned;
+  bool has_true;
+  bool has_false;
+};
+
+inline partitioned_summary fold_summary(const partitioned_summary& lhs,
+                                        const partitioned_summary& rhs) {
+  return partitioned_summary{
+      lhs.partitioned && rhs.partitioned && !(lhs.has_false && rhs.has_true),
+      lhs.has_true || rhs.has_true, lhs.has_false || rhs.has_false};
+}
+
+template <typename InputIt, typename UnaryPredicate>
+partitioned_summary local_summary(InputIt first, InputIt last,
+                                  UnaryPredicate p) {
+  auto it = std::find_if_not(first, last, p);
+  return partitioned_summary{std::none_of(it, last, p), it != first,
+                             it != last};
+}
+
+}  // namespace partition_impl
+
+template <typename ForwardIt, typename UnaryPredicate>
+bool is_partitioned(distributed_sequential_tag&& policy, ForwardIt first,
+                    ForwardIt last, UnaryPredicate p) {
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  using partition_impl::partitioned_summary;
+
+  auto res = distributed_folding_map_early_termination(
+      // range
+      first, last,
+      // kernel
+      [](ForwardIt first, ForwardIt last,
+         const partitioned_summary& partial_solution, UnaryPredicate p) {
+        auto lrange = itr_traits::local_range(first, last);
+        return partition_impl::fold_summary(
+            partial_solution,
+            partition_impl::local_summary(lrange.begin(), lrange.end(), p));
+      },
+      // halt condition
+      [](const partitioned_summary& x) { return !x.partitioned; },
+      // initial solution
+      partitioned_summary{true, false, false},
+      // map arguments
+      p);
+  return res.partitioned;
+}
+
+template <typename ForwardIt, typename UnaryPredicate>
+bool is_partitioned(distributed_parallel_tag&& policy, ForwardIt first,
+                    ForwardIt last, UnaryPredicate p) {
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  using local_iterator_t = typename itr_traits::local_iterator_type;
+  using partition_impl::partitioned_summary;
+
+  // distributed map-reduce
+  return distributed_map_reduce(
+             // range
+             first, last,
+             // kernel
+             [](ForwardIt, ForwardIt, local_iterator_t b, local_iterator_t e,
+                UnaryPredicate p) {
+               return partition_impl::local_summary(b, e, p);
+             },
+             // reduce
+             partition_impl::fold_summary,
+             // empty range
+             partitioned_summary{true, false, false},
+             // map arguments
+             p)
+      .partitioned;
+}
+
+template <typename ExecutionPolicy, typename ForwardIt,
+          typename UnaryPredicate>
+ForwardIt stable_partition(ExecutionPolicy&& policy, ForwardIt first,
+                           ForwardIt last, UnaryPredicate p) {
+  if (first == last) return last;
+  auto res = partition_impl::partition_copy(
+      std::forward<ExecutionPolicy>(policy), first, last, first, first, p,
+      true);
+  return std::next(first, res.first);
+}
+
+// the stable algorithm moves every element once, as an unstable one would
+template <typename ExecutionPolicy, typename ForwardIt,
+          typename UnaryPredicate>
+ForwardIt partition(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last,
+                    UnaryPredicate p) {
+  return impl::stable_partition(std::forward<ExecutionPolicy>(policy), first,
+                                last, p);
+}
+
+template <typename ExecutionPolicy, typename ForwardIt, typename OutputIt1,
+          typename OutputIt2, typename UnaryPredicate>
+std::pair<OutputIt1, OutputIt2> partition_copy(
+    ExecutionPolicy&& policy, ForwardIt first, ForwardIt last,
+    OutputIt1 d_first_true, OutputIt2 d_first_false, UnaryPredicate p) {
+  if (first == last) return std::make_pair(d_first_true, d_first_false);
+  auto res = partition_impl::partition_copy(
+      std::forward<ExecutionPolicy>(policy), first, last, d_first_true,
+      d_first_false, p, false);
+  return std::make_pair(std::next(d_first_true, res.first),
+                        std::next(d_first_false, res.second));
+}
 
 }  // namespace impl
 }  // namespace shad
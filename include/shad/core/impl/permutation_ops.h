@@ -26,15 +26,598 @@
 #define INCLUDE_SHAD_CORE_IMPL_PERMUTATION_OPS_H
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "shad/core/execution.h"
+#include "shad/core/impl/impl_patterns.h"
 #include "shad/distributed_iterator_traits.h"
 #include "shad/runtime/runtime.h"
 
 namespace shad {
 namespace impl {
 
+namespace permutation_impl {
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// reverse and rotate: each locality owning a portion of the output fetches
+// the input elements of its portion with bulk transfers.  In-place
+// reorderings return the fetched buffers, that are written back once all the
+// localities have read their inputs.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// Sub-problem of a reordering: the output positions [k, k + len), taken from
+// input position (i + shift) % n, or n - 1 - i when reversing.
+template <typename InputIt, typename OutputIt>
+struct reorder_args {
+  InputIt first;
+  size_t n;
+  OutputIt d_first;
+  size_t k;
+  size_t len;
+  size_t shift;
+  bool reverse;
+  size_t num_tasks;
+  bool in_place;
+};
+
+template <typename InputIt, typename OutputIt>
+void reorder_piece(rt::Handle&, const reorder_args<InputIt, OutputIt>& args,
+                   std::vector<typename OutputIt::value_type>** res) {
+  using T = typename OutputIt::value_type;
+  using args_t = reorder_args<InputIt, OutputIt>;
+  auto buffer = new std::vector<T>(args.len);
+  auto num_tasks = std::min(args.num_tasks, args.len);
+
+  auto map_args = std::make_tuple(args, buffer->data(), num_tasks);
+  rt::forEachAt(
+      rt::thisLocality(),
+      [](const std::tuple<args_t, T*, size_t>& map_args, size_t t) {
+        auto& args = std::get<0>(map_args);
+        auto num_tasks = std::get<2>(map_args);
+        size_t b = t * args.len / num_tasks;
+        size_t e = (t + 1) * args.len / num_tasks;
+        T* dst = std::get<1>(map_args) + b;
+        if (args.reverse) {
+          read_from_range(std::next(args.first, args.n - args.k - e), e - b,
+                          dst);
+          std::reverse(dst, dst + (e - b));
+        } else {
+          size_t s = (args.k + b + args.shift) % args.n;
+          size_t m = std::min(e - b, args.n - s);
+          read_from_range(std::next(args.first, s), m, dst);
+          read_from_range(args.first, e - b - m, dst + m);
+        }
+      },
+      map_args, num_tasks);
+
+  if (args.in_place) {
+    *res = buffer;
+  } else {
+    write_to_range(buffer->data(), args.len, std::next(args.d_first, args.k));
+    delete buffer;
+    *res = nullptr;
+  }
+}
+
+template <typename OutputIt>
+void write_buffer(
+    rt::Handle&,
+    const std::tuple<std::vector<typename OutputIt::value_type>*, OutputIt>&
+        args) {
+  auto buffer = std::get<0>(args);
+  write_to_range(buffer->data(), buffer->size(), std::get<1>(args));
+  delete buffer;
+}
+
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt>
+OutputIt reorder(ExecutionPolicy&& policy, InputIt first, InputIt last,
+                 OutputIt d_first, size_t shift, bool reverse,
+                 bool in_place) {
+  using T = typename OutputIt::value_type;
+  using itr_traits = distributed_random_access_iterator_trait<OutputIt>;
+  using args_t = reorder_args<InputIt, OutputIt>;
+
+  size_t n = std::distance(first, last);
+  auto d_last = std::next(d_first, n);
+  if (n == 0) return d_last;
+
+  auto pieces = itr_traits::distribution(d_first, d_last);
+  std::vector<std::vector<T>*> buffers(pieces.size());
+  rt::Handle h;
+  size_t k = 0;
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    args_t args{first,   n,       d_first,           k,       pieces[i].second,
+                shift,   reverse, num_tasks(policy), in_place};
+    rt::asyncExecuteAtWithRet(h, pieces[i].first,
+                              reorder_piece<InputIt, OutputIt>, args,
+                              &buffers[i]);
+    k += pieces[i].second;
+  }
+  rt::waitForCompletion(h);
+
+  if (in_place) {
+    k = 0;
+    for (size_t i = 0; i < pieces.size(); ++i) {
+      rt::asyncExecuteAt(h, pieces[i].first, write_buffer<OutputIt>,
+                         std::make_tuple(buffers[i], std::next(d_first, k)));
+      k += pieces[i].second;
+    }
+    rt::waitForCompletion(h);
+  }
+  return d_last;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// next_permutation: the last ascent of the range is found from a summary of
+// each portion, the successor of the pivot with a binary search on the
+// non-increasing suffix, and the suffix is then reversed.
+//
+////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+struct ascent_summary {
+  bool found;
+  size_t pos;
+  T front;
+  T back;
+};
+
+// the last ascent of a non-empty portion, and its first and last elements
+template <typename ForwardIt, typename Compare>
+void last_ascent(rt::Handle&,
+                 const std::tuple<ForwardIt, ForwardIt, Compare>& args,
+                 ascent_summary<typename ForwardIt::value_type>* res) {
+  using itr_traits = distributed_iterator_traits<ForwardIt>;
+  auto lrange = itr_traits::local_range(std::get<0>(args), std::get<1>(args));
+  auto comp = std::get<2>(args);
+  auto data = &*lrange.begin();
+  size_t size = std::distance(lrange.begin(), lrange.end());
+  res->found = false;
+  res->front = data[0];
+  res->back = data[size - 1];
+  for (size_t i = size - 1; i > 0; --i) {
+    if (comp(data[i - 1], data[i])) {
+      res->found = true;
+      res->pos = i - 1;
+      return;
+    }
+  }
+}
+
+template <typename T, typename Compare>
+struct inverse_compare {
+  bool operator()(const T& a, const T& b) const { return comp(b, a); }
+  Compare comp;
+};
+
+template <typename ExecutionPolicy, typename BidirIt, typename Compare>
+bool next_permutation(ExecutionPolicy&& policy, BidirIt first, BidirIt last,
+                      Compare comp) {
+  using T = typename BidirIt::value_type;
+  using itr_traits = distributed_random_access_iterator_trait<BidirIt>;
+  size_t n = std::distance(first, last);
+  if (n < 2) return false;
+
+  // the non-empty portions of the range
+  std::vector<std::pair<rt::Locality, size_t>> pieces;
+  std::vector<size_t> offsets;
+  size_t k = 0;
+  for (auto& piece : itr_traits::distribution(first, last)) {
+    if (piece.second != 0) {
+      pieces.push_back(piece);
+      offsets.push_back(k);
+    }
+    k += piece.second;
+  }
+
+  std::vector<ascent_summary<T>> summaries(pieces.size());
+  rt::Handle h;
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    auto p_first = std::next(first, offsets[i]);
+    rt::asyncExecuteAtWithRet(
+        h, pieces[i].first, last_ascent<BidirIt, Compare>,
+        std::make_tuple(p_first, std::next(p_first, pieces[i].second), comp),
+        &summaries[i]);
+  }
+  rt::waitForCompletion(h);
+
+  // the pivot is the last element that is less than its successor
+  size_t pivot = n;
+  for (size_t i = pieces.size(); i-- > 0 && pivot == n;) {
+    if (summaries[i].found)
+      pivot = offsets[i] + summaries[i].pos;
+    else if (i > 0 && comp(summaries[i - 1].back, summaries[i].front))
+      pivot = offsets[i] - 1;
+  }
+  if (pivot == n) {
+    reorder(policy, first, last, first, 0, true, true);
+    return false;
+  }
+
+  // the last element of the suffix that is greater than the pivot
+  auto pivot_it = std::next(first, pivot);
+  T pivot_value = *pivot_it;
+  size_t lo = pivot + 1, hi = n;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    T value = *std::next(first, mid);
+    if (comp(pivot_value, value))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  auto successor = std::next(first, lo - 1);
+  *pivot_it = T(*successor);
+  *successor = pivot_value;
+
+  reorder(policy, std::next(pivot_it), last, std::next(pivot_it), 0, true,
+          true);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// shuffle: every element is sent to a random portion of the range, chosen
+// with a counter-based generator, in a single bulk exchange.  Each portion
+// then shuffles the elements it received and writes them at the position of
+// its bucket in the output.  Any distribution of the buckets, followed by
+// uniform shuffles of the buckets, gives a uniform random permutation.
+//
+// Given a seed and a distribution of the range, the result does not depend
+// on the number of tasks used.
+//
+////////////////////////////////////////////////////////////////////////////////
+constexpr size_t kShuffleBlockSize = 1 << 16;
+constexpr size_t kMaxShuffleBlocks = 256;
+
+// counter-based generator (the splitmix64 finalizer)
+inline uint64_t random_at(uint64_t seed, uint64_t counter) {
+  uint64_t z = seed + (counter + 1) * 0x9e3779b97f4a7c15ull;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+// The bucket of the element at position base + i of a range of n elements:
+// buckets are chosen with probability proportional to their size, or
+// uniformly when no offsets are given.
+struct bucket_of {
+  size_t operator()(size_t i) const {
+    double u = (random_at(seed, base + i) >> 11) * 0x1.0p-53;
+    if (offsets == nullptr) return u * num_buckets;
+    size_t r = u * n;
+    return std::upper_bound(offsets, offsets + num_buckets, r) - offsets - 1;
+  }
+  uint64_t seed;
+  size_t base;
+  size_t n;
+  const size_t* offsets;
+  size_t num_buckets;
+};
+
+// Stable scatter of src into dst grouped by bucket; counts receives the size
+// of each bucket.  Tasks work on contiguous blocks of the input, so that the
+// result does not depend on their number.
+template <typename T>
+void scatter_to_buckets(const T* src, size_t n, T* dst, bucket_of bucket,
+                        size_t num_tasks, size_t* counts) {
+  size_t num_buckets = bucket.num_buckets;
+  if (num_buckets == 1) {
+    std::copy(src, src + n, dst);
+    counts[0] = n;
+    return;
+  }
+  num_tasks = std::max<size_t>(1, std::min(num_tasks, n));
+  std::vector<size_t> offsets(num_tasks * num_buckets, 0);
+
+  auto map_args =
+      std::make_tuple(src, n, dst, bucket, num_tasks, offsets.data(), false);
+  auto kernel = [](const decltype(map_args)& map_args, size_t t) {
+    auto src = std::get<0>(map_args);
+    auto n = std::get<1>(map_args);
+    auto bucket = std::get<3>(map_args);
+    auto num_tasks = std::get<4>(map_args);
+    auto offsets = std::get<5>(map_args) + t * bucket.num_buckets;
+    size_t b = t * n / num_tasks, e = (t + 1) * n / num_tasks;
+    if (!std::get<6>(map_args)) {
+      for (size_t i = b; i < e; ++i) ++offsets[bucket(i)];
+    } else {
+      auto dst = std::get<2>(map_args);
+      for (size_t i = b; i < e; ++i) dst[offsets[bucket(i)]++] = src[i];
+    }
+  };
+  rt::forEachAt(rt::thisLocality(), kernel, map_args, num_tasks);
+
+  size_t offset = 0;
+  for (size_t d = 0; d < num_buckets; ++d) {
+    counts[d] = 0;
+    for (size_t t = 0; t < num_tasks; ++t) {
+      auto count = offsets[t * num_buckets + d];
+      offsets[t * num_buckets + d] = offset;
+      offset += count;
+      counts[d] += count;
+    }
+  }
+  std::get<6>(map_args) = true;
+  rt::forEachAt(rt::thisLocality(), kernel, map_args, num_tasks);
+}
+
+// Uniform shuffle of a local buffer: large buffers are split in random
+// blocks, that are shuffled by different tasks.
+template <typename T>
+void local_shuffle(T* data, size_t n, uint64_t seed, size_t num_tasks) {
+  size_t num_blocks = std::min(n / kShuffleBlockSize, kMaxShuffleBlocks);
+  if (num_blocks < 2) {
+    std::mt19937_64 gen(seed);
+    std::shuffle(data, data + n, gen);
+    return;
+  }
+
+  std::vector<T> buffer(n);
+  std::vector<size_t> counts(num_blocks);
+  scatter_to_buckets(data, n, buffer.data(),
+                     bucket_of{seed, 0, n, nullptr, num_blocks}, num_tasks,
+                     counts.data());
+  std::vector<size_t> offsets(num_blocks + 1, 0);
+  for (size_t i = 0; i < num_blocks; ++i)
+    offsets[i + 1] = offsets[i] + counts[i];
+
+  auto map_args = std::make_tuple(buffer.data(), data, offsets.data(), seed);
+  rt::forEachAt(
+      rt::thisLocality(),
+      [](const decltype(map_args)& map_args, size_t i) {
+        auto src = std::get<0>(map_args);
+        auto dst = std::get<1>(map_args);
+        auto offsets = std::get<2>(map_args);
+        std::mt19937_64 gen(random_at(~std::get<3>(map_args), i));
+        std::shuffle(src + offsets[i], src + offsets[i + 1], gen);
+        std::copy(src + offsets[i], src + offsets[i + 1], dst + offsets[i]);
+      },
+      map_args, num_blocks);
+}
+
+// per-portion state of a shuffle
+template <typename T>
+struct shuffle_state {
+  std::vector<T> send;
+  std::vector<size_t> counts;
+  std::vector<T> recv;
+};
+
+template <typename T>
+struct shuffle_info {
+  shuffle_state<T>* state;
+  const size_t* counts;
+  T* recv;
+};
+
+// the portion [offset, offset + len) of the range, owned by the calling
+// locality, and the bucket offsets at the root
+template <typename RandomIt>
+struct shuffle_args {
+  RandomIt first;
+  size_t n;
+  size_t offset;
+  size_t len;
+  uint64_t seed;
+  rt::Locality root;
+  const size_t* offsets;
+  size_t num_buckets;
+  size_t num_tasks;
+};
+
+template <typename RandomIt>
+void shuffle_scatter(rt::Handle&, const shuffle_args<RandomIt>& args,
+                     shuffle_info<typename RandomIt::value_type>* res) {
+  using T = typename RandomIt::value_type;
+  using itr_traits = distributed_iterator_traits<RandomIt>;
+  auto p_first = std::next(args.first, args.offset);
+  auto lrange = itr_traits::local_range(p_first, std::next(p_first, args.len));
+  std::vector<size_t> offsets(args.num_buckets);
+  rt::dma(offsets.data(), args.root, args.offsets, args.num_buckets);
+
+  auto state = new shuffle_state<T>();
+  state->send.resize(args.len);
+  state->counts.resize(args.num_buckets);
+  scatter_to_buckets(&*lrange.begin(), args.len, state->send.data(),
+                     bucket_of{args.seed, args.offset, args.n, offsets.data(),
+                               args.num_buckets},
+                     args.num_tasks, state->counts.data());
+  *res = shuffle_info<T>{state, state->counts.data(), nullptr};
+}
+
+template <typename T>
+void shuffle_alloc(rt::Handle&,
+                   const std::pair<shuffle_state<T>*, size_t>& args,
+                   shuffle_info<T>* res) {
+  auto state = args.first;
+  state->recv.resize(args.second);
+  *res = shuffle_info<T>{state, state->counts.data(), state->recv.data()};
+}
+
+template <typename T>
+struct shuffle_target {
+  rt::Locality locality;
+  T* dst;
+};
+
+// send the buckets of a portion to their destinations
+template <typename T>
+void shuffle_send(rt::Handle&,
+                  const std::tuple<shuffle_state<T>*, rt::Locality,
+                                   const shuffle_target<T>*, size_t>& args) {
+  auto state = std::get<0>(args);
+  auto num_buckets = std::get<3>(args);
+  std::vector<shuffle_target<T>> targets(num_buckets);
+  rt::dma(targets.data(), std::get<1>(args), std::get<2>(args), num_buckets);
+
+  rt::Handle h;
+  const T* src = state->send.data();
+  for (size_t d = 0; d < num_buckets; ++d) {
+    auto count = state->counts[d];
+    if (count == 0) continue;
+    if (targets[d].locality == rt::thisLocality())
+      std::copy(src, src + count, targets[d].dst);
+    else
+      rt::asyncDma(h, targets[d].locality, targets[d].dst, src, count);
+    src += count;
+  }
+  rt::waitForCompletion(h);
+  std::vector<T>().swap(state->send);
+}
+
+// shuffle the received bucket and write it at position offset of the range
+template <typename RandomIt>
+void shuffle_write(
+    rt::Handle&,
+    const std::tuple<shuffle_state<typename RandomIt::value_type>*, RandomIt,
+                     size_t, uint64_t, size_t>& args) {
+  auto state = std::get<0>(args);
+  local_shuffle(state->recv.data(), state->recv.size(), std::get<3>(args),
+                std::get<4>(args));
+  write_to_range(state->recv.data(), state->recv.size(),
+                 std::next(std::get<1>(args), std::get<2>(args)));
+  delete state;
+}
+
+template <typename ExecutionPolicy, typename RandomIt>
+void shuffle(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+             uint64_t seed) {
+  using T = typename RandomIt::value_type;
+  using itr_traits = distributed_random_access_iterator_trait<RandomIt>;
+  size_t n = std::distance(first, last);
+  if (n < 2) return;
+
+  auto pieces = itr_traits::distribution(first, last);
+  size_t num_buckets = pieces.size();
+  std::vector<size_t> offsets(num_buckets);
+  for (size_t i = 1; i < num_buckets; ++i)
+    offsets[i] = offsets[i - 1] + pieces[i - 1].second;
+
+  // the buckets of each portion
+  std::vector<shuffle_info<T>> infos(num_buckets);
+  rt::Handle h;
+  for (size_t s = 0; s < num_buckets; ++s) {
+    shuffle_args<RandomIt> args{first,
+                                n,
+                                offsets[s],
+                                pieces[s].second,
+                                seed,
+                                rt::thisLocality(),
+                                offsets.data(),
+                                num_buckets,
+                                num_tasks(policy)};
+    rt::asyncExecuteAtWithRet(h, pieces[s].first, shuffle_scatter<RandomIt>,
+                              args, &infos[s]);
+  }
+  rt::waitForCompletion(h);
+  std::vector<size_t> counts(num_buckets * num_buckets);
+  for (size_t s = 0; s < num_buckets; ++s)
+    rt::asyncDma(h, counts.data() + s * num_buckets, pieces[s].first,
+                 infos[s].counts, num_buckets);
+  rt::waitForCompletion(h);
+
+  // allocate the receive buffers, and compute where each portion sends its
+  // buckets
+  std::vector<size_t> bucket_offsets(num_buckets + 1, 0);
+  for (size_t d = 0; d < num_buckets; ++d) {
+    size_t size = 0;
+    for (size_t s = 0; s < num_buckets; ++s)
+      size += counts[s * num_buckets + d];
+    bucket_offsets[d + 1] = bucket_offsets[d] + size;
+    rt::asyncExecuteAtWithRet(h, pieces[d].first, shuffle_alloc<T>,
+                              std::make_pair(infos[d].state, size), &infos[d]);
+  }
+  rt::waitForCompletion(h);
+  std::vector<shuffle_target<T>> targets(num_buckets * num_buckets);
+  for (size_t d = 0; d < num_buckets; ++d) {
+    T* dst = infos[d].recv;
+    for (size_t s = 0; s < num_buckets; ++s) {
+      targets[s * num_buckets + d] = shuffle_target<T>{pieces[d].first, dst};
+      dst += counts[s * num_buckets + d];
+    }
+  }
+
+  for (size_t s = 0; s < num_buckets; ++s) {
+    const shuffle_target<T>* row = targets.data() + s * num_buckets;
+    rt::asyncExecuteAt(h, pieces[s].first, shuffle_send<T>,
+                       std::make_tuple(infos[s].state, rt::thisLocality(), row,
+                                       num_buckets));
+  }
+  rt::waitForCompletion(h);
+
+  for (size_t d = 0; d < num_buckets; ++d)
+    rt::asyncExecuteAt(
+        h, pieces[d].first, shuffle_write<RandomIt>,
+        std::make_tuple(infos[d].state, first, bucket_offsets[d],
+                        random_at(~seed, d), num_tasks(policy)));
+  rt::waitForCompletion(h);
+}
+
+}  // namespace permutation_impl
+
+template <typename ExecutionPolicy, typename BidirIt>
+void reverse(ExecutionPolicy&& policy, BidirIt first, BidirIt last) {
+  permutation_impl::reorder(std::forward<ExecutionPolicy>(policy), first,
+                            last, first, 0, true, true);
+}
+
+template <typename ExecutionPolicy, typename BidirIt, typename OutputIt>
+OutputIt reverse_copy(ExecutionPolicy&& policy, BidirIt first, BidirIt last,
+                      OutputIt d_first) {
+  return permutation_impl::reorder(std::forward<ExecutionPolicy>(policy),
+                                   first, last, d_first, 0, true, false);
+}
+
+template <typename ExecutionPolicy, typename ForwardIt>
+ForwardIt rotate(ExecutionPolicy&& policy, ForwardIt first, ForwardIt middle,
+                 ForwardIt last) {
+  if (first == middle) return last;
+  if (middle == last) return first;
+  permutation_impl::reorder(std::forward<ExecutionPolicy>(policy), first, last,
+                            first, std::distance(first, middle), false, true);
+  return std::next(first, std::distance(middle, last));
+}
+
+template <typename ExecutionPolicy, typename ForwardIt, typename OutputIt>
+OutputIt rotate_copy(ExecutionPolicy&& policy, ForwardIt first,
+                     ForwardIt middle, ForwardIt last, OutputIt d_first) {
+  return permutation_impl::reorder(std::forward<ExecutionPolicy>(policy),
+                                   first, last, d_first,
+                                   std::distance(first, middle), false, false);
+}
+
+template <typename ExecutionPolicy, typename RandomIt, typename URBG>
+void shuffle(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+             URBG&& g) {
+  std::uniform_int_distribution<uint64_t> dist;
+  permutation_impl::shuffle(std::forward<ExecutionPolicy>(policy), first,
+                            last, dist(g));
+}
+
+template <typename ExecutionPolicy, typename BidirIt, typename Compare>
+bool next_permutation(ExecutionPolicy&& policy, BidirIt first, BidirIt last,
+                      Compare comp) {
+  return permutation_impl::next_permutation(
+      std::forward<ExecutionPolicy>(policy), first, last, comp);
+}
+
+template <typename ExecutionPolicy, typename BidirIt, typename Compare>
+bool prev_permutation(ExecutionPolicy&& policy, BidirIt first, BidirIt last,
+                      Compare comp) {
+  using T = typename BidirIt::value_type;
+  return permutation_impl::next_permutation(
+      std::forward<ExecutionPolicy>(policy), first, last,
+      permutation_impl::inverse_compare<T, Compare>{comp});
+}
 
 }  // namespace impl
 }  // namespace shad
@@ -28,13 +28,296 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "shad/core/execution.h"
+#include "shad/core/impl/impl_patterns.h"
+#include "shad/core/impl/other_ops_on_sorted_ranges.h"
 #include "shad/distributed_iterator_traits.h"
 #include "shad/runtime/runtime.h"
 
 namespace shad {
 namespace impl {
 
+namespace set_impl {
+
+// The set operations split the merge path of the two inputs in balanced
+// sub-problems, one for each task of each locality.  Split points are moved
+// backward to the first element of their run of equivalent elements, so that
+// each sub-problem can be solved independently with the sequential algorithm.
+// The sizes of the partial results are then scanned to compute their output
+// offsets, and each task writes its result with bulk transfers.
+
+template <typename It, typename T, typename Compare>
+size_t lower_bound_at(It first, size_t n, const T& value, Compare comp) {
+  size_t lo = 0, hi = n;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (comp(merge_impl::read_at(first, mid), value))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+// split of the merge path at position k that does not separate equivalent
+// elements
+template <typename It1, typename It2, typename Compare>
+std::pair<size_t, size_t> set_co_rank(size_t k, It1 first1, size_t n1,
+                                      It2 first2, size_t n2, Compare comp) {
+  if (k >= n1 + n2) return std::make_pair(n1, n2);
+  size_t i = merge_impl::co_rank(k, first1, n1, first2, n2, comp);
+  size_t j = k - i;
+
+  // the first element after the split; ties are taken from the first range
+  typename std::iterator_traits<It1>::value_type pivot{};
+  if (i < n1) pivot = merge_impl::read_at(first1, i);
+  if (j < n2) {
+    auto b = merge_impl::read_at(first2, j);
+    if (i == n1 || comp(b, pivot)) pivot = b;
+  }
+  return std::make_pair(lower_bound_at(first1, i, pivot, comp),
+                        lower_bound_at(first2, j, pivot, comp));
+}
+
+struct union_op {
+  template <typename It1, typename It2, typename OutputIt, typename Compare>
+  static OutputIt apply(It1 first1, It1 last1, It2 first2, It2 last2,
+                        OutputIt d_first, Compare comp) {
+    return std::set_union(first1, last1, first2, last2, d_first, comp);
+  }
+};
+
+struct intersection_op {
+  template <typename It1, typename It2, typename OutputIt, typename Compare>
+  static OutputIt apply(It1 first1, It1 last1, It2 first2, It2 last2,
+                        OutputIt d_first, Compare comp) {
+    return std::set_intersection(first1, last1, first2, last2, d_first, comp);
+  }
+};
+
+struct difference_op {
+  template <typename It1, typename It2, typename OutputIt, typename Compare>
+  static OutputIt apply(It1 first1, It1 last1, It2 first2, It2 last2,
+                        OutputIt d_first, Compare comp) {
+    return std::set_difference(first1, last1, first2, last2, d_first, comp);
+  }
+};
+
+// Sub-problem of a set operation: the positions [k, k + len) of the merge
+// path and the iterators to the input ranges.
+template <typename It1, typename It2, typename Compare>
+struct set_args {
+  It1 first1;
+  size_t n1;
+  It2 first2;
+  size_t n2;
+  size_t k;
+  size_t len;
+  Compare comp;
+  size_t num_tasks;
+  bool count_only;
+};
+
+template <typename T>
+struct set_state {
+  std::vector<std::vector<T>> results;  // one for each task
+  std::vector<size_t> sizes;            // one for each task
+};
+
+// output iterator that counts the elements assigned through it
+class count_iterator {
+ public:
+  using iterator_category = std::output_iterator_tag;
+  using value_type = void;
+  using difference_type = void;
+  using pointer = void;
+  using reference = void;
+
+  explicit count_iterator(size_t* count) : count_(count) {}
+
+  template <typename T>
+  count_iterator& operator=(const T&) {
+    ++*count_;
+    return *this;
+  }
+  count_iterator& operator*() { return *this; }
+  count_iterator& operator++() { return *this; }
+  count_iterator operator++(int) { return *this; }
+
+ private:
+  size_t* count_;
+};
+
+template <typename T>
+struct set_counts {
+  set_state<T>* state;
+  size_t count;
+};
+
+template <typename Op, typename It1, typename It2, typename Compare>
+void set_op_portion(rt::Handle&, const set_args<It1, It2, Compare>& args,
+                    set_counts<typename It1::value_type>* res) {
+  using T = typename It1::value_type;
+  using args_t = set_args<It1, It2, Compare>;
+  auto num_tasks = std::max<size_t>(1, std::min(args.num_tasks, args.len));
+  auto state = new set_state<T>();
+  state->results.resize(num_tasks);
+  state->sizes.resize(num_tasks, 0);
+
+  auto map_args = std::make_tuple(args, state, num_tasks);
+  rt::forEachAt(
+      rt::thisLocality(),
+      [](const std::tuple<args_t, set_state<T>*, size_t>& map_args,
+         size_t i) {
+        auto& args = std::get<0>(map_args);
+        auto num_tasks = std::get<2>(map_args);
+        auto k0 = args.k + i * args.len / num_tasks;
+        auto k1 = args.k + (i + 1) * args.len / num_tasks;
+        auto begin = set_co_rank(k0, args.first1, args.n1, args.first2,
+                                 args.n2, args.comp);
+        auto end = set_co_rank(k1, args.first1, args.n1, args.first2,
+                               args.n2, args.comp);
+
+        std::vector<T> a(end.first - begin.first);
+        std::vector<typename It2::value_type> b(end.second - begin.second);
+        read_from_range(std::next(args.first1, begin.first), a.size(),
+                        a.data());
+        read_from_range(std::next(args.first2, begin.second), b.size(),
+                        b.data());
+        auto state = std::get<1>(map_args);
+        if (args.count_only) {
+          // advance the merge without materializing the result
+          Op::apply(a.begin(), a.end(), b.begin(), b.end(),
+                    count_iterator(&state->sizes[i]), args.comp);
+        } else {
+          auto& result = state->results[i];
+          Op::apply(a.begin(), a.end(), b.begin(), b.end(),
+                    std::back_inserter(result), args.comp);
+          state->sizes[i] = result.size();
+        }
+      },
+      map_args, num_tasks);
+
+  res->count = 0;
+  for (auto size : state->sizes) res->count += size;
+  if (args.count_only) {
+    delete state;
+    state = nullptr;
+  }
+  res->state = state;
+}
+
+template <typename OutputIt>
+void write_set_portion(
+    rt::Handle&,
+    const std::tuple<set_state<typename OutputIt::value_type>*, OutputIt>&
+        args) {
+  using T = typename OutputIt::value_type;
+  auto state = std::get<0>(args);
+  std::vector<size_t> offsets(state->results.size(), 0);
+  for (size_t i = 1; i < offsets.size(); ++i)
+    offsets[i] = offsets[i - 1] + state->results[i - 1].size();
+
+  auto map_args = std::make_tuple(state, offsets.data(), std::get<1>(args));
+  rt::forEachAt(
+      rt::thisLocality(),
+      [](const std::tuple<set_state<T>*, size_t*, OutputIt>& map_args,
+         size_t i) {
+        auto& result = std::get<0>(map_args)->results[i];
+        write_to_range(result.data(), result.size(),
+                       std::next(std::get<2>(map_args),
+                                 std::get<1>(map_args)[i]));
+      },
+      map_args, offsets.size());
+  delete state;
+}
+
+// first pass: solve the sub-problems and count the partial results
+template <typename Op, typename ExecutionPolicy, typename It1, typename It2,
+          typename Compare>
+std::vector<set_counts<typename It1::value_type>> set_op_counts(
+    ExecutionPolicy&& policy, It1 first1, It1 last1, It2 first2, It2 last2,
+    Compare comp, bool count_only) {
+  size_t n1 = std::distance(first1, last1);
+  size_t n2 = std::distance(first2, last2);
+  size_t n = n1 + n2;
+  auto num_localities = rt::numLocalities();
+  std::vector<set_counts<typename It1::value_type>> counts(num_localities);
+
+  rt::Handle h;
+  for (uint32_t l = 0; l < num_localities; ++l) {
+    size_t k = l * n / num_localities;
+    size_t len = (l + 1) * n / num_localities - k;
+    set_args<It1, It2, Compare> args{
+        first1, n1, first2, n2, k, len, comp, num_tasks(policy), count_only};
+    rt::asyncExecuteAtWithRet(h, rt::Locality(l),
+                              set_op_portion<Op, It1, It2, Compare>, args,
+                              &counts[l]);
+  }
+  rt::waitForCompletion(h);
+  return counts;
+}
+
+template <typename Op, typename ExecutionPolicy, typename It1, typename It2,
+          typename OutputIt, typename Compare>
+OutputIt set_op(ExecutionPolicy&& policy, It1 first1, It1 last1, It2 first2,
+                It2 last2, OutputIt d_first, Compare comp) {
+  auto counts = set_op_counts<Op>(std::forward<ExecutionPolicy>(policy),
+                                  first1, last1, first2, last2, comp, false);
+
+  // second pass: write the partial results
+  rt::Handle h;
+  size_t offset = 0;
+  for (uint32_t l = 0; l < counts.size(); ++l) {
+    rt::asyncExecuteAt(
+        h, rt::Locality(l), write_set_portion<OutputIt>,
+        std::make_tuple(counts[l].state, std::next(d_first, offset)));
+    offset += counts[l].count;
+  }
+  rt::waitForCompletion(h);
+  return std::next(d_first, offset);
+}
+
+}  // namespace set_impl
+
+// [first2, last2) is included in [first1, last1) iff their difference is empty
+template <typename ExecutionPolicy, typename InputIt1, typename InputIt2,
+          typename Compare>
+bool includes(ExecutionPolicy&& policy, InputIt1 first1, InputIt1 last1,
+              InputIt2 first2, InputIt2 last2, Compare comp) {
+  auto counts = set_impl::set_op_counts<set_impl::difference_op>(
+      std::forward<ExecutionPolicy>(policy), first2, last2, first1, last1,
+      comp, true);
+  return std::all_of(
+      counts.begin(), counts.end(),
+      [](const set_impl::set_counts<typename InputIt2::value_type>& c) {
+        return c.count == 0;
+      });
+}
+
+template <typename ExecutionPolicy, typename InputIt1, typename InputIt2,
+          typename OutputIt, typename Compare>
+OutputIt set_union(ExecutionPolicy&& policy, InputIt1 first1, InputIt1 last1,
+                   InputIt2 first2, InputIt2 last2, OutputIt d_first,
+                   Compare comp) {
+  return set_impl::set_op<set_impl::union_op>(
+      std::forward<ExecutionPolicy>(policy), first1, last1, first2, last2,
+      d_first, comp);
+}
+
+template <typename ExecutionPolicy, typename InputIt1, typename InputIt2,
+          typename OutputIt, typename Compare>
+OutputIt set_intersection(ExecutionPolicy&& policy, InputIt1 first1,
+                          InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                          OutputIt d_first, Compare comp) {
+  return set_impl::set_op<set_impl::intersection_op>(
+      std::forward<ExecutionPolicy>(policy), first1, last1, first2, last2,
+      d_first, comp);
+}
 
 }  // namespace impl
 }  // namespace shad
@@ -28,13 +28,707 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include "shad/core/execution.h"
+#include "shad/core/impl/heap_ops.h"
+#include "shad/core/impl/impl_patterns.h"
 #include "shad/distributed_iterator_traits.h"
 #include "shad/runtime/runtime.h"
 
 namespace shad {
 namespace impl {
 
+namespace sort_impl {
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// local sorting
+//
+////////////////////////////////////////////////////////////////////////////////
+// merge adjacent sorted runs, in parallel, until a single run is left.
+// bounds holds the boundaries of the runs (i.e., number of runs + 1 entries).
+template <typename T, typename Compare>
+void merge_runs(T* data, std::vector<size_t> bounds, Compare comp) {
+  while (bounds.size() > 2) {
+    size_t num_pairs = (bounds.size() - 1) / 2;
+    auto merge_args = std::make_tuple(data, bounds.data(), comp);
+    rt::forEachAt(
+        rt::thisLocality(),
+        [](const decltype(merge_args)& merge_args, size_t i) {
+          auto data = std::get<0>(merge_args);
+          auto b = std::get<1>(merge_args) + 2 * i;
+          std::inplace_merge(data + b[0], data + b[1], data + b[2],
+                             std::get<2>(merge_args));
+        },
+        merge_args, num_pairs);
+
+    std::vector<size_t> next;
+    for (size_t i = 0; i < bounds.size(); i += 2) next.push_back(bounds[i]);
+    if (next.back() != bounds.back()) next.push_back(bounds.back());
+    bounds.swap(next);
+  }
+}
+
+template <bool stable, typename T, typename Compare>
+void local_sort(distributed_sequential_tag, T* first, T* last,
+                Compare comp) {
+  if (stable)
+    std::stable_sort(first, last, comp);
+  else
+    std::sort(first, last, comp);
+}
+
+// sort each partition of the range in parallel, then merge the partitions
+template <bool stable, typename T, typename Compare>
+void local_sort(distributed_parallel_tag, T* first, T* last, Compare comp) {
+  auto parts = local_iterator_traits<T*>::partitions(
+      first, last, rt::impl::getConcurrency());
+  if (parts.size() < 2) {
+    local_sort<stable>(distributed_sequential_tag{}, first, last, comp);
+    return;
+  }
+
+  local_map_void(first, last, [&](T* b, T* e) {
+    local_sort<stable>(distributed_sequential_tag{}, b, e, comp);
+  });
+
+  std::vector<size_t> bounds;
+  for (auto& part : parts) bounds.push_back(std::distance(first, part.begin()));
+  bounds.push_back(std::distance(first, last));
+  merge_runs(first, std::move(bounds), comp);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// distribution sort skeleton: every locality splits its local portion into
+// one run per destination (bucket), gathers and sorts its bucket, and writes
+// it back at its final position.
+//
+////////////////////////////////////////////////////////////////////////////////
+// per-locality state, alive for the duration of a sort
+template <typename T>
+struct sort_state {
+  std::vector<T> input;               // local portion
+  std::vector<T> splitters;           // sample sort splitters
+  std::vector<size_t> bin_bounds;     // radix sort bins of each bucket
+  std::vector<size_t> histogram;      // radix sort bin histogram
+  std::vector<sort_state<T>*> peers;  // states of all the localities
+  std::vector<size_t> bounds;         // bucket boundaries in input
+  std::vector<T> bucket;              // bucket of the locality
+};
+
+template <typename T>
+struct sort_run {
+  const T* data;
+  size_t size;
+};
+
+// copy the runs of the bucket of the calling locality from all the
+// localities, and return the boundaries of the runs
+template <typename T>
+std::vector<size_t> fetch_bucket(sort_state<T>* state) {
+  auto num_localities = rt::numLocalities();
+  std::vector<sort_run<T>> runs(num_localities);
+
+  rt::Handle h;
+  for (uint32_t s = 0; s < num_localities; ++s) {
+    auto run_args = std::make_pair(state->peers[s],
+                                   static_cast<uint32_t>(rt::thisLocality()));
+    rt::asyncExecuteAtWithRet(
+        h, rt::Locality(s),
+        [](rt::Handle&, const decltype(run_args)& run_args, sort_run<T>* res) {
+          auto peer = run_args.first;
+          auto d = run_args.second;
+          res->data = peer->input.data() + peer->bounds[d];
+          res->size = peer->bounds[d + 1] - peer->bounds[d];
+        },
+        run_args, &runs[s]);
+  }
+  rt::waitForCompletion(h);
+
+  std::vector<size_t> bounds(1, 0);
+  for (auto& run : runs) bounds.push_back(bounds.back() + run.size);
+  state->bucket.resize(bounds.back());
+  for (uint32_t s = 0; s < num_localities; ++s) {
+    if (runs[s].size == 0) continue;
+    rt::asyncDma(h, state->bucket.data() + bounds[s], rt::Locality(s),
+                 runs[s].data, runs[s].size);
+  }
+  rt::waitForCompletion(h);
+  return bounds;
+}
+
+// write the bucket of the calling locality at its final position
+template <typename RandomIt>
+void write_bucket(
+    rt::Handle&,
+    const std::tuple<sort_state<typename RandomIt::value_type>*,
+                     RandomIt, size_t>& args) {
+  auto state = std::get<0>(args);
+  write_to_range(state->bucket.data(), state->bucket.size(),
+                 std::next(std::get<1>(args), std::get<2>(args)));
+  delete state;
+}
+
+// write the buckets back to the range starting at first
+template <typename RandomIt>
+void write_buckets(
+    RandomIt first,
+    const std::vector<sort_state<typename RandomIt::value_type>*>& states,
+    const std::vector<size_t>& bucket_sizes) {
+  rt::Handle h;
+  size_t offset = 0;
+  for (uint32_t l = 0; l < states.size(); ++l) {
+    rt::asyncExecuteAt(h, rt::Locality(l), write_bucket<RandomIt>,
+                       std::make_tuple(states[l], first, offset));
+    offset += bucket_sizes[l];
+  }
+  rt::waitForCompletion(h);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// sample sort
+//
+////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+struct sample_sort_samples {
+  static constexpr size_t kNumSamples = 64;
+  sort_state<T>* state;
+  T* splitters;
+  sort_state<T>** peers;
+  size_t weight;  // number of input elements represented by each sample
+  size_t size;
+  T samples[kNumSamples];
+};
+
+// sort the local portion of [first, last) and return regularly spaced samples
+template <typename policy_t, bool stable, typename RandomIt, typename Compare>
+void sample_local_portion(
+    rt::Handle&, const std::tuple<RandomIt, RandomIt, Compare>& args,
+    sample_sort_samples<typename RandomIt::value_type>* res) {
+  using T = typename RandomIt::value_type;
+  using itr_traits = distributed_iterator_traits<RandomIt>;
+  auto lrange = itr_traits::local_range(std::get<0>(args), std::get<1>(args));
+
+  auto state = new sort_state<T>();
+  state->input.assign(lrange.begin(), lrange.end());
+  state->splitters.resize(rt::numLocalities() - 1);
+  state->peers.resize(rt::numLocalities());
+  local_sort<stable>(policy_t{}, state->input.data(),
+                     state->input.data() + state->input.size(),
+                     std::get<2>(args));
+
+  res->state = state;
+  res->splitters = state->splitters.data();
+  res->peers = state->peers.data();
+  size_t n = state->input.size();
+  res->size = std::min(n, sample_sort_samples<T>::kNumSamples);
+  res->weight = res->size ? n / res->size : 0;
+  for (size_t i = 0; i < res->size; ++i)
+    res->samples[i] = state->input[(2 * i + 1) * n / (2 * res->size)];
+}
+
+// pick numLocalities() - 1 splitters at the weighted quantiles of the samples
+template <typename T, typename Compare>
+std::vector<T> select_splitters(
+    const std::vector<sample_sort_samples<T>>& samples, Compare comp) {
+  std::vector<std::pair<T, size_t>> pool;
+  size_t total = 0;
+  for (auto& s : samples) {
+    for (size_t i = 0; i < s.size; ++i) {
+      pool.emplace_back(s.samples[i], s.weight);
+      total += s.weight;
+    }
+  }
+  std::sort(pool.begin(), pool.end(),
+            [&](const std::pair<T, size_t>& a, const std::pair<T, size_t>& b) {
+              return comp(a.first, b.first);
+            });
+
+  std::vector<T> splitters;
+  size_t acc = 0;
+  auto p = pool.begin();
+  for (size_t d = 1; d < samples.size(); ++d) {
+    size_t target = total * d / samples.size();
+    while (p != pool.end() && acc + p->second <= target) acc += (p++)->second;
+    splitters.push_back(p != pool.end() ? p->first : pool.back().first);
+  }
+  return splitters;
+}
+
+// find the boundaries of the buckets in the sorted local portion
+template <typename T, typename Compare>
+void split_local_portion(
+    rt::Handle&, const std::tuple<sort_state<T>*, Compare>& args) {
+  auto state = std::get<0>(args);
+  auto& input = state->input;
+  state->bounds.push_back(0);
+  for (auto& splitter : state->splitters) {
+    auto it = std::upper_bound(input.begin() + state->bounds.back(),
+                               input.end(), splitter, std::get<1>(args));
+    state->bounds.push_back(std::distance(input.begin(), it));
+  }
+  state->bounds.push_back(input.size());
+}
+
+// gather the bucket of the calling locality and merge its sorted runs
+template <typename T, typename Compare>
+void merge_bucket(rt::Handle&,
+                  const std::tuple<sort_state<T>*, Compare>& args,
+                  size_t* bucket_size) {
+  auto state = std::get<0>(args);
+  auto bounds = fetch_bucket(state);
+  merge_runs(state->bucket.data(), std::move(bounds), std::get<1>(args));
+  *bucket_size = state->bucket.size();
+}
+
+/// @brief Distributed sample sort.
+///
+/// Each locality sorts its portion of the range (in parallel, depending on
+/// the policy); splitters are selected from regular samples of the sorted
+/// portions; each locality gathers the elements falling in its bucket from
+/// all the localities and merges them; finally, the buckets are written back
+/// to the range.
+///
+/// Sorting is stable when stable is true: equivalent elements land in the
+/// same bucket, and runs are merged in the order of the localities.
+template <bool stable, typename ExecutionPolicy, typename RandomIt,
+          typename Compare>
+void sample_sort(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+                 Compare comp) {
+  using T = typename RandomIt::value_type;
+  using policy_t = typename std::decay<ExecutionPolicy>::type;
+  using itr_traits = distributed_iterator_traits<RandomIt>;
+  static_assert(
+      std::is_pointer<typename itr_traits::local_iterator_type>::value,
+      "sorting requires ranges with contiguous local portions");
+
+  if (first == last) return;
+
+  // ranges mapped on a single locality are sorted in place
+  auto localities = itr_traits::localities(first, last);
+  if (localities.size() == 1) {
+    rt::executeAt(
+        localities.begin(),
+        [](const std::tuple<RandomIt, RandomIt, Compare>& args) {
+          auto lrange =
+              itr_traits::local_range(std::get<0>(args), std::get<1>(args));
+          local_sort<stable>(policy_t{}, lrange.begin(), lrange.end(),
+                             std::get<2>(args));
+        },
+        std::make_tuple(first, last, comp));
+    return;
+  }
+
+  // local sort and sampling
+  auto num_localities = rt::numLocalities();
+  std::vector<sample_sort_samples<T>> samples(num_localities);
+  rt::Handle h;
+  for (uint32_t l = 0; l < num_localities; ++l)
+    rt::asyncExecuteAtWithRet(h, rt::Locality(l),
+                              sample_local_portion<policy_t, stable, RandomIt,
+                                                   Compare>,
+                              std::make_tuple(first, last, comp), &samples[l]);
+  rt::waitForCompletion(h);
+
+  // splitters and peers distribution
+  auto splitters = select_splitters(samples, comp);
+  std::vector<sort_state<T>*> states;
+  for (auto& s : samples) states.push_back(s.state);
+  for (uint32_t l = 0; l < num_localities; ++l) {
+    rt::asyncDma(h, rt::Locality(l), samples[l].splitters, splitters.data(),
+                 splitters.size());
+    rt::asyncDma(h, rt::Locality(l), samples[l].peers, states.data(),
+                 states.size());
+  }
+  rt::waitForCompletion(h);
+
+  for (uint32_t l = 0; l < num_localities; ++l)
+    rt::asyncExecuteAt(h, rt::Locality(l), split_local_portion<T, Compare>,
+                       std::make_tuple(states[l], comp));
+  rt::waitForCompletion(h);
+
+  // all-to-all exchange and merge
+  std::vector<size_t> bucket_sizes(num_localities);
+  for (uint32_t l = 0; l < num_localities; ++l)
+    rt::asyncExecuteAtWithRet(h, rt::Locality(l), merge_bucket<T, Compare>,
+                              std::make_tuple(states[l], comp),
+                              &bucket_sizes[l]);
+  rt::waitForCompletion(h);
+
+  write_buckets(first, states, bucket_sizes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// radix sort
+//
+////////////////////////////////////////////////////////////////////////////////
+constexpr size_t kRadixBits = 8;
+constexpr size_t kRadix = size_t(1) << kRadixBits;
+// number of bins (of the most significant digits) used to split the range
+constexpr size_t kRadixBinBits = 12;
+constexpr size_t kRadixBins = size_t(1) << kRadixBinBits;
+// minimum number of elements processed by a task of the local radix sort
+constexpr size_t kRadixMinPartition = 1 << 14;
+
+struct identity_key {
+  template <typename T>
+  const T& operator()(const T& x) const {
+    return x;
+  }
+};
+
+template <typename T, typename KeyFn>
+using radix_key_t = typename std::decay<
+    typename std::result_of<KeyFn&(const T&)>::type>::type;
+
+template <typename T, typename KeyFn>
+using radix_unsigned_t =
+    typename std::make_unsigned<radix_key_t<T, KeyFn>>::type;
+
+// map keys to unsigned integers preserving their order
+template <typename T, typename KeyFn>
+radix_unsigned_t<T, KeyFn> radix_unsigned(const T& x, KeyFn& key) {
+  using K = radix_key_t<T, KeyFn>;
+  using U = radix_unsigned_t<T, KeyFn>;
+  static_assert(std::is_integral<K>::value,
+                "radix_sort requires integral keys");
+  U u = static_cast<U>(key(x));
+  if (std::is_signed<K>::value) u ^= U(1) << (8 * sizeof(U) - 1);
+  return u;
+}
+
+// LSD radix sort: num_parts tasks build the digit histograms of their
+// partition and scatter it at the offsets given by the global prefix sum, so
+// every pass is stable.  Passes on digits shared by all keys are skipped.
+template <typename T, typename KeyFn>
+void local_radix_sort(size_t num_parts, T* first, T* last, KeyFn key) {
+  using U = radix_unsigned_t<T, KeyFn>;
+  size_t n = std::distance(first, last);
+  if (n < 2) return;
+  num_parts = std::max<size_t>(1, std::min(num_parts, n / kRadixMinPartition));
+
+  std::vector<T> tmp(n);
+  std::vector<size_t> hist(num_parts * kRadix);
+  T* src = first;
+  T* dst = tmp.data();
+  for (size_t shift = 0; shift < 8 * sizeof(U); shift += kRadixBits) {
+    std::fill(hist.begin(), hist.end(), 0);
+    auto pass_args =
+        std::make_tuple(src, dst, n, num_parts, shift, hist.data(), key);
+    using pass_args_t = decltype(pass_args);
+
+    rt::forEachAt(
+        rt::thisLocality(),
+        [](const pass_args_t& args, size_t q) {
+          auto src = std::get<0>(args);
+          auto n = std::get<2>(args);
+          auto num_parts = std::get<3>(args);
+          auto shift = std::get<4>(args);
+          auto hist = std::get<5>(args) + q * kRadix;
+          auto key = std::get<6>(args);
+          for (size_t i = q * n / num_parts, e = (q + 1) * n / num_parts;
+               i < e; ++i)
+            ++hist[(radix_unsigned(src[i], key) >> shift) & (kRadix - 1)];
+        },
+        pass_args, num_parts);
+
+    // exclusive prefix sum in (digit, partition) order
+    bool trivial = false;
+    size_t sum = 0;
+    for (size_t d = 0; d < kRadix; ++d) {
+      size_t digit_begin = sum;
+      for (size_t q = 0; q < num_parts; ++q) {
+        size_t count = hist[q * kRadix + d];
+        hist[q * kRadix + d] = sum;
+        sum += count;
+      }
+      if (sum - digit_begin == n) trivial = true;
+    }
+    if (trivial) continue;
+
+    rt::forEachAt(
+        rt::thisLocality(),
+        [](const pass_args_t& args, size_t q) {
+          auto src = std::get<0>(args);
+          auto dst = std::get<1>(args);
+          auto n = std::get<2>(args);
+          auto num_parts = std::get<3>(args);
+          auto shift = std::get<4>(args);
+          auto offsets = std::get<5>(args) + q * kRadix;
+          auto key = std::get<6>(args);
+          for (size_t i = q * n / num_parts, e = (q + 1) * n / num_parts;
+               i < e; ++i)
+            dst[offsets[(radix_unsigned(src[i], key) >> shift) &
+                        (kRadix - 1)]++] = src[i];
+        },
+        pass_args, num_parts);
+    std::swap(src, dst);
+  }
+  if (src != first) std::copy(src, src + n, first);
+}
+
+template <typename T, typename KeyFn>
+void local_radix_sort(distributed_sequential_tag, T* first, T* last,
+                      KeyFn key) {
+  local_radix_sort(1, first, last, key);
+}
+
+template <typename T, typename KeyFn>
+void local_radix_sort(distributed_parallel_tag, T* first, T* last, KeyFn key) {
+  local_radix_sort(rt::impl::getConcurrency(), first, last, key);
+}
+
+template <typename T, typename KeyFn>
+struct radix_sort_info {
+  sort_state<T>* state;
+  size_t* bin_bounds;
+  sort_state<T>** peers;
+  size_t size;
+  radix_unsigned_t<T, KeyFn> min_key;
+  radix_unsigned_t<T, KeyFn> max_key;
+};
+
+// the bin of a key: its most significant digits, relative to the minimum
+template <typename U>
+struct radix_bins {
+  U min_key;
+  size_t shift;
+  size_t operator()(U key) const {
+    return std::min<size_t>((key - min_key) >> shift, kRadixBins - 1);
+  }
+};
+
+// copy the local portion of [first, last) and compute its key range
+template <typename RandomIt, typename KeyFn>
+void radix_local_portion(
+    rt::Handle&, const std::tuple<RandomIt, RandomIt, KeyFn>& args,
+    radix_sort_info<typename RandomIt::value_type, KeyFn>* res) {
+  using T = typename RandomIt::value_type;
+  using itr_traits = distributed_iterator_traits<RandomIt>;
+  auto lrange = itr_traits::local_range(std::get<0>(args), std::get<1>(args));
+  auto key = std::get<2>(args);
+
+  auto state = new sort_state<T>();
+  state->input.assign(lrange.begin(), lrange.end());
+  state->bin_bounds.resize(rt::numLocalities() - 1);
+  state->peers.resize(rt::numLocalities());
+
+  res->state = state;
+  res->bin_bounds = state->bin_bounds.data();
+  res->peers = state->peers.data();
+  res->size = state->input.size();
+  res->min_key = std::numeric_limits<decltype(res->min_key)>::max();
+  res->max_key = 0;
+  for (auto& x : state->input) {
+    auto k = radix_unsigned(x, key);
+    res->min_key = std::min(res->min_key, k);
+    res->max_key = std::max(res->max_key, k);
+  }
+}
+
+// histogram of the bins of the local portion
+template <typename T, typename KeyFn>
+void radix_histogram(
+    rt::Handle&,
+    const std::tuple<sort_state<T>*, KeyFn,
+                     radix_bins<radix_unsigned_t<T, KeyFn>>>& args,
+    const size_t** res) {
+  auto state = std::get<0>(args);
+  auto key = std::get<1>(args);
+  auto bins = std::get<2>(args);
+  state->histogram.assign(kRadixBins, 0);
+  for (auto& x : state->input) ++state->histogram[bins(radix_unsigned(x, key))];
+  *res = state->histogram.data();
+}
+
+// stable partition of the local portion by destination locality
+template <typename T, typename KeyFn>
+void radix_split(
+    rt::Handle&,
+    const std::tuple<sort_state<T>*, KeyFn,
+                     radix_bins<radix_unsigned_t<T, KeyFn>>>& args) {
+  auto state = std::get<0>(args);
+  auto key = std::get<1>(args);
+  auto bins = std::get<2>(args);
+  auto& bin_bounds = state->bin_bounds;
+  auto destination = [&](const T& x) {
+    return std::distance(bin_bounds.begin(),
+                         std::upper_bound(bin_bounds.begin(), bin_bounds.end(),
+                                          bins(radix_unsigned(x, key))));
+  };
+
+  state->bounds.assign(rt::numLocalities() + 1, 0);
+  for (auto& x : state->input) ++state->bounds[destination(x) + 1];
+  for (size_t d = 1; d < state->bounds.size(); ++d)
+    state->bounds[d] += state->bounds[d - 1];
+
+  std::vector<size_t> offsets(state->bounds);
+  std::vector<T> split(state->input.size());
+  for (auto& x : state->input) split[offsets[destination(x)]++] = x;
+  state->input.swap(split);
+}
+
+// gather the bucket of the calling locality and radix sort it
+template <typename policy_t, typename T, typename KeyFn>
+void radix_bucket(rt::Handle&, const std::tuple<sort_state<T>*, KeyFn>& args,
+                  size_t* bucket_size) {
+  auto state = std::get<0>(args);
+  fetch_bucket(state);
+  local_radix_sort(policy_t{}, state->bucket.data(),
+                   state->bucket.data() + state->bucket.size(),
+                   std::get<1>(args));
+  *bucket_size = state->bucket.size();
+}
+
+/// @brief Distributed radix sort.
+///
+/// The range is split among the localities by the most significant digits
+/// of the keys: a global histogram of kRadixBins bins, spanning the key range
+/// of the input, is used to assign contiguous bins to each locality so that
+/// buckets have similar sizes.  Every locality gathers its bucket and sorts it
+/// with a parallel LSD radix sort.  The sort is stable.
+template <typename ExecutionPolicy, typename RandomIt, typename KeyFn>
+void radix_sort(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+                KeyFn key) {
+  using T = typename RandomIt::value_type;
+  using U = radix_unsigned_t<T, KeyFn>;
+  using policy_t = typename std::decay<ExecutionPolicy>::type;
+  using itr_traits = distributed_iterator_traits<RandomIt>;
+  static_assert(
+      std::is_pointer<typename itr_traits::local_iterator_type>::value,
+      "sorting requires ranges with contiguous local portions");
+
+  if (first == last) return;
+
+  // ranges mapped on a single locality are sorted in place
+  auto localities = itr_traits::localities(first, last);
+  if (localities.size() == 1) {
+    rt::executeAt(
+        localities.begin(),
+        [](const std::tuple<RandomIt, RandomIt, KeyFn>& args) {
+          auto lrange =
+              itr_traits::local_range(std::get<0>(args), std::get<1>(args));
+          local_radix_sort(policy_t{}, lrange.begin(), lrange.end(),
+                           std::get<2>(args));
+        },
+        std::make_tuple(first, last, key));
+    return;
+  }
+
+  // local copy and key range
+  auto num_localities = rt::numLocalities();
+  std::vector<radix_sort_info<T, KeyFn>> info(num_localities);
+  rt::Handle h;
+  for (uint32_t l = 0; l < num_localities; ++l)
+    rt::asyncExecuteAtWithRet(h, rt::Locality(l),
+                              radix_local_portion<RandomIt, KeyFn>,
+                              std::make_tuple(first, last, key), &info[l]);
+  rt::waitForCompletion(h);
+
+  radix_bins<U> bins{std::numeric_limits<U>::max(), 0};
+  U max_key = 0;
+  std::vector<sort_state<T>*> states;
+  for (auto& i : info) {
+    states.push_back(i.state);
+    if (i.size == 0) continue;
+    bins.min_key = std::min(bins.min_key, i.min_key);
+    max_key = std::max(max_key, i.max_key);
+  }
+  for (U range = max_key - bins.min_key; range >> bins.shift >= kRadixBins;)
+    ++bins.shift;
+
+  // global histogram of the bins
+  std::vector<const size_t*> histograms(num_localities);
+  for (uint32_t l = 0; l < num_localities; ++l)
+    rt::asyncExecuteAtWithRet(h, rt::Locality(l), radix_histogram<T, KeyFn>,
+                              std::make_tuple(states[l], key, bins),
+                              &histograms[l]);
+  rt::waitForCompletion(h);
+
+  std::vector<size_t> local_histogram(kRadixBins);
+  std::vector<size_t> histogram(kRadixBins, 0);
+  for (uint32_t l = 0; l < num_localities; ++l) {
+    rt::dma(local_histogram.data(), rt::Locality(l), histograms[l],
+            kRadixBins);
+    for (size_t b = 0; b < kRadixBins; ++b) histogram[b] += local_histogram[b];
+  }
+
+  // contiguous bins of similar total size to each locality
+  std::vector<size_t> bin_bounds;
+  size_t total = std::accumulate(histogram.begin(), histogram.end(), 0ul);
+  size_t acc = 0, b = 0;
+  for (size_t d = 1; d < num_localities; ++d) {
+    while (b < kRadixBins && acc + histogram[b] <= total * d / num_localities)
+      acc += histogram[b++];
+    bin_bounds.push_back(b);
+  }
+  for (uint32_t l = 0; l < num_localities; ++l) {
+    rt::asyncDma(h, rt::Locality(l), info[l].bin_bounds, bin_bounds.data(),
+                 bin_bounds.size());
+    rt::asyncDma(h, rt::Locality(l), info[l].peers, states.data(),
+                 states.size());
+  }
+  rt::waitForCompletion(h);
+
+  for (uint32_t l = 0; l < num_localities; ++l)
+    rt::asyncExecuteAt(h, rt::Locality(l), radix_split<T, KeyFn>,
+                       std::make_tuple(states[l], key, bins));
+  rt::waitForCompletion(h);
+
+  // all-to-all exchange and local sort
+  std::vector<size_t> bucket_sizes(num_localities);
+  for (uint32_t l = 0; l < num_localities; ++l)
+    rt::asyncExecuteAtWithRet(h, rt::Locality(l),
+                              radix_bucket<policy_t, T, KeyFn>,
+                              std::make_tuple(states[l], key),
+                              &bucket_sizes[l]);
+  rt::waitForCompletion(h);
+
+  write_buckets(first, states, bucket_sizes);
+}
+
+}  // namespace sort_impl
+
+template <typename ExecutionPolicy, typename RandomIt, typename Compare>
+void sort(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+          Compare comp) {
+  sort_impl::sample_sort<false>(std::forward<ExecutionPolicy>(policy), first,
+                                last, comp);
+}
+
+template <typename ExecutionPolicy, typename RandomIt, typename Compare>
+void stable_sort(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+                 Compare comp) {
+  sort_impl::sample_sort<true>(std::forward<ExecutionPolicy>(policy), first,
+                               last, comp);
+}
+
+template <typename ExecutionPolicy, typename RandomIt, typename KeyFn>
+void radix_sort(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+                KeyFn key) {
+  sort_impl::radix_sort(std::forward<ExecutionPolicy>(policy), first, last,
+                        key);
+}
+
+// the smallest elements are selected first, so that only [first, middle)
+// is sorted
+template <typename ExecutionPolicy, typename RandomIt, typename Compare>
+void partial_sort(ExecutionPolicy&& policy, RandomIt first, RandomIt middle,
+                  RandomIt last, Compare comp) {
+  if (first == middle) return;
+  if (middle != last) impl::nth_element(policy, first, middle, last, comp);
+  sort_impl::sample_sort<false>(std::forward<ExecutionPolicy>(policy), first,
+                                middle, comp);
+}
 
 }  // namespace impl
 }  // namespace shad
@@ -0,0 +1,205 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef INCLUDE_SHAD_CORE_VECTOR_H_
+#define INCLUDE_SHAD_CORE_VECTOR_H_
+
+#include <memory>
+#include <tuple>
+
+#include "shad/core/iterator.h"
+#include "shad/data_structures/vector.h"
+#include "shad/distributed_iterator_traits.h"
+
+namespace shad {
+
+/// @brief Distributed dynamic-size sequence container.
+///
+/// shad::vector is the STL-style wrapper of shad::Vector.  Each Locality
+/// stores one contiguous chunk of the elements, and the iterators of the
+/// container expose it as a local range of raw pointers, so that the
+/// algorithms in shad/core process it at local speed.
+///
+/// Elements are appended with push_back(), or in bulk from parallel kernels
+/// through shad::buffered_insert_iterator: buffered insertions are staged on
+/// the Locality performing them and published at the end of the vector, in
+/// unspecified order, when the iterator is flushed.
+///
+/// Typical usage:
+/// @code
+/// shad::vector<int> v;
+/// shad::buffered_insert_iterator<shad::vector<int>> ins(v, v.end());
+/// for (int i = 0; i < 1024; ++i) ins = i;
+/// ins.wait();
+/// ins.flush();
+/// @endcode
+///
+/// @tparam T The type of the elements.
+/// @tparam Allocator The allocator used for the chunks of the container.
+///
+/// @warning Element access returns copies: elements are modified through
+/// insert(), algorithms over the iterators, or output iterators.
+template <class T, class Allocator = std::allocator<T>>
+class vector {
+  using vector_t = Vector<T, Allocator>;
+
+  friend class insert_iterator<vector>;
+  friend class buffered_insert_iterator<vector>;
+
+ public:
+  /// @defgroup Types
+  /// @{
+  /// The type of the stored value.
+  using value_type = typename vector_t::value_type;
+  /// The type of the allocator.
+  using allocator_type = Allocator;
+  /// The type used to represent size.
+  using size_type = std::size_t;
+  /// The type used to represent distances.
+  using difference_type = std::ptrdiff_t;
+  /// The type for pointer to ::value_type.
+  using pointer = value_type *;
+  /// The type for pointer to ::const_value_type
+  using const_pointer = const value_type *;
+  /// The type of iterators on the vector.
+  using iterator = typename vector_t::iterator;
+  /// The type of const iterators on the vector.
+  using const_iterator = typename vector_t::const_iterator;
+  /// @}
+
+ public:
+  /// @brief Constructor.
+  ///
+  /// @param count The initial size of the container.
+  explicit vector(size_type count = 0) { ptr = vector_t::Create(count); }
+
+  /// @brief Constructor.
+  ///
+  /// @param count The initial size of the container.
+  /// @param value The value used to initialize the elements.
+  vector(size_type count, const value_type &value) : vector(count) {
+    using itr_traits = distributed_iterator_traits<iterator>;
+    rt::executeOnAll(
+        [](const std::tuple<iterator, iterator, value_type> &args) {
+          auto lrange =
+              itr_traits::local_range(std::get<0>(args), std::get<1>(args));
+          std::fill(lrange.begin(), lrange.end(), std::get<2>(args));
+        },
+        std::make_tuple(begin(), end(), value));
+  }
+
+  vector(const vector &) = delete;
+  vector &operator=(const vector &) = delete;
+
+  /// @brief Destructor.
+  ~vector() { vector_t::Destroy(ptr.get()->GetGlobalID()); }
+
+  /// @defgroup Element access
+  /// @{
+  /// @brief The element at position pos, with bounds checking.
+  /// @throw std::out_of_range if pos is not within the range of the container.
+  value_type at(size_type pos) const { return impl()->At(pos); }
+  /// @brief The element at position pos.
+  value_type operator[](size_type pos) const { return (*impl())[pos]; }
+  /// @brief The first element of the container.
+  value_type front() const { return impl()->Front(); }
+  /// @brief The last element of the container.
+  value_type back() const { return impl()->Back(); }
+  /// @}
+
+  /// @defgroup Iterators
+  /// @{
+  /// @brief The iterator to the beginning of the sequence.
+  /// @return an ::iterator to the beginning of the sequence.
+  iterator begin() noexcept { return impl()->begin(); }
+  /// @brief The iterator to the beginning of the sequence.
+  /// @return a ::const_iterator to the beginning of the sequence.
+  const_iterator begin() const noexcept { return impl()->begin(); }
+  /// @brief The iterator to the beginning of the sequence.
+  /// @return a ::const_iterator to the beginning of the sequence.
+  const_iterator cbegin() const noexcept { return impl()->cbegin(); }
+  /// @brief The iterator to the end of the sequence.
+  /// @return an ::iterator to the end of the sequence.
+  iterator end() noexcept { return impl()->end(); }
+  /// @brief The iterator to the end of the sequence.
+  /// @return a ::const_iterator to the end of the sequence.
+  const_iterator end() const noexcept { return impl()->end(); }
+  /// @brief The iterator to the end of the sequence.
+  /// @return a ::const_iterator to the end of the sequence.
+  const_iterator cend() const noexcept { return impl()->cend(); }
+  /// @}
+
+  /// @defgroup Capacity
+  /// @{
+  /// @brief Empty test.
+  /// @return true if empty, and false otherwise.
+  bool empty() const noexcept { return size() == 0; }
+  /// @brief The size of the container.
+  /// @return the size of the container.
+  size_type size() const noexcept { return impl()->Size(); }
+  /// @brief The maximum number of elements the container can hold.
+  size_type max_size() const noexcept { return impl()->MaxSize(); }
+  /// @brief Increase the capacity of the container to at least new_cap.
+  void reserve(size_type new_cap) { impl()->Reserve(new_cap); }
+  /// @brief The number of elements that can be held in allocated storage.
+  size_type capacity() const noexcept { return impl()->Capacity(); }
+  /// @}
+
+  /// @defgroup Modifiers
+  /// @{
+  /// @brief Removes all the elements and releases the storage.
+  void clear() noexcept { impl()->Clear(); }
+
+  /// @brief Inserts value before pos.
+  ///
+  /// @param pos The iterator before which the value is inserted.
+  /// @param value The value to be inserted.
+  /// @return an iterator to the inserted element.
+  iterator insert(const_iterator pos, const value_type &value) {
+    return impl()->insert(pos, value);
+  }
+
+  /// @brief Appends value at the end of the container.
+  void push_back(const value_type &value) { impl()->PushBack(value); }
+
+  /// @brief Resizes the container to contain count elements.
+  void resize(size_type count) { impl()->Resize(count); }
+  /// @}
+
+ private:
+  using internal_container_t = vector_t;
+  using oid_t = typename internal_container_t::ObjectID;
+  oid_t global_id() { return impl()->GetGlobalID(); }
+  static internal_container_t *from_global_id(oid_t oid) {
+    return internal_container_t::GetPtr(oid).get();
+  }
+
+  std::shared_ptr<vector_t> ptr = nullptr;
+  const vector_t *impl() const { return ptr.get(); }
+  vector_t *impl() { return ptr.get(); }
+};
+
+}  // namespace shad
+
+#endif /* INCLUDE_SHAD_CORE_VECTOR_H_ */
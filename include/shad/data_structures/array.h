@@ -30,12 +30,16 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "shad/data_structures/abstract_data_structure.h"
 #include "shad/data_structures/buffer.h"
+#include "shad/data_structures/distribution.h"
 #include "shad/runtime/runtime.h"
 
 namespace shad {
@@ -47,17 +51,21 @@ namespace shad {
 /// @warning obects of type T need to be trivially copiable.
 ///
 /// @tparam T type of the entries stored in the Array.
-template <typename T>
-class Array : public AbstractDataStructure<Array<T>> {
+/// @tparam DistributionT policy mapping positions to localities; one of
+/// BlockDistribution (default), CyclicDistribution, BlockCyclicDistribution,
+/// and ExplicitDistribution.
+template <typename T, typename DistributionT = BlockDistribution>
+class Array : public AbstractDataStructure<Array<T, DistributionT>> {
   template <typename>
   friend class AbstractDataStructure;
 
  public:
   constexpr static size_t kMaxChunkSize =
       constants::max(constants::kBufferNumBytes / sizeof(T), 1lu);
-  using ObjectID = typename AbstractDataStructure<Array<T>>::ObjectID;
-  using BuffersVector = impl::BuffersVector<std::tuple<size_t, T>, Array<T>>;
-  using ShadArrayPtr = typename AbstractDataStructure<Array<T>>::SharedPtr;
+  using ArrayT = Array<T, DistributionT>;
+  using ObjectID = typename AbstractDataStructure<ArrayT>::ObjectID;
+  using BuffersVector = impl::BuffersVector<std::tuple<size_t, T>, ArrayT>;
+  using ShadArrayPtr = typename AbstractDataStructure<ArrayT>::SharedPtr;
 
   /// @brief Retrieve the Global Identifier.
   ///
@@ -77,8 +85,36 @@ class Array : public AbstractDataStructure<Array<T>> {
   /// @param initValue Initialization value.
   /// @return A shared pointer to the newly created array instance.
   static ShadArrayPtr Create(size_t size, const T &initValue);
+
+  /// @brief Create method.
+  ///
+  /// Creates a new array instance distributed according to a given policy.
+  ///
+  /// @param size The size of the array.
+  /// @param initValue Initialization value.
+  /// @param distribution The distribution policy.
+  /// @return A shared pointer to the newly created array instance.
+  static ShadArrayPtr Create(size_t size, const T &initValue,
+                             const DistributionT &distribution);
 #endif
 
+  /// @brief Create method for arrays with explicit per-Locality sizes.
+  ///
+  /// Typical usage:
+  /// @code
+  /// using ArrayT = shad::Array<size_t, shad::ExplicitDistribution>;
+  /// // The first Locality holds the hubs of the graph: give it less work.
+  /// std::vector<size_t> sizes(shad::rt::numLocalities(), 2 * kChunk);
+  /// sizes[0] = kChunk;
+  /// auto arrayPtr = ArrayT::CreateWithLocalSizes(sizes, 0lu);
+  /// @endcode
+  ///
+  /// @param localSizes The number of elements owned by each Locality.
+  /// @param initValue Initialization value.
+  /// @return A shared pointer to the newly created array instance.
+  static ShadArrayPtr CreateWithLocalSizes(
+      const std::vector<size_t> &localSizes, const T &initValue);
+
   /// @brief Synchronous insert method.
   ///
   /// Inserts an element at the specified position synchronously.
@@ -253,6 +289,89 @@ class Array : public AbstractDataStructure<Array<T>> {
   /// written; result must point to a valid memory allocation.
   void AsyncAt(rt::Handle &handle, const size_t pos, T *result);
 
+  /// @brief Ranged Lookup Method.
+  ///
+  /// Retrieve a range of consecutive elements.  The range is split at the
+  /// boundaries of the chunks owned by each Locality and every piece is
+  /// read with a single DMA transfer; transfers from different localities
+  /// proceed concurrently.
+  ///
+  /// Typical usage:
+  /// @code
+  /// auto arrayPtr = shad::Array<size_t>::Create(kArraySize, kInitValue);
+  /// // ... fill the array with useful values ...
+  ///
+  /// std::vector<size_t> values(kArraySize);
+  /// arrayPtr->AtRange(0, kArraySize, values.data());
+  /// @endcode
+  ///
+  /// @param[in] pos The first position of the range.
+  /// @param[in] numValues The number of elements to read.
+  /// @param[out] values Pointer to the region where the elements are
+  /// written; it must be able to hold numValues elements.
+  void AtRange(const size_t pos, const size_t numValues, T *values);
+
+  /// @brief Asynchronous Ranged Lookup Method.
+  ///
+  /// @warning Asynchronous operations are guaranteed to have completed
+  /// only after calling the rt::waitForCompletion(rt::Handle &handle) method.
+  ///
+  /// @param[in,out] handle The handle to be used to wait for completion.
+  /// @param[in] pos The first position of the range.
+  /// @param[in] numValues The number of elements to read.
+  /// @param[out] values Pointer to the region where the elements are
+  /// written; it must be able to hold numValues elements.
+  void AsyncAtRange(rt::Handle &handle, const size_t pos,
+                    const size_t numValues, T *values);
+
+  /// @brief Set the width of the halo regions.
+  ///
+  /// Each Locality keeps read-only copies of the width elements preceding
+  /// and following its own range, so that stencil-like kernels can read
+  /// neighboring positions through HaloAt() without communication.  The
+  /// halos are filled by this method and refreshed by ExchangeHalos().
+  ///
+  /// Typical usage:
+  /// @code
+  /// auto arrayPtr = shad::Array<double>::Create(kArraySize, 0.0);
+  /// // ... fill the array with useful values ...
+  /// arrayPtr->SetHaloWidth(1);
+  /// using ObjectID = shad::Array<double>::ObjectID;
+  /// auto smooth = [](size_t pos, double &, ObjectID &oid, ObjectID &outID) {
+  ///   auto ptr = shad::Array<double>::GetPtr(oid);
+  ///   double value = ptr->HaloAt(pos);
+  ///   if (pos > 0) value += ptr->HaloAt(pos - 1);
+  ///   if (pos + 1 < ptr->Size()) value += ptr->HaloAt(pos + 1);
+  ///   shad::Array<double>::GetPtr(outID)->InsertAt(pos, value / 3);
+  /// };
+  /// arrayPtr->ForEach(smooth, oid, outID);
+  /// @endcode
+  ///
+  /// @warning This is a collective operation, and it is supported only by
+  /// distributions assigning a contiguous range to each Locality.
+  ///
+  /// @param width The number of elements copied from each side.
+  void SetHaloWidth(size_t width);
+
+  /// @brief Refresh the halo regions of all the localities.
+  ///
+  /// @warning This is a collective operation: updates to the array are
+  /// visible through the halos only after it has completed.
+  void ExchangeHalos();
+
+  /// @brief Read an element from the local data or from the halos.
+  ///
+  /// Positions outside the local range extended by the halos are retrieved
+  /// with At().
+  ///
+  /// @param[in] pos The target position.
+  /// @return The value of the element at position pos, as of the last
+  /// ExchangeHalos() for halo elements.
+  T HaloAt(const size_t pos);
+
+  /// @brief The width of the halo regions.
+  size_t HaloWidth() const { return haloWidth_; }
+
   /// @brief Applies a user-defined function to an element.
   ///
   /// Applies a user-defined function to the element at the specified position.
@@ -459,45 +578,49 @@ class Array : public AbstractDataStructure<Array<T>> {
   }
 
  protected:
-  Array(ObjectID oid, size_t size, const T &initValue)
+  Array(ObjectID oid, size_t size, const T &initValue,
+        const DistributionT &distribution = DistributionT())
       : oid_(oid),
         size_(size),
-        pivot_((size % rt::numLocalities() == 0)
-                   ? rt::numLocalities()
-                   : rt::numLocalities() - (size % rt::numLocalities())),
+        distribution_(distribution),
         data_(),
-        dataDistribution_(),
         buffers_(oid) {
-    rt::Locality pivot(pivot_);
-    size_t start = 0;
-    size_t chunkSize = size / rt::numLocalities();
-    auto localities = rt::allLocalities();
-
-    for (auto &locality : localities) {
-      if (locality < pivot) {
-        dataDistribution_.emplace_back(
-            std::make_pair(start, start + chunkSize - 1));
-      } else {
-        dataDistribution_.emplace_back(
-            std::make_pair(start, start + chunkSize));
-        ++start;
-      }
-
-      start += chunkSize;
-    }
-    if (rt::thisLocality() < pivot)
-      data_.resize(chunkSize, initValue);
-    else
-      data_.resize(chunkSize + 1, initValue);
+    distribution_.Init(size, rt::numLocalities());
+    data_.resize(
+        distribution_.LocalSize(static_cast<uint32_t>(rt::thisLocality())),
+        initValue);
   }
 
  private:
   ObjectID oid_;
   size_t size_;
-  uint32_t pivot_;
+  DistributionT distribution_;
   std::vector<T> data_;
-  std::vector<std::pair<size_t, size_t>> dataDistribution_;
   BuffersVector buffers_;
+  // Addresses of the data chunks of all the localities, used as DMA
+  // targets.  They are fetched on the first ranged lookup.
+  std::vector<const T *> chunksAddresses_;
+  std::once_flag chunksAddressesFlag_;
+  // Copies of the elements preceding and following the local range.
+  size_t haloWidth_ = 0;
+  std::vector<T> leftHalo_;
+  std::vector<T> rightHalo_;
+
+  void FetchChunksAddresses() {
+    std::call_once(chunksAddressesFlag_, [this]() {
+      auto addressLambda = [](rt::Handle &, const ObjectID &oid,
+                              const T **res) {
+        *res = ArrayT::GetPtr(oid)->data_.data();
+      };
+      chunksAddresses_.resize(rt::numLocalities());
+      rt::Handle handle;
+      for (auto &locality : rt::allLocalities())
+        rt::asyncExecuteAtWithRet(
+            handle, locality, addressLambda, oid_,
+            &chunksAddresses_[static_cast<uint32_t>(locality)]);
+      rt::waitForCompletion(handle);
+    });
+  }
 
   struct InsertAtArgs {
     ObjectID oid;
@@ -511,7 +634,7 @@ class Array : public AbstractDataStructure<Array<T>> {
   };
 
   static void InsertAtFun(const InsertAtArgs &args) {
-    ShadArrayPtr ptr = Array<T>::GetPtr(args.oid);
+    ShadArrayPtr ptr = ArrayT::GetPtr(args.oid);
     ptr->data_[args.pos] = args.value;
   }
 
@@ -523,7 +646,7 @@ class Array : public AbstractDataStructure<Array<T>> {
     argsPtr += sizeof(size_t);
     size_t chunkSize = *reinterpret_cast<size_t *>(argsPtr);
     argsPtr += sizeof(size_t);
-    ShadArrayPtr ptr = Array<T>::GetPtr(oid);
+    ShadArrayPtr ptr = ArrayT::GetPtr(oid);
     memcpy(&(ptr->data_[pos]), argsPtr, chunkSize * sizeof(T));
   }
 
@@ -536,22 +659,22 @@ class Array : public AbstractDataStructure<Array<T>> {
     argsPtr += sizeof(size_t);
     size_t chunkSize = *reinterpret_cast<size_t *>(argsPtr);
     argsPtr += sizeof(size_t);
-    ShadArrayPtr ptr = Array<T>::GetPtr(oid);
+    ShadArrayPtr ptr = ArrayT::GetPtr(oid);
     memcpy(&(ptr->data_[pos]), argsPtr, chunkSize * sizeof(T));
   }
 
   static void AsyncInsertAtFun(shad::rt::Handle &, const InsertAtArgs &args) {
-    ShadArrayPtr ptr = Array<T>::GetPtr(args.oid);
+    ShadArrayPtr ptr = ArrayT::GetPtr(args.oid);
     ptr->data_[args.pos] = args.value;
   }
 
   static void AtFun(const AtArgs &args, T *result) {
-    ShadArrayPtr ptr = Array<T>::GetPtr(args.oid);
+    ShadArrayPtr ptr = ArrayT::GetPtr(args.oid);
     *result = ptr->data_[args.pos];
   }
 
   static void AsyncAtFun(rt::Handle &handle, const AtArgs &args, T *result) {
-    ShadArrayPtr ptr = Array<T>::GetPtr(args.oid);
+    ShadArrayPtr ptr = ArrayT::GetPtr(args.oid);
     *result = ptr->data_[args.pos];
   }
 
@@ -560,7 +683,7 @@ class Array : public AbstractDataStructure<Array<T>> {
                            ApplyFunT function, std::tuple<Args...> &args,
                            std::index_sequence<is...>) {
     // Get a local instance on the remote node.
-    auto arrayPtr = Array<T>::GetPtr(oid);
+    auto arrayPtr = ArrayT::GetPtr(oid);
     T &element = arrayPtr->data_[loffset];
     function(pos, element, std::get<is>(args)...);
   }
@@ -583,7 +706,7 @@ class Array : public AbstractDataStructure<Array<T>> {
                                 std::tuple<Args...> &args,
                                 std::index_sequence<is...>) {
     // Get a local instance on the remote node.
-    auto arrayPtr = Array<T>::GetPtr(oid);
+    auto arrayPtr = ArrayT::GetPtr(oid);
     T &element = arrayPtr->data_[loffset];
     function(handle, pos, element, std::get<is>(args)...);
   }
@@ -606,7 +729,7 @@ class Array : public AbstractDataStructure<Array<T>> {
                                     std::tuple<Args...> &args,
                                     std::index_sequence<is...>) {
     // Get a local instance on the remote node.
-    auto arrayPtr = Array<T>::GetPtr(oid);
+    auto arrayPtr = ArrayT::GetPtr(oid);
     T &element = arrayPtr->data_[i + lpos];
     function(i + pos, element, std::get<is>(args)...);
   }
@@ -630,7 +753,7 @@ class Array : public AbstractDataStructure<Array<T>> {
                                          std::tuple<Args...> &args,
                                          std::index_sequence<is...>) {
     // Get a local instance on the remote node.
-    auto arrayPtr = Array<T>::GetPtr(oid);
+    auto arrayPtr = ArrayT::GetPtr(oid);
     T &element = arrayPtr->data_[i + lpos];
     function(handle, i + pos, element, std::get<is>(args)...);
   }
@@ -651,10 +774,13 @@ class Array : public AbstractDataStructure<Array<T>> {
 
   template <typename ApplyFunT, typename... Args, std::size_t... is>
   static void AsyncCallForEachFun(rt::Handle &handle, const size_t i,
-                                  T *arrayPtr, ApplyFunT function, size_t pos,
+                                  T *arrayPtr, ApplyFunT function,
+                                  const DistributionT *distribution,
                                   std::tuple<Args...> &args,
                                   std::index_sequence<is...>) {
-    function(handle, pos + i, arrayPtr[i], std::get<is>(args)...);
+    size_t pos = distribution->GlobalPosition(
+        static_cast<uint32_t>(rt::thisLocality()), i);
+    function(handle, pos, arrayPtr[i], std::get<is>(args)...);
   }
 
   template <typename Tuple, typename... Args>
@@ -672,9 +798,12 @@ class Array : public AbstractDataStructure<Array<T>> {
 
   template <typename ApplyFunT, typename... Args, std::size_t... is>
   static void CallForEachFun(size_t i, T *arrayPtr, ApplyFunT function,
-                             size_t pos, std::tuple<Args...> &args,
+                             const DistributionT *distribution,
+                             std::tuple<Args...> &args,
                              std::index_sequence<is...>) {
-    function(i + pos, arrayPtr[i], std::get<is>(args)...);
+    size_t pos = distribution->GlobalPosition(
+        static_cast<uint32_t>(rt::thisLocality()), i);
+    function(pos, arrayPtr[i], std::get<is>(args)...);
   }
 
   template <typename Tuple, typename... Args>
@@ -690,23 +819,53 @@ class Array : public AbstractDataStructure<Array<T>> {
   }
 };
 
-static std::pair<rt::Locality, size_t> getTargetLocalityFromTargePosition(
-    const std::vector<std::pair<size_t, size_t>> &dataDistribution,
-    size_t position) {
-  auto itr = std::lower_bound(
-      dataDistribution.begin(), dataDistribution.end(), position,
-      [](const std::pair<size_t, size_t> &lhs, const size_t position) -> bool {
-        return lhs.second < position;
-      });
-
-  rt::Locality dest(std::distance(dataDistribution.begin(), itr));
-  size_t off = position - itr->first;
-  return std::make_pair(dest, off);
+template <typename T, typename DistributionT>
+typename Array<T, DistributionT>::ShadArrayPtr
+Array<T, DistributionT>::CreateWithLocalSizes(
+    const std::vector<size_t> &localSizes, const T &initValue) {
+  static_assert(std::is_same<DistributionT, ExplicitDistribution>::value,
+                "CreateWithLocalSizes requires the ExplicitDistribution");
+  size_t size = std::accumulate(localSizes.begin(), localSizes.end(), 0lu);
+  auto ptr = ArrayT::Create(0lu, initValue);
+
+  size_t argsSize = sizeof(ObjectID) + sizeof(T) +
+                    sizeof(size_t) * (rt::numLocalities() + 1);
+  std::shared_ptr<uint8_t> args(new uint8_t[argsSize],
+                                std::default_delete<uint8_t[]>());
+  uint8_t *argsPtr = args.get();
+  ObjectID oid = ptr->GetGlobalID();
+  memcpy(argsPtr, &oid, sizeof(oid));
+  argsPtr += sizeof(oid);
+  memcpy(argsPtr, &initValue, sizeof(T));
+  argsPtr += sizeof(T);
+  memcpy(argsPtr, &size, sizeof(size_t));
+  argsPtr += sizeof(size_t);
+  memcpy(argsPtr, localSizes.data(), sizeof(size_t) * rt::numLocalities());
+
+  auto setSizesLambda = [](const uint8_t *args, const uint32_t) {
+    ObjectID oid(ObjectID::kNullID);
+    memcpy(&oid, args, sizeof(oid));
+    args += sizeof(oid);
+    T initValue;
+    memcpy(&initValue, args, sizeof(T));
+    args += sizeof(T);
+    auto ptr = ArrayT::GetPtr(oid);
+    memcpy(&ptr->size_, args, sizeof(size_t));
+    args += sizeof(size_t);
+    std::vector<size_t> localSizes(rt::numLocalities());
+    memcpy(localSizes.data(), args, sizeof(size_t) * localSizes.size());
+    ptr->distribution_.SetLocalSizes(localSizes.data(), localSizes.size());
+    ptr->data_.resize(ptr->distribution_.LocalSize(
+                          static_cast<uint32_t>(rt::thisLocality())),
+                      initValue);
+  };
+  rt::executeOnAll(setSizesLambda, args, argsSize);
+  return ptr;
 }
 
-template <typename T>
-void Array<T>::InsertAt(const size_t pos, const T &value) {
-  auto target = getTargetLocalityFromTargePosition(dataDistribution_, pos);
+template <typename T, typename DistributionT>
+void Array<T, DistributionT>::InsertAt(const size_t pos, const T &value) {
+  auto target = distribution_.Owner(pos);
 
   if (target.first == rt::thisLocality()) {
     data_[target.second] = value;
@@ -716,10 +875,10 @@ void Array<T>::InsertAt(const size_t pos, const T &value) {
   }
 }
 
-template <typename T>
-void Array<T>::AsyncInsertAt(rt::Handle &handle, const size_t pos,
-                             const T &value) {
-  auto target = getTargetLocalityFromTargePosition(dataDistribution_, pos);
+template <typename T, typename DistributionT>
+void Array<T, DistributionT>::AsyncInsertAt(rt::Handle &handle,
+                                            const size_t pos, const T &value) {
+  auto target = distribution_.Owner(pos);
   if (target.first == rt::thisLocality()) {
     data_[target.second] = value;
   } else {
@@ -728,9 +887,10 @@ void Array<T>::AsyncInsertAt(rt::Handle &handle, const size_t pos,
   }
 }
 
-template <typename T>
-void Array<T>::BufferedInsertAt(const size_t pos, const T &value) {
-  auto target = getTargetLocalityFromTargePosition(dataDistribution_, pos);
+template <typename T, typename DistributionT>
+void Array<T, DistributionT>::BufferedInsertAt(const size_t pos,
+                                               const T &value) {
+  auto target = distribution_.Owner(pos);
   if (target.first == rt::thisLocality()) {
     data_[target.second] = value;
   } else {
@@ -738,52 +898,18 @@ void Array<T>::BufferedInsertAt(const size_t pos, const T &value) {
   }
 }
 
-template <typename T>
-void Array<T>::InsertAt(const size_t pos, const T *values,
-                        const size_t numValues) {
+template <typename T, typename DistributionT>
+void Array<T, DistributionT>::InsertAt(const size_t pos, const T *values,
+                                       const size_t numValues) {
   size_t tgtPos = 0, firstPos = pos;
   rt::Locality tgtLoc;
   size_t remainingValues = numValues;
   size_t chunkSize = 0;
   T *valuesPtr = const_cast<T *>(values);
 
-  while ((remainingValues > 0) &&
-         (firstPos < pivot_ * (size_ / rt::numLocalities()))) {
-    tgtLoc = rt::Locality(firstPos / (size_ / rt::numLocalities()));
-    tgtPos = firstPos % (size_ / rt::numLocalities());
-    chunkSize =
-        std::min((size_ / rt::numLocalities() - tgtPos), remainingValues);
-    if (tgtLoc == rt::thisLocality()) {
-      memcpy(&data_[tgtPos], valuesPtr, chunkSize * sizeof(T));
-    } else {
-      chunkSize = constants::min(chunkSize, kMaxChunkSize);
-      size_t argsSize =
-          sizeof(oid_) + sizeof(size_t) * 2 + sizeof(T) * chunkSize;
-      std::shared_ptr<uint8_t> args(new uint8_t[argsSize],
-                                    std::default_delete<uint8_t[]>());
-      uint8_t *argsPtr = args.get();
-      memcpy(argsPtr, &oid_, sizeof(oid_));
-      argsPtr += sizeof(oid_);
-      memcpy(argsPtr, &tgtPos, sizeof(size_t));
-      argsPtr += sizeof(size_t);
-      memcpy(argsPtr, &chunkSize, sizeof(size_t));
-      argsPtr += sizeof(size_t);
-      memcpy(argsPtr, valuesPtr, sizeof(T) * chunkSize);
-
-      rt::executeAt(tgtLoc, RangedInsertAtFun, args, argsSize);
-    }
-
-    firstPos += chunkSize;
-    remainingValues -= chunkSize;
-    valuesPtr += chunkSize;
-  }
   while (remainingValues > 0) {
-    size_t newPos = firstPos - (pivot_ * (size_ / rt::numLocalities()));
-    tgtLoc =
-        rt::Locality(pivot_ + newPos / ((size_ / rt::numLocalities() + 1)));
-    tgtPos = newPos % ((size_ / rt::numLocalities() + 1));
-    chunkSize =
-        std::min((size_ / rt::numLocalities() + 1 - tgtPos), remainingValues);
+    std::tie(tgtLoc, tgtPos) = distribution_.Owner(firstPos);
+    chunkSize = std::min(distribution_.RunLength(firstPos), remainingValues);
     if (tgtLoc == rt::thisLocality()) {
       memcpy(&data_[tgtPos], valuesPtr, chunkSize * sizeof(T));
     } else {
@@ -811,9 +937,10 @@ void Array<T>::InsertAt(const size_t pos, const T *values,
   }
 }
 
-template <typename T>
-void Array<T>::AsyncInsertAt(rt::Handle &handle, const size_t pos,
-                             const T *values, const size_t numValues) {
+template <typename T, typename DistributionT>
+void Array<T, DistributionT>::AsyncInsertAt(rt::Handle &handle,
+                                            const size_t pos, const T *values,
+                                            const size_t numValues) {
   size_t tgtPos = 0, firstPos = pos;
   rt::Locality tgtLoc;
   size_t remainingValues = numValues;
@@ -821,19 +948,8 @@ void Array<T>::AsyncInsertAt(rt::Handle &handle, const size_t pos,
   T *valuesPtr = const_cast<T *>(values);
 
   while (remainingValues > 0) {
-    if (firstPos < pivot_ * (size_ / rt::numLocalities())) {
-      tgtLoc = rt::Locality(firstPos / (size_ / rt::numLocalities()));
-      tgtPos = firstPos % (size_ / rt::numLocalities());
-      chunkSize =
-          std::min((size_ / rt::numLocalities() - tgtPos), remainingValues);
-    } else {
-      size_t newPos = firstPos - (pivot_ * (size_ / rt::numLocalities()));
-      tgtLoc =
-          rt::Locality(pivot_ + newPos / ((size_ / rt::numLocalities() + 1)));
-      tgtPos = newPos % ((size_ / rt::numLocalities() + 1));
-      chunkSize =
-          std::min((size_ / rt::numLocalities() + 1 - tgtPos), remainingValues);
-    }
+    std::tie(tgtLoc, tgtPos) = distribution_.Owner(firstPos);
+    chunkSize = std::min(distribution_.RunLength(firstPos), remainingValues);
     if (tgtLoc == rt::thisLocality()) {
       memcpy(&data_[tgtPos], valuesPtr, chunkSize * sizeof(T));
     } else {
@@ -863,10 +979,11 @@ void Array<T>::AsyncInsertAt(rt::Handle &handle, const size_t pos,
   }
 }
 
-template <typename T>
-void Array<T>::BufferedAsyncInsertAt(rt::Handle &handle, const size_t pos,
-                                     const T &value) {
-  auto target = getTargetLocalityFromTargePosition(dataDistribution_, pos);
+template <typename T, typename DistributionT>
+void Array<T, DistributionT>::BufferedAsyncInsertAt(rt::Handle &handle,
+                                                    const size_t pos,
+                                                    const T &value) {
+  auto target = distribution_.Owner(pos);
   if (target.first == rt::thisLocality()) {
     data_[target.second] = value;
   } else {
@@ -875,12 +992,12 @@ void Array<T>::BufferedAsyncInsertAt(rt::Handle &handle, const size_t pos,
   }
 }
 
-template <typename T>
-T Array<T>::At(const size_t pos) {
+template <typename T, typename DistributionT>
+T Array<T, DistributionT>::At(const size_t pos) {
   if (rt::numLocalities() == 1) {
     return data_[pos];
   }
-  auto target = getTargetLocalityFromTargePosition(dataDistribution_, pos);
+  auto target = distribution_.Owner(pos);
   T retValue;
   if (target.first == rt::thisLocality()) {
     retValue = data_[target.second];
@@ -891,9 +1008,10 @@ T Array<T>::At(const size_t pos) {
   return retValue;
 }
 
-template <typename T>
-void Array<T>::AsyncAt(rt::Handle &handle, const size_t pos, T *result) {
-  auto target = getTargetLocalityFromTargePosition(dataDistribution_, pos);
+template <typename T, typename DistributionT>
+void Array<T, DistributionT>::AsyncAt(rt::Handle &handle, const size_t pos,
+                                      T *result) {
+  auto target = distribution_.Owner(pos);
   if (target.first == rt::thisLocality()) {
     *result = data_[target.second];
   } else {
@@ -902,10 +1020,98 @@ void Array<T>::AsyncAt(rt::Handle &handle, const size_t pos, T *result) {
   }
 }
 
-template <typename T>
+template <typename T, typename DistributionT>
+void Array<T, DistributionT>::AtRange(const size_t pos, const size_t numValues,
+                                      T *values) {
+  if (rt::numLocalities() == 1) {
+    std::copy(data_.begin() + pos, data_.begin() + pos + numValues, values);
+    return;
+  }
+  rt::Handle handle;
+  AsyncAtRange(handle, pos, numValues, values);
+  rt::waitForCompletion(handle);
+}
+
+template <typename T, typename DistributionT>
+void Array<T, DistributionT>::AsyncAtRange(rt::Handle &handle, const size_t pos,
+                                           const size_t numValues, T *values) {
+  size_t tgtPos = 0, firstPos = pos;
+  rt::Locality tgtLoc;
+  size_t remainingValues = numValues;
+  size_t chunkSize = 0;
+  T *valuesPtr = values;
+
+  if (rt::numLocalities() > 1) FetchChunksAddresses();
+  while (remainingValues > 0) {
+    std::tie(tgtLoc, tgtPos) = distribution_.Owner(firstPos);
+    chunkSize = std::min(distribution_.RunLength(firstPos), remainingValues);
+    if (tgtLoc == rt::thisLocality()) {
+      std::copy(data_.begin() + tgtPos, data_.begin() + tgtPos + chunkSize,
+                valuesPtr);
+    } else {
+      const T *remoteData =
+          chunksAddresses_[static_cast<uint32_t>(tgtLoc)] + tgtPos;
+      rt::asyncDma(handle, static_cast<const T *>(valuesPtr), tgtLoc,
+                   remoteData, chunkSize);
+    }
+
+    firstPos += chunkSize;
+    remainingValues -= chunkSize;
+    valuesPtr += chunkSize;
+  }
+}
+
+template <typename T, typename DistributionT>
+void Array<T, DistributionT>::SetHaloWidth(size_t width) {
+  static_assert(DistributionT::kContiguous,
+                "Halos require a contiguous distribution");
+  auto setWidthLambda = [](const std::tuple<ObjectID, size_t> &args) {
+    auto ptr = ArrayT::GetPtr(std::get<0>(args));
+    ptr->haloWidth_ = std::get<1>(args);
+  };
+  rt::executeOnAll(setWidthLambda, std::make_tuple(oid_, width));
+  ExchangeHalos();
+}
+
+template <typename T, typename DistributionT>
+void Array<T, DistributionT>::ExchangeHalos() {
+  auto exchangeLambda = [](const ObjectID &oid) {
+    auto ptr = ArrayT::GetPtr(oid);
+    size_t first = ptr->distribution_.GlobalPosition(
+        static_cast<uint32_t>(rt::thisLocality()), 0);
+    size_t last = std::min(first + ptr->data_.size(), ptr->size_);
+    size_t leftSize = std::min(ptr->haloWidth_, first);
+    size_t rightSize = std::min(ptr->haloWidth_, ptr->size_ - last);
+    ptr->leftHalo_.resize(leftSize);
+    ptr->rightHalo_.resize(rightSize);
+
+    rt::Handle handle;
+    ptr->AsyncAtRange(handle, first - leftSize, leftSize,
+                      ptr->leftHalo_.data());
+    ptr->AsyncAtRange(handle, last, rightSize, ptr->rightHalo_.data());
+    rt::waitForCompletion(handle);
+  };
+  rt::executeOnAll(exchangeLambda, oid_);
+}
+
+template <typename T, typename DistributionT>
+T Array<T, DistributionT>::HaloAt(const size_t pos) {
+  size_t first = distribution_.GlobalPosition(
+      static_cast<uint32_t>(rt::thisLocality()), 0);
+  size_t last = first + data_.size();
+  if (pos >= first && pos < last) return data_[pos - first];
+  if (pos < first && first - pos <= leftHalo_.size())
+    return leftHalo_[leftHalo_.size() - (first - pos)];
+  if (pos >= last && pos - last < rightHalo_.size())
+    return rightHalo_[pos - last];
+  return At(pos);
+}
+
+template <typename T, typename DistributionT>
 template <typename ApplyFunT, typename... Args>
-void Array<T>::Apply(const size_t pos, ApplyFunT &&function, Args &... args) {
-  auto target = getTargetLocalityFromTargePosition(dataDistribution_, pos);
+void Array<T, DistributionT>::Apply(const size_t pos, ApplyFunT &&function,
+                                    Args &... args) {
+  auto target = distribution_.Owner(pos);
   if (target.first == rt::thisLocality()) {
     function(pos, data_[target.second], args...);
     return;
@@ -920,11 +1126,11 @@ void Array<T>::Apply(const size_t pos, ApplyFunT &&function, Args &... args) {
   rt::executeAt(target.first, ApplyFunWrapper<ArgsTuple, Args...>, argsTuple);
 }
 
-template <typename T>
+template <typename T, typename DistributionT>
 template <typename ApplyFunT, typename... Args>
-void Array<T>::AsyncApply(rt::Handle &handle, const size_t pos,
-                          ApplyFunT &&function, Args &... args) {
-  auto target = getTargetLocalityFromTargePosition(dataDistribution_, pos);
+void Array<T, DistributionT>::AsyncApply(rt::Handle &handle, const size_t pos,
+                                         ApplyFunT &&function, Args &... args) {
+  auto target = distribution_.Owner(pos);
 
   using FunctionTy = void (*)(rt::Handle &, size_t, T &, Args & ...);
   FunctionTy fn = std::forward<decltype(function)>(function);
@@ -937,10 +1143,12 @@ void Array<T>::AsyncApply(rt::Handle &handle, const size_t pos,
                      AsyncApplyFunWrapper<ArgsTuple, Args...>, argsTuple);
 }
 
-template <typename T>
+template <typename T, typename DistributionT>
 template <typename ApplyFunT, typename... Args>
-void Array<T>::ForEachInRange(const size_t first, const size_t last,
-                              ApplyFunT &&function, Args &... args) {
+void Array<T, DistributionT>::ForEachInRange(const size_t first,
+                                             const size_t last,
+                                             ApplyFunT &&function,
+                                             Args &... args) {
   using FunctionTy = void (*)(size_t, T &, Args & ...);
   FunctionTy fn = std::forward<decltype(function)>(function);
   using ArgsTuple =
@@ -953,19 +1161,8 @@ void Array<T>::ForEachInRange(const size_t first, const size_t last,
 
   ArgsTuple argsTuple{oid_, firstPos, tgtPos, fn, std::tuple<Args...>(args...)};
   while (remainingValues > 0) {
-    if (firstPos < pivot_ * (size_ / rt::numLocalities())) {
-      tgtLoc = rt::Locality(firstPos / (size_ / rt::numLocalities()));
-      tgtPos = firstPos % (size_ / rt::numLocalities());
-      chunkSize =
-          std::min((size_ / rt::numLocalities() - tgtPos), remainingValues);
-    } else {
-      size_t newPos = firstPos - (pivot_ * (size_ / rt::numLocalities()));
-      tgtLoc =
-          rt::Locality(pivot_ + newPos / ((size_ / rt::numLocalities() + 1)));
-      tgtPos = newPos % ((size_ / rt::numLocalities() + 1));
-      chunkSize =
-          std::min((size_ / rt::numLocalities() + 1 - tgtPos), remainingValues);
-    }
+    std::tie(tgtLoc, tgtPos) = distribution_.Owner(firstPos);
+    chunkSize = std::min(distribution_.RunLength(firstPos), remainingValues);
 
     std::get<1>(argsTuple) = firstPos;
     std::get<2>(argsTuple) = tgtPos;
@@ -978,11 +1175,13 @@ void Array<T>::ForEachInRange(const size_t first, const size_t last,
   }
 }
 
-template <typename T>
+template <typename T, typename DistributionT>
 template <typename ApplyFunT, typename... Args>
-void Array<T>::AsyncForEachInRange(rt::Handle &handle, const size_t first,
-                                   const size_t last, ApplyFunT &&function,
-                                   Args &... args) {
+void Array<T, DistributionT>::AsyncForEachInRange(rt::Handle &handle,
+                                                  const size_t first,
+                                                  const size_t last,
+                                                  ApplyFunT &&function,
+                                                  Args &... args) {
   using FunctionTy = void (*)(rt::Handle &, size_t, T &, Args & ...);
   FunctionTy fn = std::forward<decltype(function)>(function);
   using ArgsTuple =
@@ -996,19 +1195,8 @@ void Array<T>::AsyncForEachInRange(rt::Handle &handle, const size_t first,
   ArgsTuple argsTuple{oid_, firstPos, tgtPos, fn, std::tuple<Args...>(args...)};
 
   while (remainingValues > 0) {
-    if (firstPos < pivot_ * (size_ / rt::numLocalities())) {
-      tgtLoc = rt::Locality(firstPos / (size_ / rt::numLocalities()));
-      tgtPos = firstPos % (size_ / rt::numLocalities());
-      chunkSize =
-          std::min((size_ / rt::numLocalities() - tgtPos), remainingValues);
-    } else {
-      size_t newPos = firstPos - (pivot_ * (size_ / rt::numLocalities()));
-      tgtLoc =
-          rt::Locality(pivot_ + newPos / ((size_ / rt::numLocalities() + 1)));
-      tgtPos = newPos % ((size_ / rt::numLocalities() + 1));
-      chunkSize =
-          std::min((size_ / rt::numLocalities() + 1 - tgtPos), remainingValues);
-    }
+    std::tie(tgtLoc, tgtPos) = distribution_.Owner(firstPos);
+    chunkSize = std::min(distribution_.RunLength(firstPos), remainingValues);
 
     std::get<1>(argsTuple) = firstPos;
     std::get<2>(argsTuple) = tgtPos;
@@ -1022,25 +1210,24 @@ void Array<T>::AsyncForEachInRange(rt::Handle &handle, const size_t first,
   }
 }
 
-template <typename T>
+template <typename T, typename DistributionT>
 template <typename ApplyFunT, typename... Args>
-void Array<T>::AsyncForEach(rt::Handle &handle, ApplyFunT &&function,
-                            Args &... args) {
+void Array<T, DistributionT>::AsyncForEach(rt::Handle &handle,
+                                           ApplyFunT &&function,
+                                           Args &... args) {
   using FunctionTy = void (*)(rt::Handle &, size_t, T &, Args & ...);
   FunctionTy fn = std::forward<decltype(function)>(function);
 
   using feArgs = std::tuple<ObjectID, FunctionTy, std::tuple<Args...>>;
-  using ArgsTuple = std::tuple<T *, FunctionTy, size_t, std::tuple<Args...>>;
+  using ArgsTuple = std::tuple<T *, FunctionTy, const DistributionT *,
+                               std::tuple<Args...>>;
 
   feArgs arguments{oid_, fn, std::tuple<Args...>(args...)};
 
   auto feLambda = [](rt::Handle &handle, const feArgs &args) {
-    auto arrayPtr = Array<T>::GetPtr(std::get<0>(args));
-
-    size_t currentLocality = static_cast<uint32_t>(rt::thisLocality());
+    auto arrayPtr = ArrayT::GetPtr(std::get<0>(args));
     ArgsTuple argsTuple(arrayPtr->data_.data(), std::get<1>(args),
-                        arrayPtr->dataDistribution_[currentLocality].first,
-                        std::get<2>(args));
+                        &arrayPtr->distribution_, std::get<2>(args));
 
     rt::asyncForEachAt(handle, rt::thisLocality(),
                        AsyncForEachFunWrapper<ArgsTuple, Args...>, argsTuple,
@@ -1049,23 +1236,22 @@ void Array<T>::AsyncForEach(rt::Handle &handle, ApplyFunT &&function,
   rt::asyncExecuteOnAll(handle, feLambda, arguments);
 }
 
-template <typename T>
+template <typename T, typename DistributionT>
 template <typename ApplyFunT, typename... Args>
-void Array<T>::ForEach(ApplyFunT &&function, Args &... args) {
+void Array<T, DistributionT>::ForEach(ApplyFunT &&function, Args &... args) {
   using FunctionTy = void (*)(size_t, T &, Args & ...);
   FunctionTy fn = std::forward<decltype(function)>(function);
 
   using feArgs = std::tuple<ObjectID, FunctionTy, std::tuple<Args...>>;
-  using ArgsTuple = std::tuple<T *, FunctionTy, size_t, std::tuple<Args...>>;
+  using ArgsTuple = std::tuple<T *, FunctionTy, const DistributionT *,
+                               std::tuple<Args...>>;
 
   feArgs arguments{oid_, fn, std::tuple<Args...>(args...)};
 
   auto feLambda = [](const feArgs &args) {
-    auto arrayPtr = Array<T>::GetPtr(std::get<0>(args));
-    size_t currentLocality = static_cast<uint32_t>(rt::thisLocality());
+    auto arrayPtr = ArrayT::GetPtr(std::get<0>(args));
     ArgsTuple argsTuple(arrayPtr->data_.data(), std::get<1>(args),
-                        arrayPtr->dataDistribution_[currentLocality].first,
-                        std::get<2>(args));
+                        &arrayPtr->distribution_, std::get<2>(args));
 
     rt::forEachAt(rt::thisLocality(), ForEachFunWrapper<ArgsTuple, Args...>,
                   argsTuple, arrayPtr->data_.size());
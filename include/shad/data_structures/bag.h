@@ -0,0 +1,343 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef INCLUDE_SHAD_DATA_STRUCTURES_BAG_H_
+#define INCLUDE_SHAD_DATA_STRUCTURES_BAG_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "shad/data_structures/abstract_data_structure.h"
+#include "shad/data_structures/buffer.h"
+#include "shad/data_structures/local_bag.h"
+#include "shad/runtime/runtime.h"
+
+namespace shad {
+
+/// @brief The Bag data structure.
+///
+/// SHAD's Bag is a distributed, unordered work-list (e.g., the frontier of a
+/// graph traversal).  Unlike Set, elements are not hashed: each Locality owns
+/// a LocalBag, producers push to the Locality of their choice (or to their
+/// own), and consumers pop from the local partition.  Idle consumers can
+/// steal a batch of elements from other localities.
+///
+/// Typical usage:
+/// @code
+/// auto frontier = shad::Bag<uint64_t>::Create();
+/// frontier->BufferedPush(ownerOf(v), v);
+/// frontier->WaitForBufferedPush();
+/// frontier->ForEachElement(visit, args...);
+/// frontier->Clear();
+/// @endcode
+///
+/// @tparam T type of the elements.
+/// @warning obects of type T need to be trivially copiable.
+template <typename T>
+class Bag : public AbstractDataStructure<Bag<T>> {
+  template <typename>
+  friend class AbstractDataStructure;
+
+ public:
+  using value_type = T;
+  using BagT = Bag<T>;
+  using LBagT = LocalBag<T>;
+  using ObjectID = typename AbstractDataStructure<BagT>::ObjectID;
+  using ShadBagPtr = typename AbstractDataStructure<BagT>::SharedPtr;
+  using BuffersVector = typename impl::BuffersVector<T, BagT>;
+
+  /// @brief Create method.
+  ///
+  /// Creates a new bag instance.
+  /// @param segmentSize Number of elements per segment of the local bags.
+  /// @return A shared pointer to the newly created bag instance.
+#ifdef DOXYGEN_IS_RUNNING
+  static ShadBagPtr Create(const size_t segmentSize);
+#endif
+
+  /// @brief Getter of the Global Identifier.
+  ///
+  /// @return The global identifier associated with the bag instance.
+  ObjectID GetGlobalID() const { return oid_; }
+
+  /// @brief Overall size of the bag (number of elements).
+  /// @warning Calling the size method may result in one-to-all
+  /// communication among localities to retrieve consinstent information.
+  /// @return the size of the bag.
+  size_t Size() const;
+
+  /// @brief Number of elements held by the calling Locality.
+  size_t LocalSize() const { return localBag_.Size(); }
+
+  /// @brief Push an element in the partition of the calling Locality.
+  /// @param[in] element the element.
+  void Push(const T &element) { localBag_.Push(element); }
+
+  /// @brief Push an element in the partition of a given Locality.
+  /// @param[in] loc the target Locality.
+  /// @param[in] element the element.
+  void Push(const rt::Locality &loc, const T &element);
+
+  /// @brief Asynchronously push an element in the partition of a given
+  /// Locality.
+  /// @warning Asynchronous operations are guaranteed to have completed
+  /// only after calling the rt::waitForCompletion(rt::Handle &handle) method.
+  /// @param[in,out] handle Reference to the handle
+  /// to be used to wait for completion.
+  /// @param[in] loc the target Locality.
+  /// @param[in] element the element.
+  void AsyncPush(rt::Handle &handle, const rt::Locality &loc,
+                 const T &element);
+
+  /// @brief Buffered Push method.
+  /// Pushes an element in the partition of a given Locality, using
+  /// aggregation buffers.
+  /// @warning Insertions are finalized only after calling
+  /// the WaitForBufferedPush() method.
+  /// @param[in] loc the target Locality.
+  /// @param[in] element The element.
+  void BufferedPush(const rt::Locality &loc, const T &element) {
+    buffers_.Insert(element, loc);
+  }
+
+  /// @brief Asynchronous Buffered Push method.
+  /// @warning asynchronous buffered insertions are finalized only after
+  /// calling the rt::waitForCompletion(rt::Handle &handle) method AND
+  /// the WaitForBufferedPush() method, in this order.
+  /// @param[in,out] handle Reference to the handle
+  /// @param[in] loc the target Locality.
+  /// @param[in] element The element.
+  void BufferedAsyncPush(rt::Handle &handle, const rt::Locality &loc,
+                         const T &element) {
+    buffers_.AsyncInsert(handle, element, loc);
+  }
+
+  /// @brief Finalize method for buffered pushes.
+  void WaitForBufferedPush() { buffers_.FlushAll(); }
+
+  /// @brief Pop an element from the partition of the calling Locality.
+  /// @param[out] element the removed element, if any.
+  /// @return false if the local partition is empty, true otherwise.
+  bool Pop(T *element) { return localBag_.Pop(element); }
+
+  /// @brief Steal elements from the other localities.
+  ///
+  /// Localities are visited round-robin, starting from the one following the
+  /// calling Locality.  Up to a buffer worth of elements is moved from the
+  /// first non-empty partition: one of them is returned, the others are
+  /// pushed in the local partition.
+  /// @param[out] element the stolen element, if any.
+  /// @return false if no element could be stolen, true otherwise.
+  bool Steal(T *element);
+
+  /// @brief Pop an element, stealing from other localities when the local
+  /// partition is empty.
+  /// @param[out] element the removed element, if any.
+  /// @return false if no element was found, true otherwise.
+  bool PopOrSteal(T *element) { return Pop(element) || Steal(element); }
+
+  /// @brief Remove all the elements.
+  void Clear() {
+    auto clearLambda = [](const ObjectID &oid) {
+      auto bagPtr = BagT::GetPtr(oid);
+      bagPtr->localBag_.Clear();
+    };
+    rt::executeOnAll(clearLambda, oid_);
+  }
+
+  /// @brief Apply a user-defined function to every element, without
+  /// removing them.
+  ///
+  /// @tparam ApplyFunT User-defined function type.  The function prototype
+  /// should be:
+  /// @code
+  /// void(const T&, Args&);
+  /// @endcode
+  /// @tparam ...Args Types of the function arguments.
+  ///
+  /// @param function The function to apply.
+  /// @param args The function arguments.
+  template <typename ApplyFunT, typename... Args>
+  void ForEachElement(ApplyFunT &&function, Args &... args);
+
+  /// @brief Asynchronously apply a user-defined function to every element,
+  /// without removing them.
+  ///
+  /// @tparam ApplyFunT User-defined function type.  The function prototype
+  /// should be:
+  /// @code
+  /// void(rt::Handle&, const T&, Args&);
+  /// @endcode
+  /// @tparam ...Args Types of the function arguments.
+  ///
+  /// @param handle An handle for the associated task-group.
+  /// @param function The function to apply.
+  /// @param args The function arguments.
+  template <typename ApplyFunT, typename... Args>
+  void AsyncForEachElement(rt::Handle &handle, ApplyFunT &&function,
+                           Args &... args);
+
+  // FIXME it should be protected
+  void BufferEntryInsert(const T &element) { localBag_.Push(element); }
+
+ private:
+  ObjectID oid_;
+  LBagT localBag_;
+  BuffersVector buffers_;
+
+  struct ExeAtArgs {
+    ObjectID oid;
+    T element;
+  };
+
+  static constexpr size_t kStealBatchSize =
+      constants::max(constants::kBufferNumBytes / sizeof(T), 1lu);
+
+ protected:
+  Bag(ObjectID oid, const size_t segmentSize = LBagT::kDefaultSegmentSize)
+      : oid_(oid), localBag_(segmentSize), buffers_(oid) {}
+};
+
+template <typename T>
+inline size_t Bag<T>::Size() const {
+  size_t size = localBag_.Size();
+  size_t remoteSize(0);
+  auto sizeLambda = [](const ObjectID &oid, size_t *res) {
+    auto bagPtr = BagT::GetPtr(oid);
+    *res = bagPtr->localBag_.Size();
+  };
+  for (auto tgtLoc : rt::allLocalities()) {
+    if (tgtLoc != rt::thisLocality()) {
+      rt::executeAtWithRet(tgtLoc, sizeLambda, oid_, &remoteSize);
+      size += remoteSize;
+    }
+  }
+  return size;
+}
+
+template <typename T>
+inline void Bag<T>::Push(const rt::Locality &loc, const T &element) {
+  if (loc == rt::thisLocality()) {
+    localBag_.Push(element);
+  } else {
+    auto pushLambda = [](const ExeAtArgs &args) {
+      auto bagPtr = BagT::GetPtr(args.oid);
+      bagPtr->localBag_.Push(args.element);
+    };
+    ExeAtArgs args = {oid_, element};
+    rt::executeAt(loc, pushLambda, args);
+  }
+}
+
+template <typename T>
+inline void Bag<T>::AsyncPush(rt::Handle &handle, const rt::Locality &loc,
+                              const T &element) {
+  if (loc == rt::thisLocality()) {
+    localBag_.Push(element);
+  } else {
+    auto pushLambda = [](rt::Handle &, const ExeAtArgs &args) {
+      auto bagPtr = BagT::GetPtr(args.oid);
+      bagPtr->localBag_.Push(args.element);
+    };
+    ExeAtArgs args = {oid_, element};
+    rt::asyncExecuteAt(handle, loc, pushLambda, args);
+  }
+}
+
+template <typename T>
+bool Bag<T>::Steal(T *element) {
+  auto stealLambda = [](const ObjectID &oid, uint8_t *res,
+                        uint32_t *resSize) {
+    auto bagPtr = BagT::GetPtr(oid);
+    // Leave about half of the elements to the victim.
+    size_t toSteal =
+        std::min(kStealBatchSize, (bagPtr->localBag_.Size() + 1) / 2);
+    size_t stolen =
+        bagPtr->localBag_.Pop(reinterpret_cast<T *>(res), toSteal);
+    *resSize = stolen * sizeof(T);
+  };
+  std::vector<T> stolen(kStealBatchSize);
+  uint32_t numLocalities = rt::numLocalities();
+  uint32_t self = static_cast<uint32_t>(rt::thisLocality());
+  for (uint32_t i = 1; i < numLocalities; ++i) {
+    rt::Locality victim((self + i) % numLocalities);
+    uint32_t resSize = 0;
+    rt::executeAtWithRetBuff(victim, stealLambda, oid_,
+                             reinterpret_cast<uint8_t *>(stolen.data()),
+                             &resSize);
+    size_t numStolen = resSize / sizeof(T);
+    if (numStolen == 0) continue;
+    *element = stolen[0];
+    localBag_.Push(stolen.data() + 1, numStolen - 1);
+    return true;
+  }
+  return false;
+}
+
+template <typename T>
+template <typename ApplyFunT, typename... Args>
+void Bag<T>::ForEachElement(ApplyFunT &&function, Args &... args) {
+  using FunctionTy = void (*)(const T &, Args &...);
+  FunctionTy fn = std::forward<decltype(function)>(function);
+  using feArgs = std::tuple<ObjectID, FunctionTy, std::tuple<Args...>>;
+  using ArgsTuple = std::tuple<LBagT *, FunctionTy, std::tuple<Args...>>;
+  feArgs arguments(oid_, fn, std::tuple<Args...>(args...));
+  auto feLambda = [](const feArgs &args) {
+    auto bagPtr = BagT::GetPtr(std::get<0>(args));
+    ArgsTuple argsTuple(&bagPtr->localBag_, std::get<1>(args),
+                        std::get<2>(args));
+    rt::forEachAt(rt::thisLocality(),
+                  LBagT::template ForEachElementFunWrapper<ArgsTuple, Args...>,
+                  argsTuple, bagPtr->localBag_.NumSegments());
+  };
+  rt::executeOnAll(feLambda, arguments);
+}
+
+template <typename T>
+template <typename ApplyFunT, typename... Args>
+void Bag<T>::AsyncForEachElement(rt::Handle &handle, ApplyFunT &&function,
+                                 Args &... args) {
+  using FunctionTy = void (*)(rt::Handle &, const T &, Args &...);
+  FunctionTy fn = std::forward<decltype(function)>(function);
+  using feArgs = std::tuple<ObjectID, FunctionTy, std::tuple<Args...>>;
+  using ArgsTuple = std::tuple<LBagT *, FunctionTy, std::tuple<Args...>>;
+  feArgs arguments{oid_, fn, std::tuple<Args...>(args...)};
+  auto feLambda = [](rt::Handle &handle, const feArgs &args) {
+    auto bagPtr = BagT::GetPtr(std::get<0>(args));
+    ArgsTuple argsTuple = std::make_tuple(
+        &bagPtr->localBag_, std::get<1>(args), std::get<2>(args));
+    rt::asyncForEachAt(
+        handle, rt::thisLocality(),
+        LBagT::template AsyncForEachElementFunWrapper<ArgsTuple, Args...>,
+        argsTuple, bagPtr->localBag_.NumSegments());
+  };
+  rt::asyncExecuteOnAll(handle, feLambda, arguments);
+}
+
+}  // namespace shad
+
+#endif  // INCLUDE_SHAD_DATA_STRUCTURES_BAG_H_
@@ -0,0 +1,407 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef INCLUDE_SHAD_DATA_STRUCTURES_BLOOM_FILTER_H_
+#define INCLUDE_SHAD_DATA_STRUCTURES_BLOOM_FILTER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "shad/data_structures/abstract_data_structure.h"
+#include "shad/data_structures/buffer.h"
+#include "shad/data_structures/compare_and_hash_utils.h"
+#include "shad/runtime/runtime.h"
+
+namespace shad {
+
+/// @brief The BloomFilter data structure.
+///
+/// SHAD's BloomFilter is a distributed approximate-membership filter: a query
+/// may return false positives, but never false negatives.  Elements are
+/// assigned to localities with the same hashing used by Set and Hashmap, and
+/// each Locality stores a blocked Bloom filter (all the probes of an element
+/// hit the same 512-bit block, i.e., one cache line).
+///
+/// After a call to Replicate(), every Locality holds a read-only copy of the
+/// whole filter, so that queries are answered without communication.  This
+/// is meant to screen out definite negatives before paying for a remote
+/// lookup in a Set or a Hashmap.
+///
+/// Typical usage:
+/// @code
+/// auto filter = shad::BloomFilter<uint64_t>::Create(numVertices, 0.01);
+/// filter->BufferedInsert(v);
+/// filter->WaitForBufferedInsert();
+/// filter->Replicate();
+/// if (filter->MayContain(v)) { /* do the expensive lookup */ }
+/// @endcode
+///
+/// @tparam T type of the elements.
+/// @warning obects of type T need to be trivially copiable.
+template <typename T>
+class BloomFilter : public AbstractDataStructure<BloomFilter<T>> {
+  template <typename>
+  friend class AbstractDataStructure;
+
+ public:
+  using value_type = T;
+  using FilterT = BloomFilter<T>;
+  using ObjectID = typename AbstractDataStructure<FilterT>::ObjectID;
+  using ShadBloomFilterPtr = typename AbstractDataStructure<FilterT>::SharedPtr;
+  using BuffersVector = typename impl::BuffersVector<T, FilterT>;
+
+  /// Number of bits in a block.
+  static constexpr size_t kBlockBits = 512;
+  static constexpr size_t kWordsPerBlock = kBlockBits / 64;
+
+  /// @brief Create method.
+  ///
+  /// Creates a new filter sized for the expected number of elements and the
+  /// target false positive rate.
+  /// @param numElements Expected number of elements.
+  /// @param falsePositiveRate Target false positive rate, in (0, 1).
+  /// @return A shared pointer to the newly created filter instance.
+#ifdef DOXYGEN_IS_RUNNING
+  static ShadBloomFilterPtr Create(const size_t numElements,
+                                   const double falsePositiveRate);
+#endif
+
+  /// @brief Getter of the Global Identifier.
+  ///
+  /// @return The global identifier associated with the filter instance.
+  ObjectID GetGlobalID() const { return oid_; }
+
+  /// @brief Number of hash probes per element.
+  size_t NumHashes() const { return numHashes_; }
+
+  /// @brief Number of bits stored on each Locality.
+  size_t LocalNumBits() const { return numBlocks_ * kBlockBits; }
+
+  /// @brief Insert an element in the filter.
+  /// @param[in] element the element.
+  void Insert(const T &element);
+
+  /// @brief Asynchronously Insert an element in the filter.
+  /// @warning Asynchronous operations are guaranteed to have completed
+  /// only after calling the rt::waitForCompletion(rt::Handle &handle) method.
+  /// @param[in,out] handle Reference to the handle
+  /// to be used to wait for completion.
+  /// @param[in] element the element.
+  void AsyncInsert(rt::Handle &handle, const T &element);
+
+  /// @brief Buffered Insert method.
+  /// Inserts an element, using aggregation buffers.
+  /// @warning Insertions are finalized only after calling
+  /// the WaitForBufferedInsert() method.
+  /// @param[in] element The element.
+  void BufferedInsert(const T &element) {
+    buffers_.Insert(element, TargetLocality(element));
+  }
+
+  /// @brief Asynchronous Buffered Insert method.
+  /// Asynchronously inserts an element, using aggregation buffers.
+  /// @warning asynchronous buffered insertions are finalized only after
+  /// calling the rt::waitForCompletion(rt::Handle &handle) method AND
+  /// the WaitForBufferedInsert() method, in this order.
+  /// @param[in,out] handle Reference to the handle
+  /// @param[in] element The element.
+  void BufferedAsyncInsert(rt::Handle &handle, const T &element) {
+    buffers_.AsyncInsert(handle, element, TargetLocality(element));
+  }
+
+  /// @brief Finalize method for buffered insertions.
+  void WaitForBufferedInsert() { buffers_.FlushAll(); }
+
+  /// @brief Membership query.
+  ///
+  /// Uses the local replica, if any, otherwise queries the owner Locality.
+  /// @param[in] element the element.
+  /// @return false if the element has definitely not been inserted, true if
+  /// it may have been inserted.
+  bool MayContain(const T &element);
+
+  /// @brief Batched membership query.
+  ///
+  /// Elements are grouped by owner Locality and each group is queried with a
+  /// single message; with a local replica no message is sent at all.
+  /// @param[in] elements the elements to query.
+  /// @param[in] numElements the number of elements.
+  /// @param[out] results results[i] is true if elements[i] may be in the
+  /// filter.
+  void MayContain(const T *elements, size_t numElements, bool *results);
+
+  /// @brief Build, on every Locality, a read-only copy of the whole filter.
+  ///
+  /// @warning Insertions performed after Replicate are not visible to the
+  /// replicas until the next call to Replicate.
+  void Replicate();
+
+  /// @brief Release the replicas built by Replicate.
+  void DropReplicas() {
+    auto dropLambda = [](const ObjectID &oid) {
+      auto ptr = FilterT::GetPtr(oid);
+      ptr->replica_.clear();
+      ptr->replica_.shrink_to_fit();
+    };
+    rt::executeOnAll(dropLambda, oid_);
+  }
+
+  /// @brief Reset the filter to the empty state.
+  void Clear() {
+    auto clearLambda = [](const ObjectID &oid) {
+      auto ptr = FilterT::GetPtr(oid);
+      for (size_t i = 0; i < ptr->numBlocks_ * kWordsPerBlock; ++i)
+        ptr->bits_[i] = 0;
+      ptr->replica_.clear();
+    };
+    rt::executeOnAll(clearLambda, oid_);
+  }
+
+  // FIXME it should be protected
+  void BufferEntryInsert(const T &element) { LocalInsert(element); }
+
+ private:
+  ObjectID oid_;
+  size_t numBlocks_;
+  size_t numHashes_;
+  std::unique_ptr<std::atomic<uint64_t>[]> bits_;
+  std::vector<uint64_t> replica_;
+  BuffersVector buffers_;
+
+  struct ExeAtArgs {
+    ObjectID oid;
+    T element;
+  };
+
+  static constexpr size_t kQueryBatchSize =
+      constants::max(constants::kBufferNumBytes / sizeof(T), 1lu);
+
+  struct QueryArgs {
+    explicit QueryArgs(const ObjectID &oid) : oid(oid), numElements(0) {}
+    ObjectID oid;
+    size_t numElements;
+    T elements[kQueryBatchSize];
+  };
+
+  static rt::Locality TargetLocality(const T &element) {
+    return rt::Locality(shad::hash<T>{}(element) % rt::numLocalities());
+  }
+
+  // Returns the block of element, and the two values used for the double
+  // hashing of the bit positions within the block.
+  size_t Probe(const T &element, uint32_t *h1, uint32_t *h2) const {
+    uint64_t hash = shad::HashFunction(element, 42u);
+    *h1 = static_cast<uint32_t>(hash);
+    *h2 = static_cast<uint32_t>(hash >> 32) | 1;
+    return (hash ^ (hash >> 29)) % numBlocks_;
+  }
+
+  void LocalInsert(const T &element) {
+    uint32_t h1, h2;
+    std::atomic<uint64_t> *block = &bits_[Probe(element, &h1, &h2) *
+                                          kWordsPerBlock];
+    for (size_t i = 0; i < numHashes_; ++i) {
+      uint32_t bit = (h1 + i * h2) % kBlockBits;
+      block[bit / 64].fetch_or(1ull << (bit % 64), std::memory_order_relaxed);
+    }
+  }
+
+  template <typename WordT>
+  bool TestBlock(const WordT *block, uint32_t h1, uint32_t h2) const {
+    for (size_t i = 0; i < numHashes_; ++i) {
+      uint32_t bit = (h1 + i * h2) % kBlockBits;
+      if (!(static_cast<uint64_t>(block[bit / 64]) & (1ull << (bit % 64))))
+        return false;
+    }
+    return true;
+  }
+
+  bool LocalMayContain(const T &element) const {
+    uint32_t h1, h2;
+    size_t block = Probe(element, &h1, &h2);
+    return TestBlock(&bits_[block * kWordsPerBlock], h1, h2);
+  }
+
+  bool ReplicaMayContain(const T &element) const {
+    uint32_t h1, h2;
+    size_t block = Probe(element, &h1, &h2);
+    size_t owner = static_cast<uint32_t>(TargetLocality(element));
+    return TestBlock(
+        &replica_[(owner * numBlocks_ + block) * kWordsPerBlock], h1, h2);
+  }
+
+ protected:
+  BloomFilter(ObjectID oid, const size_t numElements,
+              const double falsePositiveRate)
+      : oid_(oid), buffers_(oid) {
+    double fpr = std::min(std::max(falsePositiveRate, 1e-9), 0.5);
+    double ln2 = std::log(2.0);
+    double numBits = -static_cast<double>(std::max(numElements, 1lu)) *
+                     std::log(fpr) / (ln2 * ln2);
+    size_t localBits = static_cast<size_t>(numBits / rt::numLocalities()) + 1;
+    numBlocks_ = (localBits + kBlockBits - 1) / kBlockBits;
+    numHashes_ = std::max(
+        static_cast<size_t>(std::round(-std::log(fpr) / ln2)), 1lu);
+    bits_.reset(new std::atomic<uint64_t>[numBlocks_ * kWordsPerBlock]);
+    for (size_t i = 0; i < numBlocks_ * kWordsPerBlock; ++i) bits_[i] = 0;
+  }
+};
+
+template <typename T>
+inline void BloomFilter<T>::Insert(const T &element) {
+  rt::Locality targetLocality = TargetLocality(element);
+  if (targetLocality == rt::thisLocality()) {
+    LocalInsert(element);
+  } else {
+    auto insertLambda = [](const ExeAtArgs &args) {
+      FilterT::GetPtr(args.oid)->LocalInsert(args.element);
+    };
+    ExeAtArgs args = {oid_, element};
+    rt::executeAt(targetLocality, insertLambda, args);
+  }
+}
+
+template <typename T>
+inline void BloomFilter<T>::AsyncInsert(rt::Handle &handle,
+                                        const T &element) {
+  rt::Locality targetLocality = TargetLocality(element);
+  if (targetLocality == rt::thisLocality()) {
+    LocalInsert(element);
+  } else {
+    auto insertLambda = [](rt::Handle &, const ExeAtArgs &args) {
+      FilterT::GetPtr(args.oid)->LocalInsert(args.element);
+    };
+    ExeAtArgs args = {oid_, element};
+    rt::asyncExecuteAt(handle, targetLocality, insertLambda, args);
+  }
+}
+
+template <typename T>
+inline bool BloomFilter<T>::MayContain(const T &element) {
+  if (!replica_.empty()) return ReplicaMayContain(element);
+  rt::Locality targetLocality = TargetLocality(element);
+  if (targetLocality == rt::thisLocality()) return LocalMayContain(element);
+  auto queryLambda = [](const ExeAtArgs &args, bool *res) {
+    *res = FilterT::GetPtr(args.oid)->LocalMayContain(args.element);
+  };
+  ExeAtArgs args = {oid_, element};
+  bool res;
+  rt::executeAtWithRet(targetLocality, queryLambda, args, &res);
+  return res;
+}
+
+template <typename T>
+void BloomFilter<T>::MayContain(const T *elements, size_t numElements,
+                                bool *results) {
+  if (!replica_.empty()) {
+    for (size_t i = 0; i < numElements; ++i)
+      results[i] = ReplicaMayContain(elements[i]);
+    return;
+  }
+
+  // Group the positions of the elements by owner.
+  std::vector<std::vector<size_t>> positions(rt::numLocalities());
+  for (size_t i = 0; i < numElements; ++i) {
+    auto loc = TargetLocality(elements[i]);
+    if (loc == rt::thisLocality())
+      results[i] = LocalMayContain(elements[i]);
+    else
+      positions[static_cast<uint32_t>(loc)].push_back(i);
+  }
+
+  auto queryLambda = [](rt::Handle &, const QueryArgs &args, uint8_t *res,
+                        uint32_t *resSize) {
+    auto ptr = FilterT::GetPtr(args.oid);
+    for (size_t i = 0; i < args.numElements; ++i)
+      res[i] = ptr->LocalMayContain(args.elements[i]);
+    *resSize = args.numElements;
+  };
+
+  size_t numBatches = 0;
+  for (auto &p : positions)
+    numBatches += (p.size() + kQueryBatchSize - 1) / kQueryBatchSize;
+  std::vector<uint8_t> answers(numBatches * kQueryBatchSize);
+  std::vector<uint32_t> answerSizes(numBatches);
+
+  rt::Handle handle;
+  QueryArgs args(oid_);
+  size_t batch = 0;
+  for (uint32_t loc = 0; loc < positions.size(); ++loc) {
+    auto &p = positions[loc];
+    for (size_t first = 0; first < p.size(); first += kQueryBatchSize) {
+      args.numElements = std::min(kQueryBatchSize, p.size() - first);
+      for (size_t i = 0; i < args.numElements; ++i)
+        args.elements[i] = elements[p[first + i]];
+      rt::asyncExecuteAtWithRetBuff(handle, rt::Locality(loc), queryLambda,
+                                    args, &answers[batch * kQueryBatchSize],
+                                    &answerSizes[batch]);
+      ++batch;
+    }
+  }
+  rt::waitForCompletion(handle);
+
+  batch = 0;
+  for (auto &p : positions) {
+    for (size_t first = 0; first < p.size(); first += kQueryBatchSize) {
+      size_t n = std::min(kQueryBatchSize, p.size() - first);
+      for (size_t i = 0; i < n; ++i)
+        results[p[first + i]] = answers[batch * kQueryBatchSize + i];
+      ++batch;
+    }
+  }
+}
+
+template <typename T>
+void BloomFilter<T>::Replicate() {
+  auto replicateLambda = [](const ObjectID &oid) {
+    auto ptr = FilterT::GetPtr(oid);
+    size_t localWords = ptr->numBlocks_ * kWordsPerBlock;
+    ptr->replica_.assign(localWords * rt::numLocalities(), 0);
+    auto getBitsLambda = [](const ObjectID &oid, const uint64_t **res) {
+      auto ptr = FilterT::GetPtr(oid);
+      *res = reinterpret_cast<const uint64_t *>(ptr->bits_.get());
+    };
+    for (auto &loc : rt::allLocalities()) {
+      uint64_t *dst =
+          ptr->replica_.data() + static_cast<uint32_t>(loc) * localWords;
+      if (loc == rt::thisLocality()) {
+        for (size_t i = 0; i < localWords; ++i) dst[i] = ptr->bits_[i];
+        continue;
+      }
+      const uint64_t *remoteBits;
+      rt::executeAtWithRet(loc, getBitsLambda, oid, &remoteBits);
+      rt::dma(dst, loc, remoteBits, localWords);
+    }
+  };
+  rt::executeOnAll(replicateLambda, oid_);
+}
+
+}  // namespace shad
+
+#endif  // INCLUDE_SHAD_DATA_STRUCTURES_BLOOM_FILTER_H_
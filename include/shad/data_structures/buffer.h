@@ -28,6 +28,9 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "shad/data_structures/object_identifier.h"
@@ -220,6 +223,156 @@ class BuffersVector {
   std::vector<BufferType> buffers_;
 };
 
+/// @brief The SerializedBuffer utility.
+///
+/// Buffer used to aggregate variable-length entries in insertion methods.
+/// Entries are appended in their serialized form and handed back to the
+/// DataStructure instance on the target Locality through the
+/// BufferEntriesInsert(const uint8_t *, size_t) method.
+/// @tparam DataStructure DataStructure using the buffer.
+template <typename DataStructure>
+class SerializedBuffer {
+  template <typename>
+  friend class SerializedBuffersVector;
+
+ public:
+  /// Size of the buffer in bytes.
+  constexpr static size_t kBufferSize = constants::kBufferNumBytes;
+  using ObjectID = ObjectIdentifier<DataStructure>;
+
+  SerializedBuffer(const SerializedBuffer& rhs)
+      : size_(rhs.size_), lock_(), oid_(rhs.oid_), tgtLoc_(rhs.tgtLoc_) {
+    std::memcpy(data_.data(), rhs.data_.data(), size_);
+  }
+
+  explicit SerializedBuffer(const ObjectID& oid)
+      : size_(0), lock_(), oid_(oid), tgtLoc_() {}
+
+  void FlushBuffer() {
+    if (size_ == 0) return;
+    rt::executeAt(tgtLoc_, InsertEntriesLambda,
+                  PackMessage(data_.data(), size_), sizeof(ObjectID) + size_);
+    size_ = 0;
+  }
+
+  void AsyncFlushBuffer(rt::Handle& handle) {
+    if (size_ == 0) return;
+    rt::asyncExecuteAt(handle, tgtLoc_, AsyncInsertEntriesLambda,
+                       PackMessage(data_.data(), size_),
+                       sizeof(ObjectID) + size_);
+    size_ = 0;
+  }
+
+  void Insert(const uint8_t* entry, const size_t numBytes) {
+    std::lock_guard<rt::Lock> _(lock_);
+    if (size_ + numBytes > kBufferSize) FlushBuffer();
+    if (numBytes > kBufferSize) {
+      rt::executeAt(tgtLoc_, InsertEntriesLambda, PackMessage(entry, numBytes),
+                    sizeof(ObjectID) + numBytes);
+      return;
+    }
+    std::memcpy(data_.data() + size_, entry, numBytes);
+    size_ += numBytes;
+  }
+
+  void AsyncInsert(rt::Handle& handle, const uint8_t* entry,
+                   const size_t numBytes) {
+    std::lock_guard<rt::Lock> _(lock_);
+    if (size_ + numBytes > kBufferSize) AsyncFlushBuffer(handle);
+    if (numBytes > kBufferSize) {
+      rt::asyncExecuteAt(handle, tgtLoc_, AsyncInsertEntriesLambda,
+                         PackMessage(entry, numBytes),
+                         sizeof(ObjectID) + numBytes);
+      return;
+    }
+    std::memcpy(data_.data() + size_, entry, numBytes);
+    size_ += numBytes;
+  }
+
+ private:
+  static std::shared_ptr<uint8_t> PackMessage(const ObjectID& oid,
+                                              const uint8_t* entries,
+                                              const size_t numBytes) {
+    std::shared_ptr<uint8_t> message(new uint8_t[sizeof(ObjectID) + numBytes],
+                                     std::default_delete<uint8_t[]>());
+    std::memcpy(message.get(), &oid, sizeof(ObjectID));
+    std::memcpy(message.get() + sizeof(ObjectID), entries, numBytes);
+    return message;
+  }
+
+  std::shared_ptr<uint8_t> PackMessage(const uint8_t* entries,
+                                       const size_t numBytes) const {
+    return PackMessage(oid_, entries, numBytes);
+  }
+
+  static void InsertEntries(const uint8_t* message, const uint32_t numBytes) {
+    ObjectID oid(ObjectID::kNullID);
+    std::memcpy(&oid, message, sizeof(ObjectID));
+    auto dsPtr = DataStructure::GetPtr(oid);
+    dsPtr->BufferEntriesInsert(message + sizeof(ObjectID),
+                               numBytes - sizeof(ObjectID));
+  }
+
+  static void InsertEntriesLambda(const uint8_t* message,
+                                  const uint32_t numBytes) {
+    InsertEntries(message, numBytes);
+  }
+
+  static void AsyncInsertEntriesLambda(rt::Handle&, const uint8_t* message,
+                                       const uint32_t numBytes) {
+    InsertEntries(message, numBytes);
+  }
+
+  std::array<uint8_t, kBufferSize> data_;
+  size_t size_;
+  rt::Lock lock_;
+  ObjectID oid_;
+
+ protected:
+  rt::Locality tgtLoc_;
+};
+
+/// Vector of serialized buffers, of size NumLocalities,
+/// accessed by the remote locality ID
+template <typename DataStructure>
+class SerializedBuffersVector {
+ public:
+  using BufferType = SerializedBuffer<DataStructure>;
+  explicit SerializedBuffersVector(ObjectIdentifier<DataStructure> oid)
+      : buffers_(rt::numLocalities(), BufferType(oid)) {
+    for (size_t i = 0; i < (rt::numLocalities()); i++) {
+      buffers_[i].tgtLoc_ = rt::Locality(i);
+    }
+  }
+
+  void Insert(const uint8_t* entry, const size_t numBytes,
+              const rt::Locality& tgtLoc) {
+    uint32_t tgtId = static_cast<uint32_t>(tgtLoc);
+    buffers_[tgtId].Insert(entry, numBytes);
+  }
+
+  void AsyncInsert(rt::Handle& handle, const uint8_t* entry,
+                   const size_t numBytes, const rt::Locality& tgtLoc) {
+    uint32_t tgtId = static_cast<uint32_t>(tgtLoc);
+    buffers_.at(tgtId).AsyncInsert(handle, entry, numBytes);
+  }
+
+  void FlushAll() {
+    for (auto& buffer : buffers_) {
+      buffer.FlushBuffer();
+    }
+  }
+
+  void AsyncFlushAll(rt::Handle& handle) {
+    for (auto& buffer : buffers_) {
+      buffer.AsyncFlushBuffer(handle);
+    }
+  }
+
+ private:
+  std::vector<BufferType> buffers_;
+};
+
 }  // namespace impl
 }  // namespace shad
 
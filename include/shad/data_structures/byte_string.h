@@ -0,0 +1,350 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef INCLUDE_SHAD_DATA_STRUCTURES_BYTE_STRING_H_
+#define INCLUDE_SHAD_DATA_STRUCTURES_BYTE_STRING_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "shad/data_structures/compare_and_hash_utils.h"
+#include "shad/runtime/runtime.h"
+
+namespace shad {
+
+/// @brief The ArenaAllocator utility.
+///
+/// Bump allocator used to store the payload of variable-length objects
+/// (e.g., ByteString) on a Locality.  Memory is carved out of large chunks
+/// with a single atomic fetch-add; chunks are never returned to the system
+/// before the end of the program.
+///
+/// Typical Usage:
+/// @code
+/// uint8_t *buffer = shad::ArenaAllocator::Instance().Allocate(42);
+/// @endcode
+///
+/// @warning Memory obtained from the arena is never released, erasing
+/// or overwriting an entry does not reclaim its storage.
+class ArenaAllocator {
+ public:
+  /// Size in bytes of the chunks managed by the arena.
+  static constexpr size_t kChunkSize = 1 << 20;
+  /// Alignment of the returned allocations.
+  static constexpr size_t kAlignment = alignof(std::max_align_t);
+
+  ArenaAllocator() : current_(nullptr), bytesAllocated_(0) { NewChunk(); }
+
+  ArenaAllocator(const ArenaAllocator &) = delete;
+  ArenaAllocator &operator=(const ArenaAllocator &) = delete;
+
+  /// @brief The arena of the calling Locality.
+  /// @return A reference to the Locality-wide arena.
+  static ArenaAllocator &Instance() {
+    static ArenaAllocator arena;
+    return arena;
+  }
+
+  /// @brief Allocate a block of memory from the arena.
+  /// @param[in] numBytes The size of the block.
+  /// @return A pointer to the allocated block.
+  uint8_t *Allocate(size_t numBytes) {
+    numBytes = (numBytes + kAlignment - 1) & ~(kAlignment - 1);
+    bytesAllocated_ += numBytes;
+    if (numBytes > kChunkSize / 4) return DedicatedChunk(numBytes);
+
+    for (;;) {
+      Chunk *chunk = current_.load();
+      size_t offset = chunk->used.fetch_add(numBytes);
+      if (offset + numBytes <= kChunkSize) return chunk->data.get() + offset;
+
+      std::lock_guard<rt::Lock> _(lock_);
+      if (current_.load() == chunk) NewChunk();
+    }
+  }
+
+  /// @brief Number of bytes handed out by the arena so far.
+  size_t BytesAllocated() const { return bytesAllocated_; }
+
+ private:
+  struct Chunk {
+    explicit Chunk(size_t size) : data(new uint8_t[size]), used(0) {}
+    std::unique_ptr<uint8_t[]> data;
+    std::atomic<size_t> used;
+  };
+
+  void NewChunk() {
+    chunks_.emplace_back(new Chunk(kChunkSize));
+    current_ = chunks_.back().get();
+  }
+
+  uint8_t *DedicatedChunk(size_t numBytes) {
+    std::lock_guard<rt::Lock> _(lock_);
+    chunks_.emplace_back(new Chunk(numBytes));
+    chunks_.back()->used = numBytes;
+    return chunks_.back()->data.get();
+  }
+
+  std::vector<std::unique_ptr<Chunk>> chunks_;
+  std::atomic<Chunk *> current_;
+  std::atomic<size_t> bytesAllocated_;
+  rt::Lock lock_;
+};
+
+/// @brief Variable-length sequence of bytes.
+///
+/// ByteString is a fixed-footprint handle to a sequence of bytes that can be
+/// used as key or value of SHAD's hashmaps.  Short sequences (up to
+/// kInlineSize bytes) are stored inline, longer ones are copied in the
+/// ArenaAllocator of the Locality that creates the object.  The handle keeps a
+/// 32-bit hash of the content, so that comparisons between different strings
+/// usually terminate without touching the payload.
+///
+/// Typical Usage:
+/// @code
+/// using MapT = shad::Hashmap<shad::ByteString, shad::ByteString>;
+/// auto map = MapT::Create(1024);
+/// map->Insert(shad::ByteString("key"), shad::ByteString("value"));
+/// @endcode
+///
+/// @warning The payload of long strings lives in the local arena: objects
+/// travel between localities through their serialized form
+/// (see SerializedSize(), Serialize(), and Deserialize()).
+class ByteString {
+ public:
+  /// Number of bytes stored without using the arena.
+  static constexpr uint32_t kInlineSize = 16;
+
+  ByteString() : size_(0), hash_(HashBytes(nullptr, 0)) {
+    std::memset(inline_, 0, kInlineSize);
+  }
+
+  /// @brief Constructor.
+  /// @param[in] data Pointer to the bytes to copy.
+  /// @param[in] size Number of bytes to copy.
+  ByteString(const void *data, size_t size)
+      : size_(static_cast<uint32_t>(size)),
+        hash_(HashBytes(reinterpret_cast<const uint8_t *>(data), size)) {
+    std::memset(inline_, 0, kInlineSize);
+    if (size_ <= kInlineSize) {
+      std::memcpy(inline_, data, size_);
+    } else {
+      uint8_t *payload = ArenaAllocator::Instance().Allocate(size_);
+      std::memcpy(payload, data, size_);
+      ptr_ = payload;
+    }
+  }
+
+  explicit ByteString(const char *str) : ByteString(str, std::strlen(str)) {}
+
+  explicit ByteString(const std::string &str)
+      : ByteString(str.data(), str.size()) {}
+
+  /// @brief Pointer to the first byte of the sequence.
+  const uint8_t *data() const { return IsInline() ? inline_ : ptr_; }
+
+  /// @brief Number of bytes in the sequence.
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  /// @brief True if the payload is stored within the object.
+  bool IsInline() const { return size_ <= kInlineSize; }
+
+  /// @brief The 32-bit hash of the content.
+  uint32_t HashPrefix() const { return hash_; }
+
+  /// @brief A copy of the content as std::string.
+  std::string str() const {
+    return std::string(reinterpret_cast<const char *>(data()), size_);
+  }
+
+  /// @brief Number of bytes required by Serialize().
+  size_t SerializedSize() const { return sizeof(uint32_t) + size_; }
+
+  /// @brief Write the compact representation of the object.
+  /// @param[out] buffer The destination buffer.
+  /// @return A pointer to the first byte after the written data.
+  uint8_t *Serialize(uint8_t *buffer) const {
+    std::memcpy(buffer, &size_, sizeof(uint32_t));
+    std::memcpy(buffer + sizeof(uint32_t), data(), size_);
+    return buffer + SerializedSize();
+  }
+
+  /// @brief Read an object written by Serialize().
+  ///
+  /// Long payloads are copied into the arena of the calling Locality.
+  /// @param[in,out] buffer The source buffer; it is advanced past the object.
+  /// @return The deserialized object.
+  static ByteString Deserialize(const uint8_t **buffer) {
+    uint32_t size;
+    std::memcpy(&size, *buffer, sizeof(uint32_t));
+    ByteString res(*buffer + sizeof(uint32_t), size);
+    *buffer += sizeof(uint32_t) + size;
+    return res;
+  }
+
+  bool operator==(const ByteString &rhs) const {
+    return hash_ == rhs.hash_ && size_ == rhs.size_ &&
+           std::memcmp(data(), rhs.data(), size_) == 0;
+  }
+
+  bool operator!=(const ByteString &rhs) const { return !(*this == rhs); }
+
+  /// @brief Lexicographical byte-wise ordering.
+  bool operator<(const ByteString &rhs) const {
+    int res = std::memcmp(data(), rhs.data(), std::min(size_, rhs.size_));
+    return res < 0 || (res == 0 && size_ < rhs.size_);
+  }
+
+  friend std::ostream &operator<<(std::ostream &os, const ByteString &rhs) {
+    return os.write(reinterpret_cast<const char *>(rhs.data()), rhs.size_);
+  }
+
+ private:
+  static uint32_t HashBytes(const uint8_t *data, size_t size) {
+    uint64_t hash = 0;
+    for (size_t i = 0; i < size; ++i) {
+      hash += data[i];
+      hash += (hash << 10);
+      hash ^= (hash >> 6);
+    }
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    hash += (hash << 15);
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+  }
+
+  uint32_t size_;
+  uint32_t hash_;
+  union {
+    uint8_t inline_[kInlineSize];
+    const uint8_t *ptr_;
+  };
+};
+
+/// @brief Comparison functor specialized for ByteString.
+///
+/// The stored hash and the length are checked before the payload.
+///
+/// @return false if first == second, true otherwise.
+template <>
+class MemCmp<ByteString> {
+ public:
+  bool operator()(const ByteString *first, const ByteString *second) const {
+    return !(*first == *second);
+  }
+};
+
+/// @brief Hash functor specialized for ByteString.
+///
+/// ByteString is not std-hashable for shad::is_std_hashable, so this is the
+/// functor used by Hashmap and Set.  It returns the hash stored in the
+/// object, without reading the payload.
+template <>
+struct hash<ByteString, false> {
+  size_t operator()(const ByteString &str) const noexcept {
+    return str.HashPrefix();
+  }
+};
+
+namespace impl {
+
+/// @brief Serialization traits used by data structures to ship keys and
+/// values between localities.
+///
+/// The default implementation copies the bytes of trivially copiable types.
+/// Variable-length types specialize it to produce their compact form, and to
+/// Fetch() the payload of objects that were copied bitwise from a remote
+/// Locality.
+/// @tparam T The type to serialize.
+template <typename T>
+struct SerializationTraits {
+  static constexpr bool kIsVariableLength = false;
+
+  static size_t Size(const T &) { return sizeof(T); }
+
+  static uint8_t *Serialize(const T &obj, uint8_t *buffer) {
+    std::memcpy(buffer, &obj, sizeof(T));
+    return buffer + sizeof(T);
+  }
+
+  static T Deserialize(const uint8_t **buffer) {
+    T obj;
+    std::memcpy(&obj, *buffer, sizeof(T));
+    *buffer += sizeof(T);
+    return obj;
+  }
+
+  static T Fetch(const rt::Locality &, const T &obj) { return obj; }
+};
+
+template <>
+struct SerializationTraits<ByteString> {
+  static constexpr bool kIsVariableLength = true;
+
+  static size_t Size(const ByteString &obj) { return obj.SerializedSize(); }
+
+  static uint8_t *Serialize(const ByteString &obj, uint8_t *buffer) {
+    return obj.Serialize(buffer);
+  }
+
+  static ByteString Deserialize(const uint8_t **buffer) {
+    return ByteString::Deserialize(buffer);
+  }
+
+  // Copy the payload of an object received from loc in the local arena.
+  static ByteString Fetch(const rt::Locality &loc, const ByteString &obj) {
+    if (obj.IsInline() || loc == rt::thisLocality()) return obj;
+    std::unique_ptr<uint8_t[]> payload(new uint8_t[obj.size()]);
+    rt::dma(payload.get(), loc, obj.data(), obj.size());
+    return ByteString(payload.get(), obj.size());
+  }
+};
+
+}  // namespace impl
+
+}  // namespace shad
+
+namespace std {
+
+template <>
+struct hash<shad::ByteString> {
+  size_t operator()(const shad::ByteString &str) const noexcept {
+    return str.HashPrefix();
+  }
+};
+
+}  // namespace std
+
+#endif  // INCLUDE_SHAD_DATA_STRUCTURES_BYTE_STRING_H_
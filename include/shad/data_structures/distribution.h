@@ -0,0 +1,252 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef INCLUDE_SHAD_DATA_STRUCTURES_DISTRIBUTION_H_
+#define INCLUDE_SHAD_DATA_STRUCTURES_DISTRIBUTION_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "shad/runtime/runtime.h"
+
+namespace shad {
+
+/// @brief Block distribution policy.
+///
+/// Each Locality owns one contiguous range of positions; the ranges differ
+/// in size by at most one element, and the larger ones are assigned to the
+/// last localities.
+///
+/// All the distribution policies expose the same interface:
+///   - Init(size, numLocalities) computes the layout of size elements;
+///   - Owner(pos) returns the Locality owning a position together with its
+///     offset in the local storage of that Locality, in constant time;
+///   - GlobalPosition(loc, offset) is the inverse of Owner();
+///   - LocalSize(loc) is the number of elements owned by a Locality;
+///   - RunLength(pos) is the number of consecutive positions, starting from
+///     pos, stored contiguously on the owner of pos.
+class BlockDistribution {
+ public:
+  /// True if each Locality owns a contiguous range of positions.
+  static constexpr bool kContiguous = true;
+
+  void Init(size_t size, uint32_t numLocalities) {
+    chunkSize_ = size / numLocalities;
+    pivot_ = (size % numLocalities == 0)
+                 ? numLocalities
+                 : numLocalities - (size % numLocalities);
+  }
+
+  std::pair<rt::Locality, size_t> Owner(size_t pos) const {
+    size_t boundary = pivot_ * chunkSize_;
+    if (pos < boundary)
+      return std::make_pair(rt::Locality(pos / chunkSize_), pos % chunkSize_);
+    size_t newPos = pos - boundary;
+    return std::make_pair(rt::Locality(pivot_ + newPos / (chunkSize_ + 1)),
+                          newPos % (chunkSize_ + 1));
+  }
+
+  size_t GlobalPosition(uint32_t loc, size_t offset) const {
+    if (loc < pivot_) return loc * chunkSize_ + offset;
+    return pivot_ * chunkSize_ + (loc - pivot_) * (chunkSize_ + 1) + offset;
+  }
+
+  size_t LocalSize(uint32_t loc) const {
+    return loc < pivot_ ? chunkSize_ : chunkSize_ + 1;
+  }
+
+  size_t RunLength(size_t pos) const {
+    auto owner = Owner(pos);
+    return LocalSize(static_cast<uint32_t>(owner.first)) - owner.second;
+  }
+
+ private:
+  size_t chunkSize_ = 0;
+  uint32_t pivot_ = 0;
+};
+
+/// @brief Cyclic distribution policy.
+///
+/// Position i is owned by Locality i % numLocalities.
+class CyclicDistribution {
+ public:
+  /// True if each Locality owns a contiguous range of positions.
+  static constexpr bool kContiguous = false;
+
+  void Init(size_t size, uint32_t numLocalities) {
+    size_ = size;
+    numLocalities_ = numLocalities;
+  }
+
+  std::pair<rt::Locality, size_t> Owner(size_t pos) const {
+    return std::make_pair(rt::Locality(pos % numLocalities_),
+                          pos / numLocalities_);
+  }
+
+  size_t GlobalPosition(uint32_t loc, size_t offset) const {
+    return offset * numLocalities_ + loc;
+  }
+
+  size_t LocalSize(uint32_t loc) const {
+    return size_ / numLocalities_ + (loc < size_ % numLocalities_ ? 1 : 0);
+  }
+
+  size_t RunLength(size_t) const { return 1; }
+
+ private:
+  size_t size_ = 0;
+  uint32_t numLocalities_ = 1;
+};
+
+/// @brief Block-cyclic distribution policy.
+///
+/// Positions are grouped in blocks of blockSize elements, and blocks are
+/// dealt to the localities in round-robin.
+///
+/// Typical usage:
+/// @code
+/// using ArrayT = shad::Array<size_t, shad::BlockCyclicDistribution>;
+/// auto arrayPtr =
+///     ArrayT::Create(kArraySize, 0lu, shad::BlockCyclicDistribution(64));
+/// @endcode
+class BlockCyclicDistribution {
+ public:
+  /// True if each Locality owns a contiguous range of positions.
+  static constexpr bool kContiguous = false;
+
+  /// @brief Constructor.
+  /// @param blockSize The number of consecutive positions in a block.
+  explicit BlockCyclicDistribution(size_t blockSize = 64)
+      : blockSize_(std::max(blockSize, size_t(1))) {}
+
+  void Init(size_t size, uint32_t numLocalities) {
+    size_ = size;
+    numLocalities_ = numLocalities;
+  }
+
+  std::pair<rt::Locality, size_t> Owner(size_t pos) const {
+    size_t block = pos / blockSize_;
+    return std::make_pair(
+        rt::Locality(block % numLocalities_),
+        (block / numLocalities_) * blockSize_ + pos % blockSize_);
+  }
+
+  size_t GlobalPosition(uint32_t loc, size_t offset) const {
+    size_t block = (offset / blockSize_) * numLocalities_ + loc;
+    return block * blockSize_ + offset % blockSize_;
+  }
+
+  size_t LocalSize(uint32_t loc) const {
+    size_t numFullBlocks = size_ / blockSize_;
+    size_t lastOwner = numFullBlocks % numLocalities_;
+    size_t localBlocks =
+        numFullBlocks / numLocalities_ + (loc < lastOwner ? 1 : 0);
+    return localBlocks * blockSize_ +
+           (loc == lastOwner ? size_ % blockSize_ : 0);
+  }
+
+  size_t RunLength(size_t pos) const { return blockSize_ - pos % blockSize_; }
+
+  size_t BlockSize() const { return blockSize_; }
+
+ private:
+  size_t blockSize_;
+  size_t size_ = 0;
+  uint32_t numLocalities_ = 1;
+};
+
+/// @brief Distribution policy with explicit per-Locality sizes.
+///
+/// Each Locality owns one contiguous range of positions of a user-defined
+/// size, e.g., to assign fewer vertices of a power-law graph to the
+/// localities holding the hubs.  Owner() uses a guide table with a few
+/// entries per Locality, so that the lookup takes constant time unless the
+/// sizes are extremely unbalanced.
+///
+/// @warning Arrays using this policy are created through
+/// Array::CreateWithLocalSizes(); without explicit sizes the policy falls
+/// back to the layout of BlockDistribution.
+class ExplicitDistribution {
+ public:
+  /// True if each Locality owns a contiguous range of positions.
+  static constexpr bool kContiguous = true;
+
+  void Init(size_t size, uint32_t numLocalities) {
+    BlockDistribution block;
+    block.Init(size, numLocalities);
+    std::vector<size_t> sizes(numLocalities);
+    for (uint32_t i = 0; i < numLocalities; ++i) sizes[i] = block.LocalSize(i);
+    SetLocalSizes(sizes.data(), numLocalities);
+  }
+
+  /// @brief Set the number of elements owned by each Locality.
+  /// @param sizes Array of numLocalities sizes.
+  /// @param numLocalities The number of localities.
+  void SetLocalSizes(const size_t *sizes, uint32_t numLocalities) {
+    offsets_.assign(numLocalities + 1, 0);
+    for (uint32_t i = 0; i < numLocalities; ++i)
+      offsets_[i + 1] = offsets_[i] + sizes[i];
+    size_t size = offsets_.back();
+    size_t numBuckets = size_t(kGuideEntriesPerLocality) * numLocalities;
+    bucketWidth_ = std::max((size + numBuckets - 1) / numBuckets, size_t(1));
+    guide_.assign((size + bucketWidth_ - 1) / bucketWidth_, 0);
+    uint32_t loc = 0;
+    for (size_t b = 0; b < guide_.size(); ++b) {
+      while (offsets_[loc + 1] <= b * bucketWidth_) ++loc;
+      guide_[b] = loc;
+    }
+  }
+
+  std::pair<rt::Locality, size_t> Owner(size_t pos) const {
+    uint32_t loc = guide_[pos / bucketWidth_];
+    while (offsets_[loc + 1] <= pos) ++loc;
+    return std::make_pair(rt::Locality(loc), pos - offsets_[loc]);
+  }
+
+  size_t GlobalPosition(uint32_t loc, size_t offset) const {
+    return offsets_[loc] + offset;
+  }
+
+  size_t LocalSize(uint32_t loc) const {
+    return offsets_[loc + 1] - offsets_[loc];
+  }
+
+  size_t RunLength(size_t pos) const {
+    auto owner = Owner(pos);
+    return LocalSize(static_cast<uint32_t>(owner.first)) - owner.second;
+  }
+
+ private:
+  static constexpr uint32_t kGuideEntriesPerLocality = 4;
+
+  std::vector<size_t> offsets_;
+  std::vector<uint32_t> guide_;
+  size_t bucketWidth_ = 1;
+};
+
+}  // namespace shad
+
+#endif  // INCLUDE_SHAD_DATA_STRUCTURES_DISTRIBUTION_H_
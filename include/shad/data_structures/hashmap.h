@@ -26,13 +26,17 @@
 #define INCLUDE_SHAD_DATA_STRUCTURES_HASHMAP_H_
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
+#include <memory>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "shad/data_structures/abstract_data_structure.h"
 #include "shad/data_structures/buffer.h"
+#include "shad/data_structures/byte_string.h"
 #include "shad/data_structures/compare_and_hash_utils.h"
 #include "shad/data_structures/local_hashmap.h"
 #include "shad/distributed_iterator_traits.h"
@@ -50,6 +54,11 @@ class map_iterator;
 /// @tparam VTYPE type of the hashmap values.
 /// @tparam KEY_COMPARE key comparison function; default is MemCmp<KTYPE>.
 /// @warning obects of type KTYPE and VTYPE need to be trivially copiable.
+/// Variable-length types providing an impl::SerializationTraits
+/// specialization (e.g., ByteString) are shipped in their compact serialized
+/// form by the insertion, erase, and Lookup methods; AsyncLookup and the
+/// Apply methods still copy them bitwise, so for those methods long
+/// payloads are usable only on the Locality that owns them.
 /// @tparam INSERT_POLICY insertion policy; default is overwrite
 /// (i.e. insertions overwrite previous values
 ///  associated to the same key, if any).
@@ -91,7 +100,14 @@ class Hashmap : public AbstractDataStructure<
     KTYPE key;
     VTYPE value;
   };
-  using BuffersVector = typename impl::BuffersVector<EntryT, HmapT>;
+  /// True if keys or values travel in serialized form.
+  static constexpr bool kIsVariableLength =
+      impl::SerializationTraits<KTYPE>::kIsVariableLength ||
+      impl::SerializationTraits<VTYPE>::kIsVariableLength;
+  using BuffersVector =
+      typename std::conditional<kIsVariableLength,
+                                impl::SerializedBuffersVector<HmapT>,
+                                impl::BuffersVector<EntryT, HmapT>>::type;
 
   /// @brief Create method.
   ///
@@ -305,6 +321,16 @@ class Hashmap : public AbstractDataStructure<
     localMap_.Insert(entry.key, entry.value);
   }
 
+  // FIXME it should be protected
+  void BufferEntriesInsert(const uint8_t *entries, const size_t numBytes) {
+    const uint8_t *end = entries + numBytes;
+    while (entries < end) {
+      KTYPE key = KeySerializer::Deserialize(&entries);
+      VTYPE value = ValueSerializer::Deserialize(&entries);
+      localMap_.Insert(key, value);
+    }
+  }
+
   iterator begin() { return iterator::map_begin(this); }
   iterator end() { return iterator::map_end(this); }
   const_iterator cbegin() const { return const_iterator::map_begin(this); }
@@ -354,6 +380,76 @@ class Hashmap : public AbstractDataStructure<
     KTYPE key;
   };
 
+  using KeySerializer = impl::SerializationTraits<KTYPE>;
+  using ValueSerializer = impl::SerializationTraits<VTYPE>;
+
+  // Message layout: header | key | value (if any).  The header starts with
+  // the ObjectID of the hashmap.
+  static std::shared_ptr<uint8_t> PackMessage(const void *header,
+                                              const size_t headerSize,
+                                              const KTYPE &key,
+                                              const VTYPE *value,
+                                              uint32_t *messageSize) {
+    size_t size = headerSize + KeySerializer::Size(key);
+    if (value != nullptr) size += ValueSerializer::Size(*value);
+    std::shared_ptr<uint8_t> message(new uint8_t[size],
+                                     std::default_delete<uint8_t[]>());
+    std::memcpy(message.get(), header, headerSize);
+    uint8_t *next = KeySerializer::Serialize(key, message.get() + headerSize);
+    if (value != nullptr) ValueSerializer::Serialize(*value, next);
+    *messageSize = static_cast<uint32_t>(size);
+    return message;
+  }
+
+  static void UnpackInsert(const uint8_t *message, const size_t headerSize,
+                           LMapT **mapPtr, KTYPE *key, VTYPE *value) {
+    ObjectID oid(ObjectID::kNullID);
+    std::memcpy(&oid, message, sizeof(ObjectID));
+    message += headerSize;
+    *mapPtr = &HmapT::GetPtr(oid)->localMap_;
+    *key = KeySerializer::Deserialize(&message);
+    *value = ValueSerializer::Deserialize(&message);
+  }
+
+  void BufferedInsertImpl(std::false_type, const KTYPE &key,
+                          const VTYPE &value, const rt::Locality &loc) {
+    buffers_.Insert(EntryT(key, value), loc);
+  }
+
+  void BufferedInsertImpl(std::true_type, const KTYPE &key, const VTYPE &value,
+                          const rt::Locality &loc) {
+    std::vector<uint8_t> entry(KeySerializer::Size(key) +
+                               ValueSerializer::Size(value));
+    ValueSerializer::Serialize(value,
+                               KeySerializer::Serialize(key, entry.data()));
+    buffers_.Insert(entry.data(), entry.size(), loc);
+  }
+
+  void BufferedAsyncInsertImpl(std::false_type, rt::Handle &handle,
+                               const KTYPE &key, const VTYPE &value,
+                               const rt::Locality &loc) {
+    buffers_.AsyncInsert(handle, EntryT(key, value), loc);
+  }
+
+  void BufferedAsyncInsertImpl(std::true_type, rt::Handle &handle,
+                               const KTYPE &key, const VTYPE &value,
+                               const rt::Locality &loc) {
+    std::vector<uint8_t> entry(KeySerializer::Size(key) +
+                               ValueSerializer::Size(value));
+    ValueSerializer::Serialize(value,
+                               KeySerializer::Serialize(key, entry.data()));
+    buffers_.AsyncInsert(handle, entry.data(), entry.size(), loc);
+  }
+
+  static void UnpackLookup(const uint8_t *message, const size_t headerSize,
+                           LMapT **mapPtr, KTYPE *key) {
+    ObjectID oid(ObjectID::kNullID);
+    std::memcpy(&oid, message, sizeof(ObjectID));
+    message += headerSize;
+    *mapPtr = &HmapT::GetPtr(oid)->localMap_;
+    *key = KeySerializer::Deserialize(&message);
+  }
+
  protected:
   Hashmap(ObjectID oid, const size_t numEntries)
       : oid_(oid),
@@ -397,6 +493,26 @@ Hashmap<KTYPE, VTYPE, KEY_COMPARE, INSERT_POLICY>::Insert(const KTYPE &key,
     auto lres = localMap_.Insert(key, value);
     res.first = itr_traits::iterator_from_local(begin(), end(), lres.first);
     res.second = lres.second;
+  } else if (kIsVariableLength) {
+    struct Header {
+      ObjectID oid;
+      iterator first, last;
+    } header = {oid_, begin(), end()};
+    auto insertLambda = [](const uint8_t *message, const uint32_t,
+                           std::pair<iterator, bool> *res_ptr) {
+      const Header &header = *reinterpret_cast<const Header *>(message);
+      LMapT *mapPtr;
+      KTYPE key;
+      VTYPE value;
+      UnpackInsert(message, sizeof(Header), &mapPtr, &key, &value);
+      auto lres = mapPtr->Insert(key, value);
+      res_ptr->first = itr_traits::iterator_from_local(
+          header.first, header.last, lres.first);
+      res_ptr->second = lres.second;
+    };
+    uint32_t size;
+    auto message = PackMessage(&header, sizeof(Header), key, &value, &size);
+    rt::executeAtWithRet(targetLocality, insertLambda, message, size, &res);
   } else {
     auto insertLambda =
         [](const std::tuple<iterator, iterator, InsertArgs> &args_,
@@ -424,6 +540,18 @@ inline void Hashmap<KTYPE, VTYPE, KEY_COMPARE, INSERT_POLICY>::AsyncInsert(
 
   if (targetLocality == rt::thisLocality()) {
     localMap_.AsyncInsert(handle, key, value);
+  } else if (kIsVariableLength) {
+    auto insertLambda = [](rt::Handle &handle, const uint8_t *message,
+                           const uint32_t) {
+      LMapT *mapPtr;
+      KTYPE key;
+      VTYPE value;
+      UnpackInsert(message, sizeof(ObjectID), &mapPtr, &key, &value);
+      mapPtr->AsyncInsert(handle, key, value);
+    };
+    uint32_t size;
+    auto message = PackMessage(&oid_, sizeof(ObjectID), key, &value, &size);
+    rt::asyncExecuteAt(handle, targetLocality, insertLambda, message, size);
   } else {
     auto insertLambda = [](rt::Handle &handle, const InsertArgs &args) {
       auto mapPtr = HmapT::GetPtr(args.oid);
@@ -440,7 +568,8 @@ inline void Hashmap<KTYPE, VTYPE, KEY_COMPARE, INSERT_POLICY>::BufferedInsert(
     const KTYPE &key, const VTYPE &value) {
   size_t targetId = shad::hash<KTYPE>{}(key) % rt::numLocalities();
   rt::Locality targetLocality(targetId);
-  buffers_.Insert(EntryT(key, value), targetLocality);
+  BufferedInsertImpl(std::integral_constant<bool, kIsVariableLength>{}, key,
+                     value, targetLocality);
 }
 
 template <typename KTYPE, typename VTYPE, typename KEY_COMPARE,
@@ -451,7 +580,8 @@ inline void Hashmap<KTYPE, VTYPE, KEY_COMPARE,
                                                         const VTYPE &value) {
   size_t targetId = shad::hash<KTYPE>{}(key) % rt::numLocalities();
   rt::Locality targetLocality(targetId);
-  buffers_.AsyncInsert(handle, EntryT(key, value), targetLocality);
+  BufferedAsyncInsertImpl(std::integral_constant<bool, kIsVariableLength>{},
+                          handle, key, value, targetLocality);
 }
 
 template <typename KTYPE, typename VTYPE, typename KEY_COMPARE,
@@ -463,6 +593,16 @@ inline void Hashmap<KTYPE, VTYPE, KEY_COMPARE, INSERT_POLICY>::Erase(
 
   if (targetLocality == rt::thisLocality()) {
     localMap_.Erase(key);
+  } else if (kIsVariableLength) {
+    auto eraseLambda = [](const uint8_t *message, const uint32_t) {
+      LMapT *mapPtr;
+      KTYPE key;
+      UnpackLookup(message, sizeof(ObjectID), &mapPtr, &key);
+      mapPtr->Erase(key);
+    };
+    uint32_t size;
+    auto message = PackMessage(&oid_, sizeof(ObjectID), key, nullptr, &size);
+    rt::executeAt(targetLocality, eraseLambda, message, size);
   } else {
     auto eraseLambda = [](const LookupArgs &args) {
       auto mapPtr = HmapT::GetPtr(args.oid);
@@ -482,6 +622,17 @@ inline void Hashmap<KTYPE, VTYPE, KEY_COMPARE, INSERT_POLICY>::AsyncErase(
 
   if (targetLocality == rt::thisLocality()) {
     localMap_.AsyncErase(handle, key);
+  } else if (kIsVariableLength) {
+    auto eraseLambda = [](rt::Handle &handle, const uint8_t *message,
+                          const uint32_t) {
+      LMapT *mapPtr;
+      KTYPE key;
+      UnpackLookup(message, sizeof(ObjectID), &mapPtr, &key);
+      mapPtr->AsyncErase(handle, key);
+    };
+    uint32_t size;
+    auto message = PackMessage(&oid_, sizeof(ObjectID), key, nullptr, &size);
+    rt::asyncExecuteAt(handle, targetLocality, eraseLambda, message, size);
   } else {
     auto eraseLambda = [](rt::Handle &handle, const LookupArgs &args) {
       auto mapPtr = HmapT::GetPtr(args.oid);
@@ -501,6 +652,22 @@ inline bool Hashmap<KTYPE, VTYPE, KEY_COMPARE, INSERT_POLICY>::Lookup(
 
   if (targetLocality == rt::thisLocality()) {
     return localMap_.Lookup(key, res);
+  } else if (kIsVariableLength) {
+    auto lookupLambda = [](const uint8_t *message, const uint32_t,
+                           LookupResult *res) {
+      LMapT *mapPtr;
+      KTYPE key;
+      UnpackLookup(message, sizeof(ObjectID), &mapPtr, &key);
+      res->found = mapPtr->Lookup(key, &res->value);
+    };
+    uint32_t size;
+    auto message = PackMessage(&oid_, sizeof(ObjectID), key, nullptr, &size);
+    LookupResult lres;
+    rt::executeAtWithRet(targetLocality, lookupLambda, message, size, &lres);
+    if (lres.found) {
+      *res = ValueSerializer::Fetch(targetLocality, lres.value);
+    }
+    return lres.found;
   } else {
     auto lookupLambda = [](const LookupArgs &args, LookupResult *res) {
       auto mapPtr = HmapT::GetPtr(args.oid);
@@ -0,0 +1,316 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef INCLUDE_SHAD_DATA_STRUCTURES_LOCAL_BAG_H_
+#define INCLUDE_SHAD_DATA_STRUCTURES_LOCAL_BAG_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "shad/runtime/runtime.h"
+
+namespace shad {
+
+/// @brief The LocalBag data structure.
+///
+/// SHAD's LocalBag is a "local", thread-safe, unordered work-list.  Elements
+/// are stored in a list of fixed-size segments: producers reserve slots with
+/// a single atomic fetch-add on the tail segment, consumers claim them with a
+/// compare-and-swap on the head segment.  Neither Push nor Pop takes a lock,
+/// except when a new segment has to be linked.
+/// LocalBags can be used ONLY on the Locality on which they are created.
+///
+/// @tparam T type of the elements.
+/// @warning Segments are reclaimed only by Clear or when the LocalBag is
+/// destroyed.
+template <typename T>
+class LocalBag {
+  template <typename>
+  friend class Bag;
+
+ public:
+  /// @brief Constructor.
+  /// @param segmentSize Number of elements per segment.
+  explicit LocalBag(size_t segmentSize = kDefaultSegmentSize)
+      : segmentSize_(std::max(segmentSize, 1lu)), size_(0) {
+    Clear();
+  }
+
+  LocalBag(const LocalBag &) = delete;
+  LocalBag &operator=(const LocalBag &) = delete;
+
+  /// Default number of elements per segment.
+  static constexpr size_t kDefaultSegmentSize = 1024;
+
+  /// @brief Number of elements in the bag.
+  size_t Size() const { return size_.load(); }
+
+  /// @brief Add an element to the bag.
+  /// @param[in] element the element.
+  void Push(const T &element) { Push(&element, 1); }
+
+  /// @brief Add a sequence of elements to the bag.
+  /// @param[in] elements pointer to the first element.
+  /// @param[in] numElements number of elements.
+  void Push(const T *elements, size_t numElements);
+
+  /// @brief Remove an element from the bag.
+  /// @param[out] element the removed element, if any.
+  /// @return false if the bag is empty, true otherwise.
+  bool Pop(T *element) { return Pop(element, 1) == 1; }
+
+  /// @brief Remove up to numElements elements from the bag.
+  /// @param[out] elements buffer receiving the removed elements.
+  /// @param[in] numElements capacity of the buffer.
+  /// @return the number of elements removed.
+  size_t Pop(T *elements, size_t numElements);
+
+  /// @brief Remove all the elements.
+  /// @warning Clear must not be called concurrently with other operations.
+  void Clear() {
+    segments_.clear();
+    segments_.emplace_back(new Segment(segmentSize_));
+    head_ = segments_.back().get();
+    tail_ = segments_.back().get();
+    size_ = 0;
+  }
+
+  /// @brief Apply a user-defined function to every element, without
+  /// removing them.
+  ///
+  /// @tparam ApplyFunT User-defined function type.  The function prototype
+  /// should be:
+  /// @code
+  /// void(const T&, Args&);
+  /// @endcode
+  /// @tparam ...Args Types of the function arguments.
+  ///
+  /// @param function The function to apply.
+  /// @param args The function arguments.
+  /// @warning The bag must not be modified during the iteration.
+  template <typename ApplyFunT, typename... Args>
+  void ForEachElement(ApplyFunT &&function, Args &... args);
+
+  /// @brief Asynchronously apply a user-defined function to every element,
+  /// without removing them.
+  ///
+  /// @tparam ApplyFunT User-defined function type.  The function prototype
+  /// should be:
+  /// @code
+  /// void(rt::Handle&, const T&, Args&);
+  /// @endcode
+  /// @tparam ...Args Types of the function arguments.
+  ///
+  /// @param handle An handle for the associated task-group.
+  /// @param function The function to apply.
+  /// @param args The function arguments.
+  /// @warning The bag must not be modified during the iteration.
+  template <typename ApplyFunT, typename... Args>
+  void AsyncForEachElement(rt::Handle &handle, ApplyFunT &&function,
+                           Args &... args);
+
+  template <typename Tuple, typename... Args>
+  static void ForEachElementFunWrapper(const Tuple &args, size_t i) {
+    constexpr auto Size = std::tuple_size<
+        typename std::decay<decltype(std::get<2>(args))>::type>::value;
+    Tuple &tuple = const_cast<Tuple &>(args);
+    CallForEachElementFun(i, std::get<0>(tuple), std::get<1>(tuple),
+                          std::get<2>(tuple), std::make_index_sequence<Size>{});
+  }
+
+  template <typename Tuple, typename... Args>
+  static void AsyncForEachElementFunWrapper(rt::Handle &handle,
+                                            const Tuple &args, size_t i) {
+    constexpr auto Size = std::tuple_size<
+        typename std::decay<decltype(std::get<2>(args))>::type>::value;
+    Tuple &tuple = const_cast<Tuple &>(args);
+    AsyncCallForEachElementFun(handle, i, std::get<0>(tuple),
+                               std::get<1>(tuple), std::get<2>(tuple),
+                               std::make_index_sequence<Size>{});
+  }
+
+ private:
+  struct Segment {
+    explicit Segment(size_t capacity)
+        : elements(new T[capacity]),
+          ready(new std::atomic<bool>[capacity]),
+          capacity(capacity),
+          writeIdx(0),
+          readIdx(0),
+          next(nullptr) {
+      for (size_t i = 0; i < capacity; ++i) ready[i] = false;
+    }
+
+    // Slots that have been reserved by producers.
+    size_t Written() const { return std::min(writeIdx.load(), capacity); }
+
+    std::unique_ptr<T[]> elements;
+    std::unique_ptr<std::atomic<bool>[]> ready;
+    const size_t capacity;
+    std::atomic<size_t> writeIdx;
+    std::atomic<size_t> readIdx;
+    std::atomic<Segment *> next;
+  };
+
+  // Link a new segment after last, unless another thread already did.
+  void Grow(Segment *last) {
+    std::lock_guard<rt::Lock> _(segmentsLock_);
+    if (tail_.load() != last) return;
+    segments_.emplace_back(new Segment(segmentSize_));
+    Segment *segment = segments_.back().get();
+    last->next = segment;
+    tail_ = segment;
+  }
+
+  // Number of segments that may contain elements.
+  size_t NumSegments() {
+    std::lock_guard<rt::Lock> _(segmentsLock_);
+    return segments_.size();
+  }
+
+  Segment *GetSegment(size_t i) {
+    std::lock_guard<rt::Lock> _(segmentsLock_);
+    return segments_[i].get();
+  }
+
+  template <typename ApplyFunT, typename... Args, std::size_t... is>
+  static void CallForEachElementFun(const size_t i, LocalBag<T> *bagPtr,
+                                    ApplyFunT function,
+                                    std::tuple<Args...> &args,
+                                    std::index_sequence<is...>) {
+    Segment *segment = bagPtr->GetSegment(i);
+    size_t last = segment->Written();
+    for (size_t j = segment->readIdx.load(); j < last; ++j)
+      function(segment->elements[j], std::get<is>(args)...);
+  }
+
+  template <typename ApplyFunT, typename... Args, std::size_t... is>
+  static void AsyncCallForEachElementFun(rt::Handle &handle, const size_t i,
+                                         LocalBag<T> *bagPtr,
+                                         ApplyFunT function,
+                                         std::tuple<Args...> &args,
+                                         std::index_sequence<is...>) {
+    Segment *segment = bagPtr->GetSegment(i);
+    size_t last = segment->Written();
+    for (size_t j = segment->readIdx.load(); j < last; ++j)
+      function(handle, segment->elements[j], std::get<is>(args)...);
+  }
+
+  size_t segmentSize_;
+  std::vector<std::unique_ptr<Segment>> segments_;
+  std::atomic<Segment *> head_;
+  std::atomic<Segment *> tail_;
+  std::atomic<size_t> size_;
+  rt::Lock segmentsLock_;
+};
+
+template <typename T>
+void LocalBag<T>::Push(const T *elements, size_t numElements) {
+  while (numElements != 0) {
+    Segment *segment = tail_.load();
+    size_t first = segment->writeIdx.fetch_add(numElements);
+    if (first >= segment->capacity) {
+      Grow(segment);
+      continue;
+    }
+    size_t count = std::min(numElements, segment->capacity - first);
+    for (size_t i = 0; i < count; ++i) {
+      segment->elements[first + i] = elements[i];
+      segment->ready[first + i].store(true, std::memory_order_release);
+    }
+    size_ += count;
+    elements += count;
+    numElements -= count;
+    if (numElements != 0) Grow(segment);
+  }
+}
+
+template <typename T>
+size_t LocalBag<T>::Pop(T *elements, size_t numElements) {
+  size_t popped = 0;
+  while (popped < numElements) {
+    Segment *segment = head_.load();
+    size_t first = segment->readIdx.load();
+    size_t last = segment->Written();
+    if (first >= last) {
+      // Move to the next segment only when this one is exhausted.
+      Segment *next = segment->next.load();
+      if (first < segment->capacity || next == nullptr) break;
+      head_.compare_exchange_strong(segment, next);
+      continue;
+    }
+    // Do not overtake a producer that is still writing.
+    size_t count = std::min(numElements - popped, last - first);
+    size_t ready = 0;
+    while (ready < count &&
+           segment->ready[first + ready].load(std::memory_order_acquire))
+      ++ready;
+    if (ready == 0) {
+      rt::impl::yield();
+      continue;
+    }
+    if (!segment->readIdx.compare_exchange_weak(first, first + ready))
+      continue;
+    for (size_t i = 0; i < ready; ++i)
+      elements[popped + i] = segment->elements[first + i];
+    size_ -= ready;
+    popped += ready;
+  }
+  return popped;
+}
+
+template <typename T>
+template <typename ApplyFunT, typename... Args>
+void LocalBag<T>::ForEachElement(ApplyFunT &&function, Args &... args) {
+  using FunctionTy = void (*)(const T &, Args &...);
+  FunctionTy fn = std::forward<decltype(function)>(function);
+  using ArgsTuple = std::tuple<LocalBag<T> *, FunctionTy, std::tuple<Args...>>;
+  ArgsTuple argsTuple(this, fn, std::tuple<Args...>(args...));
+  rt::forEachAt(rt::thisLocality(),
+                ForEachElementFunWrapper<ArgsTuple, Args...>, argsTuple,
+                NumSegments());
+}
+
+template <typename T>
+template <typename ApplyFunT, typename... Args>
+void LocalBag<T>::AsyncForEachElement(rt::Handle &handle, ApplyFunT &&function,
+                                      Args &... args) {
+  using FunctionTy = void (*)(rt::Handle &, const T &, Args &...);
+  FunctionTy fn = std::forward<decltype(function)>(function);
+  using ArgsTuple = std::tuple<LocalBag<T> *, FunctionTy, std::tuple<Args...>>;
+  ArgsTuple argsTuple(this, fn, std::tuple<Args...>(args...));
+  rt::asyncForEachAt(handle, rt::thisLocality(),
+                     AsyncForEachElementFunWrapper<ArgsTuple, Args...>,
+                     argsTuple, NumSegments());
+}
+
+}  // namespace shad
+
+#endif  // INCLUDE_SHAD_DATA_STRUCTURES_LOCAL_BAG_H_
@@ -0,0 +1,634 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef INCLUDE_SHAD_DATA_STRUCTURES_LOCAL_BITMAP_SET_H_
+#define INCLUDE_SHAD_DATA_STRUCTURES_LOCAL_BITMAP_SET_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "shad/runtime/runtime.h"
+
+namespace shad {
+
+/// @brief The LocalBitmapSet data structure.
+///
+/// SHAD's LocalBitmapSet is a "local", thread-safe set of integers, meant
+/// for dense domains such as vertex identifiers.  The domain is split in
+/// chunks of 2^16 consecutive values; a hashed directory maps the high bits
+/// of an element to the container of its chunk, and each container adapts
+/// to the density of the chunk:
+///   - up to kMaxArraySize elements are kept in a sorted array of 16-bit
+///     offsets (2 bytes per element);
+///   - denser chunks use a 8KB bitmap.
+/// This is the layout of roaring bitmaps: compared to LocalSet, which stores
+/// every element with its state in a hashed bucket, memory for dense sets is
+/// cut by an order of magnitude, and intersections and unions work a chunk
+/// at a time on sorted arrays or on bitmap words.
+/// LocalBitmapSets can be used ONLY on the Locality on which they are
+/// created.
+///
+/// @tparam T integral type of the elements.
+///
+/// @warning Intersect, Union and Compact must not be called concurrently
+/// with insertions or removals.
+template <typename T>
+class LocalBitmapSet {
+  static_assert(std::is_integral<T>::value,
+                "LocalBitmapSet requires an integral element type");
+
+ public:
+  using value_type = T;
+
+  /// Number of bits of an element encoded by the position in a container.
+  static constexpr size_t kChunkBits = 16;
+  /// Maximum cardinality of an array container.
+  static constexpr size_t kMaxArraySize = 4096;
+
+  /// @brief Constructor.
+  /// @param numInitBuckets number of buckets of the chunk directory.
+  explicit LocalBitmapSet(const size_t numInitBuckets = 64)
+      : numBuckets_(std::max(numInitBuckets, 1lu)),
+        buckets_(new std::atomic<Container*>[numBuckets_]),
+        size_(0) {
+    for (size_t i = 0; i < numBuckets_; ++i) buckets_[i] = nullptr;
+  }
+
+  LocalBitmapSet(const LocalBitmapSet&) = delete;
+  LocalBitmapSet& operator=(const LocalBitmapSet&) = delete;
+
+  /// @brief Size of the set (number of elements).
+  /// @return the size of the set.
+  size_t Size() const { return size_.load(); }
+
+  /// @brief Insert an element in the set.
+  /// @param[in] element the element to insert.
+  /// @return true if the insertion took place, false if the element was
+  /// already in the set.
+  bool Insert(const T& element);
+
+  /// @brief Asynchronously Insert an element in the set.
+  /// @warning Asynchronous operations are guaranteed to have completed
+  /// only after calling the rt::waitForCompletion(rt::Handle &handle) method.
+  /// @param[in,out] handle Reference to the handle
+  /// to be used to wait for completion.
+  /// @param[in] element the element to insert.
+  void AsyncInsert(rt::Handle& handle, const T& element);
+
+  /// @brief Remove an element from the set.
+  /// @param[in] element the element to remove.
+  void Erase(const T& element);
+
+  /// @brief Asynchronously remove an element from the set.
+  /// @warning Asynchronous operations are guaranteed to have completed
+  /// only after calling the rt::waitForCompletion(rt::Handle &handle) method.
+  /// @param[in,out] handle Reference to the handle
+  /// to be used to wait for completion.
+  /// @param[in] element the element to remove.
+  void AsyncErase(rt::Handle& handle, const T& element);
+
+  /// @brief Check if the set contains a given element.
+  /// @param[in] element the element to find.
+  /// @return true if the element is found, false otherwise.
+  bool Find(const T& element);
+
+  /// @brief Asynchronously check if the set contains a given element.
+  /// @warning Asynchronous operations are guaranteed to have completed
+  /// only after calling the rt::waitForCompletion(rt::Handle &handle) method.
+  /// @param[in,out] handle Reference to the handle
+  /// to be used to wait for completion.
+  /// @param[in] element the element to find.
+  /// @param[out] found the address where to store the result of the operation.
+  void AsyncFind(rt::Handle& handle, const T& element, bool* found);
+
+  /// @brief Clear the content of the set.
+  void Clear() {
+    for (size_t i = 0; i < numBuckets_; ++i) buckets_[i] = nullptr;
+    containers_.clear();
+    size_ = 0;
+  }
+
+  /// @brief Convert every container to its most compact representation.
+  ///
+  /// Bitmaps whose cardinality dropped below kMaxArraySize (after removals)
+  /// become arrays, and arrays release their unused capacity.
+  void Compact();
+
+  /// @brief Number of bytes used by the containers and the directory.
+  size_t MemoryUsage() const;
+
+  /// @brief Number of elements in both this set and other.
+  size_t IntersectionSize(const LocalBitmapSet<T>& other) const;
+
+  /// @brief Compute the intersection of this set and other.
+  /// @param[in] other the other set.
+  /// @param[out] result the set receiving the intersection; its previous
+  /// content is discarded.
+  void Intersect(const LocalBitmapSet<T>& other,
+                 LocalBitmapSet<T>* result) const;
+
+  /// @brief Compute the union of this set and other.
+  /// @param[in] other the other set.
+  /// @param[out] result the set receiving the union; its previous content is
+  /// discarded.
+  void Union(const LocalBitmapSet<T>& other, LocalBitmapSet<T>* result) const;
+
+  /// @brief Apply a user-defined function to each element in the set.
+  ///
+  /// The elements of a chunk are visited in increasing order, chunks are
+  /// visited in parallel.
+  /// @tparam ApplyFunT User-defined function type.
+  /// The function prototype should be:
+  /// @code
+  /// void(const T&, Args&);
+  /// @endcode
+  /// @tparam ...Args Types of the function arguments.
+  /// @param function The function to apply.
+  /// @param args The function arguments.
+  template <typename ApplyFunT, typename... Args>
+  void ForEachElement(ApplyFunT&& function, Args&... args);
+
+  /// @brief Asynchronously apply a user-defined function
+  /// to each element in the set.
+  /// @tparam ApplyFunT User-defined function type.
+  /// The function prototype should be:
+  /// @code
+  /// void(shad::rt::Handle&, const T&, Args&);
+  /// @endcode
+  /// @tparam ...Args Types of the function arguments.
+  /// @warning Asynchronous operations are guaranteed to have completed.
+  /// only after calling the rt::waitForCompletion(rt::Handle &handle) method.
+  /// @param[in,out] handle Reference to the handle.
+  /// to be used to wait for completion.
+  /// @param function The function to apply.
+  /// @param args The function arguments.
+  template <typename ApplyFunT, typename... Args>
+  void AsyncForEachElement(rt::Handle& handle, ApplyFunT&& function,
+                           Args&... args);
+
+ private:
+  static constexpr size_t kChunkSize = 1lu << kChunkBits;
+  static constexpr size_t kBitmapWords = kChunkSize / 64;
+  using UnsignedT = typename std::make_unsigned<T>::type;
+
+  struct Container {
+    explicit Container(uint64_t key)
+        : key(key), isBitmap(false), cardinality(0), next(nullptr) {}
+
+    bool TestBit(uint16_t offset) const {
+      uint64_t word =
+          __atomic_load_n(&bitmap[offset / 64], __ATOMIC_RELAXED);
+      return word & (1ull << (offset % 64));
+    }
+
+    // Requires lock, or exclusive access.
+    void ToBitmap() {
+      std::unique_ptr<uint64_t[]> newBitmap(new uint64_t[kBitmapWords]());
+      for (auto offset : array)
+        newBitmap[offset / 64] |= 1ull << (offset % 64);
+      bitmap = std::move(newBitmap);
+      isBitmap.store(true, std::memory_order_release);
+      std::vector<uint16_t>().swap(array);
+    }
+
+    // Requires exclusive access.
+    void ToArray() {
+      array.clear();
+      for (size_t w = 0; w < kBitmapWords; ++w)
+        for (uint64_t word = bitmap[w]; word != 0; word &= word - 1)
+          array.push_back(w * 64 + __builtin_ctzll(word));
+      isBitmap = false;
+      bitmap.reset();
+    }
+
+    const uint64_t key;
+    std::atomic<bool> isBitmap;
+    size_t cardinality;
+    std::vector<uint16_t> array;
+    std::unique_ptr<uint64_t[]> bitmap;
+    Container* next;
+    rt::Lock lock;
+  };
+
+  static uint64_t KeyOf(const T& element) {
+    return static_cast<uint64_t>(static_cast<UnsignedT>(element)) >>
+           kChunkBits;
+  }
+
+  static uint16_t OffsetOf(const T& element) {
+    return static_cast<uint16_t>(static_cast<UnsignedT>(element));
+  }
+
+  static T ElementOf(uint64_t key, uint16_t offset) {
+    return static_cast<T>((key << kChunkBits) | offset);
+  }
+
+  size_t BucketOf(uint64_t key) const {
+    return (key * 0x9E3779B97F4A7C15ull >> 32) % numBuckets_;
+  }
+
+  Container* GetContainer(uint64_t key) const {
+    Container* container = buckets_[BucketOf(key)].load();
+    while (container != nullptr && container->key != key)
+      container = container->next;
+    return container;
+  }
+
+  Container* GetOrCreateContainer(uint64_t key) {
+    Container* container = GetContainer(key);
+    if (container != nullptr) return container;
+    std::lock_guard<rt::Lock> _(directoryLock_);
+    container = GetContainer(key);
+    if (container != nullptr) return container;
+    containers_.emplace_back(new Container(key));
+    container = containers_.back().get();
+    auto& bucket = buckets_[BucketOf(key)];
+    container->next = bucket.load();
+    bucket.store(container);
+    return container;
+  }
+
+  // Add a container built by Intersect or Union.
+  void Adopt(std::unique_ptr<Container>&& container) {
+    if (container->cardinality == 0) return;
+    auto& bucket = buckets_[BucketOf(container->key)];
+    container->next = bucket.load();
+    bucket.store(container.get());
+    size_ += container->cardinality;
+    containers_.push_back(std::move(container));
+  }
+
+  static std::unique_ptr<Container> IntersectContainers(const Container& a,
+                                                        const Container& b);
+  static std::unique_ptr<Container> UnionContainers(const Container& a,
+                                                    const Container& b);
+  static std::unique_ptr<Container> CopyContainer(const Container& a);
+
+  template <typename ApplyFunT, typename... Args, std::size_t... is>
+  static void CallForEachElementFun(const size_t i, LocalBitmapSet<T>* setPtr,
+                                    ApplyFunT function,
+                                    std::tuple<Args...>& args,
+                                    std::index_sequence<is...>) {
+    Container* container = setPtr->containers_[i].get();
+    std::lock_guard<rt::Lock> _(container->lock);
+    if (container->isBitmap) {
+      for (size_t w = 0; w < kBitmapWords; ++w)
+        for (uint64_t word = container->bitmap[w]; word != 0;
+             word &= word - 1) {
+          T element =
+              ElementOf(container->key, w * 64 + __builtin_ctzll(word));
+          function(element, std::get<is>(args)...);
+        }
+    } else {
+      for (auto offset : container->array) {
+        T element = ElementOf(container->key, offset);
+        function(element, std::get<is>(args)...);
+      }
+    }
+  }
+
+  template <typename ApplyFunT, typename... Args, std::size_t... is>
+  static void AsyncCallForEachElementFun(rt::Handle& handle, const size_t i,
+                                         LocalBitmapSet<T>* setPtr,
+                                         ApplyFunT function,
+                                         std::tuple<Args...>& args,
+                                         std::index_sequence<is...>) {
+    Container* container = setPtr->containers_[i].get();
+    std::lock_guard<rt::Lock> _(container->lock);
+    if (container->isBitmap) {
+      for (size_t w = 0; w < kBitmapWords; ++w)
+        for (uint64_t word = container->bitmap[w]; word != 0;
+             word &= word - 1) {
+          T element =
+              ElementOf(container->key, w * 64 + __builtin_ctzll(word));
+          function(handle, element, std::get<is>(args)...);
+        }
+    } else {
+      for (auto offset : container->array) {
+        T element = ElementOf(container->key, offset);
+        function(handle, element, std::get<is>(args)...);
+      }
+    }
+  }
+
+  template <typename Tuple, typename... Args>
+  static void ForEachElementFunWrapper(const Tuple& args, size_t i) {
+    constexpr auto Size = std::tuple_size<
+        typename std::decay<decltype(std::get<2>(args))>::type>::value;
+    Tuple& tuple = const_cast<Tuple&>(args);
+    CallForEachElementFun(i, std::get<0>(tuple), std::get<1>(tuple),
+                          std::get<2>(tuple), std::make_index_sequence<Size>{});
+  }
+
+  template <typename Tuple, typename... Args>
+  static void AsyncForEachElementFunWrapper(rt::Handle& handle,
+                                            const Tuple& args, size_t i) {
+    constexpr auto Size = std::tuple_size<
+        typename std::decay<decltype(std::get<2>(args))>::type>::value;
+    Tuple& tuple = const_cast<Tuple&>(args);
+    AsyncCallForEachElementFun(handle, i, std::get<0>(tuple),
+                               std::get<1>(tuple), std::get<2>(tuple),
+                               std::make_index_sequence<Size>{});
+  }
+
+  size_t numBuckets_;
+  std::unique_ptr<std::atomic<Container*>[]> buckets_;
+  std::vector<std::unique_ptr<Container>> containers_;
+  std::atomic<size_t> size_;
+  rt::Lock directoryLock_;
+};
+
+template <typename T>
+bool LocalBitmapSet<T>::Insert(const T& element) {
+  Container* container = GetOrCreateContainer(KeyOf(element));
+  uint16_t offset = OffsetOf(element);
+  std::lock_guard<rt::Lock> _(container->lock);
+  if (container->isBitmap) {
+    uint64_t& word = container->bitmap[offset / 64];
+    uint64_t bit = 1ull << (offset % 64);
+    if (word & bit) return false;
+    __atomic_fetch_or(&word, bit, __ATOMIC_RELAXED);
+  } else {
+    auto& array = container->array;
+    auto position = std::lower_bound(array.begin(), array.end(), offset);
+    if (position != array.end() && *position == offset) return false;
+    array.insert(position, offset);
+    if (array.size() > kMaxArraySize) container->ToBitmap();
+  }
+  ++container->cardinality;
+  ++size_;
+  return true;
+}
+
+template <typename T>
+void LocalBitmapSet<T>::AsyncInsert(rt::Handle& handle, const T& element) {
+  auto args = std::tuple<LocalBitmapSet<T>*, T>(this, element);
+  auto insertLambda = [](rt::Handle&,
+                         const std::tuple<LocalBitmapSet<T>*, T>& t) {
+    (std::get<0>(t))->Insert(std::get<1>(t));
+  };
+  rt::asyncExecuteAt(handle, rt::thisLocality(), insertLambda, args);
+}
+
+template <typename T>
+void LocalBitmapSet<T>::Erase(const T& element) {
+  Container* container = GetContainer(KeyOf(element));
+  if (container == nullptr) return;
+  uint16_t offset = OffsetOf(element);
+  std::lock_guard<rt::Lock> _(container->lock);
+  if (container->isBitmap) {
+    uint64_t& word = container->bitmap[offset / 64];
+    uint64_t bit = 1ull << (offset % 64);
+    if (!(word & bit)) return;
+    __atomic_fetch_and(&word, ~bit, __ATOMIC_RELAXED);
+  } else {
+    auto& array = container->array;
+    auto position = std::lower_bound(array.begin(), array.end(), offset);
+    if (position == array.end() || *position != offset) return;
+    array.erase(position);
+  }
+  --container->cardinality;
+  --size_;
+}
+
+template <typename T>
+void LocalBitmapSet<T>::AsyncErase(rt::Handle& handle, const T& element) {
+  auto args = std::tuple<LocalBitmapSet<T>*, T>(this, element);
+  auto eraseLambda = [](rt::Handle&,
+                        const std::tuple<LocalBitmapSet<T>*, T>& t) {
+    (std::get<0>(t))->Erase(std::get<1>(t));
+  };
+  rt::asyncExecuteAt(handle, rt::thisLocality(), eraseLambda, args);
+}
+
+template <typename T>
+bool LocalBitmapSet<T>::Find(const T& element) {
+  Container* container = GetContainer(KeyOf(element));
+  if (container == nullptr) return false;
+  uint16_t offset = OffsetOf(element);
+  // Bitmaps are never freed while the set is in use: no lock needed.
+  if (container->isBitmap.load(std::memory_order_acquire))
+    return container->TestBit(offset);
+  std::lock_guard<rt::Lock> _(container->lock);
+  if (container->isBitmap) return container->TestBit(offset);
+  return std::binary_search(container->array.begin(), container->array.end(),
+                            offset);
+}
+
+template <typename T>
+void LocalBitmapSet<T>::AsyncFind(rt::Handle& handle, const T& element,
+                                  bool* found) {
+  auto args = std::tuple<LocalBitmapSet<T>*, T, bool*>(this, element, found);
+  auto findLambda = [](rt::Handle&,
+                       const std::tuple<LocalBitmapSet<T>*, T, bool*>& t) {
+    *std::get<2>(t) = (std::get<0>(t))->Find(std::get<1>(t));
+  };
+  rt::asyncExecuteAt(handle, rt::thisLocality(), findLambda, args);
+}
+
+template <typename T>
+void LocalBitmapSet<T>::Compact() {
+  for (auto& container : containers_) {
+    if (container->isBitmap && container->cardinality <= kMaxArraySize)
+      container->ToArray();
+    container->array.shrink_to_fit();
+  }
+}
+
+template <typename T>
+size_t LocalBitmapSet<T>::MemoryUsage() const {
+  size_t bytes = sizeof(*this) + numBuckets_ * sizeof(Container*);
+  for (auto& container : containers_) {
+    bytes += sizeof(Container);
+    if (container->isBitmap)
+      bytes += kBitmapWords * sizeof(uint64_t);
+    else
+      bytes += container->array.capacity() * sizeof(uint16_t);
+  }
+  return bytes;
+}
+
+template <typename T>
+std::unique_ptr<typename LocalBitmapSet<T>::Container>
+LocalBitmapSet<T>::CopyContainer(const Container& a) {
+  std::unique_ptr<Container> res(new Container(a.key));
+  res->cardinality = a.cardinality;
+  if (a.isBitmap) {
+    res->bitmap.reset(new uint64_t[kBitmapWords]);
+    std::copy(a.bitmap.get(), a.bitmap.get() + kBitmapWords,
+              res->bitmap.get());
+    res->isBitmap = true;
+  } else {
+    res->array = a.array;
+  }
+  return res;
+}
+
+template <typename T>
+std::unique_ptr<typename LocalBitmapSet<T>::Container>
+LocalBitmapSet<T>::IntersectContainers(const Container& a,
+                                       const Container& b) {
+  std::unique_ptr<Container> res(new Container(a.key));
+  if (a.isBitmap && b.isBitmap) {
+    std::unique_ptr<uint64_t[]> bitmap(new uint64_t[kBitmapWords]);
+    size_t cardinality = 0;
+    for (size_t w = 0; w < kBitmapWords; ++w) {
+      bitmap[w] = a.bitmap[w] & b.bitmap[w];
+      cardinality += __builtin_popcountll(bitmap[w]);
+    }
+    res->bitmap = std::move(bitmap);
+    res->isBitmap = true;
+    res->cardinality = cardinality;
+    if (cardinality <= kMaxArraySize) res->ToArray();
+  } else if (a.isBitmap || b.isBitmap) {
+    const Container& bitmap = a.isBitmap ? a : b;
+    const Container& array = a.isBitmap ? b : a;
+    for (auto offset : array.array)
+      if (bitmap.bitmap[offset / 64] & (1ull << (offset % 64)))
+        res->array.push_back(offset);
+  } else {
+    std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(),
+                          b.array.end(), std::back_inserter(res->array));
+  }
+  if (!res->isBitmap) res->cardinality = res->array.size();
+  return res;
+}
+
+template <typename T>
+std::unique_ptr<typename LocalBitmapSet<T>::Container>
+LocalBitmapSet<T>::UnionContainers(const Container& a, const Container& b) {
+  if (!a.isBitmap && b.isBitmap) return UnionContainers(b, a);
+  std::unique_ptr<Container> res(new Container(a.key));
+  if (a.isBitmap) {
+    res->bitmap.reset(new uint64_t[kBitmapWords]);
+    std::copy(a.bitmap.get(), a.bitmap.get() + kBitmapWords,
+              res->bitmap.get());
+    if (b.isBitmap) {
+      for (size_t w = 0; w < kBitmapWords; ++w)
+        res->bitmap[w] |= b.bitmap[w];
+    } else {
+      for (auto offset : b.array)
+        res->bitmap[offset / 64] |= 1ull << (offset % 64);
+    }
+    size_t cardinality = 0;
+    for (size_t w = 0; w < kBitmapWords; ++w)
+      cardinality += __builtin_popcountll(res->bitmap[w]);
+    res->isBitmap = true;
+    res->cardinality = cardinality;
+  } else {
+    std::set_union(a.array.begin(), a.array.end(), b.array.begin(),
+                   b.array.end(), std::back_inserter(res->array));
+    res->cardinality = res->array.size();
+    if (res->cardinality > kMaxArraySize) res->ToBitmap();
+  }
+  return res;
+}
+
+template <typename T>
+size_t LocalBitmapSet<T>::IntersectionSize(
+    const LocalBitmapSet<T>& other) const {
+  size_t res = 0;
+  for (auto& container : containers_) {
+    Container* match = other.GetContainer(container->key);
+    if (match == nullptr) continue;
+    if (container->isBitmap && match->isBitmap) {
+      for (size_t w = 0; w < kBitmapWords; ++w)
+        res += __builtin_popcountll(container->bitmap[w] & match->bitmap[w]);
+    } else {
+      res += IntersectContainers(*container, *match)->cardinality;
+    }
+  }
+  return res;
+}
+
+template <typename T>
+void LocalBitmapSet<T>::Intersect(const LocalBitmapSet<T>& other,
+                                  LocalBitmapSet<T>* result) const {
+  result->Clear();
+  const LocalBitmapSet<T>& smaller =
+      containers_.size() <= other.containers_.size() ? *this : other;
+  const LocalBitmapSet<T>& larger = &smaller == this ? other : *this;
+  for (auto& container : smaller.containers_) {
+    Container* match = larger.GetContainer(container->key);
+    if (match != nullptr)
+      result->Adopt(IntersectContainers(*container, *match));
+  }
+}
+
+template <typename T>
+void LocalBitmapSet<T>::Union(const LocalBitmapSet<T>& other,
+                              LocalBitmapSet<T>* result) const {
+  result->Clear();
+  for (auto& container : containers_) {
+    Container* match = other.GetContainer(container->key);
+    if (match != nullptr)
+      result->Adopt(UnionContainers(*container, *match));
+    else
+      result->Adopt(CopyContainer(*container));
+  }
+  for (auto& container : other.containers_) {
+    if (GetContainer(container->key) == nullptr)
+      result->Adopt(CopyContainer(*container));
+  }
+}
+
+template <typename T>
+template <typename ApplyFunT, typename... Args>
+void LocalBitmapSet<T>::ForEachElement(ApplyFunT&& function, Args&... args) {
+  using FunctionTy = void (*)(const T&, Args&...);
+  FunctionTy fn = std::forward<decltype(function)>(function);
+  using ArgsTuple =
+      std::tuple<LocalBitmapSet<T>*, FunctionTy, std::tuple<Args...>>;
+  ArgsTuple argsTuple(this, fn, std::tuple<Args...>(args...));
+  rt::forEachAt(rt::thisLocality(),
+                ForEachElementFunWrapper<ArgsTuple, Args...>, argsTuple,
+                containers_.size());
+}
+
+template <typename T>
+template <typename ApplyFunT, typename... Args>
+void LocalBitmapSet<T>::AsyncForEachElement(rt::Handle& handle,
+                                            ApplyFunT&& function,
+                                            Args&... args) {
+  using FunctionTy = void (*)(rt::Handle&, const T&, Args&...);
+  FunctionTy fn = std::forward<decltype(function)>(function);
+  using ArgsTuple =
+      std::tuple<LocalBitmapSet<T>*, FunctionTy, std::tuple<Args...>>;
+  ArgsTuple argsTuple(this, fn, std::tuple<Args...>(args...));
+  rt::asyncForEachAt(handle, rt::thisLocality(),
+                     AsyncForEachElementFunWrapper<ArgsTuple, Args...>,
+                     argsTuple, containers_.size());
+}
+
+}  // namespace shad
+
+#endif  // INCLUDE_SHAD_DATA_STRUCTURES_LOCAL_BITMAP_SET_H_
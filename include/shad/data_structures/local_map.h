@@ -0,0 +1,460 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef INCLUDE_SHAD_DATA_STRUCTURES_LOCAL_MAP_H_
+#define INCLUDE_SHAD_DATA_STRUCTURES_LOCAL_MAP_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "shad/runtime/runtime.h"
+
+namespace shad {
+
+/// @brief The LocalMap data structure.
+///
+/// SHAD's LocalMap is a "local", thread-safe, ordered associative container,
+/// implemented as a lazy concurrent skip list: lookups never take locks,
+/// insertions and removals lock only the predecessors of the affected node.
+/// LocalMaps can be used ONLY on the Locality on which they are created.
+///
+/// @tparam KTYPE type of the keys.
+/// @tparam VTYPE type of the values.
+/// @tparam KEY_COMPARE strict weak ordering of the keys;
+/// default is std::less<KTYPE>.
+///
+/// @warning Nodes removed by Erase are reclaimed only by Clear or when the
+/// LocalMap is destroyed.
+template <typename KTYPE, typename VTYPE,
+          typename KEY_COMPARE = std::less<KTYPE>>
+class LocalMap {
+  template <typename, typename, typename>
+  friend class Map;
+
+ public:
+  /// @brief Constructor.
+  LocalMap() : head_(new Node(kMaxLevel)), size_(0) {
+    head_->fullyLinked = true;
+  }
+
+  /// @brief Destructor.
+  ~LocalMap() { FreeNodes(); }
+
+  LocalMap(const LocalMap &) = delete;
+  LocalMap &operator=(const LocalMap &) = delete;
+
+  /// @brief Size of the map (number of entries).
+  /// @return the size of the map.
+  size_t Size() const { return size_.load(); }
+
+  /// @brief Insert a key-value pair in the map.
+  ///
+  /// If the key is already present its value is overwritten.
+  /// @param[in] key the key.
+  /// @param[in] value the value to copy into the map.
+  /// @return true if the key was not in the map, false otherwise.
+  bool Insert(const KTYPE &key, const VTYPE &value);
+
+  /// @brief Asynchronously Insert a key-value pair in the map.
+  /// @warning Asynchronous operations are guaranteed to have completed
+  /// only after calling the rt::waitForCompletion(rt::Handle &handle) method.
+  /// @param[in,out] handle Reference to the handle
+  /// to be used to wait for completion.
+  /// @param[in] key the key.
+  /// @param[in] value the value to copy into the map.
+  void AsyncInsert(rt::Handle &handle, const KTYPE &key, const VTYPE &value);
+
+  /// @brief Get the value associated to a key.
+  /// @param[in] key the key.
+  /// @param[out] res the value, if the key is found.
+  /// @return true if the entry is found, false otherwise.
+  bool Lookup(const KTYPE &key, VTYPE *res);
+
+  /// @brief Remove a key-value pair from the map.
+  /// @param[in] key the key.
+  void Erase(const KTYPE &key);
+
+  /// @brief Asynchronously remove a key-value pair from the map.
+  /// @warning Asynchronous operations are guaranteed to have completed
+  /// only after calling the rt::waitForCompletion(rt::Handle &handle) method.
+  /// @param[in,out] handle Reference to the handle
+  /// to be used to wait for completion.
+  /// @param[in] key the key.
+  void AsyncErase(rt::Handle &handle, const KTYPE &key);
+
+  /// @brief Find the first entry whose key is not less than key.
+  /// @param[in] key the key.
+  /// @param[out] resKey the key of the entry, if found.
+  /// @param[out] resValue the value of the entry, if found.
+  /// @return true if such an entry exists, false otherwise.
+  bool LowerBound(const KTYPE &key, KTYPE *resKey, VTYPE *resValue);
+
+  /// @brief Clear the content of the map.
+  /// @warning Clear must not be called concurrently with other operations.
+  void Clear() {
+    FreeNodes();
+    head_ = new Node(kMaxLevel);
+    head_->fullyLinked = true;
+    size_ = 0;
+  }
+
+  /// @brief Apply a user-defined function to each key-value pair, in key
+  /// order.
+  ///
+  /// @tparam ApplyFunT User-defined function type.  The function prototype
+  /// should be:
+  /// @code
+  /// void(const KTYPE&, VTYPE&, Args&);
+  /// @endcode
+  /// @tparam ...Args Types of the function arguments.
+  ///
+  /// @param function The function to apply.
+  /// @param args The function arguments.
+  template <typename ApplyFunT, typename... Args>
+  void ForEachEntry(ApplyFunT &&function, Args &... args);
+
+  /// @brief Apply a user-defined function, in key order, to each key-value
+  /// pair whose key is in the range [first, last).
+  ///
+  /// @tparam ApplyFunT User-defined function type.  The function prototype
+  /// should be:
+  /// @code
+  /// void(const KTYPE&, VTYPE&, Args&);
+  /// @endcode
+  /// @tparam ...Args Types of the function arguments.
+  ///
+  /// @param first The first key of the range.
+  /// @param last The key past the end of the range.
+  /// @param function The function to apply.
+  /// @param args The function arguments.
+  template <typename ApplyFunT, typename... Args>
+  void ForEachInRange(const KTYPE &first, const KTYPE &last,
+                      ApplyFunT &&function, Args &... args);
+
+ private:
+  /// Maximum height of the skip list; with kLevelRatio 4 it comfortably
+  /// indexes billions of entries.
+  static constexpr int kMaxLevel = 16;
+  static constexpr uint32_t kLevelRatio = 4;
+
+  struct Node {
+    explicit Node(int h)
+        : height(h),
+          marked(false),
+          fullyLinked(false),
+          next(new std::atomic<Node *>[h]) {
+      for (int i = 0; i < h; ++i) next[i] = nullptr;
+    }
+
+    KTYPE key;
+    VTYPE value;
+    const int height;
+    std::atomic<bool> marked;
+    std::atomic<bool> fullyLinked;
+    rt::Lock lock;
+    std::unique_ptr<std::atomic<Node *>[]> next;
+  };
+
+  KEY_COMPARE KeyComp_;
+  Node *head_;
+  std::atomic<size_t> size_;
+  std::vector<Node *> retired_;
+  rt::Lock retiredLock_;
+
+  static int RandomLevel() {
+    static thread_local uint64_t state =
+        0x9E3779B97F4A7C15ull ^ reinterpret_cast<uintptr_t>(&state);
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    int level = 1;
+    uint64_t bits = state;
+    while (level < kMaxLevel && (bits % kLevelRatio) == 0) {
+      ++level;
+      bits /= kLevelRatio;
+    }
+    return level;
+  }
+
+  // Fill preds and succs for key; return the highest level at which a node
+  // with an equal key has been found, -1 otherwise.
+  int Find(const KTYPE &key, Node **preds, Node **succs) const {
+    int found = -1;
+    Node *pred = head_;
+    for (int level = kMaxLevel - 1; level >= 0; --level) {
+      Node *curr = pred->next[level].load();
+      while (curr != nullptr && KeyComp_(curr->key, key)) {
+        pred = curr;
+        curr = pred->next[level].load();
+      }
+      if (found == -1 && curr != nullptr && !KeyComp_(key, curr->key))
+        found = level;
+      preds[level] = pred;
+      succs[level] = curr;
+    }
+    return found;
+  }
+
+  static void UnlockPreds(Node **preds, int highestLocked) {
+    Node *prev = nullptr;
+    for (int level = 0; level <= highestLocked; ++level) {
+      if (preds[level] != prev) {
+        preds[level]->lock.unlock();
+        prev = preds[level];
+      }
+    }
+  }
+
+  static bool IsLive(const Node *node) {
+    return node->fullyLinked && !node->marked;
+  }
+
+  void FreeNodes() {
+    Node *node = head_;
+    while (node != nullptr) {
+      Node *next = node->next[0].load();
+      delete node;
+      node = next;
+    }
+    for (auto node : retired_) delete node;
+    retired_.clear();
+    head_ = nullptr;
+  }
+
+  template <typename ApplyFunT, typename... Args, std::size_t... is>
+  static void CallForEachFun(Node *node, const KTYPE *last,
+                             const KEY_COMPARE &comp, ApplyFunT function,
+                             std::tuple<Args...> &args,
+                             std::index_sequence<is...>) {
+    for (; node != nullptr; node = node->next[0].load()) {
+      if (last != nullptr && !comp(node->key, *last)) break;
+      if (IsLive(node)) function(node->key, node->value, std::get<is>(args)...);
+    }
+  }
+};
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+bool LocalMap<KTYPE, VTYPE, KEY_COMPARE>::Insert(const KTYPE &key,
+                                                 const VTYPE &value) {
+  int topLevel = RandomLevel();
+  Node *preds[kMaxLevel];
+  Node *succs[kMaxLevel];
+
+  for (;;) {
+    int found = Find(key, preds, succs);
+    if (found != -1) {
+      Node *nodeFound = succs[found];
+      if (!nodeFound->marked) {
+        while (!nodeFound->fullyLinked) rt::impl::yield();
+        std::lock_guard<rt::Lock> _(nodeFound->lock);
+        if (!nodeFound->marked) {
+          nodeFound->value = value;
+          return false;
+        }
+      }
+      // The node is being removed, retry.
+      continue;
+    }
+
+    int highestLocked = -1;
+    bool valid = true;
+    Node *prevPred = nullptr;
+    for (int level = 0; valid && level < topLevel; ++level) {
+      Node *pred = preds[level];
+      Node *succ = succs[level];
+      if (pred != prevPred) {
+        pred->lock.lock();
+        prevPred = pred;
+      }
+      highestLocked = level;
+      valid = !pred->marked && (succ == nullptr || !succ->marked) &&
+              pred->next[level].load() == succ;
+    }
+    if (!valid) {
+      UnlockPreds(preds, highestLocked);
+      continue;
+    }
+
+    Node *newNode = new Node(topLevel);
+    newNode->key = key;
+    newNode->value = value;
+    for (int level = 0; level < topLevel; ++level)
+      newNode->next[level] = succs[level];
+    for (int level = 0; level < topLevel; ++level)
+      preds[level]->next[level] = newNode;
+    newNode->fullyLinked = true;
+    size_ += 1;
+    UnlockPreds(preds, highestLocked);
+    return true;
+  }
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+void LocalMap<KTYPE, VTYPE, KEY_COMPARE>::AsyncInsert(rt::Handle &handle,
+                                                      const KTYPE &key,
+                                                      const VTYPE &value) {
+  using LMapPtr = LocalMap<KTYPE, VTYPE, KEY_COMPARE> *;
+  auto args = std::make_tuple(this, key, value);
+  auto insertLambda = [](rt::Handle &,
+                         const std::tuple<LMapPtr, KTYPE, VTYPE> &t) {
+    (std::get<0>(t))->Insert(std::get<1>(t), std::get<2>(t));
+  };
+  rt::asyncExecuteAt(handle, rt::thisLocality(), insertLambda, args);
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+bool LocalMap<KTYPE, VTYPE, KEY_COMPARE>::Lookup(const KTYPE &key,
+                                                 VTYPE *res) {
+  Node *preds[kMaxLevel];
+  Node *succs[kMaxLevel];
+  int found = Find(key, preds, succs);
+  if (found == -1) return false;
+  Node *node = succs[found];
+  if (!IsLive(node)) return false;
+  std::lock_guard<rt::Lock> _(node->lock);
+  *res = node->value;
+  return true;
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+void LocalMap<KTYPE, VTYPE, KEY_COMPARE>::Erase(const KTYPE &key) {
+  Node *victim = nullptr;
+  bool isMarked = false;
+  int topLevel = -1;
+  Node *preds[kMaxLevel];
+  Node *succs[kMaxLevel];
+
+  for (;;) {
+    int found = Find(key, preds, succs);
+    if (found != -1) victim = succs[found];
+    if (!isMarked &&
+        (found == -1 || !victim->fullyLinked ||
+         victim->height - 1 != found || victim->marked))
+      return;
+
+    if (!isMarked) {
+      topLevel = victim->height;
+      victim->lock.lock();
+      if (victim->marked) {
+        victim->lock.unlock();
+        return;
+      }
+      victim->marked = true;
+      isMarked = true;
+    }
+
+    int highestLocked = -1;
+    bool valid = true;
+    Node *prevPred = nullptr;
+    for (int level = 0; valid && level < topLevel; ++level) {
+      Node *pred = preds[level];
+      if (pred != prevPred) {
+        pred->lock.lock();
+        prevPred = pred;
+      }
+      highestLocked = level;
+      valid = !pred->marked && pred->next[level].load() == victim;
+    }
+    if (!valid) {
+      UnlockPreds(preds, highestLocked);
+      continue;
+    }
+
+    for (int level = topLevel - 1; level >= 0; --level)
+      preds[level]->next[level] = victim->next[level].load();
+    victim->lock.unlock();
+    size_ -= 1;
+    UnlockPreds(preds, highestLocked);
+
+    std::lock_guard<rt::Lock> _(retiredLock_);
+    retired_.push_back(victim);
+    return;
+  }
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+void LocalMap<KTYPE, VTYPE, KEY_COMPARE>::AsyncErase(rt::Handle &handle,
+                                                     const KTYPE &key) {
+  using LMapPtr = LocalMap<KTYPE, VTYPE, KEY_COMPARE> *;
+  auto args = std::make_tuple(this, key);
+  auto eraseLambda = [](rt::Handle &, const std::tuple<LMapPtr, KTYPE> &t) {
+    (std::get<0>(t))->Erase(std::get<1>(t));
+  };
+  rt::asyncExecuteAt(handle, rt::thisLocality(), eraseLambda, args);
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+bool LocalMap<KTYPE, VTYPE, KEY_COMPARE>::LowerBound(const KTYPE &key,
+                                                     KTYPE *resKey,
+                                                     VTYPE *resValue) {
+  Node *preds[kMaxLevel];
+  Node *succs[kMaxLevel];
+  Find(key, preds, succs);
+  for (Node *node = succs[0]; node != nullptr; node = node->next[0].load()) {
+    if (!IsLive(node)) continue;
+    std::lock_guard<rt::Lock> _(node->lock);
+    if (node->marked) continue;
+    *resKey = node->key;
+    *resValue = node->value;
+    return true;
+  }
+  return false;
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+template <typename ApplyFunT, typename... Args>
+void LocalMap<KTYPE, VTYPE, KEY_COMPARE>::ForEachEntry(ApplyFunT &&function,
+                                                       Args &... args) {
+  using FunctionTy = void (*)(const KTYPE &, VTYPE &, Args &...);
+  FunctionTy fn = std::forward<decltype(function)>(function);
+  std::tuple<Args &...> argsTuple(args...);
+  CallForEachFun(head_->next[0].load(), nullptr, KeyComp_, fn, argsTuple,
+                 std::index_sequence_for<Args...>{});
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+template <typename ApplyFunT, typename... Args>
+void LocalMap<KTYPE, VTYPE, KEY_COMPARE>::ForEachInRange(const KTYPE &first,
+                                                         const KTYPE &last,
+                                                         ApplyFunT &&function,
+                                                         Args &... args) {
+  using FunctionTy = void (*)(const KTYPE &, VTYPE &, Args &...);
+  FunctionTy fn = std::forward<decltype(function)>(function);
+  Node *preds[kMaxLevel];
+  Node *succs[kMaxLevel];
+  Find(first, preds, succs);
+  std::tuple<Args &...> argsTuple(args...);
+  CallForEachFun(succs[0], &last, KeyComp_, fn, argsTuple,
+                 std::index_sequence_for<Args...>{});
+}
+
+}  // namespace shad
+
+#endif  // INCLUDE_SHAD_DATA_STRUCTURES_LOCAL_MAP_H_
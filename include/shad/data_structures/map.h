@@ -0,0 +1,607 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef INCLUDE_SHAD_DATA_STRUCTURES_MAP_H_
+#define INCLUDE_SHAD_DATA_STRUCTURES_MAP_H_
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "shad/data_structures/abstract_data_structure.h"
+#include "shad/data_structures/buffer.h"
+#include "shad/data_structures/local_map.h"
+#include "shad/runtime/runtime.h"
+
+namespace shad {
+
+/// @brief The Map data structure.
+///
+/// SHAD's Map is a distributed, thread-safe, ordered associative container.
+/// Keys are range-partitioned across localities by a replicated vector of
+/// splitters: Locality i owns the keys in [splitter[i - 1], splitter[i]).
+/// Each Locality stores its partition in a LocalMap (a concurrent skip list),
+/// so that range scans only touch the localities overlapping the range.
+///
+/// Typical usage:
+/// @code
+/// auto map = shad::Map<uint64_t, uint64_t>::Create(0lu, 1lu << 32);
+/// map->Insert(42, 1);
+/// map->Rebalance();  // adapt the partitioning to the inserted keys
+/// map->ForEachInRange(10, 100, fn);
+/// @endcode
+///
+/// @tparam KTYPE type of the map keys.
+/// @tparam VTYPE type of the map values.
+/// @tparam KEY_COMPARE strict weak ordering of the keys;
+/// default is std::less<KTYPE>.
+/// @warning obects of type KTYPE and VTYPE need to be trivially copiable.
+/// @warning Rebalance is a collective operation and must not overlap with
+/// any other operation on the Map.
+template <typename KTYPE, typename VTYPE,
+          typename KEY_COMPARE = std::less<KTYPE>>
+class Map : public AbstractDataStructure<Map<KTYPE, VTYPE, KEY_COMPARE>> {
+  template <typename>
+  friend class AbstractDataStructure;
+
+ public:
+  using value_type = std::pair<KTYPE, VTYPE>;
+  using MapT = Map<KTYPE, VTYPE, KEY_COMPARE>;
+  using LMapT = LocalMap<KTYPE, VTYPE, KEY_COMPARE>;
+  using ObjectID = typename AbstractDataStructure<MapT>::ObjectID;
+  using ShadMapPtr = typename AbstractDataStructure<MapT>::SharedPtr;
+
+  struct EntryT {
+    EntryT(const KTYPE &k, const VTYPE &v) : key(k), value(v) {}
+    EntryT() = default;
+    KTYPE key;
+    VTYPE value;
+  };
+  using BuffersVector = typename impl::BuffersVector<EntryT, MapT>;
+
+  /// Result of the LowerBound operation.
+  struct LookupResult {
+    bool found;
+    KTYPE key;
+    VTYPE value;
+  };
+
+  /// Number of keys sampled on each Locality by Rebalance.
+  static constexpr size_t kSamplesPerLocality = 64;
+
+  /// @brief Create method.
+  ///
+  /// Creates a new map instance.  Until the first call to Rebalance, all the
+  /// entries are stored on Locality 0.
+  /// @return A shared pointer to the newly created map instance.
+#ifdef DOXYGEN_IS_RUNNING
+  static ShadMapPtr Create();
+#endif
+
+  /// @brief Create method.
+  ///
+  /// Creates a new map instance whose key range [minKey, maxKey) is evenly
+  /// split among localities.  Available only for arithmetic keys.
+  /// @param minKey The expected smallest key.
+  /// @param maxKey The expected largest key.
+  /// @return A shared pointer to the newly created map instance.
+#ifdef DOXYGEN_IS_RUNNING
+  static ShadMapPtr Create(const KTYPE &minKey, const KTYPE &maxKey);
+#endif
+
+  /// @brief Getter of the Global Identifier.
+  ///
+  /// @return The global identifier associated with the map instance.
+  ObjectID GetGlobalID() const { return oid_; }
+
+  /// @brief Overall size of the map (number of entries).
+  /// @warning Calling the size method may result in one-to-all
+  /// communication among localities to retrieve consinstent information.
+  /// @return the size of the map.
+  size_t Size() const;
+
+  /// @brief Insert a key-value pair in the map.
+  /// @param[in] key the key.
+  /// @param[in] value the value to copy into the map.
+  /// @return true if the key was not in the map, false otherwise.
+  bool Insert(const KTYPE &key, const VTYPE &value);
+
+  /// @brief Asynchronously Insert a key-value pair in the map.
+  /// @warning Asynchronous operations are guaranteed to have completed
+  /// only after calling the rt::waitForCompletion(rt::Handle &handle) method.
+  /// @param[in,out] handle Reference to the handle
+  /// to be used to wait for completion.
+  /// @param[in] key the key.
+  /// @param[in] value the value to copy into the map.
+  void AsyncInsert(rt::Handle &handle, const KTYPE &key, const VTYPE &value);
+
+  /// @brief Buffered Insert method.
+  /// Inserts a key-value pair, using aggregation buffers.
+  /// @warning Insertions are finalized only after calling
+  /// the WaitForBufferedInsert() method.
+  /// @param[in] key The key.
+  /// @param[in] value The value.
+  void BufferedInsert(const KTYPE &key, const VTYPE &value) {
+    buffers_.Insert(EntryT(key, value), TargetLocality(key));
+  }
+
+  /// @brief Asynchronous Buffered Insert method.
+  /// Asynchronously inserts a key-value pair, using aggregation buffers.
+  /// @warning asynchronous buffered insertions are finalized only after
+  /// calling the rt::waitForCompletion(rt::Handle &handle) method AND
+  /// the WaitForBufferedInsert() method, in this order.
+  /// @param[in,out] handle Reference to the handle
+  /// @param[in] key The key.
+  /// @param[in] value The value.
+  void BufferedAsyncInsert(rt::Handle &handle, const KTYPE &key,
+                           const VTYPE &value) {
+    buffers_.AsyncInsert(handle, EntryT(key, value), TargetLocality(key));
+  }
+
+  /// @brief Finalize method for buffered insertions.
+  void WaitForBufferedInsert() {
+    auto flushLambda_ = [](const ObjectID &oid) {
+      auto ptr = MapT::GetPtr(oid);
+      ptr->buffers_.FlushAll();
+    };
+    rt::executeOnAll(flushLambda_, oid_);
+  }
+
+  /// @brief Remove a key-value pair from the map.
+  /// @param[in] key the key.
+  void Erase(const KTYPE &key);
+
+  /// @brief Asynchronously remove a key-value pair from the map.
+  /// @warning Asynchronous operations are guaranteed to have completed
+  /// only after calling the rt::waitForCompletion(rt::Handle &handle) method.
+  /// @param[in,out] handle Reference to the handle
+  /// to be used to wait for completion.
+  /// @param[in] key the key.
+  void AsyncErase(rt::Handle &handle, const KTYPE &key);
+
+  /// @brief Clear the content of the map.
+  void Clear() {
+    auto clearLambda = [](const ObjectID &oid) {
+      auto mapPtr = MapT::GetPtr(oid);
+      mapPtr->localMap_.Clear();
+    };
+    rt::executeOnAll(clearLambda, oid_);
+  }
+
+  /// @brief Get the value associated to a key.
+  /// @param[in] key the key.
+  /// @param[out] res the value, if the key is found.
+  /// @return true if the entry is found, false otherwise.
+  bool Lookup(const KTYPE &key, VTYPE *res);
+
+  /// @brief Find the entry with the smallest key not less than key.
+  /// @param[in] key the key.
+  /// @param[out] resKey the key of the entry, if found.
+  /// @param[out] resValue the value of the entry, if found.
+  /// @return true if such an entry exists, false otherwise.
+  bool LowerBound(const KTYPE &key, KTYPE *resKey, VTYPE *resValue);
+
+  /// @brief Apply a user-defined function to each key-value pair.
+  ///
+  /// Entries are visited in key order within each Locality, and localities
+  /// process their partitions in parallel.
+  ///
+  /// @tparam ApplyFunT User-defined function type.  The function prototype
+  /// should be:
+  /// @code
+  /// void(const KTYPE&, VTYPE&, Args&);
+  /// @endcode
+  /// @tparam ...Args Types of the function arguments.
+  ///
+  /// @param function The function to apply.
+  /// @param args The function arguments.
+  template <typename ApplyFunT, typename... Args>
+  void ForEachEntry(ApplyFunT &&function, Args &... args);
+
+  /// @brief Apply a user-defined function to each key-value pair whose key is
+  /// in the range [first, last).
+  ///
+  /// Only the localities whose partition overlaps the range are involved.
+  ///
+  /// @tparam ApplyFunT User-defined function type.  The function prototype
+  /// should be:
+  /// @code
+  /// void(const KTYPE&, VTYPE&, Args&);
+  /// @endcode
+  /// @tparam ...Args Types of the function arguments.
+  ///
+  /// @param first The first key of the range.
+  /// @param last The key past the end of the range.
+  /// @param function The function to apply.
+  /// @param args The function arguments.
+  template <typename ApplyFunT, typename... Args>
+  void ForEachInRange(const KTYPE &first, const KTYPE &last,
+                      ApplyFunT &&function, Args &... args);
+
+  /// @brief Recompute the splitters from the current content of the map and
+  /// migrate the entries accordingly.
+  ///
+  /// Every Locality contributes kSamplesPerLocality evenly spaced keys,
+  /// weighted by the size of its partition; the new splitters are the
+  /// weighted quantiles of the samples, so that skewed key distributions end
+  /// up evenly spread across localities.
+  void Rebalance();
+
+  /// @brief The Locality owning a key.
+  /// @param[in] key the key.
+  /// @return The Locality where key is (or would be) stored.
+  rt::Locality TargetLocality(const KTYPE &key) const {
+    auto pos = std::upper_bound(splitters_.begin(), splitters_.end(), key,
+                                KeyComp_);
+    return rt::Locality(static_cast<uint32_t>(pos - splitters_.begin()));
+  }
+
+  // FIXME it should be protected
+  void BufferEntryInsert(const EntryT &entry) {
+    localMap_.Insert(entry.key, entry.value);
+  }
+
+ private:
+  ObjectID oid_;
+  KEY_COMPARE KeyComp_;
+  std::vector<KTYPE> splitters_;
+  LMapT localMap_;
+  BuffersVector buffers_;
+
+  struct InsertArgs {
+    ObjectID oid;
+    KTYPE key;
+    VTYPE value;
+  };
+
+  struct LookupArgs {
+    ObjectID oid;
+    KTYPE key;
+  };
+
+  struct SamplesT {
+    size_t localSize;
+    size_t numSamples;
+    KTYPE samples[kSamplesPerLocality];
+  };
+
+  template <typename ApplyFunT, typename... Args, std::size_t... is>
+  static void CallForEachFun(LMapT *mapPtr, const KTYPE *first,
+                             const KTYPE *last, ApplyFunT function,
+                             std::tuple<Args...> &args,
+                             std::index_sequence<is...>) {
+    if (first == nullptr)
+      mapPtr->ForEachEntry(function, std::get<is>(args)...);
+    else
+      mapPtr->ForEachInRange(*first, *last, function, std::get<is>(args)...);
+  }
+
+  template <typename ArgsTuple, typename... Args>
+  static void ForEachFunWrapper(const ArgsTuple &args) {
+    constexpr auto Size = std::tuple_size<
+        typename std::decay<decltype(std::get<4>(args))>::type>::value;
+    ArgsTuple &tuple = const_cast<ArgsTuple &>(args);
+    auto mapPtr = MapT::GetPtr(std::get<0>(tuple));
+    bool inRange = std::get<1>(tuple);
+    CallForEachFun(&mapPtr->localMap_,
+                   inRange ? &std::get<2>(tuple) : nullptr,
+                   inRange ? &std::get<3>(tuple) : nullptr,
+                   std::get<5>(tuple), std::get<4>(tuple),
+                   std::make_index_sequence<Size>{});
+  }
+
+  static void SetSplitters(const uint8_t *buffer, const uint32_t size) {
+    ObjectID oid(ObjectID::kNullID);
+    std::memcpy(&oid, buffer, sizeof(ObjectID));
+    auto mapPtr = MapT::GetPtr(oid);
+    size_t numSplitters = (size - sizeof(ObjectID)) / sizeof(KTYPE);
+    const KTYPE *splitters =
+        reinterpret_cast<const KTYPE *>(buffer + sizeof(ObjectID));
+    mapPtr->splitters_.assign(splitters, splitters + numSplitters);
+  }
+
+  template <typename K = KTYPE>
+  void InitSplitters(const K &minKey, const K &maxKey, std::true_type) {
+    uint32_t numLocalities = rt::numLocalities();
+    splitters_.reserve(numLocalities - 1);
+    for (uint32_t i = 1; i < numLocalities; ++i) {
+      splitters_.push_back(static_cast<K>(
+          minKey + (maxKey - minKey) / numLocalities * i));
+    }
+  }
+
+  template <typename K = KTYPE>
+  void InitSplitters(const K &, const K &, std::false_type) {}
+
+ protected:
+  explicit Map(ObjectID oid) : oid_(oid), buffers_(oid) {}
+
+  Map(ObjectID oid, const KTYPE &minKey, const KTYPE &maxKey)
+      : oid_(oid), buffers_(oid) {
+    InitSplitters(minKey, maxKey, std::is_arithmetic<KTYPE>{});
+  }
+};
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+inline size_t Map<KTYPE, VTYPE, KEY_COMPARE>::Size() const {
+  size_t size = localMap_.Size();
+  size_t remoteSize;
+  auto sizeLambda = [](const ObjectID &oid, size_t *res) {
+    auto mapPtr = MapT::GetPtr(oid);
+    *res = mapPtr->localMap_.Size();
+  };
+  for (auto tgtLoc : rt::allLocalities()) {
+    if (tgtLoc != rt::thisLocality()) {
+      rt::executeAtWithRet(tgtLoc, sizeLambda, oid_, &remoteSize);
+      size += remoteSize;
+    }
+  }
+  return size;
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+inline bool Map<KTYPE, VTYPE, KEY_COMPARE>::Insert(const KTYPE &key,
+                                                   const VTYPE &value) {
+  rt::Locality targetLocality = TargetLocality(key);
+  if (targetLocality == rt::thisLocality()) {
+    return localMap_.Insert(key, value);
+  }
+  auto insertLambda = [](const InsertArgs &args, bool *res) {
+    auto mapPtr = MapT::GetPtr(args.oid);
+    *res = mapPtr->localMap_.Insert(args.key, args.value);
+  };
+  bool res;
+  rt::executeAtWithRet(targetLocality, insertLambda,
+                       InsertArgs{oid_, key, value}, &res);
+  return res;
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+inline void Map<KTYPE, VTYPE, KEY_COMPARE>::AsyncInsert(rt::Handle &handle,
+                                                        const KTYPE &key,
+                                                        const VTYPE &value) {
+  rt::Locality targetLocality = TargetLocality(key);
+  if (targetLocality == rt::thisLocality()) {
+    localMap_.AsyncInsert(handle, key, value);
+  } else {
+    auto insertLambda = [](rt::Handle &, const InsertArgs &args) {
+      auto mapPtr = MapT::GetPtr(args.oid);
+      mapPtr->localMap_.Insert(args.key, args.value);
+    };
+    InsertArgs args = {oid_, key, value};
+    rt::asyncExecuteAt(handle, targetLocality, insertLambda, args);
+  }
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+inline void Map<KTYPE, VTYPE, KEY_COMPARE>::Erase(const KTYPE &key) {
+  rt::Locality targetLocality = TargetLocality(key);
+  if (targetLocality == rt::thisLocality()) {
+    localMap_.Erase(key);
+  } else {
+    auto eraseLambda = [](const LookupArgs &args) {
+      auto mapPtr = MapT::GetPtr(args.oid);
+      mapPtr->localMap_.Erase(args.key);
+    };
+    LookupArgs args = {oid_, key};
+    rt::executeAt(targetLocality, eraseLambda, args);
+  }
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+inline void Map<KTYPE, VTYPE, KEY_COMPARE>::AsyncErase(rt::Handle &handle,
+                                                       const KTYPE &key) {
+  rt::Locality targetLocality = TargetLocality(key);
+  if (targetLocality == rt::thisLocality()) {
+    localMap_.AsyncErase(handle, key);
+  } else {
+    auto eraseLambda = [](rt::Handle &, const LookupArgs &args) {
+      auto mapPtr = MapT::GetPtr(args.oid);
+      mapPtr->localMap_.Erase(args.key);
+    };
+    LookupArgs args = {oid_, key};
+    rt::asyncExecuteAt(handle, targetLocality, eraseLambda, args);
+  }
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+inline bool Map<KTYPE, VTYPE, KEY_COMPARE>::Lookup(const KTYPE &key,
+                                                   VTYPE *res) {
+  rt::Locality targetLocality = TargetLocality(key);
+  if (targetLocality == rt::thisLocality()) {
+    return localMap_.Lookup(key, res);
+  }
+  auto lookupLambda = [](const LookupArgs &args, LookupResult *res) {
+    auto mapPtr = MapT::GetPtr(args.oid);
+    res->found = mapPtr->localMap_.Lookup(args.key, &res->value);
+  };
+  LookupArgs args = {oid_, key};
+  LookupResult lres;
+  rt::executeAtWithRet(targetLocality, lookupLambda, args, &lres);
+  if (lres.found) *res = lres.value;
+  return lres.found;
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+inline bool Map<KTYPE, VTYPE, KEY_COMPARE>::LowerBound(const KTYPE &key,
+                                                       KTYPE *resKey,
+                                                       VTYPE *resValue) {
+  auto lowerBoundLambda = [](const LookupArgs &args, LookupResult *res) {
+    auto mapPtr = MapT::GetPtr(args.oid);
+    res->found =
+        mapPtr->localMap_.LowerBound(args.key, &res->key, &res->value);
+  };
+  LookupArgs args = {oid_, key};
+  LookupResult lres;
+  // Partitions are ordered: the answer is in the first non-empty partition
+  // at or after the one owning key.
+  for (uint32_t i = static_cast<uint32_t>(TargetLocality(key));
+       i < rt::numLocalities(); ++i) {
+    rt::executeAtWithRet(rt::Locality(i), lowerBoundLambda, args, &lres);
+    if (lres.found) {
+      *resKey = lres.key;
+      *resValue = lres.value;
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+template <typename ApplyFunT, typename... Args>
+void Map<KTYPE, VTYPE, KEY_COMPARE>::ForEachEntry(ApplyFunT &&function,
+                                                  Args &... args) {
+  using FunctionTy = void (*)(const KTYPE &, VTYPE &, Args &...);
+  FunctionTy fn = std::forward<decltype(function)>(function);
+  using ArgsTuple = std::tuple<ObjectID, bool, KTYPE, KTYPE,
+                               std::tuple<Args...>, FunctionTy>;
+  ArgsTuple arguments(oid_, false, KTYPE(), KTYPE(),
+                      std::tuple<Args...>(args...), fn);
+  rt::executeOnAll(ForEachFunWrapper<ArgsTuple, Args...>, arguments);
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+template <typename ApplyFunT, typename... Args>
+void Map<KTYPE, VTYPE, KEY_COMPARE>::ForEachInRange(const KTYPE &first,
+                                                    const KTYPE &last,
+                                                    ApplyFunT &&function,
+                                                    Args &... args) {
+  if (!KeyComp_(first, last)) return;
+  using FunctionTy = void (*)(const KTYPE &, VTYPE &, Args &...);
+  FunctionTy fn = std::forward<decltype(function)>(function);
+  using ArgsTuple = std::tuple<ObjectID, bool, KTYPE, KTYPE,
+                               std::tuple<Args...>, FunctionTy>;
+  ArgsTuple arguments(oid_, true, first, last, std::tuple<Args...>(args...),
+                      fn);
+  uint32_t firstLoc = static_cast<uint32_t>(TargetLocality(first));
+  uint32_t lastLoc = static_cast<uint32_t>(TargetLocality(last));
+  rt::Handle handle;
+  for (uint32_t i = firstLoc; i <= lastLoc; ++i) {
+    rt::asyncExecuteAt(
+        handle, rt::Locality(i),
+        [](rt::Handle &, const ArgsTuple &args) {
+          ForEachFunWrapper<ArgsTuple, Args...>(args);
+        },
+        arguments);
+  }
+  rt::waitForCompletion(handle);
+}
+
+template <typename KTYPE, typename VTYPE, typename KEY_COMPARE>
+void Map<KTYPE, VTYPE, KEY_COMPARE>::Rebalance() {
+  uint32_t numLocalities = rt::numLocalities();
+  if (numLocalities == 1) return;
+
+  // 1. Gather evenly spaced samples from every partition.
+  auto sampleLambda = [](rt::Handle &, const ObjectID &oid, SamplesT *res) {
+    auto mapPtr = MapT::GetPtr(oid);
+    res->localSize = mapPtr->localMap_.Size();
+    res->numSamples = 0;
+    size_t stride =
+        std::max(res->localSize / kSamplesPerLocality, static_cast<size_t>(1));
+    size_t pos = 0;
+    mapPtr->localMap_.ForEachEntry(
+        [](const KTYPE &key, VTYPE &, SamplesT *&res, size_t &stride,
+           size_t &pos) {
+          if (pos++ % stride == 0 && res->numSamples < kSamplesPerLocality)
+            res->samples[res->numSamples++] = key;
+        },
+        res, stride, pos);
+  };
+  std::vector<SamplesT> samples(numLocalities);
+  rt::Handle handle;
+  for (auto &loc : rt::allLocalities()) {
+    rt::asyncExecuteAtWithRet(handle, loc, sampleLambda, oid_,
+                              &samples[static_cast<uint32_t>(loc)]);
+  }
+  rt::waitForCompletion(handle);
+
+  // 2. Pick the weighted quantiles as new splitters.
+  std::vector<std::pair<KTYPE, double>> weighted;
+  double totalWeight = 0;
+  for (auto &s : samples) {
+    if (s.numSamples == 0) continue;
+    double weight = static_cast<double>(s.localSize) / s.numSamples;
+    for (size_t i = 0; i < s.numSamples; ++i)
+      weighted.emplace_back(s.samples[i], weight);
+    totalWeight += s.localSize;
+  }
+  if (weighted.empty()) return;
+  KEY_COMPARE comp;
+  std::sort(weighted.begin(), weighted.end(),
+            [&](const std::pair<KTYPE, double> &a,
+                const std::pair<KTYPE, double> &b) {
+              return comp(a.first, b.first);
+            });
+  std::vector<KTYPE> newSplitters;
+  double cumulative = 0;
+  auto it = weighted.begin();
+  for (uint32_t i = 1; i < numLocalities; ++i) {
+    double threshold = totalWeight * i / numLocalities;
+    while (it != weighted.end() - 1 && cumulative + it->second <= threshold) {
+      cumulative += it->second;
+      ++it;
+    }
+    newSplitters.push_back(it->first);
+  }
+
+  // 3. Broadcast the splitters.
+  uint32_t bufferSize = sizeof(ObjectID) + sizeof(KTYPE) * newSplitters.size();
+  std::shared_ptr<uint8_t> buffer(new uint8_t[bufferSize],
+                                  std::default_delete<uint8_t[]>());
+  std::memcpy(buffer.get(), &oid_, sizeof(ObjectID));
+  std::memcpy(buffer.get() + sizeof(ObjectID), newSplitters.data(),
+              sizeof(KTYPE) * newSplitters.size());
+  rt::executeOnAll(SetSplitters, buffer, bufferSize);
+
+  // 4. Move the entries that changed owner.
+  auto migrateLambda = [](const ObjectID &oid) {
+    auto mapPtr = MapT::GetPtr(oid);
+    std::vector<EntryT> toMove;
+    auto self = mapPtr.get();
+    auto toMovePtr = &toMove;
+    mapPtr->localMap_.ForEachEntry(
+        [](const KTYPE &key, VTYPE &value, MapT *&self,
+           std::vector<EntryT> *&toMove) {
+          if (self->TargetLocality(key) != rt::thisLocality())
+            toMove->emplace_back(key, value);
+        },
+        self, toMovePtr);
+    for (auto &entry : toMove) {
+      mapPtr->buffers_.Insert(entry, mapPtr->TargetLocality(entry.key));
+      mapPtr->localMap_.Erase(entry.key);
+    }
+  };
+  rt::executeOnAll(migrateLambda, oid_);
+  WaitForBufferedInsert();
+}
+
+}  // namespace shad
+
+#endif  // INCLUDE_SHAD_DATA_STRUCTURES_MAP_H_
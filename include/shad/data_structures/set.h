@@ -195,6 +195,51 @@ class Set : public AbstractDataStructure<Set<T, ELEM_COMPARE>> {
   void AsyncForEachElement(rt::Handle& handle, ApplyFunT&& function,
                            Args&... args);
 
+  /// @brief Union of two sets.
+  ///
+  /// Sets of the same type place each element on the same Locality, so the
+  /// operation is computed independently on each Locality, without
+  /// per-element communication.
+  ///
+  /// Typical usage:
+  /// @code
+  /// auto set1 = shad::Set<int>::Create(1024);
+  /// auto set2 = shad::Set<int>::Create(1024);
+  /// // ...
+  /// auto result = set1->Union(set2);
+  /// @endcode
+  ///
+  /// @param[in] other The second operand.
+  /// @return A shared pointer to a new set containing the elements that are
+  /// in this set or in other.
+  ShadSetPtr Union(const ShadSetPtr& other) {
+    return SetAlgebra(other, SetOperation::kUnion, Size() + other->Size());
+  }
+
+  /// @brief Intersection of two sets.
+  ///
+  /// Computed independently on each Locality, probing the larger local set
+  /// with the elements of the smaller one.
+  ///
+  /// @param[in] other The second operand.
+  /// @return A shared pointer to a new set containing the elements that are
+  /// both in this set and in other.
+  ShadSetPtr Intersect(const ShadSetPtr& other) {
+    return SetAlgebra(other, SetOperation::kIntersect,
+                      std::min(Size(), other->Size()));
+  }
+
+  /// @brief Difference of two sets.
+  ///
+  /// Computed independently on each Locality.
+  ///
+  /// @param[in] other The second operand.
+  /// @return A shared pointer to a new set containing the elements of this
+  /// set that are not in other.
+  ShadSetPtr Difference(const ShadSetPtr& other) {
+    return SetAlgebra(other, SetOperation::kDifference, Size());
+  }
+
   /// @brief Print all the entries in the set.
   /// @warning std::ostream & operator<< must be defined for T.
   void PrintAllElements() {
@@ -252,6 +297,18 @@ class Set : public AbstractDataStructure<Set<T, ELEM_COMPARE>> {
     T element;
   };
 
+  enum class SetOperation { kUnion, kIntersect, kDifference };
+
+  struct SetAlgebraArgs {
+    ObjectID lhs;
+    ObjectID rhs;
+    ObjectID result;
+    SetOperation op;
+  };
+
+  ShadSetPtr SetAlgebra(const ShadSetPtr& other, SetOperation op,
+                        size_t expectedEntries);
+
  protected:
   Set(ObjectID oid, const size_t numEntries)
       : oid_(oid),
@@ -449,6 +506,42 @@ void Set<T, ELEM_COMPARE>::AsyncForEachElement(rt::Handle& handle,
   rt::asyncExecuteOnAll(handle, feLambda, arguments);
 }
 
+template <typename T, typename ELEM_COMPARE>
+typename Set<T, ELEM_COMPARE>::ShadSetPtr Set<T, ELEM_COMPARE>::SetAlgebra(
+    const ShadSetPtr& other, SetOperation op, size_t expectedEntries) {
+  auto result = SetT::Create(expectedEntries);
+  SetAlgebraArgs args{oid_, other->GetGlobalID(), result->GetGlobalID(), op};
+  auto algebraLambda = [](const SetAlgebraArgs& args) {
+    LSetT* lhs = &SetT::GetPtr(args.lhs)->localSet_;
+    LSetT* rhs = &SetT::GetPtr(args.rhs)->localSet_;
+    LSetT* res = &SetT::GetPtr(args.result)->localSet_;
+    auto insertFn = [](const T& element, LSetT*& res) {
+      res->Insert(element);
+    };
+    auto probeFn = [](const T& element, LSetT*& probe, bool& expected,
+                      LSetT*& res) {
+      if (probe->Find(element) == expected) res->Insert(element);
+    };
+    bool expected = true;
+    switch (args.op) {
+      case SetOperation::kUnion:
+        lhs->ForEachElement(insertFn, res);
+        rhs->ForEachElement(insertFn, res);
+        break;
+      case SetOperation::kIntersect:
+        if (lhs->Size() > rhs->Size()) std::swap(lhs, rhs);
+        lhs->ForEachElement(probeFn, rhs, expected, res);
+        break;
+      case SetOperation::kDifference:
+        expected = false;
+        lhs->ForEachElement(probeFn, rhs, expected, res);
+        break;
+    }
+  };
+  rt::executeOnAll(algebraLambda, args);
+  return result;
+}
+
 template <typename SetT, typename T, typename NonConstT>
 class set_iterator : public std::iterator<std::forward_iterator_tag, T> {
  public:
@@ -0,0 +1,508 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef INCLUDE_SHAD_DATA_STRUCTURES_SKETCHES_H_
+#define INCLUDE_SHAD_DATA_STRUCTURES_SKETCHES_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "shad/data_structures/compare_and_hash_utils.h"
+#include "shad/data_structures/one_per_locality.h"
+#include "shad/runtime/runtime.h"
+
+namespace shad {
+
+/// @brief HyperLogLog cardinality estimator.
+///
+/// The sketch uses 2^precision one-byte registers, and estimates the number
+/// of distinct elements inserted with a relative standard error of about
+/// 1.04 / sqrt(2^precision).  Insertions are thread safe.  It is meant to be
+/// instantiated with OnePerLocality, updated locally, and combined with
+/// MergeSketches() or AllMergeSketches().
+///
+/// Typical usage:
+/// @code
+/// using HLL = shad::HyperLogLog<uint64_t>;
+/// auto sketch = shad::OnePerLocality<HLL>::Create(size_t(14));
+/// (*sketch)->Insert(v);  // on any locality, through GetPtr(oid)
+/// double distinct = shad::MergeSketches(sketch).Estimate();
+/// @endcode
+///
+/// @tparam T type of the elements.
+/// @warning obects of type T need to be trivially copiable.
+template <typename T>
+class HyperLogLog {
+ public:
+  /// @brief Location of the registers, used to merge remote sketches.
+  struct State {
+    const uint8_t *registers;
+    size_t numRegisters;
+  };
+
+  /// @brief Constructor.
+  /// @param precision Base-2 logarithm of the number of registers, in
+  /// [4, 18].
+  explicit HyperLogLog(size_t precision = 12)
+      : precision_(std::min(std::max(precision, 4lu), 18lu)),
+        numRegisters_(1lu << precision_),
+        registers_(new std::atomic<uint8_t>[numRegisters_]) {
+    Clear();
+  }
+
+  HyperLogLog(const HyperLogLog &rhs) : HyperLogLog(rhs.precision_) {
+    Merge(rhs);
+  }
+
+  HyperLogLog &operator=(const HyperLogLog &rhs) {
+    if (this == &rhs) return *this;
+    HyperLogLog tmp(rhs);
+    std::swap(precision_, tmp.precision_);
+    std::swap(numRegisters_, tmp.numRegisters_);
+    std::swap(registers_, tmp.registers_);
+    return *this;
+  }
+
+  /// @brief Add an element to the sketch.
+  void Insert(const T &element) {
+    uint64_t hash = shad::HashFunction(element, 7u);
+    size_t idx = hash >> (64 - precision_);
+    uint64_t rest = (hash << precision_) | (1ull << (precision_ - 1));
+    uint8_t rank = __builtin_clzll(rest) + 1;
+    uint8_t current = registers_[idx].load(std::memory_order_relaxed);
+    while (current < rank &&
+           !registers_[idx].compare_exchange_weak(current, rank)) {
+    }
+  }
+
+  /// @brief Estimated number of distinct elements.
+  double Estimate() const {
+    double m = numRegisters_;
+    double sum = 0;
+    size_t zeros = 0;
+    for (size_t i = 0; i < numRegisters_; ++i) {
+      uint8_t r = registers_[i].load(std::memory_order_relaxed);
+      sum += std::ldexp(1.0, -r);
+      zeros += r == 0;
+    }
+    double alpha = 0.7213 / (1 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+    // Linear counting for small cardinalities.
+    if (estimate <= 2.5 * m && zeros != 0)
+      estimate = m * std::log(m / zeros);
+    return estimate;
+  }
+
+  /// @brief Merge another sketch (with the same precision) into this one.
+  void Merge(const HyperLogLog &rhs) {
+    for (size_t i = 0; i < numRegisters_; ++i)
+      MaxRegister(i, rhs.registers_[i].load(std::memory_order_relaxed));
+  }
+
+  /// @brief Reset the sketch to the empty state.
+  void Clear() {
+    for (size_t i = 0; i < numRegisters_; ++i) registers_[i] = 0;
+  }
+
+  /// @brief Number of bytes of the registers.
+  size_t NumRegisters() const { return numRegisters_; }
+
+  // Used by MergeSketches() and AllMergeSketches().
+  State GetState() const {
+    return State{reinterpret_cast<const uint8_t *>(registers_.get()),
+                 numRegisters_};
+  }
+
+  void MergeRemote(const rt::Locality &loc, const State &state) {
+    std::vector<uint8_t> remote(state.numRegisters);
+    rt::dma(remote.data(), loc, state.registers, state.numRegisters);
+    for (size_t i = 0; i < numRegisters_; ++i) MaxRegister(i, remote[i]);
+  }
+
+ private:
+  static_assert(sizeof(std::atomic<uint8_t>) == sizeof(uint8_t),
+                "HyperLogLog registers are copied as raw bytes");
+
+  void MaxRegister(size_t idx, uint8_t value) {
+    uint8_t current = registers_[idx].load(std::memory_order_relaxed);
+    while (current < value &&
+           !registers_[idx].compare_exchange_weak(current, value)) {
+    }
+  }
+
+  size_t precision_;
+  size_t numRegisters_;
+  std::unique_ptr<std::atomic<uint8_t>[]> registers_;
+};
+
+/// @brief Count-min sketch frequency estimator.
+///
+/// The sketch is a depth x width matrix of counters.  Estimates never
+/// underestimate the true frequency, and overestimate it by at most
+/// e / width * TotalCount() with probability 1 - exp(-depth).  Updates are
+/// thread safe.
+///
+/// Typical usage:
+/// @code
+/// using CMS = shad::CountMinSketch<uint64_t>;
+/// auto sketch = shad::OnePerLocality<CMS>::Create(size_t(4096), size_t(4));
+/// (*sketch)->Insert(key);
+/// shad::AllMergeSketches(sketch);
+/// uint64_t count = (*sketch)->Estimate(key);
+/// @endcode
+///
+/// @tparam T type of the elements.
+/// @warning obects of type T need to be trivially copiable.
+template <typename T>
+class CountMinSketch {
+ public:
+  /// @brief Location of the counters, used to merge remote sketches.
+  struct State {
+    const uint64_t *counters;
+    size_t numCounters;
+    uint64_t totalCount;
+  };
+
+  /// @brief Constructor.
+  /// @param width Number of counters per row.
+  /// @param depth Number of rows.
+  explicit CountMinSketch(size_t width = 2048, size_t depth = 4)
+      : width_(std::max(width, 1lu)),
+        depth_(std::max(depth, 1lu)),
+        counters_(new std::atomic<uint64_t>[width_ * depth_]),
+        totalCount_(0) {
+    Clear();
+  }
+
+  CountMinSketch(const CountMinSketch &rhs)
+      : CountMinSketch(rhs.width_, rhs.depth_) {
+    Merge(rhs);
+  }
+
+  CountMinSketch &operator=(const CountMinSketch &rhs) {
+    if (this == &rhs) return *this;
+    CountMinSketch tmp(rhs);
+    std::swap(width_, tmp.width_);
+    std::swap(depth_, tmp.depth_);
+    std::swap(counters_, tmp.counters_);
+    totalCount_ = tmp.totalCount_.load();
+    return *this;
+  }
+
+  /// @brief Add count occurrences of element.
+  void Insert(const T &element, uint64_t count = 1) {
+    uint64_t h1, h2;
+    Hash(element, &h1, &h2);
+    for (size_t r = 0; r < depth_; ++r)
+      counters_[r * width_ + (h1 + r * h2) % width_].fetch_add(
+          count, std::memory_order_relaxed);
+    totalCount_.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  /// @brief Estimated number of occurrences of element.
+  uint64_t Estimate(const T &element) const {
+    uint64_t h1, h2;
+    Hash(element, &h1, &h2);
+    uint64_t res = UINT64_MAX;
+    for (size_t r = 0; r < depth_; ++r)
+      res = std::min(res, counters_[r * width_ + (h1 + r * h2) % width_].load(
+                              std::memory_order_relaxed));
+    return res;
+  }
+
+  /// @brief Sum of the counts inserted.
+  uint64_t TotalCount() const { return totalCount_; }
+
+  /// @brief Merge another sketch (with the same shape) into this one.
+  void Merge(const CountMinSketch &rhs) {
+    for (size_t i = 0; i < width_ * depth_; ++i)
+      counters_[i].fetch_add(rhs.counters_[i].load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+    totalCount_ += rhs.totalCount_;
+  }
+
+  /// @brief Reset the sketch to the empty state.
+  void Clear() {
+    for (size_t i = 0; i < width_ * depth_; ++i) counters_[i] = 0;
+    totalCount_ = 0;
+  }
+
+  // Used by MergeSketches() and AllMergeSketches().
+  State GetState() const {
+    return State{reinterpret_cast<const uint64_t *>(counters_.get()),
+                 width_ * depth_, totalCount_};
+  }
+
+  void MergeRemote(const rt::Locality &loc, const State &state) {
+    std::vector<uint64_t> remote(state.numCounters);
+    rt::dma(remote.data(), loc, state.counters, state.numCounters);
+    for (size_t i = 0; i < width_ * depth_; ++i)
+      counters_[i].fetch_add(remote[i], std::memory_order_relaxed);
+    totalCount_ += state.totalCount;
+  }
+
+ private:
+  static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+                "CountMinSketch counters are copied as raw words");
+
+  static void Hash(const T &element, uint64_t *h1, uint64_t *h2) {
+    uint64_t hash = shad::HashFunction(element, 11u);
+    *h1 = hash & 0xFFFFFFFF;
+    *h2 = (hash >> 32) | 1;
+  }
+
+  size_t width_;
+  size_t depth_;
+  std::unique_ptr<std::atomic<uint64_t>[]> counters_;
+  std::atomic<uint64_t> totalCount_;
+};
+
+/// @brief Heavy-hitters (top-k) sketch.
+///
+/// TopK tracks the k most frequent elements with a CountMinSketch and a
+/// small candidate table.  The table is locked only when the estimate of an
+/// element reaches the smallest count in the table, so that updates of
+/// infrequent elements stay lock-free.
+///
+/// Typical usage:
+/// @code
+/// using TopKT = shad::TopK<uint64_t>;
+/// auto sketch = shad::OnePerLocality<TopKT>::Create(size_t(10));
+/// (*sketch)->Insert(key);
+/// auto heavyHitters = shad::MergeSketches(sketch).Entries();
+/// @endcode
+///
+/// @tparam T type of the elements.
+/// @warning obects of type T need to be trivially copiable.
+template <typename T>
+class TopK {
+ public:
+  /// @brief Element of the candidate table.
+  struct Entry {
+    T element;
+    uint64_t count;
+  };
+
+  /// @brief Location of the sketch, used to merge remote sketches.
+  struct State {
+    typename CountMinSketch<T>::State sketch;
+    const Entry *entries;
+    size_t numEntries;
+  };
+
+  /// @brief Constructor.
+  /// @param k Number of heavy hitters to track.
+  /// @param width Number of counters per row of the count-min sketch.
+  /// @param depth Number of rows of the count-min sketch.
+  explicit TopK(size_t k = 16, size_t width = 2048, size_t depth = 4)
+      : k_(std::max(k, 1lu)), sketch_(width, depth), threshold_(0) {
+    entries_.reserve(k_);
+  }
+
+  TopK(const TopK &rhs)
+      : k_(rhs.k_), sketch_(rhs.sketch_), entries_(rhs.entries_),
+        threshold_(rhs.threshold_.load()) {
+    entries_.reserve(k_);
+  }
+
+  TopK &operator=(const TopK &rhs) {
+    if (this == &rhs) return *this;
+    k_ = rhs.k_;
+    sketch_ = rhs.sketch_;
+    entries_ = rhs.entries_;
+    entries_.reserve(k_);
+    threshold_ = rhs.threshold_.load();
+    return *this;
+  }
+
+  /// @brief Add count occurrences of element.
+  void Insert(const T &element, uint64_t count = 1) {
+    sketch_.Insert(element, count);
+    uint64_t estimate = sketch_.Estimate(element);
+    if (estimate < threshold_.load(std::memory_order_relaxed)) return;
+    std::lock_guard<rt::Lock> _(lock_);
+    Offer(element, estimate);
+  }
+
+  /// @brief Estimated number of occurrences of element.
+  uint64_t Estimate(const T &element) const {
+    return sketch_.Estimate(element);
+  }
+
+  /// @brief The tracked heavy hitters, by decreasing estimated count.
+  std::vector<Entry> Entries() const {
+    std::vector<Entry> res;
+    {
+      std::lock_guard<rt::Lock> _(lock_);
+      res = entries_;
+    }
+    std::sort(res.begin(), res.end(), [](const Entry &a, const Entry &b) {
+      return a.count > b.count;
+    });
+    return res;
+  }
+
+  /// @brief Merge another sketch (with the same shape) into this one.
+  void Merge(const TopK &rhs) {
+    sketch_.Merge(rhs.sketch_);
+    MergeEntries(rhs.entries_.data(), rhs.entries_.size());
+  }
+
+  /// @brief Reset the sketch to the empty state.
+  void Clear() {
+    sketch_.Clear();
+    entries_.clear();
+    threshold_ = 0;
+  }
+
+  // Used by MergeSketches() and AllMergeSketches().
+  State GetState() const {
+    return State{sketch_.GetState(), entries_.data(), entries_.size()};
+  }
+
+  void MergeRemote(const rt::Locality &loc, const State &state) {
+    sketch_.MergeRemote(loc, state.sketch);
+    std::vector<Entry> remote(state.numEntries);
+    if (state.numEntries != 0)
+      rt::dma(reinterpret_cast<const uint8_t *>(remote.data()), loc,
+              reinterpret_cast<const uint8_t *>(state.entries),
+              state.numEntries * sizeof(Entry));
+    MergeEntries(remote.data(), remote.size());
+  }
+
+ private:
+  // Requires lock_.
+  void Offer(const T &element, uint64_t estimate) {
+    MemCmp<T> differs;
+    for (auto &entry : entries_) {
+      if (!differs(&entry.element, &element)) {
+        entry.count = std::max(entry.count, estimate);
+        UpdateThreshold();
+        return;
+      }
+    }
+    if (entries_.size() < k_) {
+      entries_.push_back(Entry{element, estimate});
+    } else {
+      auto min = std::min_element(
+          entries_.begin(), entries_.end(),
+          [](const Entry &a, const Entry &b) { return a.count < b.count; });
+      if (min->count >= estimate) return;
+      *min = Entry{element, estimate};
+    }
+    UpdateThreshold();
+  }
+
+  // Requires lock_.
+  void UpdateThreshold() {
+    if (entries_.size() < k_) return;
+    uint64_t min = UINT64_MAX;
+    for (auto &entry : entries_) min = std::min(min, entry.count);
+    threshold_.store(min, std::memory_order_relaxed);
+  }
+
+  // The candidates of both sides are re-estimated with the merged sketch.
+  void MergeEntries(const Entry *entries, size_t numEntries) {
+    std::lock_guard<rt::Lock> _(lock_);
+    std::vector<Entry> candidates(entries_);
+    candidates.insert(candidates.end(), entries, entries + numEntries);
+    entries_.clear();
+    threshold_ = 0;
+    for (auto &entry : candidates)
+      Offer(entry.element, sketch_.Estimate(entry.element));
+  }
+
+  size_t k_;
+  CountMinSketch<T> sketch_;
+  std::vector<Entry> entries_;
+  std::atomic<uint64_t> threshold_;
+  mutable rt::Lock lock_;
+};
+
+/// @brief Merge the instances of a sketch held by all the localities.
+///
+/// The local instances are left unchanged.  The calling locality fetches one
+/// sketch per locality, for a total communication of O(P * sketch) bytes.
+///
+/// @tparam SketchT The type of the sketch (HyperLogLog, CountMinSketch, or
+/// TopK).
+/// @param sketch The OnePerLocality instance holding the sketches.
+/// @return The merged sketch.
+/// @warning Updates performed concurrently with the merge might be missed.
+template <typename SketchT>
+SketchT MergeSketches(const std::shared_ptr<OnePerLocality<SketchT>> &sketch) {
+  using OPLT = OnePerLocality<SketchT>;
+  SketchT result(*(*sketch).operator->());
+  auto stateLambda = [](const typename OPLT::ObjectID &oid,
+                        typename SketchT::State *res) {
+    *res = (*OPLT::GetPtr(oid))->GetState();
+  };
+  for (auto &loc : rt::allLocalities()) {
+    if (loc == rt::thisLocality()) continue;
+    typename SketchT::State state;
+    rt::executeAtWithRet(loc, stateLambda, sketch->GetGlobalID(), &state);
+    result.MergeRemote(loc, state);
+  }
+  return result;
+}
+
+/// @brief Replace every instance of a sketch with the merge of all of them.
+///
+/// The sketches are merged on the calling locality, then every other
+/// locality copies the result: the communication is O(P * sketch) bytes.
+///
+/// @tparam SketchT The type of the sketch (HyperLogLog, CountMinSketch, or
+/// TopK).
+/// @param sketch The OnePerLocality instance holding the sketches.
+/// @warning Updates performed concurrently with the merge might be lost.
+template <typename SketchT>
+void AllMergeSketches(const std::shared_ptr<OnePerLocality<SketchT>> &sketch) {
+  using OPLT = OnePerLocality<SketchT>;
+  SketchT &local = *(*sketch).operator->();
+  local = MergeSketches(sketch);
+
+  struct Args {
+    typename OPLT::ObjectID oid;
+    rt::Locality source;
+    typename SketchT::State state;
+  };
+  auto copyLambda = [](const Args &args) {
+    if (args.source == rt::thisLocality()) return;
+    SketchT &local = *(*OPLT::GetPtr(args.oid)).operator->();
+    local.Clear();
+    local.MergeRemote(args.source, args.state);
+  };
+  Args args = {sketch->GetGlobalID(), rt::thisLocality(), local.GetState()};
+  rt::executeOnAll(copyLambda, args);
+}
+
+}  // namespace shad
+
+#endif  // INCLUDE_SHAD_DATA_STRUCTURES_SKETCHES_H_
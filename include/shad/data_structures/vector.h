@@ -33,6 +33,7 @@
 #include <memory>
 #include <stdexcept>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -46,8 +47,21 @@ namespace shad {
 ///
 /// ::shad::Vector is a distributed container that can grow dynamically.
 ///
+/// Each Locality stores one contiguous chunk of the elements: with P
+/// localities and a chunk size of C, the element in position i is stored by
+/// Locality i / C.  Vector iterators implement the
+/// distributed_iterator_traits protocol, so the algorithms in shad/core
+/// process the chunk of each Locality through raw pointers.
+///
+/// When the Capacity is exceeded, the chunks grow to at least twice their
+/// size and the elements are moved to their new owners.
+///
 /// @warning The contained type must be trivially copiable.
 ///
+/// @warning Growing the vector relocates its elements.  PushBack() and
+/// BufferedPushBack() are serialized with the growth, while element accesses
+/// concurrent with a growth are not safe.
+///
 /// @tparam T The type of the entries stored in a ::shad::Vector.
 /// @tparam Allocator The allocator to be used.
 template <typename T, typename Allocator = std::allocator<T>>
@@ -114,6 +128,10 @@ class Vector : public AbstractDataStructure<Vector<T, Allocator>> {
   /// increasing its Capacity to n.  In all the other cases, the function does
   /// not affect the Capacity of the shad::Vector.
   ///
+  /// Each Locality allocates its new chunk with a single message, and
+  /// value-initializes it with a parallel loop so that memory pages are first
+  /// touched by its own threads.
+  ///
   /// @warning Reserve is not thread safe, so don't try to reserve from multiple
   /// concurrent tasks.
   ///
@@ -127,8 +145,8 @@ class Vector : public AbstractDataStructure<Vector<T, Allocator>> {
   /// is greater than the current Size, the container is expanded by inserting
   /// at the end as many elements as needed to reach a size of n.
   ///
-  /// If n is greater than the current capacity, more data blocks will be
-  /// allocated to extend the capacity to at least n elements.
+  /// If n is greater than the current capacity, the chunks will be grown to
+  /// extend the capacity to at least n elements.
   ///
   /// @param[in] n The new container size, expressend in number of elements.
   void Resize(size_type n);
@@ -185,6 +203,27 @@ class Vector : public AbstractDataStructure<Vector<T, Allocator>> {
 
   /// @}
 
+  /// @name Iterators
+  /// @{
+
+  /// @brief An iterator to the first element of the shad::Vector.
+  iterator begin() noexcept { return iterator(0, oid_); }
+  /// @brief An iterator to the first element of the shad::Vector.
+  const_iterator begin() const noexcept { return cbegin(); }
+  /// @brief A const iterator to the first element of the shad::Vector.
+  const_iterator cbegin() const noexcept { return const_iterator(0, oid_); }
+
+  /// @brief An iterator past the last element of the shad::Vector.
+  iterator end() noexcept { return iterator(Size(), oid_); }
+  /// @brief An iterator past the last element of the shad::Vector.
+  const_iterator end() const noexcept { return cend(); }
+  /// @brief A const iterator past the last element of the shad::Vector.
+  const_iterator cend() const noexcept {
+    return const_iterator(Size(), oid_);
+  }
+
+  /// @}
+
   /// @name Modifiers
   /// @{
 
@@ -197,6 +236,44 @@ class Vector : public AbstractDataStructure<Vector<T, Allocator>> {
   /// @brief Adds an element at the end of the shad::Vector.
   void PushBack(const T &value);
 
+  /// @brief Adds an element at the end of the shad::Vector, using per-Locality
+  /// append buffers.
+  ///
+  /// Elements are staged on the calling Locality; every kBlockSize elements
+  /// the Locality reserves the corresponding slots at the end of the vector
+  /// with a single request to the Locality owning the size, and writes them
+  /// in bulk.  Concurrent appends from different localities therefore do
+  /// not serialize on a single Locality.  The relative order of elements
+  /// appended by different tasks is unspecified.
+  ///
+  /// Typical usage:
+  /// @code
+  /// auto vectorPtr = shad::Vector<size_t>::Create(0);
+  /// shad::rt::forEachOnAll(
+  ///     [](const ObjectID &oid, size_t i) {
+  ///       shad::Vector<size_t>::GetPtr(oid)->BufferedPushBack(i);
+  ///     },
+  ///     vectorPtr->GetGlobalID(), kNumElements);
+  /// vectorPtr->WaitForBufferedPushBack();
+  /// @endcode
+  ///
+  /// @warning Appended elements are part of the vector only after calling
+  /// the WaitForBufferedPushBack() method.
+  ///
+  /// @param[in] value The element to append.
+  void BufferedPushBack(const T &value);
+
+  /// @brief Finalize method for buffered appends.
+  ///
+  /// Publishes the elements staged on all the localities.
+  void WaitForBufferedPushBack();
+
+  /// @brief Publishes the elements staged on the calling Locality.
+  ///
+  /// @warning Unlike WaitForBufferedPushBack(), this method does not flush
+  /// the staging buffers of the other localities.
+  void FlushBufferedPushBack();
+
   /// @brief Write a value at the specified position.
   ///
   /// This method overwrite the element at the specified position.
@@ -495,129 +572,157 @@ class Vector : public AbstractDataStructure<Vector<T, Allocator>> {
 
   ObjectID GetGlobalID() const { return oid_; }
 
+  /// @brief Inserts value before position, shifting the following elements.
+  ///
+  /// The tail of the vector is moved in bulk, with one transfer for each
+  /// Locality storing a piece of it.
+  ///
+  /// @warning The shift reads and rewrites the whole tail of the vector, and
+  /// it is not safe with respect to concurrent modifications.
+  iterator insert(const_iterator position, const value_type &value);
+
+  void buffered_async_insert(rt::Handle &, const value_type &value) {
+    BufferedPushBack(value);
+  }
+
+  void buffered_async_wait(rt::Handle &handle) {
+    rt::waitForCompletion(handle);
+  }
+
+  void buffered_async_flush() { FlushBufferedPushBack(); }
+
   /// @brief Destructor.
   ~Vector() { _clear(); }
 
   void BufferEntryInsert(const std::tuple<size_type, value_type> entry) {
-    auto blockOffsetPair = _blockOffsetFromPosition(std::get<0>(entry));
-    size_type localBlock = _globlalBlockToLocalBlock(blockOffsetPair.first);
-    dataBlocks_.at(localBlock)[blockOffsetPair.second] = std::get<1>(entry);
+    data_[_targetFromPosition(std::get<0>(entry)).second] = std::get<1>(entry);
   }
 
  protected:
   Vector(ObjectID oid, size_type n)
       : oid_(oid),
-        dataBlocks_(),
         mainLocality_(static_cast<uint64_t>(oid) % rt::numLocalities()),
+        data_(nullptr),
+        newData_(nullptr),
+        chunkSize_(std::max(_chunkSize(n), size_type(1))),
         sizeCapacityLock_(),
         size_(n),
-        capacity_(0),
+        capacity_(chunkSize_ * rt::numLocalities()),
         allocator_(),
         buffers_(oid) {
-    size_t blocksToAllocate = std::max(_sizeToLocalBlocks(n, kBlockSize), 1UL);
-    capacity_ =
-        std::max(kBlockSize * _blockOffsetFromPosition(n).first, kBlockSize);
-
-    if (n == 0 && static_cast<uint32_t>(rt::thisLocality()) != 0) return;
-
-    for (size_t i = 0; i < blocksToAllocate; ++i)
-      dataBlocks_.emplace_back(std::allocator_traits<allocator_type>::allocate(
-          allocator_, kBlockSize));
+    data_ = _allocateChunk(chunkSize_);
   }
 
  private:
   friend class AbstractDataStructure<Vector<T, Allocator>>;
   static const size_type kBlockSize;
 
-  std::tuple<rt::Locality, size_t, size_t> _targetFromPosition(
-      size_type position, size_type blockSize) const {
-    size_t blockNumber = position / blockSize;
-    size_t destination = blockNumber % rt::numLocalities();
-    size_t offset = position % blockSize;
-    return std::make_tuple(rt::Locality(destination), blockNumber, offset);
+  // The Locality storing the element in position, and the offset of the
+  // element in the chunk of that Locality.
+  std::pair<rt::Locality, size_type> _targetFromPosition(
+      size_type position) const {
+    return std::make_pair(rt::Locality(position / chunkSize_),
+                          position % chunkSize_);
   }
 
-  size_t _sizeToLocalBlocks(size_type n, size_type blockSize) const {
-    size_t fullyUsedBlocks(0);
-    rt::Locality pivot(0);
-
-    if (n == 0) return 0;
-
-    std::tie(pivot, fullyUsedBlocks, std::ignore) =
-        _targetFromPosition(n - 1, blockSize);
-
-    size_t localBlocks = fullyUsedBlocks / rt::numLocalities();
-    if (rt::thisLocality() <= pivot) localBlocks += 1;
-
-    return localBlocks;
+  // Number of elements stored by each Locality for a capacity of n elements.
+  static size_type _chunkSize(size_type n) {
+    return (n + rt::numLocalities() - 1) / rt::numLocalities();
   }
 
-  std::pair<size_type, size_type> _blockOffsetFromPosition(size_type n) const {
-    size_type blockNumber = n / kBlockSize;
-    size_type offset = n % kBlockSize;
-    return std::make_pair(blockNumber, offset);
+  // Allocate a chunk of n elements, initializing it in parallel so that its
+  // pages are first touched by the threads of this Locality.
+  value_type *_allocateChunk(size_type n) {
+    value_type *chunk =
+        std::allocator_traits<allocator_type>::allocate(allocator_, n);
+    rt::forEachAt(rt::thisLocality(),
+                  [](const std::pair<value_type *, size_type> &args,
+                     size_t i) {
+                    size_type first = i * kBlockSize;
+                    std::uninitialized_fill_n(
+                        args.first + first,
+                        std::min(kBlockSize, args.second - first),
+                        value_type());
+                  },
+                  std::make_pair(chunk, n), (n + kBlockSize - 1) / kBlockSize);
+    return chunk;
   }
 
-  size_type _globlalBlockToLocalBlock(size_type n) const {
-    size_type i = 0;
-    while (static_cast<uint32_t>(rt::thisLocality()) < n) {
-      n -= rt::numLocalities();
-      ++i;
+  void _deallocateChunk(value_type *chunk, size_type n) {
+    if (chunk == nullptr) return;
+    if (!std::is_trivially_destructible<value_type>::value) {
+      for (T *toDestroy = chunk; toDestroy < chunk + n; ++toDestroy)
+        std::allocator_traits<allocator_type>::destroy(allocator_, toDestroy);
     }
-    return i;
+    std::allocator_traits<allocator_type>::deallocate(allocator_, chunk, n);
   }
 
+  // Grow the capacity to at least n elements, at least doubling it.  Every
+  // Locality allocates its new chunk, and then sends its elements to their
+  // new owners, which pull them with rt::dma.
   void _reserve(size_type n) {
-    size_type currentCapacity = Capacity();
-    if (currentCapacity >= n) return;
-
-    rt::Locality insertLocality(0);
-    size_t lastBlock(0);
-    std::tie(insertLocality, lastBlock, std::ignore) =
-        _targetFromPosition(currentCapacity, kBlockSize);
-    size_t newLastBlock = n / kBlockSize;
-
-    size_type blocksToAllocate = 1;
-    blocksToAllocate += newLastBlock - lastBlock;
-
-    std::vector<size_type> newBlocks(rt::numLocalities(), 0);
-    for (size_t i = static_cast<uint32_t>(insertLocality), j = blocksToAllocate;
-         j > 0; ++i, --j) {
-      newBlocks[i % rt::numLocalities()]++;
-    }
+    if (n <= capacity_) return;
+
+    using ReserveArgs = std::tuple<ObjectID, size_type, size_type, size_type>;
+    ReserveArgs args(oid_, chunkSize_,
+                     std::max(_chunkSize(n), 2 * chunkSize_),
+                     std::min(size_, capacity_));
+    rt::executeOnAll(
+        [](const ReserveArgs &args) {
+          auto This = Vector<T, Allocator>::GetPtr(std::get<0>(args));
+          This->newData_ = This->_allocateChunk(std::get<2>(args));
+        },
+        args);
+    rt::executeOnAll(
+        [](const ReserveArgs &args) {
+          auto This = Vector<T, Allocator>::GetPtr(std::get<0>(args));
+          This->_moveChunk(std::get<1>(args), std::get<2>(args),
+                           std::get<3>(args));
+        },
+        args);
 
-    rt::Handle handle;
-    for (size_t i = 0; i < rt::numLocalities(); ++i) {
-      if (newBlocks[i] == 0) continue;
+    capacity_ = std::get<2>(args) * rt::numLocalities();
+  }
+
+  // Move the first size elements of the vector stored on this Locality to
+  // the chunks of newChunkSize elements, and replace the local chunk.
+  void _moveChunk(size_type oldChunkSize, size_type newChunkSize,
+                  size_type size) {
+    using MoveArgs =
+        std::tuple<ObjectID, size_type, size_type, value_type *, rt::Locality>;
+    size_type first = static_cast<uint32_t>(rt::thisLocality()) * oldChunkSize;
+    size_type last = std::min(first + oldChunkSize, size);
 
+    rt::Handle handle;
+    for (size_type position = first; position < last;) {
+      rt::Locality target(position / newChunkSize);
+      size_type offset = position % newChunkSize;
+      size_type numElements = std::min(last - position, newChunkSize - offset);
       rt::asyncExecuteAt(
-          handle, rt::Locality(i),
-          [](rt::Handle &, const std::pair<ObjectID, size_type> &args) {
-            auto This = Vector<T, Allocator>::GetPtr(args.first);
-
-            for (size_t i = 0; i < args.second; ++i) {
-              This->dataBlocks_.emplace_back(
-                  std::allocator_traits<allocator_type>::allocate(
-                      This->allocator_, kBlockSize));
-            }
+          handle, target,
+          [](rt::Handle &, const MoveArgs &args) {
+            auto This = Vector<T, Allocator>::GetPtr(std::get<0>(args));
+            rt::dma(This->newData_ + std::get<1>(args), std::get<4>(args),
+                    std::get<3>(args), std::get<2>(args));
           },
-          std::make_pair(oid_, newBlocks[i]));
+          MoveArgs(oid_, offset, numElements, data_ + (position - first),
+                   rt::thisLocality()));
+      position += numElements;
     }
-
     rt::waitForCompletion(handle);
 
-    capacity_ += kBlockSize * blocksToAllocate;
+    // Other localities may still be filling newData_, which stays valid
+    // until the next growth.
+    _deallocateChunk(data_, oldChunkSize);
+    data_ = newData_;
+    chunkSize_ = newChunkSize;
   }
 
   void _clear() {
-    for (auto block : dataBlocks_) {
-      for (T *toDestroy = block; toDestroy < block + kBlockSize; ++toDestroy) {
-        std::allocator_traits<allocator_type>::destroy(allocator_, toDestroy);
-      }
-      std::allocator_traits<allocator_type>::deallocate(allocator_, block,
-                                                        kBlockSize);
-    }
-    dataBlocks_.clear();
+    _deallocateChunk(data_, chunkSize_);
+    data_ = nullptr;
+    newData_ = nullptr;
+    chunkSize_ = 0;
   }
 
   template <typename ApplyFunT, typename... Args, std::size_t... is>
@@ -625,11 +730,8 @@ class Vector : public AbstractDataStructure<Vector<T, Allocator>> {
                            ApplyFunT function, std::tuple<Args...> &args,
                            std::index_sequence<is...>) {
     auto This = Vector<T, Allocator>::GetPtr(oid);
-    auto blockOffsetPair = This->_blockOffsetFromPosition(position);
-    size_type localBlock =
-        This->_globlalBlockToLocalBlock(blockOffsetPair.first);
     value_type &element =
-        This->dataBlocks_.at(localBlock)[blockOffsetPair.second];
+        This->data_[This->_targetFromPosition(position).second];
     function(position, element, std::get<is>(args)...);
   }
 
@@ -648,10 +750,8 @@ class Vector : public AbstractDataStructure<Vector<T, Allocator>> {
                                 std::tuple<Args...> &args,
                                 std::index_sequence<is...>) {
     auto This = Vector<T, Allocator>::GetPtr(oid);
-    auto blockOffsetPair = This->_blockOffsetFromPosition(position);
-    size_type localBlock =
-        This->_globlalBlockToLocalBlock(blockOffsetPair.first);
-    value_type &element = This->dataBlocks_[localBlock][blockOffsetPair.second];
+    value_type &element =
+        This->data_[This->_targetFromPosition(position).second];
     function(handle, position, element, std::get<is>(args)...);
   }
 
@@ -672,11 +772,8 @@ class Vector : public AbstractDataStructure<Vector<T, Allocator>> {
                                     std::index_sequence<is...>) {
     // Get a local instance on the remote node.
     auto This = Vector<T, Allocator>::GetPtr(oid);
-    auto blockOffsetPair = This->_blockOffsetFromPosition(position + i);
-    size_type localBlock =
-        This->_globlalBlockToLocalBlock(blockOffsetPair.first);
     value_type &element =
-        This->dataBlocks_.at(localBlock)[blockOffsetPair.second];
+        This->data_[This->_targetFromPosition(position + i).second];
     function(position + i, element, std::get<is>(args)...);
   }
 
@@ -699,11 +796,8 @@ class Vector : public AbstractDataStructure<Vector<T, Allocator>> {
                                          std::index_sequence<is...>) {
     // Get a local instance on the remote node.
     auto This = Vector<T, Allocator>::GetPtr(oid);
-    auto blockOffsetPair = This->_blockOffsetFromPosition(position + i);
-    size_type localBlock =
-        This->_globlalBlockToLocalBlock(blockOffsetPair.first);
     value_type &element =
-        This->dataBlocks_.at(localBlock)[blockOffsetPair.second];
+        This->data_[This->_targetFromPosition(position + i).second];
     function(handle, position + i, element, std::get<is>(args)...);
   }
 
@@ -724,12 +818,33 @@ class Vector : public AbstractDataStructure<Vector<T, Allocator>> {
 
   ObjectID oid_;
   rt::Locality mainLocality_;
-  std::vector<value_type *> dataBlocks_;
+  value_type *data_;     // the chunk stored on this Locality
+  value_type *newData_;  // the chunk being filled while the vector grows
+  size_type chunkSize_;
   rt::Lock sizeCapacityLock_;
   size_type size_;
   size_type capacity_;
   allocator_type allocator_;
   BuffersVector buffers_;
+  rt::Lock appendLock_;
+  std::vector<value_type> appendBuffer_;
+
+  // Reserve values.size() slots at the end of the vector and write values.
+  void _publishAppend(const std::vector<value_type> &values);
+
+  template <typename IteratorType>
+  void _asyncWriteRange(rt::Handle &handle, size_type startingPoint,
+                        IteratorType begin, size_type newElements);
+
+  // Copy the n elements from position to buffer, stored on bufferLocality
+  // (or from buffer to position when store is true), with one message and
+  // one dma for each Locality storing a piece of the range.
+  void _asyncTransferRange(rt::Handle &handle, size_type position,
+                           size_type n, value_type *buffer,
+                           rt::Locality bufferLocality, bool store);
+
+  // Value-initialize the n elements starting at position.
+  void _fillRange(size_type position, size_type n);
 };
 
 template <typename T, typename Allocator>
@@ -739,13 +854,29 @@ const typename Vector<T, Allocator>::size_type
 
 template <typename T, typename Allocator>
 template <typename ValueType>
-class Vector<T, Allocator>::Iterator
-    : std::iterator<std::random_access_iterator_tag, ValueType> {
+class Vector<T, Allocator>::Iterator {
  public:
+  using difference_type = std::ptrdiff_t;
+  using value_type = typename Vector<T, Allocator>::value_type;
+  using pointer = const value_type *;
+  using reference = const value_type;
+  using iterator_category = std::random_access_iterator_tag;
+  using local_iterator_type = ValueType *;
+  using distribution_range = std::vector<std::pair<rt::Locality, size_t>>;
+
+  Iterator() : Iterator(0, Vector<T, Allocator>::ObjectID::kNullID) {}
+
   Iterator(Vector<T, Allocator>::size_type n,
            Vector<T, Allocator>::ObjectID oid)
       : position_(n), oid_(oid) {}
 
+  /// @brief Conversion from iterator to const_iterator.
+  template <typename OtherValueType,
+            typename = typename std::enable_if<std::is_same<
+                const OtherValueType, ValueType>::value>::type>
+  Iterator(const Iterator<OtherValueType> &O)  // NOLINT
+      : position_(O.position_), oid_(O.oid_) {}
+
   Iterator(const Iterator &itr) = default;
 
   Iterator &operator=(const Iterator &itr) = default;
@@ -768,6 +899,16 @@ class Vector<T, Allocator>::Iterator
 
   bool operator!=(const Iterator &rhs) const { return !(*this == rhs); }
 
+  bool operator<(const Iterator &rhs) const {
+    return oid_ == rhs.oid_ && position_ < rhs.position_;
+  }
+
+  bool operator>(const Iterator &rhs) const { return rhs < *this; }
+
+  bool operator<=(const Iterator &rhs) const { return !(rhs < *this); }
+
+  bool operator>=(const Iterator &rhs) const { return !(*this < rhs); }
+
   Iterator &operator+=(const ptrdiff_t &movement) {
     position_ += movement;
     return *this;
@@ -796,23 +937,24 @@ class Vector<T, Allocator>::Iterator
   Iterator operator--(int) {
     auto tmp(*this);
     --position_;
-    tmp;
+    return tmp;
   }
 
-  Iterator operator+(const ptrdiff_t &movement) {
+  Iterator operator+(const ptrdiff_t &movement) const {
     Iterator tmp(*this);
     tmp.position_ += movement;
     return tmp;
   }
 
-  Iterator operator-(const ptrdiff_t &movement) {
+  Iterator operator-(const ptrdiff_t &movement) const {
     Iterator tmp(*this);
     tmp.position_ -= movement;
     return tmp;
   }
 
-  ptrdiff_t operator-(const Iterator &rhs) {
-    return std::distance(rhs.position_, this->position_);
+  ptrdiff_t operator-(const Iterator &rhs) const {
+    return static_cast<ptrdiff_t>(position_) -
+           static_cast<ptrdiff_t>(rhs.position_);
   }
 
   const value_type operator*() const {
@@ -825,7 +967,75 @@ class Vector<T, Allocator>::Iterator
     return &*(*this);
   }
 
+  class local_iterator_range {
+   public:
+    local_iterator_range(local_iterator_type B, local_iterator_type E)
+        : begin_(B), end_(E) {}
+    local_iterator_type begin() { return begin_; }
+    local_iterator_type end() { return end_; }
+
+   private:
+    local_iterator_type begin_;
+    local_iterator_type end_;
+  };
+
+  /// @brief The localities storing at least one element of [B, E).
+  static rt::localities_range localities(const Iterator &B,
+                                         const Iterator &E) {
+    if (B.position_ >= E.position_)
+      return rt::localities_range(rt::Locality(0), rt::Locality(0));
+
+    auto This = Vector<T, Allocator>::GetPtr(B.oid_);
+    return rt::localities_range(
+        This->_targetFromPosition(B.position_).first,
+        rt::Locality(static_cast<uint32_t>(
+                         This->_targetFromPosition(E.position_ - 1).first) +
+                     1));
+  }
+
+  /// @brief The elements of [B, E) stored on the calling Locality.
+  static local_iterator_range local_range(const Iterator &B,
+                                          const Iterator &E) {
+    auto This = Vector<T, Allocator>::GetPtr(B.oid_);
+    size_type first =
+        static_cast<uint32_t>(rt::thisLocality()) * This->chunkSize_;
+    size_type last = first + This->chunkSize_;
+    size_type begin = std::min(std::max(B.position_, first), last);
+    size_type end = std::max(begin, std::min(E.position_, last));
+    return local_iterator_range(This->data_ + (begin - first),
+                                This->data_ + (end - first));
+  }
+
+  static Iterator iterator_from_local(const Iterator &B, const Iterator &E,
+                                      local_iterator_type itr) {
+    if (itr == local_range(B, E).end()) return E;
+
+    auto This = Vector<T, Allocator>::GetPtr(B.oid_);
+    size_type first =
+        static_cast<uint32_t>(rt::thisLocality()) * This->chunkSize_;
+    return Iterator(first + (itr - This->data_), B.oid_);
+  }
+
+  /// @brief The sequence of (Locality, number of elements) pairs composing
+  /// [B, E), in the global order.
+  static distribution_range distribution(const Iterator &B,
+                                         const Iterator &E) {
+    auto This = Vector<T, Allocator>::GetPtr(B.oid_);
+    distribution_range result;
+    for (size_type position = B.position_; position < E.position_;) {
+      auto target = This->_targetFromPosition(position);
+      size_type numElements =
+          std::min(E.position_ - position, This->chunkSize_ - target.second);
+      result.emplace_back(target.first, numElements);
+      position += numElements;
+    }
+    return result;
+  }
+
  private:
+  template <typename>
+  friend class Vector<T, Allocator>::Iterator;
+
   Vector<T, Allocator>::size_type position_;
   Vector<T, Allocator>::ObjectID oid_;
 };
@@ -892,10 +1102,10 @@ void Vector<T, Allocator>::Resize(Vector<T, Allocator>::size_type n) {
                   auto n = args.second;
 
                   std::lock_guard<rt::Lock> _(This->sizeCapacityLock_);
-                  if (n <= This->size_) return;
-
+                  size_type oldSize = This->size_;
                   This->_reserve(n);
                   This->size_ = n;
+                  if (n > oldSize) This->_fillRange(oldSize, n - oldSize);
                 },
                 std::make_pair(oid_, n));
 }
@@ -904,25 +1114,20 @@ template <typename T, typename Allocator>
 typename Vector<T, Allocator>::value_type Vector<T, Allocator>::At(
     Vector<T, Allocator>::size_type n) const {
   rt::Locality target(0);
-  size_t blockNumber(0);
-  size_t offset(0);
-  std::tie(target, blockNumber, offset) = _targetFromPosition(n, kBlockSize);
+  size_type offset(0);
+  std::tie(target, offset) = _targetFromPosition(n);
 
   if (target == rt::thisLocality()) {
-    size_type localBlock = _globlalBlockToLocalBlock(blockNumber);
-    return dataBlocks_[localBlock][offset];
+    return data_[offset];
   } else {
     T value;
     rt::executeAtWithRet(
         target,
-        [](const std::tuple<ObjectID, size_type, size_type> &args, T *result) {
-          auto This = Vector<T, Allocator>::GetPtr(std::get<0>(args));
-          size_type localBlock =
-              This->_globlalBlockToLocalBlock(std::get<1>(args));
-
-          *result = This->dataBlocks_[localBlock][std::get<2>(args)];
+        [](const std::pair<ObjectID, size_type> &args, T *result) {
+          auto This = Vector<T, Allocator>::GetPtr(args.first);
+          *result = This->data_[args.second];
         },
-        std::make_tuple(oid_, blockNumber, offset), &value);
+        std::make_pair(oid_, offset), &value);
     return value;
   }
 }
@@ -949,21 +1154,17 @@ void Vector<T, Allocator>::AsyncAt(
     rt::Handle &handle, Vector<T, Allocator>::size_type n,
     Vector<T, Allocator>::value_type *result) const {
   rt::Locality target(0);
-  size_type blockNumber(0);
   size_type offset(0);
-  std::tie(target, blockNumber, offset) = _targetFromPosition(n, kBlockSize);
+  std::tie(target, offset) = _targetFromPosition(n);
 
   rt::asyncExecuteAtWithRet(
       handle, target,
-      [](rt::Handle &handle,
-         const std::tuple<ObjectID, size_type, size_type> &args, T *result) {
-        auto This = Vector<T, Allocator>::GetPtr(std::get<0>(args));
-        size_type localBlock =
-            This->_globlalBlockToLocalBlock(std::get<1>(args));
-
-        *result = This->dataBlocks_[localBlock][std::get<2>(args)];
+      [](rt::Handle &handle, const std::pair<ObjectID, size_type> &args,
+         T *result) {
+        auto This = Vector<T, Allocator>::GetPtr(args.first);
+        *result = This->data_[args.second];
       },
-      std::make_tuple(oid_, blockNumber, offset), result);
+      std::make_pair(oid_, offset), result);
 }
 
 template <typename T, typename Allocator>
@@ -989,43 +1190,155 @@ void Vector<T, Allocator>::Clear() noexcept {
 template <typename T, typename Allocator>
 void Vector<T, Allocator>::PushBack(
     const typename Vector<T, Allocator>::value_type &value) {
-  size_type newSize(0);
+  // The element is written while holding the lock, so that it cannot land
+  // in a chunk that a concurrent growth is relocating.
+  rt::executeAt(mainLocality_,
+                [](const std::pair<ObjectID, value_type> &args) {
+                  auto This = Vector<T, Allocator>::GetPtr(args.first);
+                  std::lock_guard<rt::Lock> _(This->sizeCapacityLock_);
 
-  rt::executeAtWithRet(mainLocality_,
-                       [](const ObjectID &args, size_type *size) {
-                         auto This = Vector<T, Allocator>::GetPtr(args);
-                         std::lock_guard<rt::Lock> _(This->sizeCapacityLock_);
+                  size_type position = This->size_++;
+                  This->_reserve(This->size_);
+                  This->InsertAt(position, args.second);
+                },
+                std::make_pair(oid_, value));
+}
 
-                         *size = ++This->size_;
-                         if (This->size_ > This->capacity_)
-                           This->_reserve(This->size_);
-                       },
-                       oid_, &newSize);
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::BufferedPushBack(
+    const typename Vector<T, Allocator>::value_type &value) {
+  std::vector<value_type> values;
+  {
+    std::lock_guard<rt::Lock> _(appendLock_);
+    appendBuffer_.push_back(value);
+    if (appendBuffer_.size() < kBlockSize) return;
+    values.swap(appendBuffer_);
+  }
+  _publishAppend(values);
+}
+
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::WaitForBufferedPushBack() {
+  rt::executeOnAll(
+      [](const ObjectID &oid) {
+        Vector<T, Allocator>::GetPtr(oid)->FlushBufferedPushBack();
+      },
+      oid_);
+}
+
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::FlushBufferedPushBack() {
+  std::vector<value_type> values;
+  {
+    std::lock_guard<rt::Lock> _(appendLock_);
+    values.swap(appendBuffer_);
+  }
+  _publishAppend(values);
+}
+
+template <typename T, typename Allocator>
+typename Vector<T, Allocator>::iterator Vector<T, Allocator>::insert(
+    const_iterator position, const value_type &value) {
+  size_type pos = position - cbegin();
+  size_type oldSize = Size();
+
+  std::vector<value_type> tail(oldSize - pos);
+  rt::Handle handle;
+  _asyncTransferRange(handle, pos, tail.size(), tail.data(),
+                      rt::thisLocality(), false);
+  rt::waitForCompletion(handle);
 
-  size_type position = newSize - 1;
+  Resize(oldSize + 1);
+  _asyncTransferRange(handle, pos + 1, tail.size(), tail.data(),
+                      rt::thisLocality(), true);
+  rt::waitForCompletion(handle);
+  return InsertAt(pos, value);
+}
 
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::_asyncTransferRange(
+    rt::Handle &handle, size_type position, size_type n, value_type *buffer,
+    rt::Locality bufferLocality, bool store) {
+  using TransferArgs = std::tuple<ObjectID, size_type, size_type, value_type *,
+                                  rt::Locality, bool>;
   rt::Locality target(0);
-  size_t blockNumber(0);
-  size_t offset(0);
-  std::tie(target, blockNumber, offset) =
-      _targetFromPosition(position, kBlockSize);
+  size_type offset(0);
+  while (n > 0) {
+    std::tie(target, offset) = _targetFromPosition(position);
+    size_type numElements = std::min(n, chunkSize_ - offset);
 
-  if (target == rt::thisLocality()) {
-    size_type localBlock = _globlalBlockToLocalBlock(blockNumber);
-    dataBlocks_[localBlock][offset] = value;
-  } else {
-    using MessageTuple = std::tuple<ObjectID, size_type, size_type, value_type>;
-    rt::executeAt(target,
-                  [](const MessageTuple &args) {
-                    auto This = Vector<T, Allocator>::GetPtr(std::get<0>(args));
-                    size_type localBlock =
-                        This->_globlalBlockToLocalBlock(std::get<1>(args));
+    rt::asyncExecuteAt(
+        handle, target,
+        [](rt::Handle &, const TransferArgs &args) {
+          auto This = Vector<T, Allocator>::GetPtr(std::get<0>(args));
+          value_type *local = This->data_ + std::get<1>(args);
+          if (std::get<5>(args))
+            rt::dma(local, std::get<4>(args), std::get<3>(args),
+                    std::get<2>(args));
+          else
+            rt::dma(std::get<4>(args), std::get<3>(args), local,
+                    std::get<2>(args));
+        },
+        TransferArgs(oid_, offset, numElements, buffer, bufferLocality,
+                     store));
 
-                    This->dataBlocks_[localBlock][std::get<2>(args)] =
-                        std::get<3>(args);
-                  },
-                  std::make_tuple(oid_, blockNumber, offset, value));
+    position += numElements;
+    buffer += numElements;
+    n -= numElements;
+  }
+}
+
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::_fillRange(size_type position, size_type n) {
+  using FillArgs = std::tuple<ObjectID, size_type, size_type>;
+  rt::Handle handle;
+  rt::Locality target(0);
+  size_type offset(0);
+  while (n > 0) {
+    std::tie(target, offset) = _targetFromPosition(position);
+    size_type numElements = std::min(n, chunkSize_ - offset);
+
+    rt::asyncExecuteAt(
+        handle, target,
+        [](rt::Handle &, const FillArgs &args) {
+          auto This = Vector<T, Allocator>::GetPtr(std::get<0>(args));
+          std::fill_n(This->data_ + std::get<1>(args), std::get<2>(args),
+                      value_type());
+        },
+        FillArgs(oid_, offset, numElements));
+
+    position += numElements;
+    n -= numElements;
   }
+  rt::waitForCompletion(handle);
+}
+
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::_publishAppend(
+    const std::vector<value_type> &values) {
+  if (values.empty()) return;
+
+  // The slots are reserved and filled while holding the lock, so that the
+  // elements cannot land in a chunk that a concurrent growth is relocating.
+  using AppendArgs =
+      std::tuple<ObjectID, size_type, const value_type *, rt::Locality>;
+  rt::executeAt(
+      mainLocality_,
+      [](const AppendArgs &args) {
+        auto This = Vector<T, Allocator>::GetPtr(std::get<0>(args));
+        std::lock_guard<rt::Lock> _(This->sizeCapacityLock_);
+
+        size_type startingPoint = This->size_;
+        This->size_ += std::get<1>(args);
+        This->_reserve(This->size_);
+
+        rt::Handle handle;
+        This->_asyncTransferRange(handle, startingPoint, std::get<1>(args),
+                                  const_cast<value_type *>(std::get<2>(args)),
+                                  std::get<3>(args), true);
+        rt::waitForCompletion(handle);
+      },
+      AppendArgs(oid_, values.size(), values.data(), rt::thisLocality()));
 }
 
 template <typename T, typename Allocator>
@@ -1033,26 +1346,19 @@ typename Vector<T, Allocator>::iterator Vector<T, Allocator>::InsertAt(
     Vector<T, Allocator>::size_type position,
     const Vector<T, Allocator>::value_type &value) {
   rt::Locality target(0);
-  size_t blockNumber(0);
-  size_t offset(0);
-  std::tie(target, blockNumber, offset) =
-      _targetFromPosition(position, kBlockSize);
+  size_type offset(0);
+  std::tie(target, offset) = _targetFromPosition(position);
 
   if (target == rt::thisLocality()) {
-    size_type localBlock = _globlalBlockToLocalBlock(blockNumber);
-    dataBlocks_[localBlock][offset] = value;
+    data_[offset] = value;
   } else {
-    using MessageTuple = std::tuple<ObjectID, size_type, size_type, value_type>;
+    using MessageTuple = std::tuple<ObjectID, size_type, value_type>;
     rt::executeAt(target,
                   [](const MessageTuple &args) {
                     auto This = Vector<T, Allocator>::GetPtr(std::get<0>(args));
-                    size_type localBlock =
-                        This->_globlalBlockToLocalBlock(std::get<1>(args));
-
-                    This->dataBlocks_[localBlock][std::get<2>(args)] =
-                        std::get<3>(args);
+                    This->data_[std::get<1>(args)] = std::get<2>(args);
                   },
-                  std::make_tuple(oid_, blockNumber, offset, value));
+                  std::make_tuple(oid_, offset, value));
   }
 
   return Vector<T, Allocator>::iterator(position, GetGlobalID());
@@ -1076,29 +1382,21 @@ template <typename T, typename Allocator>
 void Vector<T, Allocator>::AsyncInsertAt(
     rt::Handle &handle, Vector<T, Allocator>::size_type position,
     const Vector<T, Allocator>::value_type &value) {
-  size_type currentSize(0);
-
   rt::Locality target(0);
-  size_t blockNumber(0);
-  size_t offset(0);
-  std::tie(target, blockNumber, offset) =
-      _targetFromPosition(position, kBlockSize);
+  size_type offset(0);
+  std::tie(target, offset) = _targetFromPosition(position);
 
   if (target == rt::thisLocality()) {
-    size_type localBlock = _globlalBlockToLocalBlock(blockNumber);
-    dataBlocks_[localBlock][offset] = value;
+    data_[offset] = value;
   } else {
-    using MessageTuple = std::tuple<ObjectID, size_type, size_type, value_type>;
+    using MessageTuple = std::tuple<ObjectID, size_type, value_type>;
     rt::asyncExecuteAt(
         handle, target,
         [](rt::Handle &, const MessageTuple &args) {
           auto This = Vector<T, Allocator>::GetPtr(std::get<0>(args));
-          size_type localBlock =
-              This->_globlalBlockToLocalBlock(std::get<1>(args));
-
-          This->dataBlocks_[localBlock][std::get<2>(args)] = std::get<3>(args);
+          This->data_[std::get<1>(args)] = std::get<2>(args);
         },
-        std::make_tuple(oid_, blockNumber, offset, value));
+        std::make_tuple(oid_, offset, value));
   }
 }
 
@@ -1139,7 +1437,16 @@ void Vector<T, Allocator>::AsyncInsertAt(
     throw std::out_of_range("AsyncInsertAt: position out of range");
   }
 
-  size_type startingPoint = newSize - newElements;
+  _asyncWriteRange(handle, position, begin, newElements);
+}
+
+template <typename T, typename Allocator>
+template <typename IteratorType>
+void Vector<T, Allocator>::_asyncWriteRange(rt::Handle &handle,
+                                            size_type startingPoint,
+                                            IteratorType begin,
+                                            size_type newElements) {
+  if (newElements == 0) return;
 
   constexpr size_t kNumElements = 4000 / sizeof(value_type);
   static_assert(kNumElements >= 1,
@@ -1157,44 +1464,22 @@ void Vector<T, Allocator>::AsyncInsertAt(
 
   auto insertFunction = [](rt::Handle &, const InsertMessage &args) {
     auto This = Vector<T, Allocator>::GetPtr(args.objID);
-    auto blockOffsetPair = This->_blockOffsetFromPosition(args.startPosition);
-    size_type localBlock =
-        This->_globlalBlockToLocalBlock(blockOffsetPair.first);
+    size_type offset = This->_targetFromPosition(args.startPosition).second;
     std::copy(&args.elements[0], &args.elements[args.numElements],
-              &This->dataBlocks_.at(localBlock)[blockOffsetPair.second]);
+              This->data_ + offset);
   };
 
   InsertMessage args;
-  size_t spaceLeftInBlock = kBlockSize - (startingPoint % kBlockSize);
-  // first block
   args.objID = oid_;
-  args.startPosition = startingPoint;
-  args.numElements =
-      std::min(newElements, std::min(kNumElements, spaceLeftInBlock));
-
-  std::copy(begin, begin + args.numElements, args.elements);
-
   rt::Locality target(0);
-  size_t blockNumber(0);
-  size_t offset(0);
-  std::tie(target, blockNumber, offset) =
-      _targetFromPosition(position, kBlockSize);
-
-  rt::asyncExecuteAt(handle, target, insertFunction, args);
-
-  begin += args.numElements;
-  newElements -= args.numElements;
-  startingPoint += args.numElements;
-
-  // inner blocks
-  while (begin != end && newElements > 0) {
-    std::tie(target, blockNumber, offset) =
-        _targetFromPosition(startingPoint, kBlockSize);
+  size_type offset(0);
+  while (newElements > 0) {
+    std::tie(target, offset) = _targetFromPosition(startingPoint);
     args.startPosition = startingPoint;
 
-    spaceLeftInBlock = kBlockSize - (startingPoint % kBlockSize);
+    size_t spaceLeftInChunk = chunkSize_ - offset;
     args.numElements =
-        std::min(newElements, std::min(kNumElements, spaceLeftInBlock));
+        std::min(newElements, std::min(kNumElements, spaceLeftInChunk));
 
     std::copy(begin, begin + args.numElements, args.elements);
     rt::asyncExecuteAt(handle, target, insertFunction, args);
@@ -1209,14 +1494,11 @@ template <typename T, typename Allocator>
 void Vector<T, Allocator>::BufferedInsertAt(const size_type position,
                                             const value_type &value) {
   rt::Locality target(0);
-  size_t blockNumber(0);
-  size_t offset(0);
-  std::tie(target, blockNumber, offset) =
-      _targetFromPosition(position, kBlockSize);
+  size_type offset(0);
+  std::tie(target, offset) = _targetFromPosition(position);
 
   if (target == rt::thisLocality()) {
-    size_type localBlock = _globlalBlockToLocalBlock(blockNumber);
-    dataBlocks_[localBlock][offset] = value;
+    data_[offset] = value;
   } else {
     buffers_.Insert(std::make_tuple(position, value), target);
   }
@@ -1227,14 +1509,11 @@ void Vector<T, Allocator>::BufferedAsyncInsertAt(rt::Handle &handle,
                                                  const size_type position,
                                                  const value_type &value) {
   rt::Locality target(0);
-  size_t blockNumber(0);
-  size_t offset(0);
-  std::tie(target, blockNumber, offset) =
-      _targetFromPosition(position, kBlockSize);
+  size_type offset(0);
+  std::tie(target, offset) = _targetFromPosition(position);
 
   if (target == rt::thisLocality()) {
-    size_type localBlock = _globlalBlockToLocalBlock(blockNumber);
-    dataBlocks_[localBlock][offset] = value;
+    data_[offset] = value;
   } else {
     buffers_.AsyncInsert(handle, std::make_tuple(position, value), target);
   }
@@ -1245,10 +1524,7 @@ template <typename ApplyFunT, typename... Args>
 void Vector<T, Allocator>::Apply(const Vector<T, Allocator>::size_type position,
                                  ApplyFunT &&function, Args &... args) {
   rt::Locality target(0);
-  size_t blockNumber(0);
-  size_t offset(0);
-  std::tie(target, blockNumber, offset) =
-      _targetFromPosition(position, kBlockSize);
+  std::tie(target, std::ignore) = _targetFromPosition(position);
 
   using FunctionTy = void (*)(size_type, T &, Args & ...);
   FunctionTy fn = std::forward<decltype(function)>(function);
@@ -1265,10 +1541,7 @@ void Vector<T, Allocator>::AsyncApply(
     rt::Handle &handle, const Vector<T, Allocator>::size_type position,
     ApplyFunT &&function, Args &... args) {
   rt::Locality target(0);
-  size_t blockNumber(0);
-  size_t offset(0);
-  std::tie(target, blockNumber, offset) =
-      _targetFromPosition(position, kBlockSize);
+  std::tie(target, std::ignore) = _targetFromPosition(position);
 
   using FunctionTy = void (*)(rt::Handle &, size_type, T &, Args & ...);
   FunctionTy fn = std::forward<decltype(function)>(function);
@@ -1292,37 +1565,20 @@ void Vector<T, Allocator>::ForEachInRange(const size_type begin,
   using ArgsTuple =
       std::tuple<ObjectID, size_t, FunctionTy, std::tuple<Args...>>;
 
-  size_type numElements = end - begin;
-  size_type start = begin;
-
-  // first block
-  size_type blockSize =
-      std::min(numElements, kBlockSize - (start % kBlockSize));
+  ArgsTuple argsTuple{oid_, begin, fn, std::tuple<Args...>(args...)};
 
+  // One loop for each Locality storing a piece of the range.
   rt::Locality target(0);
-  std::tie(target, std::ignore, std::ignore) =
-      _targetFromPosition(start, kBlockSize);
-
-  ArgsTuple argsTuple{oid_, start, fn, std::tuple<Args...>(args...)};
-
-  rt::forEachAt(target, ForEachInRangeFunWrapper<ArgsTuple, Args...>, argsTuple,
-                blockSize);
-
-  start += blockSize;
-  numElements -= blockSize;
-
-  // inner blocks
-  while (start != end && numElements > 0) {
-    std::tie(target, std::ignore, std::ignore) =
-        _targetFromPosition(start, kBlockSize);
-    blockSize = std::min(kBlockSize, numElements);
+  size_type offset(0);
+  for (size_type start = begin; start < end;) {
+    std::tie(target, offset) = _targetFromPosition(start);
+    size_type numElements = std::min(end - start, chunkSize_ - offset);
 
     std::get<1>(argsTuple) = start;
     rt::forEachAt(target, ForEachInRangeFunWrapper<ArgsTuple, Args...>,
-                  argsTuple, blockSize);
+                  argsTuple, numElements);
 
-    start += blockSize;
-    numElements -= blockSize;
+    start += numElements;
   }
 }
 
@@ -1340,39 +1596,21 @@ void Vector<T, Allocator>::AsyncForEachInRange(rt::Handle &handle,
   using ArgsTuple =
       std::tuple<ObjectID, size_t, FunctionTy, std::tuple<Args...>>;
 
-  size_type numElements = end - begin;
-  size_type start = begin;
-
-  // first block
-  size_type blockSize =
-      std::min(numElements, kBlockSize - (start % kBlockSize));
+  ArgsTuple argsTuple{oid_, begin, fn, std::tuple<Args...>(args...)};
 
+  // One loop for each Locality storing a piece of the range.
   rt::Locality target(0);
-  std::tie(target, std::ignore, std::ignore) =
-      _targetFromPosition(start, kBlockSize);
-
-  ArgsTuple argsTuple{oid_, start, fn, std::tuple<Args...>(args...)};
-
-  rt::asyncForEachAt(handle, target,
-                     AsyncForEachInRangeFunWrapper<ArgsTuple, Args...>,
-                     argsTuple, blockSize);
-
-  start += blockSize;
-  numElements -= blockSize;
-
-  // inner blocks
-  while (start != end && numElements > 0) {
-    std::tie(target, std::ignore, std::ignore) =
-        _targetFromPosition(start, kBlockSize);
-    blockSize = std::min(kBlockSize, numElements);
+  size_type offset(0);
+  for (size_type start = begin; start < end;) {
+    std::tie(target, offset) = _targetFromPosition(start);
+    size_type numElements = std::min(end - start, chunkSize_ - offset);
 
     std::get<1>(argsTuple) = start;
     rt::asyncForEachAt(handle, target,
                        AsyncForEachInRangeFunWrapper<ArgsTuple, Args...>,
-                       argsTuple, blockSize);
+                       argsTuple, numElements);
 
-    start += blockSize;
-    numElements -= blockSize;
+    start += numElements;
   }
 }
 
@@ -26,13 +26,14 @@
 #define INCLUDE_SHAD_EXTENSIONS_GRAPH_LIBRARY_ALGORITHMS_SSSP_H_
 
 #include <atomic>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <utility>
 
 #include "shad/data_structures/array.h"
-#include "shad/data_structures/set.h"
+#include "shad/data_structures/bag.h"
 #include "shad/extensions/graph_library/edge_index.h"
 #include "shad/runtime/runtime.h"
 #include "shad/util/measure.h"
@@ -50,32 +51,40 @@
 template <typename GraphT, typename VertexT>
 size_t sssp_length(typename GraphT::ObjectID gid, VertexT src, VertexT dest);
 
-template <typename GraphT, typename VertexT>
-void __sssp_neigh_iter(shad::rt::Handle &handle, const VertexT &src,
-                       const VertexT &dest,
-                       typename shad::Set<VertexT>::ObjectID &qnextID,
-                       // visited will be embedded in the graph
-                       shad::Array<bool>::ObjectID &visitedID,
-                       shad::Array<bool>::ObjectID &foundID, VertexT &target) {
-  auto visitedPtr = shad::Array<bool>::GetPtr(visitedID);
-  if (visitedPtr->At(dest) == true) return;
+// Claims dest on the locality that owns its visited flag, so that each vertex
+// enters the next frontier exactly once.
+template <typename VertexT>
+void __sssp_visit(shad::rt::Handle &, size_t dest, uint8_t &visited,
+                  typename shad::Bag<VertexT>::ObjectID &qnextID,
+                  shad::Array<bool>::ObjectID &foundID, VertexT &target) {
+  if (!__sync_bool_compare_and_swap(&visited, 0, 1)) return;
   if (dest == target) {
     bool sol_found = true;
     auto foundPtr = shad::Array<bool>::GetPtr(foundID);
     foundPtr->InsertAt(0, sol_found);
     return;
   }
-  auto qnextPtr = shad::Set<VertexT>::GetPtr(qnextID);
-  qnextPtr->Insert(dest);
-  bool dest_visited = true;
-  visitedPtr->InsertAt(dest, dest_visited);
+  auto qnextPtr = shad::Bag<VertexT>::GetPtr(qnextID);
+  qnextPtr->Push(dest);
+}
+
+template <typename GraphT, typename VertexT>
+void __sssp_neigh_iter(shad::rt::Handle &handle, const VertexT &src,
+                       const VertexT &dest,
+                       typename shad::Bag<VertexT>::ObjectID &qnextID,
+                       // visited will be embedded in the graph
+                       shad::Array<uint8_t>::ObjectID &visitedID,
+                       shad::Array<bool>::ObjectID &foundID, VertexT &target) {
+  auto visitedPtr = shad::Array<uint8_t>::GetPtr(visitedID);
+  visitedPtr->AsyncApply(handle, dest, __sssp_visit<VertexT>, qnextID, foundID,
+                         target);
 }
 
 template <typename GraphT, typename VertexT>
 void __sssp_iteration(shad::rt::Handle &handle, const size_t &curr_vertex,
                       typename GraphT::ObjectID &gid,
-                      typename shad::Set<VertexT>::ObjectID &qnextID,
-                      shad::Array<bool>::ObjectID &visitedID,
+                      typename shad::Bag<VertexT>::ObjectID &qnextID,
+                      shad::Array<uint8_t>::ObjectID &visitedID,
                       shad::Array<bool>::ObjectID &foundID, size_t &target) {
   auto graphPtr = GraphT::GetPtr(gid);
   graphPtr->AsyncForEachNeighbor(handle, curr_vertex,
@@ -86,18 +95,18 @@ void __sssp_iteration(shad::rt::Handle &handle, const size_t &curr_vertex,
 template <typename GraphT, typename VertexT>
 size_t __sssp_length(  // GraphT::SharedPtr gPtr,
     typename GraphT::ObjectID gid, size_t num_vertices,
-    typename shad::Set<VertexT>::SharedPtr to_visit_0,
-    typename shad::Set<VertexT>::SharedPtr to_visit_1,
-    shad::Array<bool>::SharedPtr visitedPtr,
+    typename shad::Bag<VertexT>::SharedPtr to_visit_0,
+    typename shad::Bag<VertexT>::SharedPtr to_visit_1,
+    shad::Array<uint8_t>::SharedPtr visitedPtr,
     shad::Array<bool>::SharedPtr foundPtr, VertexT src, VertexT dest) {
   if (src == dest) return 0;
   size_t level = 0;
-  shad::Set<size_t>::ShadSetPtr qPtr, nextqPtr;
+  typename shad::Bag<VertexT>::ShadBagPtr qPtr, nextqPtr;
   qPtr = to_visit_0;
   nextqPtr = to_visit_1;
 
-  qPtr->Insert(src);
-  bool v = true;
+  qPtr->Push(src);
+  uint8_t v = 1;
   visitedPtr->InsertAt(src, v);
   auto visitedID = visitedPtr->GetGlobalID();
   auto foundID = foundPtr->GetGlobalID();
@@ -111,7 +120,7 @@ size_t __sssp_length(  // GraphT::SharedPtr gPtr,
     ++level;
     if (foundPtr->At(0)) return level;
     // prepare for next round
-    qPtr->Reset(num_vertices / 2);
+    qPtr->Clear();
     qPtr.swap(nextqPtr);
   }
   return std::numeric_limits<size_t>::infinity();
@@ -121,16 +130,17 @@ template <typename GraphT, typename VertexT>
 size_t sssp_length(typename GraphT::ObjectID gid, VertexT src, VertexT dest) {
   auto gPtr = GraphT::GetPtr(gid);
   size_t num_vertices = gPtr->Size();
-  auto q0Ptr = shad::Set<VertexT>::Create(num_vertices / 2);
-  auto q1Ptr = shad::Set<VertexT>::Create(num_vertices / 2);
-  auto visited = shad::Array<bool>::Create(num_vertices, false);
+  auto q0Ptr = shad::Bag<VertexT>::Create();
+  auto q1Ptr = shad::Bag<VertexT>::Create();
+  auto visited = shad::Array<uint8_t>::Create(num_vertices, 0);
   auto found = shad::Array<bool>::Create(1, false);
-  return __sssp_length<GraphT, VertexT>(gid, num_vertices, q0Ptr, q1Ptr,
-                                        visited, found, src, dest);
-  shad::Set<VertexT>::Destroy(q0Ptr->GetGlobalID());
-  shad::Set<VertexT>::Destroy(q1Ptr->GetGlobalID());
-  shad::Array<bool>::Destroy(visited->GetGlobalID());
+  size_t length = __sssp_length<GraphT, VertexT>(
+      gid, num_vertices, q0Ptr, q1Ptr, visited, found, src, dest);
+  shad::Bag<VertexT>::Destroy(q0Ptr->GetGlobalID());
+  shad::Bag<VertexT>::Destroy(q1Ptr->GetGlobalID());
+  shad::Array<uint8_t>::Destroy(visited->GetGlobalID());
   shad::Array<bool>::Destroy(found->GetGlobalID());
+  return length;
 }
 
 #endif  // INCLUDE_SHAD_EXTENSIONS_GRAPH_LIBRARY_ALGORITHMS_SSSP_H_
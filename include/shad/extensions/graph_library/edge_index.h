@@ -26,6 +26,7 @@
 #define INCLUDE_SHAD_EXTENSIONS_GRAPH_LIBRARY_EDGE_INDEX_H_
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <tuple>
 #include <utility>
@@ -327,6 +328,51 @@ class EdgeIndex
   void AsyncForEachEdge(rt::Handle &handle, ApplyFunT &&function,
                         Args &... args);
 
+  /// @brief Apply a user-defined function to each common neighbor of two
+  /// vertices.
+  ///
+  /// The neighbors of the vertex with the smaller degree are shipped to the
+  /// Locality owning the other vertex, where they are probed in its
+  /// neighbors list; the function is executed on that Locality.
+  ///
+  /// @tparam ApplyFunT User-defined function type.  The function prototype
+  /// should be:
+  /// @code
+  /// void(const SrcT& u, const SrcT& v, const DestT& w, Args&);
+  /// @endcode
+  /// @tparam ...Args Types of the function arguments.
+  ///
+  /// @param u The first vertex.
+  /// @param v The second vertex.
+  /// @param function The function to apply.
+  /// @param args The function arguments.
+  template <typename ApplyFunT, typename... Args>
+  void IntersectNeighbors(const SrcT &u, const SrcT &v, ApplyFunT &&function,
+                          Args &... args);
+
+  /// @brief Asynchronously apply a user-defined function to each common
+  /// neighbor of two vertices.
+  ///
+  /// @tparam ApplyFunT User-defined function type.  The function prototype
+  /// should be:
+  /// @code
+  /// void(Handle&, const SrcT& u, const SrcT& v, const DestT& w, Args&);
+  /// @endcode
+  /// @tparam ...Args Types of the function arguments.
+  ///
+  /// @param[in,out] handle Reference to the handle
+  /// to be used to wait for completion.
+  /// @warning Asynchronous operations are guaranteed to have completed
+  /// only after calling the rt::waitForCompletion(rt::Handle &handle) method.
+  /// @param u The first vertex.
+  /// @param v The second vertex.
+  /// @param function The function to apply.
+  /// @param args The function arguments.
+  template <typename ApplyFunT, typename... Args>
+  void AsyncIntersectNeighbors(rt::Handle &handle, const SrcT &u,
+                               const SrcT &v, ApplyFunT &&function,
+                               Args &... args);
+
   // FIXME for testing purposes only
   LocalEdgeIndex<SrcT, DestT, StorageT> *GetLocalIndexPtr() {
     return &localIndex_;
@@ -372,6 +418,52 @@ class EdgeIndex
     SrcT src;
   };
 
+  static constexpr size_t kIntersectChunkSize =
+      constants::max(constants::kBufferNumBytes / sizeof(DestT), 1lu);
+
+  template <typename FunctionTy, typename... Args>
+  struct IntersectArgs {
+    ObjectID oid;
+    SrcT u;
+    SrcT v;
+    FunctionTy fn;
+    std::tuple<Args...> args;
+  };
+
+  // A chunk of the neighbors list shipped to the owner of probeVertex.
+  template <typename FunctionTy, typename... Args>
+  struct IntersectChunk {
+    IntersectChunk(const IntersectArgs<FunctionTy, Args...> &_header,
+                   const SrcT &_probeVertex, const DestT *_neighbors,
+                   size_t _numNeighbors)
+        : header(_header),
+          probeVertex(_probeVertex),
+          numNeighbors(_numNeighbors) {
+      std::copy(_neighbors, _neighbors + _numNeighbors, neighbors.data());
+    }
+    IntersectArgs<FunctionTy, Args...> header;
+    SrcT probeVertex;
+    size_t numNeighbors;
+    std::array<DestT, kIntersectChunkSize> neighbors;
+  };
+
+  static rt::Locality OwnerOf(const SrcT &src) {
+    return rt::Locality(shad::hash<SrcT>{}(src) % rt::numLocalities());
+  }
+
+  template <typename FunctionTy, typename... Args, std::size_t... is>
+  static void CallIntersectFun(rt::Handle &handle,
+                               IntersectArgs<FunctionTy, Args...> &header,
+                               const DestT &w, std::index_sequence<is...>) {
+    header.fn(handle, header.u, header.v, w, std::get<is>(header.args)...);
+  }
+
+  // Runs on the owner of listVertex.
+  template <typename FunctionTy, typename... Args>
+  void AsyncShipNeighbors(rt::Handle &handle,
+                          const IntersectArgs<FunctionTy, Args...> &header,
+                          const SrcT &listVertex, const SrcT &probeVertex);
+
   struct LookupResult {
     bool found;
     /// The value associated with the key.
@@ -858,6 +950,95 @@ void EdgeIndex<SrcT, DestT, StorageT>::VertexAttributesApply(
   }
 }
 
+template <typename SrcT, typename DestT, typename StorageT>
+template <typename FunctionTy, typename... Args>
+void EdgeIndex<SrcT, DestT, StorageT>::AsyncShipNeighbors(
+    rt::Handle &handle, const IntersectArgs<FunctionTy, Args...> &header,
+    const SrcT &listVertex, const SrcT &probeVertex) {
+  using HeaderT = IntersectArgs<FunctionTy, Args...>;
+  using ChunkT = IntersectChunk<FunctionTy, Args...>;
+  constexpr auto size = sizeof...(Args);
+
+  std::vector<DestT> neighbors;
+  localIndex_.GetNeighbors(listVertex, &neighbors);
+  rt::Locality probeLocality = OwnerOf(probeVertex);
+  if (probeLocality == rt::thisLocality()) {
+    HeaderT &h = const_cast<HeaderT &>(header);
+    localIndex_.IntersectNeighbors(
+        probeVertex, neighbors.data(), neighbors.size(),
+        [&](const DestT &w) {
+          CallIntersectFun(handle, h, w, std::make_index_sequence<size>());
+        });
+    return;
+  }
+
+  auto probeLambda = [](rt::Handle &handle, const ChunkT &chunk) {
+    ChunkT &c = const_cast<ChunkT &>(chunk);
+    auto ptr = EdgeIndex<SrcT, DestT, StorageT>::GetPtr(c.header.oid);
+    ptr->localIndex_.IntersectNeighbors(
+        c.probeVertex, c.neighbors.data(), c.numNeighbors,
+        [&](const DestT &w) {
+          CallIntersectFun(handle, c.header, w,
+                           std::make_index_sequence<size>());
+        });
+  };
+  for (size_t first = 0; first < neighbors.size();
+       first += kIntersectChunkSize) {
+    size_t count = std::min(kIntersectChunkSize, neighbors.size() - first);
+    ChunkT chunk(header, probeVertex, neighbors.data() + first, count);
+    rt::asyncExecuteAt(handle, probeLocality, probeLambda, chunk);
+  }
+}
+
+template <typename SrcT, typename DestT, typename StorageT>
+template <typename ApplyFunT, typename... Args>
+void EdgeIndex<SrcT, DestT, StorageT>::AsyncIntersectNeighbors(
+    rt::Handle &handle, const SrcT &u, const SrcT &v, ApplyFunT &&function,
+    Args &... args) {
+  using FunctionTy = void (*)(rt::Handle &, const SrcT &, const SrcT &,
+                              const DestT &, Args &...);
+  FunctionTy fn = std::forward<decltype(function)>(function);
+  using HeaderT = IntersectArgs<FunctionTy, Args...>;
+  HeaderT header{oid_, u, v, fn, std::tuple<Args...>(args...)};
+
+  // The owner of u decides which list travels.
+  auto startLambda = [](rt::Handle &handle, const HeaderT &header) {
+    auto ptr = EdgeIndex<SrcT, DestT, StorageT>::GetPtr(header.oid);
+    size_t uDegree = ptr->localIndex_.GetDegree(header.u);
+    size_t vDegree = ptr->GetDegree(header.v);
+    if (uDegree == 0 || vDegree == 0) return;
+    if (uDegree <= vDegree) {
+      ptr->AsyncShipNeighbors(handle, header, header.u, header.v);
+      return;
+    }
+    auto shipLambda = [](rt::Handle &handle, const HeaderT &header) {
+      auto ptr = EdgeIndex<SrcT, DestT, StorageT>::GetPtr(header.oid);
+      ptr->AsyncShipNeighbors(handle, header, header.v, header.u);
+    };
+    rt::asyncExecuteAt(handle, OwnerOf(header.v), shipLambda, header);
+  };
+  rt::asyncExecuteAt(handle, OwnerOf(u), startLambda, header);
+}
+
+template <typename SrcT, typename DestT, typename StorageT>
+template <typename ApplyFunT, typename... Args>
+void EdgeIndex<SrcT, DestT, StorageT>::IntersectNeighbors(
+    const SrcT &u, const SrcT &v, ApplyFunT &&function, Args &... args) {
+  using FunctionTy =
+      void (*)(const SrcT &, const SrcT &, const DestT &, Args &...);
+  FunctionTy fn = std::forward<decltype(function)>(function);
+  if (OwnerOf(u) == rt::thisLocality() && OwnerOf(v) == rt::thisLocality()) {
+    localIndex_.IntersectNeighbors(u, v, fn, args...);
+    return;
+  }
+  auto asyncFn = [](rt::Handle &, const SrcT &u, const SrcT &v,
+                    const DestT &w, FunctionTy &fn,
+                    Args &... args) { fn(u, v, w, args...); };
+  rt::Handle handle;
+  AsyncIntersectNeighbors(handle, u, v, asyncFn, fn, args...);
+  rt::waitForCompletion(handle);
+}
+
 }  // namespace shad
 
 #endif  // INCLUDE_SHAD_EXTENSIONS_GRAPH_LIBRARY_EDGE_INDEX_H_
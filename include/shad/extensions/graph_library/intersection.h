@@ -0,0 +1,169 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef INCLUDE_SHAD_EXTENSIONS_GRAPH_LIBRARY_INTERSECTION_H_
+#define INCLUDE_SHAD_EXTENSIONS_GRAPH_LIBRARY_INTERSECTION_H_
+
+#include <algorithm>
+#include <cstddef>
+
+namespace shad {
+
+/// @brief Intersection of sorted ranges by linear merge.
+///
+/// @tparam T type of the elements.
+/// @tparam CallbackT Callable invoked as callback(const T&) on each common
+/// element, in increasing order.
+/// @param a the first range, sorted and without duplicates.
+/// @param na the size of the first range.
+/// @param b the second range, sorted and without duplicates.
+/// @param nb the size of the second range.
+/// @param callback The function to apply to the common elements.
+/// @return the number of common elements.
+template <typename T, typename CallbackT>
+size_t MergeIntersect(const T *a, size_t na, const T *b, size_t nb,
+                      CallbackT &&callback) {
+  size_t i = 0, j = 0, count = 0;
+  while (i < na && j < nb) {
+    if (a[i] < b[j]) {
+      ++i;
+    } else if (b[j] < a[i]) {
+      ++j;
+    } else {
+      callback(a[i]);
+      ++count;
+      ++i;
+      ++j;
+    }
+  }
+  return count;
+}
+
+/// @brief Intersection of sorted ranges by galloping (exponential) search.
+///
+/// Each element of the smaller range is searched in the larger one, starting
+/// from the position of the previous match: the cost is
+/// O(ns * log(nl / ns)), which beats the linear merge when the sizes are
+/// very different.
+///
+/// @tparam T type of the elements.
+/// @tparam CallbackT Callable invoked as callback(const T&) on each common
+/// element, in increasing order.
+/// @param small the smaller range, sorted and without duplicates.
+/// @param ns the size of the smaller range.
+/// @param large the larger range, sorted and without duplicates.
+/// @param nl the size of the larger range.
+/// @param callback The function to apply to the common elements.
+/// @return the number of common elements.
+template <typename T, typename CallbackT>
+size_t GallopingIntersect(const T *small, size_t ns, const T *large,
+                          size_t nl, CallbackT &&callback) {
+  size_t first = 0, count = 0;
+  for (size_t i = 0; i < ns && first < nl; ++i) {
+    const T &target = small[i];
+    // Find a window [first + step / 2, first + step] containing target.
+    size_t step = 1;
+    while (first + step < nl && large[first + step] < target) step <<= 1;
+    size_t last = std::min(first + step + 1, nl);
+    first = std::lower_bound(large + first + step / 2, large + last, target) -
+            large;
+    if (first < nl && !(target < large[first])) {
+      callback(target);
+      ++count;
+      ++first;
+    }
+  }
+  return count;
+}
+
+/// @brief Intersection of sorted ranges comparing blocks of elements.
+///
+/// Blocks of eight elements of the two ranges are compared
+/// all-against-all with branch-free inner loops, that the compiler maps to
+/// vector instructions; the block with the smaller maximum is then replaced.
+///
+/// @tparam T type of the elements.
+/// @tparam CallbackT Callable invoked as callback(const T&) on each common
+/// element, in increasing order.
+/// @param a the first range, sorted and without duplicates.
+/// @param na the size of the first range.
+/// @param b the second range, sorted and without duplicates.
+/// @param nb the size of the second range.
+/// @param callback The function to apply to the common elements.
+/// @return the number of common elements.
+template <typename T, typename CallbackT>
+size_t BlockIntersect(const T *a, size_t na, const T *b, size_t nb,
+                      CallbackT &&callback) {
+  constexpr size_t kBlock = 8;
+  size_t i = 0, j = 0, count = 0;
+  while (i + kBlock <= na && j + kBlock <= nb) {
+    for (size_t k = 0; k < kBlock; ++k) {
+      bool match = false;
+      for (size_t l = 0; l < kBlock; ++l) match |= a[i + k] == b[j + l];
+      if (match) {
+        callback(a[i + k]);
+        ++count;
+      }
+    }
+    const T &amax = a[i + kBlock - 1];
+    const T &bmax = b[j + kBlock - 1];
+    bool advanceA = !(bmax < amax);
+    bool advanceB = !(amax < bmax);
+    if (advanceA) i += kBlock;
+    if (advanceB) j += kBlock;
+  }
+  // Every pair still to be compared involves the tails.
+  return count + MergeIntersect(a + i, na - i, b + j, nb - j, callback);
+}
+
+/// Size ratio above which IntersectSorted switches to galloping search.
+constexpr size_t kGallopingRatio = 32;
+
+/// @brief Intersection of sorted ranges.
+///
+/// Picks GallopingIntersect when one range is more than kGallopingRatio times
+/// larger than the other, and BlockIntersect otherwise.
+///
+/// @tparam T type of the elements.
+/// @tparam CallbackT Callable invoked as callback(const T&) on each common
+/// element, in increasing order.
+/// @param a the first range, sorted and without duplicates.
+/// @param na the size of the first range.
+/// @param b the second range, sorted and without duplicates.
+/// @param nb the size of the second range.
+/// @param callback The function to apply to the common elements.
+/// @return the number of common elements.
+template <typename T, typename CallbackT>
+size_t IntersectSorted(const T *a, size_t na, const T *b, size_t nb,
+                       CallbackT &&callback) {
+  if (na > nb) return IntersectSorted(b, nb, a, na, callback);
+  if (na == 0) return 0;
+  if (nb / na > kGallopingRatio)
+    return GallopingIntersect(a, na, b, nb, callback);
+  return BlockIntersect(a, na, b, nb, callback);
+}
+
+}  // namespace shad
+
+#endif  // INCLUDE_SHAD_EXTENSIONS_GRAPH_LIBRARY_INTERSECTION_H_
@@ -266,6 +266,83 @@ class LocalEdgeIndex {
     edgeList->AsyncForEachNeighbor(handle, function, src, args...);
   }
 
+  /// @brief Apply a user-defined function to each common neighbor of two
+  /// vertices.
+  ///
+  /// The neighbors list with the smaller degree is scanned, and each of its
+  /// elements is probed in the other list: the cost is linear in the
+  /// smaller degree.
+  ///
+  /// @tparam ApplyFunT User-defined function type.  The function prototype
+  /// should be:
+  /// @code
+  /// void(const SrcT& u, const SrcT& v, const DestT& w, Args&);
+  /// @endcode
+  /// @tparam ...Args Types of the function arguments.
+  ///
+  /// @param u The first vertex.
+  /// @param v The second vertex.
+  /// @param function The function to apply.
+  /// @param args The function arguments.
+  /// @return the number of common neighbors.
+  template <typename ApplyFunT, typename... Args>
+  size_t IntersectNeighbors(const SrcT& u, const SrcT& v,
+                            ApplyFunT&& function, Args&... args) {
+    auto uList = edges_.edgeList_.Lookup(u);
+    auto vList = edges_.edgeList_.Lookup(v);
+    if (uList == nullptr || vList == nullptr) return 0;
+    auto smaller = uList->Size() <= vList->Size() ? uList : vList;
+    auto larger = smaller == uList ? vList : uList;
+    size_t count = 0;
+    smaller->ForEachNeighbor(
+        [&](const SrcT&, const DestT& w) {
+          if (!larger->Find(w)) return;
+          ++count;
+          function(u, v, w, args...);
+        },
+        u);
+    return count;
+  }
+
+  /// @brief Apply a function to each element of a list that is also a
+  /// neighbor of a given vertex.
+  ///
+  /// @tparam CallbackT Callable invoked as callback(const DestT&) on each
+  /// common element.
+  /// @param src The vertex.
+  /// @param neighbors The list to probe.
+  /// @param numNeighbors The size of the list.
+  /// @param callback The function to apply.
+  /// @return the number of common elements.
+  template <typename CallbackT>
+  size_t IntersectNeighbors(const SrcT& src, const DestT* neighbors,
+                            size_t numNeighbors, CallbackT&& callback) {
+    auto edgeList = edges_.edgeList_.Lookup(src);
+    if (edgeList == nullptr) return 0;
+    size_t count = 0;
+    for (size_t i = 0; i < numNeighbors; ++i) {
+      if (!edgeList->Find(neighbors[i])) continue;
+      ++count;
+      callback(neighbors[i]);
+    }
+    return count;
+  }
+
+  /// @brief Copy the neighbors of a vertex in a vector.
+  /// @param src The vertex.
+  /// @param[out] res The vector receiving the neighbors.
+  void GetNeighbors(const SrcT& src, std::vector<DestT>* res) {
+    res->clear();
+    auto edgeList = edges_.edgeList_.Lookup(src);
+    if (edgeList == nullptr) return;
+    res->reserve(edgeList->Size());
+    edgeList->ForEachNeighbor(
+        [](const SrcT&, const DestT& w, std::vector<DestT>* res) {
+          res->push_back(w);
+        },
+        src, res);
+  }
+
   template <typename ApplyFunT, typename... Args>
   void ForEachVertex(ApplyFunT&& function, Args&... args) {
     edges_.edgeList_.ForEachKey(function, args...);
@@ -0,0 +1,93 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "shad/core/algorithm.h"
+#include "shad/core/array.h"
+#include "shad/runtime/runtime.h"
+
+static constexpr size_t kSize = 1 << 22;
+static constexpr size_t kNumQueries = 1 << 20;
+
+using ArrayT = shad::array<int, kSize>;
+using QueriesT = shad::array<int, kNumQueries>;
+using ResultsT = shad::array<int64_t, kNumQueries>;
+
+static std::vector<int> randomValues(size_t n, unsigned seed) {
+  std::vector<int> values(n);
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist;
+  for (auto &v : values) v = dist(gen);
+  return values;
+}
+
+static void BM_StdLowerBound(benchmark::State &state) {
+  auto input = randomValues(kSize, 42);
+  std::sort(input.begin(), input.end());
+  auto queries = randomValues(kNumQueries, 7);
+  std::vector<int64_t> results(kNumQueries);
+  for (auto _ : state) {
+    for (size_t i = 0; i < kNumQueries; ++i)
+      results[i] =
+          std::lower_bound(input.begin(), input.end(), queries[i]) -
+          input.begin();
+    benchmark::DoNotOptimize(results.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+}
+BENCHMARK(BM_StdLowerBound)->Unit(benchmark::kMillisecond);
+
+static void BM_ShadBatchLowerBound(benchmark::State &state) {
+  auto input = randomValues(kSize, 42);
+  std::sort(input.begin(), input.end());
+  auto queries = randomValues(kNumQueries, 7);
+  auto array = std::make_shared<ArrayT>();
+  auto q = std::make_shared<QueriesT>();
+  auto results = std::make_shared<ResultsT>();
+  for (size_t i = 0; i < kSize; ++i) (*array)[i] = input[i];
+  for (size_t i = 0; i < kNumQueries; ++i) (*q)[i] = queries[i];
+  for (auto _ : state) {
+    shad::batch_lower_bound(shad::distributed_parallel_tag{}, array->begin(),
+                            array->end(), q->begin(), q->end(),
+                            results->begin());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+}
+BENCHMARK(BM_ShadBatchLowerBound)->Unit(benchmark::kMillisecond);
+
+namespace shad {
+int main(int argc, char **argv) {
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  ::benchmark::RunSpecifiedBenchmarks();
+
+  return 0;
+}
+}  // namespace shad
@@ -0,0 +1,173 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "shad/core/algorithm.h"
+#include "shad/core/array.h"
+#include "shad/runtime/runtime.h"
+
+static constexpr size_t kSize = 1 << 22;
+
+using ArrayT = shad::array<int, kSize>;
+
+static std::vector<int> randomInput() {
+  std::vector<int> input(kSize);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist;
+  for (auto &v : input) v = dist(gen);
+  return input;
+}
+
+static void fillArray(ArrayT &array, const std::vector<int> &input) {
+  for (size_t i = 0; i < kSize; ++i) array[i] = input[i];
+}
+
+static void BM_StdSort(benchmark::State &state) {
+  auto input = randomInput();
+  std::vector<int> data;
+  for (auto _ : state) {
+    state.PauseTiming();
+    data = input;
+    state.ResumeTiming();
+    std::sort(data.begin(), data.end());
+  }
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+BENCHMARK(BM_StdSort)->Unit(benchmark::kMillisecond);
+
+static void BM_ShadSortSequential(benchmark::State &state) {
+  auto input = randomInput();
+  auto array = std::make_shared<ArrayT>();
+  for (auto _ : state) {
+    state.PauseTiming();
+    fillArray(*array, input);
+    state.ResumeTiming();
+    shad::sort(shad::distributed_sequential_tag{}, array->begin(),
+               array->end());
+  }
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+BENCHMARK(BM_ShadSortSequential)->Unit(benchmark::kMillisecond);
+
+static void BM_ShadSortParallel(benchmark::State &state) {
+  auto input = randomInput();
+  auto array = std::make_shared<ArrayT>();
+  for (auto _ : state) {
+    state.PauseTiming();
+    fillArray(*array, input);
+    state.ResumeTiming();
+    shad::sort(shad::distributed_parallel_tag{}, array->begin(),
+               array->end());
+  }
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+BENCHMARK(BM_ShadSortParallel)->Unit(benchmark::kMillisecond);
+
+static void BM_ShadRadixSortParallel(benchmark::State &state) {
+  auto input = randomInput();
+  auto array = std::make_shared<ArrayT>();
+  for (auto _ : state) {
+    state.PauseTiming();
+    fillArray(*array, input);
+    state.ResumeTiming();
+    shad::radix_sort(shad::distributed_parallel_tag{}, array->begin(),
+                     array->end());
+  }
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+BENCHMARK(BM_ShadRadixSortParallel)->Unit(benchmark::kMillisecond);
+
+static constexpr size_t kTopK = 100;
+
+static void BM_StdPartialSortCopy(benchmark::State &state) {
+  auto input = randomInput();
+  std::vector<int> res(kTopK);
+  for (auto _ : state)
+    std::partial_sort_copy(input.begin(), input.end(), res.begin(),
+                           res.end(), std::greater<>());
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+BENCHMARK(BM_StdPartialSortCopy)->Unit(benchmark::kMillisecond);
+
+static void BM_ShadTopK(benchmark::State &state) {
+  auto input = randomInput();
+  auto array = std::make_shared<ArrayT>();
+  fillArray(*array, input);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(shad::top_k(shad::distributed_parallel_tag{},
+                                         array->begin(), array->end(), kTopK,
+                                         std::greater<>()));
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+BENCHMARK(BM_ShadTopK)->Unit(benchmark::kMillisecond);
+
+static void BM_ShadNthElement(benchmark::State &state) {
+  auto input = randomInput();
+  auto array = std::make_shared<ArrayT>();
+  for (auto _ : state) {
+    state.PauseTiming();
+    fillArray(*array, input);
+    state.ResumeTiming();
+    shad::nth_element(shad::distributed_parallel_tag{}, array->begin(),
+                      array->begin() + kSize / 2, array->end());
+  }
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+BENCHMARK(BM_ShadNthElement)->Unit(benchmark::kMillisecond);
+
+static void BM_StdShuffle(benchmark::State &state) {
+  auto data = randomInput();
+  std::mt19937_64 gen(42);
+  for (auto _ : state) std::shuffle(data.begin(), data.end(), gen);
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+BENCHMARK(BM_StdShuffle)->Unit(benchmark::kMillisecond);
+
+static void BM_ShadShuffleParallel(benchmark::State &state) {
+  auto array = std::make_shared<ArrayT>();
+  fillArray(*array, randomInput());
+  std::mt19937_64 gen(42);
+  for (auto _ : state)
+    shad::shuffle(shad::distributed_parallel_tag{}, array->begin(),
+                  array->end(), gen);
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+BENCHMARK(BM_ShadShuffleParallel)->Unit(benchmark::kMillisecond);
+
+namespace shad {
+int main(int argc, char **argv) {
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  ::benchmark::RunSpecifiedBenchmarks();
+
+  return 0;
+}
+}  // namespace shad
@@ -157,6 +157,30 @@ TYPED_TEST(ATF, shad_find_if_not) {
       shad_test_stl::find_if_not_<it_t, pred_t>, odd_pred_t);
 }
 
+// parallel searches return the first of several matches
+TYPED_TEST(ATF, shad_find_first_match) {
+  using value_t = typename TypeParam::value_type;
+  using is_odd_t = shad_test_stl::is_odd<value_t>;
+  using is_even_t = shad_test_stl::is_even<value_t>;
+  auto size = this->in->size();
+  for (auto i : {size - 1, size / 2 + 3, size / 2 + 1}) this->in->at(i) = 1;
+  auto expected = this->in->begin() + size / 2 + 1;
+  auto first = this->in->begin(), last = this->in->end();
+
+  ASSERT_EQ(shad::find_if(shad::distributed_parallel_tag{}, first, last,
+                          is_odd_t{}),
+            expected);
+  ASSERT_EQ(shad::find_if_not(shad::distributed_parallel_tag{}, first, last,
+                              is_even_t{}),
+            expected);
+  ASSERT_EQ(shad::find(shad::distributed_parallel_tag{}, first, last, 1),
+            expected);
+  ASSERT_TRUE(
+      shad::any_of(shad::distributed_parallel_tag{}, first, last, is_odd_t{}));
+  ASSERT_FALSE(shad::all_of(shad::distributed_parallel_tag{}, first, last,
+                            is_even_t{}));
+}
+
 // all_of, any_of, none_of
 TYPED_TEST(ATF, shad_all_of) {
   using it_t = typename TypeParam::iterator;
@@ -0,0 +1,144 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/core/algorithm.h"
+#include "shad/core/array.h"
+#include "shad/core/execution.h"
+
+static constexpr size_t kSize = 10000;
+static constexpr size_t kNumQueries = 1024;
+static constexpr int kMaxValue = 2000;
+
+class BinarySearchTest : public ::testing::Test {
+ public:
+  void SetUp() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, kMaxValue);
+    for (size_t i = 0; i < kSize; ++i) values_.push_back(dist(gen));
+    std::sort(values_.begin(), values_.end());
+    for (size_t i = 0; i < kSize; ++i) in_.at(i) = values_[i];
+
+    // include values out of the range of the input
+    std::uniform_int_distribution<int> qdist(-10, kMaxValue + 10);
+    for (size_t i = 0; i < kNumQueries; ++i) {
+      queries_.push_back(qdist(gen));
+      q_.at(i) = queries_.back();
+    }
+  }
+
+ protected:
+  shad::array<int, kSize> in_;
+  shad::array<int, kNumQueries> q_;
+  shad::array<int64_t, kNumQueries> out_;
+  std::vector<int> values_, queries_;
+};
+
+// copy the results, to compare them without remote references
+template <typename Array>
+std::vector<int64_t> results(const Array &array) {
+  return std::vector<int64_t>(array.begin(), array.end());
+}
+
+TEST_F(BinarySearchTest, lower_bound) {
+  for (int value : {-1, 0, 1, kMaxValue / 2, kMaxValue, kMaxValue + 1}) {
+    auto expected = std::lower_bound(values_.begin(), values_.end(), value);
+    auto res = shad::lower_bound(in_.begin(), in_.end(), value);
+    ASSERT_EQ(std::distance(in_.begin(), res),
+              std::distance(values_.begin(), expected));
+  }
+}
+
+TEST_F(BinarySearchTest, upper_bound) {
+  for (int value : {-1, 0, 1, kMaxValue / 2, kMaxValue, kMaxValue + 1}) {
+    auto expected = std::upper_bound(values_.begin(), values_.end(), value);
+    auto res = shad::upper_bound(shad::distributed_parallel_tag{},
+                                 in_.begin(), in_.end(), value);
+    ASSERT_EQ(std::distance(in_.begin(), res),
+              std::distance(values_.begin(), expected));
+  }
+}
+
+TEST_F(BinarySearchTest, equal_range_and_binary_search) {
+  for (int value : {-1, values_[kSize / 3], kMaxValue + 1}) {
+    auto expected = std::equal_range(values_.begin(), values_.end(), value);
+    auto res = shad::equal_range(in_.begin(), in_.end(), value);
+    ASSERT_EQ(std::distance(in_.begin(), res.first),
+              std::distance(values_.begin(), expected.first));
+    ASSERT_EQ(std::distance(in_.begin(), res.second),
+              std::distance(values_.begin(), expected.second));
+    ASSERT_EQ(shad::binary_search(in_.begin(), in_.end(), value),
+              std::binary_search(values_.begin(), values_.end(), value));
+  }
+}
+
+TEST_F(BinarySearchTest, comparator) {
+  std::sort(values_.begin(), values_.end(), std::greater<int>());
+  for (size_t i = 0; i < kSize; ++i) in_.at(i) = values_[i];
+  int value = values_[kSize / 2];
+  auto expected = std::lower_bound(values_.begin(), values_.end(), value,
+                                   std::greater<int>());
+  auto res =
+      shad::lower_bound(in_.begin(), in_.end(), value, std::greater<int>());
+  ASSERT_EQ(std::distance(in_.begin(), res),
+            std::distance(values_.begin(), expected));
+}
+
+TEST_F(BinarySearchTest, batch_lower_bound) {
+  auto res = shad::batch_lower_bound(shad::distributed_parallel_tag{},
+                                     in_.begin(), in_.end(), q_.begin(),
+                                     q_.end(), out_.begin());
+  ASSERT_EQ(res, out_.end());
+  auto out = results(out_);
+  for (size_t i = 0; i < kNumQueries; ++i)
+    ASSERT_EQ(out[i], std::distance(values_.begin(),
+                                    std::lower_bound(values_.begin(),
+                                                     values_.end(),
+                                                     queries_[i])));
+}
+
+TEST_F(BinarySearchTest, batch_upper_bound) {
+  shad::batch_upper_bound(shad::distributed_sequential_tag{}, in_.begin(),
+                          in_.end(), q_.begin(), q_.end(), out_.begin());
+  auto out = results(out_);
+  for (size_t i = 0; i < kNumQueries; ++i)
+    ASSERT_EQ(out[i], std::distance(values_.begin(),
+                                    std::upper_bound(values_.begin(),
+                                                     values_.end(),
+                                                     queries_[i])));
+}
+
+TEST_F(BinarySearchTest, batch_binary_search) {
+  shad::batch_binary_search(shad::distributed_parallel_tag{}, in_.begin(),
+                            in_.end(), q_.begin(), q_.end(), out_.begin());
+  auto out = results(out_);
+  for (size_t i = 0; i < kNumQueries; ++i)
+    ASSERT_EQ(out[i], std::binary_search(values_.begin(), values_.end(),
+                                         queries_[i]));
+}
@@ -23,6 +23,8 @@
 //===----------------------------------------------------------------------===//
 
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -137,6 +139,55 @@ TYPED_TEST(ATF, exclusive_scan) {
       shad_test_stl::ordered_checksum<it_t>, 0, sum_f{});
 }
 
+// parallel scans combine partial results in the order of the range
+TYPED_TEST(ATF, scan_order) {
+  using val_t = typename TypeParam::value_type;
+  auto second = [](const val_t &, const val_t &y) { return y; };
+  auto out = std::make_shared<TypeParam>();
+  std::vector<val_t> in(this->in->begin(), this->in->end());
+
+  auto res = shad::inclusive_scan(shad::distributed_parallel_tag{},
+                                  this->in->begin(), this->in->end(),
+                                  out->begin(), second);
+  ASSERT_EQ(res, out->end());
+  ASSERT_EQ(std::vector<val_t>(out->begin(), out->end()), in);
+
+  shad::exclusive_scan(shad::distributed_parallel_tag{}, this->in->begin(),
+                       this->in->end(), out->begin(), val_t{42}, second);
+  in.insert(in.begin(), val_t{42});
+  in.pop_back();
+  ASSERT_EQ(std::vector<val_t>(out->begin(), out->end()), in);
+}
+
+// parallel reductions combine partial results in the order of the range
+TYPED_TEST(ATF, reduce_order) {
+  using val_t = typename TypeParam::value_type;
+  auto second = [](const val_t &, const val_t &y) { return y; };
+  auto negate = [](const val_t &x) { return -x; };
+  auto begin = this->in->begin();
+  std::vector<val_t> in(begin, this->in->end());
+
+  for (size_t n : {size_t(0), size_t(1), size_t(17), in.size() / 3,
+                   in.size() / 2 + 1, in.size()}) {
+    auto last = begin + n;
+    auto expected = n == 0 ? val_t{42} : in[n - 1];
+    ASSERT_EQ(shad::reduce(shad::distributed_sequential_tag{}, begin, last,
+                           val_t{42}, second),
+              expected);
+    ASSERT_EQ(shad::reduce(shad::distributed_parallel_tag{}, begin, last,
+                           val_t{42}, second),
+              expected);
+
+    expected = n == 0 ? val_t{42} : -in[n - 1];
+    ASSERT_EQ(shad::transform_reduce(shad::distributed_sequential_tag{}, begin,
+                                     last, val_t{42}, second, negate),
+              expected);
+    ASSERT_EQ(shad::transform_reduce(shad::distributed_parallel_tag{}, begin,
+                                     last, val_t{42}, second, negate),
+              expected);
+  }
+}
+
 TYPED_TEST(ATF, transform_reduce_two_containers) {
   using it_t = typeof(this->in->begin());
   using val_t = typename TypeParam::value_type;
@@ -0,0 +1,133 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/core/algorithm.h"
+#include "shad/core/array.h"
+#include "shad/core/execution.h"
+
+static constexpr size_t kSize = 10000;
+
+class PartitioningTest : public ::testing::Test {
+ public:
+  using array_t = shad::array<int, kSize>;
+
+  void SetUp() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 1000);
+    for (size_t i = 0; i < kSize; ++i) {
+      expected_.push_back(dist(gen));
+      in_.at(i) = expected_.back();
+    }
+  }
+
+  static bool is_even(int x) { return x % 2 == 0; }
+
+  void CheckStable(const array_t &array) {
+    std::stable_partition(expected_.begin(), expected_.end(), is_even);
+    for (size_t i = 0; i < kSize; ++i) ASSERT_EQ(array.at(i), expected_[i]);
+  }
+
+ protected:
+  array_t in_;
+  std::vector<int> expected_;
+};
+
+TEST_F(PartitioningTest, is_partitioned) {
+  auto p = [](int x) { return x % 2 == 0; };
+  ASSERT_FALSE(shad::is_partitioned(shad::distributed_sequential_tag{},
+                                    in_.begin(), in_.end(), p));
+  ASSERT_FALSE(shad::is_partitioned(shad::distributed_parallel_tag{},
+                                    in_.begin(), in_.end(), p));
+
+  std::partition(expected_.begin(), expected_.end(), p);
+  for (size_t i = 0; i < kSize; ++i) in_.at(i) = expected_[i];
+  ASSERT_TRUE(shad::is_partitioned(shad::distributed_sequential_tag{},
+                                   in_.begin(), in_.end(), p));
+  ASSERT_TRUE(shad::is_partitioned(shad::distributed_parallel_tag{},
+                                   in_.begin(), in_.end(), p));
+  ASSERT_TRUE(shad::is_partitioned(in_.begin(), in_.begin(), p));
+}
+
+TEST_F(PartitioningTest, partition_sequential) {
+  auto p = [](int x) { return x % 2 == 0; };
+  auto num_true = std::count_if(expected_.begin(), expected_.end(), p);
+  auto res = shad::partition(shad::distributed_sequential_tag{}, in_.begin(),
+                             in_.end(), p);
+  ASSERT_EQ(std::distance(in_.begin(), res), num_true);
+  ASSERT_TRUE(shad::is_partitioned(in_.begin(), in_.end(), p));
+
+  std::vector<int> values;
+  for (size_t i = 0; i < kSize; ++i) values.push_back(in_.at(i));
+  std::sort(values.begin(), values.end());
+  std::sort(expected_.begin(), expected_.end());
+  ASSERT_EQ(values, expected_);
+}
+
+TEST_F(PartitioningTest, stable_partition_parallel) {
+  auto p = [](int x) { return x % 2 == 0; };
+  auto num_true = std::count_if(expected_.begin(), expected_.end(), p);
+  auto res = shad::stable_partition(shad::distributed_parallel_tag{},
+                                    in_.begin(), in_.end(), p);
+  ASSERT_EQ(std::distance(in_.begin(), res), num_true);
+  CheckStable(in_);
+}
+
+TEST_F(PartitioningTest, stable_partition_subrange) {
+  auto p = [](int x) { return x % 2 == 0; };
+  auto first = in_.begin() + 100, last = in_.end() - 100;
+  auto res =
+      shad::stable_partition(shad::distributed_parallel_tag{}, first, last, p);
+  auto expected = std::stable_partition(expected_.begin() + 100,
+                                        expected_.end() - 100, p);
+  ASSERT_EQ(std::distance(in_.begin(), res),
+            std::distance(expected_.begin(), expected));
+  for (size_t i = 0; i < kSize; ++i) ASSERT_EQ(in_.at(i), expected_[i]);
+}
+
+TEST_F(PartitioningTest, partition_copy) {
+  auto p = [](int x) { return x % 2 == 0; };
+  array_t out_true, out_false;
+  std::vector<int> expected_true, expected_false;
+  std::partition_copy(expected_.begin(), expected_.end(),
+                      std::back_inserter(expected_true),
+                      std::back_inserter(expected_false), p);
+
+  auto res = shad::partition_copy(shad::distributed_parallel_tag{},
+                                  in_.begin(), in_.end(), out_true.begin(),
+                                  out_false.begin(), p);
+  ASSERT_EQ(std::distance(out_true.begin(), res.first),
+            expected_true.size());
+  ASSERT_EQ(std::distance(out_false.begin(), res.second),
+            expected_false.size());
+  for (size_t i = 0; i < expected_true.size(); ++i)
+    ASSERT_EQ(out_true.at(i), expected_true[i]);
+  for (size_t i = 0; i < expected_false.size(); ++i)
+    ASSERT_EQ(out_false.at(i), expected_false[i]);
+}
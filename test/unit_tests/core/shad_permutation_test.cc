@@ -0,0 +1,183 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/core/algorithm.h"
+#include "shad/core/array.h"
+#include "shad/core/execution.h"
+
+static constexpr size_t kSize = 10007;
+
+class PermutationTest : public ::testing::Test {
+ public:
+  void SetUp() {
+    expected_.resize(kSize);
+    std::iota(expected_.begin(), expected_.end(), 0);
+    for (size_t i = 0; i < kSize; ++i) in_.at(i) = expected_[i];
+  }
+
+  template <typename Array>
+  void Check(const Array &array) {
+    for (size_t i = 0; i < kSize; ++i) ASSERT_EQ(array.at(i), expected_[i]);
+  }
+
+ protected:
+  shad::array<int, kSize> in_;
+  std::vector<int> expected_;
+};
+
+TEST_F(PermutationTest, reverse) {
+  shad::reverse(shad::distributed_parallel_tag{}, in_.begin(), in_.end());
+  std::reverse(expected_.begin(), expected_.end());
+  Check(in_);
+
+  shad::reverse(in_.begin() + 10, in_.end() - 3);
+  std::reverse(expected_.begin() + 10, expected_.end() - 3);
+  Check(in_);
+}
+
+TEST_F(PermutationTest, reverse_copy) {
+  shad::array<int, kSize> out;
+  auto res = shad::reverse_copy(shad::distributed_parallel_tag{}, in_.begin(),
+                                in_.end(), out.begin());
+  ASSERT_EQ(res, out.end());
+  std::reverse(expected_.begin(), expected_.end());
+  Check(out);
+}
+
+TEST_F(PermutationTest, rotate) {
+  for (size_t middle : {size_t(0), size_t(1), kSize / 3, kSize - 1, kSize}) {
+    auto res = shad::rotate(shad::distributed_parallel_tag{}, in_.begin(),
+                            in_.begin() + middle, in_.end());
+    auto expected = std::rotate(expected_.begin(), expected_.begin() + middle,
+                                expected_.end());
+    ASSERT_EQ(std::distance(in_.begin(), res),
+              std::distance(expected_.begin(), expected));
+    Check(in_);
+  }
+}
+
+TEST_F(PermutationTest, rotate_copy) {
+  shad::array<int, kSize> out;
+  auto res = shad::rotate_copy(in_.begin(), in_.begin() + 42, in_.end(),
+                               out.begin());
+  ASSERT_EQ(res, out.end());
+  std::rotate(expected_.begin(), expected_.begin() + 42, expected_.end());
+  Check(out);
+}
+
+TEST_F(PermutationTest, shuffle) {
+  shad::shuffle(shad::distributed_parallel_tag{}, in_.begin(), in_.end(),
+                std::mt19937(42));
+  std::vector<int> res(in_.begin(), in_.end());
+  ASSERT_NE(res, expected_);
+  std::sort(res.begin(), res.end());
+  ASSERT_EQ(res, expected_);
+}
+
+TEST_F(PermutationTest, shuffle_reproducible) {
+  shad::array<int, kSize> other;
+  for (size_t i = 0; i < kSize; ++i) other.at(i) = expected_[i];
+  shad::shuffle(shad::distributed_parallel_tag{}, in_.begin(), in_.end(),
+                std::mt19937(42));
+  shad::shuffle(shad::distributed_sequential_tag{}, other.begin(),
+                other.end(), std::mt19937(42));
+  for (size_t i = 0; i < kSize; ++i) ASSERT_EQ(in_.at(i), other.at(i));
+}
+
+TEST(PermutationSmallTest, next_permutation) {
+  shad::array<int, 6> array;
+  std::vector<int> expected{1, 2, 2, 3, 4, 5};
+  for (size_t i = 0; i < expected.size(); ++i) array.at(i) = expected[i];
+  bool more = true;
+  while (more) {
+    more = std::next_permutation(expected.begin(), expected.end());
+    ASSERT_EQ(shad::next_permutation(shad::distributed_parallel_tag{},
+                                     array.begin(), array.end()),
+              more);
+    for (size_t i = 0; i < expected.size(); ++i)
+      ASSERT_EQ(array.at(i), expected[i]);
+  }
+}
+
+TEST(PermutationSmallTest, prev_permutation) {
+  shad::array<int, 6> array;
+  std::vector<int> expected{5, 4, 3, 3, 2, 1};
+  for (size_t i = 0; i < expected.size(); ++i) array.at(i) = expected[i];
+  bool more = true;
+  while (more) {
+    more = std::prev_permutation(expected.begin(), expected.end());
+    ASSERT_EQ(shad::prev_permutation(array.begin(), array.end()), more);
+    for (size_t i = 0; i < expected.size(); ++i)
+      ASSERT_EQ(array.at(i), expected[i]);
+  }
+}
+
+TEST_F(PermutationTest, next_permutation_large) {
+  std::vector<int> values(kSize);
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> dist(0, 100);
+  for (size_t i = 0; i < kSize; ++i) {
+    values[i] = dist(gen);
+    in_.at(i) = values[i];
+  }
+  for (size_t step = 0; step < 5; ++step) {
+    auto more = std::next_permutation(values.begin(), values.end(),
+                                      std::greater<>());
+    ASSERT_EQ(shad::next_permutation(in_.begin(), in_.end(), std::greater<>()),
+              more);
+    for (size_t i = 0; i < kSize; ++i) ASSERT_EQ(in_.at(i), values[i]);
+  }
+}
+
+// large enough for the local shuffles to be split in blocks
+TEST(PermutationLargeTest, shuffle) {
+  static constexpr size_t kLargeSize = 1 << 18;
+  using ArrayT = shad::array<int, kLargeSize>;
+  auto array = std::make_shared<ArrayT>();
+  auto other = std::make_shared<ArrayT>();
+  for (size_t i = 0; i < kLargeSize; ++i) {
+    array->at(i) = i;
+    other->at(i) = i;
+  }
+  shad::shuffle(shad::distributed_parallel_tag{}, array->begin(),
+                array->end(), std::mt19937(7));
+  shad::shuffle(other->begin(), other->end(), std::mt19937(7));
+
+  std::vector<int> res(array->begin(), array->end());
+  ASSERT_EQ(res, std::vector<int>(other->begin(), other->end()));
+  size_t fixed_points = 0;
+  for (size_t i = 0; i < kLargeSize; ++i) fixed_points += res[i] == int(i);
+  ASSERT_LT(fixed_points, 20);
+  std::sort(res.begin(), res.end());
+  for (size_t i = 0; i < kLargeSize; ++i) ASSERT_EQ(res[i], int(i));
+}
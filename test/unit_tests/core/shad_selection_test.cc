@@ -0,0 +1,120 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/core/algorithm.h"
+#include "shad/core/array.h"
+#include "shad/core/execution.h"
+
+// larger than the candidates gathered by the selection in a single step
+static constexpr size_t kSize = 1 << 16;
+static constexpr int kMaxValue = 5000;
+
+class SelectionTest : public ::testing::Test {
+ public:
+  void SetUp() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, kMaxValue);
+    for (size_t i = 0; i < kSize; ++i) {
+      values_.push_back(dist(gen));
+      in_.at(i) = values_.back();
+    }
+    sorted_ = values_;
+    std::sort(sorted_.begin(), sorted_.end());
+  }
+
+  // the range is a permutation of the input
+  void CheckPermutation() {
+    std::vector<int> res(in_.begin(), in_.end());
+    std::sort(res.begin(), res.end());
+    ASSERT_EQ(res, sorted_);
+  }
+
+ protected:
+  shad::array<int, kSize> in_;
+  std::vector<int> values_, sorted_;
+};
+
+TEST_F(SelectionTest, top_k) {
+  for (size_t k : {size_t(0), size_t(1), size_t(100), kSize, kSize + 1}) {
+    auto res = shad::top_k(shad::distributed_parallel_tag{}, in_.begin(),
+                           in_.end(), k);
+    std::vector<int> expected(sorted_.begin(),
+                              sorted_.begin() + std::min(k, kSize));
+    ASSERT_EQ(res, expected);
+  }
+  ASSERT_EQ(std::vector<int>(in_.begin(), in_.end()), values_);
+}
+
+TEST_F(SelectionTest, top_k_greater) {
+  auto res = shad::top_k(shad::distributed_sequential_tag{}, in_.begin(),
+                         in_.end(), 100, std::greater<>());
+  std::vector<int> expected(sorted_.rbegin(), sorted_.rbegin() + 100);
+  ASSERT_EQ(res, expected);
+}
+
+TEST_F(SelectionTest, partial_sort_copy) {
+  shad::array<int, 1000> out;
+  auto res = shad::partial_sort_copy(shad::distributed_parallel_tag{},
+                                     in_.begin(), in_.end(), out.begin(),
+                                     out.end());
+  ASSERT_EQ(res, out.end());
+  for (size_t i = 0; i < out.size(); ++i) ASSERT_EQ(out.at(i), sorted_[i]);
+}
+
+TEST_F(SelectionTest, nth_element) {
+  for (size_t n : {size_t(0), size_t(17), kSize / 2, kSize - 1}) {
+    auto nth = in_.begin() + n;
+    shad::nth_element(shad::distributed_parallel_tag{}, in_.begin(), nth,
+                      in_.end());
+    int value = *nth;
+    ASSERT_EQ(value, sorted_[n]);
+    for (size_t i = 0; i < n; ++i) ASSERT_LE(in_.at(i), value);
+    for (size_t i = n; i < kSize; ++i) ASSERT_GE(in_.at(i), value);
+    CheckPermutation();
+  }
+}
+
+TEST_F(SelectionTest, nth_element_greater) {
+  auto nth = in_.begin() + 100;
+  shad::nth_element(in_.begin(), nth, in_.end(), std::greater<>());
+  int value = *nth;
+  ASSERT_EQ(value, sorted_[kSize - 101]);
+  for (size_t i = 0; i < 100; ++i) ASSERT_GE(in_.at(i), value);
+  CheckPermutation();
+}
+
+TEST_F(SelectionTest, partial_sort) {
+  auto middle = in_.begin() + 1000;
+  shad::partial_sort(shad::distributed_sequential_tag{}, in_.begin(), middle,
+                     in_.end());
+  for (size_t i = 0; i < 1000; ++i) ASSERT_EQ(in_.at(i), sorted_[i]);
+  CheckPermutation();
+}
@@ -0,0 +1,161 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/core/algorithm.h"
+#include "shad/core/array.h"
+#include "shad/core/execution.h"
+
+static constexpr size_t kSize1 = 5000;
+static constexpr size_t kSize2 = 3000;
+static constexpr size_t kOutSize = kSize1 + kSize2;
+
+class SetOpsTest : public ::testing::Test {
+ public:
+  void SetUp() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 500);
+    for (size_t i = 0; i < kSize1; ++i) values1_.push_back(dist(gen));
+    for (size_t i = 0; i < kSize2; ++i) values2_.push_back(dist(gen));
+    std::sort(values1_.begin(), values1_.end());
+    std::sort(values2_.begin(), values2_.end());
+    for (size_t i = 0; i < kSize1; ++i) in1_.at(i) = values1_[i];
+    for (size_t i = 0; i < kSize2; ++i) in2_.at(i) = values2_[i];
+  }
+
+  template <typename It>
+  void Check(It first, It last, const std::vector<int> &expected) {
+    ASSERT_EQ(std::distance(first, last), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+      ASSERT_EQ(out_.at(i), expected[i]);
+  }
+
+ protected:
+  shad::array<int, kSize1> in1_;
+  shad::array<int, kSize2> in2_;
+  shad::array<int, kOutSize> out_;
+  std::vector<int> values1_, values2_;
+};
+
+TEST_F(SetOpsTest, merge) {
+  std::vector<int> expected;
+  std::merge(values1_.begin(), values1_.end(), values2_.begin(),
+             values2_.end(), std::back_inserter(expected));
+
+  auto res = shad::merge(shad::distributed_sequential_tag{}, in1_.begin(),
+                         in1_.end(), in2_.begin(), in2_.end(), out_.begin());
+  Check(out_.begin(), res, expected);
+
+  res = shad::merge(shad::distributed_parallel_tag{}, in1_.begin(),
+                    in1_.end(), in2_.begin(), in2_.end(), out_.begin());
+  Check(out_.begin(), res, expected);
+}
+
+TEST_F(SetOpsTest, merge_comparator) {
+  std::sort(values1_.begin(), values1_.end(), std::greater<int>());
+  std::sort(values2_.begin(), values2_.end(), std::greater<int>());
+  for (size_t i = 0; i < kSize1; ++i) in1_.at(i) = values1_[i];
+  for (size_t i = 0; i < kSize2; ++i) in2_.at(i) = values2_[i];
+  std::vector<int> expected;
+  std::merge(values1_.begin(), values1_.end(), values2_.begin(),
+             values2_.end(), std::back_inserter(expected),
+             std::greater<int>());
+
+  auto res = shad::merge(shad::distributed_parallel_tag{}, in1_.begin(),
+                         in1_.end(), in2_.begin(), in2_.end(), out_.begin(),
+                         std::greater<int>());
+  Check(out_.begin(), res, expected);
+}
+
+TEST_F(SetOpsTest, inplace_merge) {
+  std::vector<int> expected;
+  std::merge(values1_.begin(), values1_.end(), values2_.begin(),
+             values2_.end(), std::back_inserter(expected));
+  for (size_t i = 0; i < kSize1; ++i) out_.at(i) = values1_[i];
+  for (size_t i = 0; i < kSize2; ++i) out_.at(kSize1 + i) = values2_[i];
+
+  shad::inplace_merge(shad::distributed_parallel_tag{}, out_.begin(),
+                      out_.begin() + kSize1, out_.end());
+  Check(out_.begin(), out_.end(), expected);
+}
+
+TEST_F(SetOpsTest, includes) {
+  ASSERT_EQ(shad::includes(shad::distributed_parallel_tag{}, in1_.begin(),
+                           in1_.end(), in2_.begin(), in2_.end()),
+            std::includes(values1_.begin(), values1_.end(), values2_.begin(),
+                          values2_.end()));
+  ASSERT_TRUE(shad::includes(shad::distributed_parallel_tag{}, in1_.begin(),
+                             in1_.end(), in1_.begin() + 100,
+                             in1_.begin() + 2000));
+  ASSERT_TRUE(shad::includes(in1_.begin(), in1_.end(), in2_.begin(),
+                             in2_.begin()));
+
+  // an element missing from the first range
+  in2_.at(0) = values1_.back() + 1;
+  ASSERT_FALSE(shad::includes(shad::distributed_parallel_tag{},
+                              in1_.begin(), in1_.end(), in2_.begin(),
+                              in2_.begin() + 1));
+
+  // more copies of an element than in the first range
+  size_t copies = std::count(values1_.begin(), values1_.end(), values1_[0]);
+  for (size_t i = 0; i <= copies; ++i) in2_.at(i) = values1_[0];
+  ASSERT_TRUE(shad::includes(shad::distributed_parallel_tag{}, in1_.begin(),
+                             in1_.end(), in2_.begin(),
+                             in2_.begin() + copies));
+  ASSERT_FALSE(shad::includes(shad::distributed_parallel_tag{},
+                              in1_.begin(), in1_.end(), in2_.begin(),
+                              in2_.begin() + copies + 1));
+}
+
+TEST_F(SetOpsTest, set_union) {
+  std::vector<int> expected;
+  std::set_union(values1_.begin(), values1_.end(), values2_.begin(),
+                 values2_.end(), std::back_inserter(expected));
+
+  auto res = shad::set_union(shad::distributed_sequential_tag{},
+                             in1_.begin(), in1_.end(), in2_.begin(),
+                             in2_.end(), out_.begin());
+  Check(out_.begin(), res, expected);
+
+  res = shad::set_union(shad::distributed_parallel_tag{}, in1_.begin(),
+                        in1_.end(), in2_.begin(), in2_.end(), out_.begin());
+  Check(out_.begin(), res, expected);
+}
+
+TEST_F(SetOpsTest, set_intersection) {
+  std::vector<int> expected;
+  std::set_intersection(values1_.begin(), values1_.end(), values2_.begin(),
+                        values2_.end(), std::back_inserter(expected));
+
+  auto res = shad::set_intersection(shad::distributed_parallel_tag{},
+                                    in1_.begin(), in1_.end(), in2_.begin(),
+                                    in2_.end(), out_.begin());
+  Check(out_.begin(), res, expected);
+}
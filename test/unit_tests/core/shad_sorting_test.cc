@@ -0,0 +1,180 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/core/algorithm.h"
+#include "shad/core/array.h"
+#include "shad/core/execution.h"
+
+static constexpr size_t kSortSize = 10000;
+
+struct KeyIndex {
+  int key;
+  int index;
+};
+
+template <typename T>
+class SortTest : public ::testing::Test {
+ public:
+  using array_t = shad::array<T, kSortSize>;
+
+  void SetUp() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, kSortSize / 4);
+    for (size_t i = 0; i < kSortSize; ++i) {
+      expected_.push_back(dist(gen));
+      array_.at(i) = expected_.back();
+    }
+  }
+
+  void Check(size_t n) {
+    std::sort(expected_.begin(), expected_.end());
+    for (size_t i = 0; i < n; ++i) ASSERT_EQ(array_.at(i), expected_[i]);
+  }
+
+ protected:
+  array_t array_;
+  std::vector<T> expected_;
+};
+
+using SortTestTypes = ::testing::Types<int, int64_t>;
+TYPED_TEST_CASE(SortTest, SortTestTypes);
+
+TYPED_TEST(SortTest, sort_sequential) {
+  shad::sort(shad::distributed_sequential_tag{}, this->array_.begin(),
+             this->array_.end());
+  this->Check(kSortSize);
+}
+
+TYPED_TEST(SortTest, sort_parallel) {
+  shad::sort(shad::distributed_parallel_tag{}, this->array_.begin(),
+             this->array_.end());
+  this->Check(kSortSize);
+}
+
+TYPED_TEST(SortTest, sort_comparator) {
+  shad::sort(shad::distributed_parallel_tag{}, this->array_.begin(),
+             this->array_.end(), std::greater<TypeParam>());
+  std::sort(this->expected_.begin(), this->expected_.end(),
+            std::greater<TypeParam>());
+  for (size_t i = 0; i < kSortSize; ++i)
+    ASSERT_EQ(this->array_.at(i), this->expected_[i]);
+}
+
+TYPED_TEST(SortTest, sort_subrange) {
+  auto first = this->array_.begin() + 100;
+  auto last = this->array_.end() - 100;
+  shad::sort(shad::distributed_parallel_tag{}, first, last);
+  std::sort(this->expected_.begin() + 100, this->expected_.end() - 100);
+  for (size_t i = 0; i < kSortSize; ++i)
+    ASSERT_EQ(this->array_.at(i), this->expected_[i]);
+}
+
+TYPED_TEST(SortTest, partial_sort) {
+  auto middle = this->array_.begin() + kSortSize / 10;
+  shad::partial_sort(shad::distributed_parallel_tag{}, this->array_.begin(),
+                     middle, this->array_.end());
+  this->Check(kSortSize / 10);
+}
+
+TYPED_TEST(SortTest, radix_sort_sequential) {
+  shad::radix_sort(shad::distributed_sequential_tag{}, this->array_.begin(),
+                   this->array_.end());
+  this->Check(kSortSize);
+}
+
+TYPED_TEST(SortTest, radix_sort_parallel) {
+  shad::radix_sort(shad::distributed_parallel_tag{}, this->array_.begin(),
+                   this->array_.end());
+  this->Check(kSortSize);
+}
+
+TEST(StableSortTest, stable_sort) {
+  shad::array<KeyIndex, kSortSize> array;
+  std::vector<KeyIndex> expected;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(0, 16);
+  for (size_t i = 0; i < kSortSize; ++i) {
+    expected.push_back(KeyIndex{dist(gen), static_cast<int>(i)});
+    array.at(i) = expected.back();
+  }
+
+  auto comp = [](const KeyIndex& a, const KeyIndex& b) {
+    return a.key < b.key;
+  };
+  shad::stable_sort(shad::distributed_parallel_tag{}, array.begin(),
+                    array.end(), comp);
+  std::stable_sort(expected.begin(), expected.end(), comp);
+  for (size_t i = 0; i < kSortSize; ++i) {
+    KeyIndex value = array.at(i);
+    ASSERT_EQ(value.key, expected[i].key);
+    ASSERT_EQ(value.index, expected[i].index);
+  }
+}
+
+TEST(RadixSortTest, radix_sort_signed) {
+  static constexpr size_t kSize = 1 << 17;
+  shad::array<int64_t, kSize> array;
+  std::vector<int64_t> expected;
+  std::mt19937_64 gen(42);
+  std::uniform_int_distribution<int64_t> dist(
+      std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+  for (size_t i = 0; i < kSize; ++i) {
+    expected.push_back(dist(gen));
+    array.at(i) = expected.back();
+  }
+
+  shad::radix_sort(shad::distributed_parallel_tag{}, array.begin(),
+                   array.end());
+  std::sort(expected.begin(), expected.end());
+  for (size_t i = 0; i < kSize; ++i) ASSERT_EQ(array.at(i), expected[i]);
+}
+
+TEST(RadixSortTest, radix_sort_key) {
+  shad::array<KeyIndex, kSortSize> array;
+  std::vector<KeyIndex> expected;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(-16, 16);
+  for (size_t i = 0; i < kSortSize; ++i) {
+    expected.push_back(KeyIndex{dist(gen), static_cast<int>(i)});
+    array.at(i) = expected.back();
+  }
+
+  shad::radix_sort(shad::distributed_parallel_tag{}, array.begin(),
+                   array.end(), [](const KeyIndex& x) { return x.key; });
+  std::stable_sort(
+      expected.begin(), expected.end(),
+      [](const KeyIndex& a, const KeyIndex& b) { return a.key < b.key; });
+  for (size_t i = 0; i < kSortSize; ++i) {
+    KeyIndex value = array.at(i);
+    ASSERT_EQ(value.key, expected[i].key);
+    ASSERT_EQ(value.index, expected[i].index);
+  }
+}
@@ -0,0 +1,133 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+#include "gtest/gtest.h"
+
+#include "shad/core/algorithm.h"
+#include "shad/core/array.h"
+#include "shad/core/iterator.h"
+#include "shad/core/numeric.h"
+#include "shad/core/vector.h"
+#include "shad/runtime/runtime.h"
+
+static constexpr size_t kVectorSize = 100000;
+
+TEST(shad_vector, Construction) {
+  shad::vector<int> empty;
+  ASSERT_TRUE(empty.empty());
+  ASSERT_EQ(std::distance(empty.begin(), empty.end()), 0);
+
+  shad::vector<int> v(kVectorSize, 7);
+  ASSERT_EQ(v.size(), kVectorSize);
+  ASSERT_GE(v.capacity(), kVectorSize);
+  ASSERT_EQ(v.front(), 7);
+  ASSERT_EQ(v.back(), 7);
+  ASSERT_EQ(shad::count(shad::distributed_parallel_tag{}, v.begin(), v.end(),
+                        7),
+            kVectorSize);
+}
+
+TEST(shad_vector, PushBackAndResize) {
+  shad::vector<int> v;
+  for (int i = 0; i < 1000; ++i) v.push_back(i);
+  ASSERT_EQ(v.size(), 1000);
+  for (int i = 0; i < 1000; ++i) ASSERT_EQ(v[i], i);
+
+  v.resize(500);
+  ASSERT_EQ(v.size(), 500);
+  ASSERT_EQ(v.back(), 499);
+
+  // Growing within the capacity value-initializes the exposed elements.
+  v.resize(1000);
+  ASSERT_EQ(v.size(), 1000);
+  ASSERT_EQ(v.at(499), 499);
+  for (int i = 500; i < 1000; ++i) ASSERT_EQ(v[i], 0);
+
+  v.resize(kVectorSize);
+  ASSERT_EQ(v.size(), kVectorSize);
+  ASSERT_EQ(v.at(499), 499);
+  ASSERT_EQ(shad::count(shad::distributed_parallel_tag{}, v.begin(), v.end(),
+                        0),
+            kVectorSize - 499);
+
+  v.clear();
+  ASSERT_TRUE(v.empty());
+}
+
+TEST(shad_vector, Insert) {
+  shad::vector<int> v;
+  for (int i = 0; i < 100; ++i) v.push_back(i);
+
+  auto pos = v.insert(v.cbegin() + 50, -1);
+  ASSERT_EQ(std::distance(v.begin(), pos), 50);
+  ASSERT_EQ(v.size(), 101);
+  for (int i = 0; i < 50; ++i) ASSERT_EQ(v[i], i);
+  ASSERT_EQ(v[50], -1);
+  for (int i = 50; i < 100; ++i) ASSERT_EQ(v[i + 1], i);
+
+  v.insert(v.cend(), 100);
+  ASSERT_EQ(v.back(), 100);
+
+  std::insert_iterator<shad::vector<int>> ins(v, v.begin());
+  for (int i = 0; i < 10; ++i) ins = 1000 + i;
+  ASSERT_EQ(v.size(), 112);
+  for (int i = 0; i < 10; ++i) ASSERT_EQ(v[i], 1000 + i);
+
+  // the tail spans several blocks
+  shad::vector<int> large;
+  for (size_t i = 0; i < kVectorSize; ++i) large.push_back(i);
+  large.insert(large.cbegin() + 10, -1);
+  ASSERT_EQ(large.size(), kVectorSize + 1);
+  for (size_t i = 0; i < 10; ++i) ASSERT_EQ(large[i], i);
+  ASSERT_EQ(large[10], -1);
+  for (size_t i = 10; i < kVectorSize; ++i) ASSERT_EQ(large[i + 1], i);
+}
+
+TEST(shad_vector, BufferedInsertIterator) {
+  shad::array<int, kVectorSize> input;
+  shad::fill(shad::distributed_parallel_tag{}, input.begin(), input.end(), 1);
+
+  shad::vector<int> v;
+  shad::transform(shad::distributed_parallel_tag{}, input.begin(),
+                  input.end(),
+                  shad::buffered_insert_iterator<shad::vector<int>>(v, v.end()),
+                  [](int x) { return x + 1; });
+  ASSERT_EQ(v.size(), kVectorSize);
+  ASSERT_EQ(shad::reduce(shad::distributed_parallel_tag{}, v.begin(), v.end(),
+                         0),
+            2 * kVectorSize);
+
+  shad::buffered_insert_iterator<shad::vector<int>> ins(v, v.end());
+  for (int i = 0; i < 1000; ++i) ins = 3;
+  ins.wait();
+  ins.flush();
+  ASSERT_EQ(v.size(), kVectorSize + 1000);
+  ASSERT_EQ(shad::count(shad::distributed_parallel_tag{}, v.begin(), v.end(),
+                        3),
+            1000);
+}
@@ -136,6 +136,29 @@ TEST_F(ArrayTest, RangedAsyncInsertAndAsyncGet) {
   shad::Array<size_t>::Destroy(edsPtr->GetGlobalID());
 }
 
+TEST_F(ArrayTest, RangedSyncInsertAndRangedGet) {
+  std::vector<size_t> values(kArraySize);
+
+  auto edsPtr = shad::Array<size_t>::Create(kArraySize, kInitValue);
+  edsPtr->InsertAt(0, inputData_.data(), kArraySize);
+
+  edsPtr->AtRange(0, kArraySize, values.data());
+  for (size_t i = 0; i < kArraySize; i++) {
+    ASSERT_EQ(values[i], i + 1);
+  }
+
+  size_t first = kArraySize / 3, numValues = kArraySize / 2;
+  std::vector<size_t> slice(numValues);
+  shad::rt::Handle handle;
+  edsPtr->AsyncAtRange(handle, first, numValues, slice.data());
+  shad::rt::waitForCompletion(handle);
+  for (size_t i = 0; i < numValues; i++) {
+    ASSERT_EQ(slice[i], first + i + 1);
+  }
+
+  shad::Array<size_t>::Destroy(edsPtr->GetGlobalID());
+}
+
 TEST_F(ArrayTest, BufferedSyncInsertAndSyncGet) {
   auto edsPtr = shad::Array<size_t>::Create(kArraySize, kInitValue);
   for (size_t i = 0; i < kArraySize; i++) {
@@ -368,3 +391,76 @@ TEST_F(ArrayTest, AsyncInsertAsyncForEachAndAsyncGet) {
   }
   shad::Array<size_t>::Destroy(edsPtr->GetGlobalID());
 }
+
+template <typename ArrayT>
+static void CheckDistributedArray(typename ArrayT::SharedPtr edsPtr) {
+  std::vector<size_t> values(kArraySize);
+  for (size_t i = 0; i < kArraySize; i++) values[i] = i + 1;
+  edsPtr->InsertAt(0, values.data(), kArraySize);
+  edsPtr->ForEach(applyFun, kInitValue);
+
+  std::fill(values.begin(), values.end(), 0);
+  edsPtr->AtRange(0, kArraySize, values.data());
+  for (size_t i = 0; i < kArraySize; i++) {
+    ASSERT_EQ(values[i], i + 1 + kInitValue);
+    ASSERT_EQ(edsPtr->At(i), i + 1 + kInitValue);
+  }
+  ArrayT::Destroy(edsPtr->GetGlobalID());
+}
+
+TEST_F(ArrayTest, DistributionPolicies) {
+  using CyclicArray = shad::Array<size_t, shad::CyclicDistribution>;
+  CheckDistributedArray<CyclicArray>(
+      CyclicArray::Create(kArraySize, kInitValue));
+
+  using BlockCyclicArray = shad::Array<size_t, shad::BlockCyclicDistribution>;
+  CheckDistributedArray<BlockCyclicArray>(BlockCyclicArray::Create(
+      kArraySize, kInitValue, shad::BlockCyclicDistribution(16)));
+
+  using ExplicitArray = shad::Array<size_t, shad::ExplicitDistribution>;
+  std::vector<size_t> sizes(shad::rt::numLocalities(),
+                            kArraySize / shad::rt::numLocalities());
+  sizes.back() += kArraySize % shad::rt::numLocalities();
+  auto explicitPtr = ExplicitArray::CreateWithLocalSizes(sizes, kInitValue);
+  ASSERT_EQ(explicitPtr->Size(), kArraySize);
+  CheckDistributedArray<ExplicitArray>(explicitPtr);
+}
+
+TEST_F(ArrayTest, HaloExchange) {
+  using ObjectID = shad::Array<size_t>::ObjectID;
+  auto inPtr = shad::Array<size_t>::Create(kArraySize, kInitValue);
+  auto outPtr = shad::Array<size_t>::Create(kArraySize, 0lu);
+  inPtr->InsertAt(0, inputData_.data(), kArraySize);
+  inPtr->SetHaloWidth(2);
+  ASSERT_EQ(inPtr->HaloWidth(), 2);
+
+  ObjectID inID = inPtr->GetGlobalID(), outID = outPtr->GetGlobalID();
+  auto stencil = [](size_t pos, size_t &, ObjectID &inID, ObjectID &outID) {
+    auto ptr = shad::Array<size_t>::GetPtr(inID);
+    size_t value = 0;
+    for (size_t k = pos < 2 ? 0 : pos - 2;
+         k <= pos + 2 && k < ptr->Size(); ++k)
+      value += ptr->HaloAt(k);
+    shad::Array<size_t>::GetPtr(outID)->InsertAt(pos, value);
+  };
+  inPtr->ForEach(stencil, inID, outID);
+
+  std::vector<size_t> values(kArraySize);
+  outPtr->AtRange(0, kArraySize, values.data());
+  for (size_t i = 0; i < kArraySize; i++) {
+    size_t expected = 0;
+    for (size_t k = i < 2 ? 0 : i - 2; k <= i + 2 && k < kArraySize; ++k)
+      expected += k + 1;
+    ASSERT_EQ(values[i], expected);
+  }
+
+  // Updates become visible through the halos after the exchange.
+  for (size_t i = 0; i < kArraySize; i++) inputData_[i] = 2 * (i + 1);
+  inPtr->InsertAt(0, inputData_.data(), kArraySize);
+  inPtr->ExchangeHalos();
+  for (size_t i = 0; i < kArraySize; i++) {
+    ASSERT_EQ(inPtr->HaloAt(i), 2 * (i + 1));
+  }
+  shad::Array<size_t>::Destroy(inID);
+  shad::Array<size_t>::Destroy(outID);
+}
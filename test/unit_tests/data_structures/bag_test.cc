@@ -0,0 +1,114 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/data_structures/array.h"
+#include "shad/data_structures/bag.h"
+#include "shad/runtime/runtime.h"
+
+class BagTest : public ::testing::Test {
+ public:
+  using BagType = shad::Bag<uint64_t>;
+  static constexpr uint64_t kToInsert = 10000;
+
+  static shad::rt::Locality Owner(uint64_t element) {
+    return shad::rt::Locality(element % shad::rt::numLocalities());
+  }
+};
+
+TEST_F(BagTest, PushAndSize) {
+  auto bag = BagType::Create();
+  shad::rt::Handle handle;
+  for (uint64_t i = 0; i < kToInsert; ++i) {
+    switch (i % 4) {
+      case 0:
+        bag->Push(Owner(i), i);
+        break;
+      case 1:
+        bag->AsyncPush(handle, Owner(i), i);
+        break;
+      case 2:
+        bag->BufferedPush(Owner(i), i);
+        break;
+      default:
+        bag->BufferedAsyncPush(handle, Owner(i), i);
+    }
+  }
+  shad::rt::waitForCompletion(handle);
+  bag->WaitForBufferedPush();
+  ASSERT_EQ(bag->Size(), kToInsert);
+
+  auto checkLambda = [](const BagType::ObjectID &oid) {
+    auto bagPtr = BagType::GetPtr(oid);
+    uint64_t element;
+    while (bagPtr->Pop(&element))
+      ASSERT_EQ(Owner(element), shad::rt::thisLocality());
+  };
+  shad::rt::executeOnAll(checkLambda, bag->GetGlobalID());
+  ASSERT_EQ(bag->Size(), 0);
+  BagType::Destroy(bag->GetGlobalID());
+}
+
+TEST_F(BagTest, ForEachElementAndClear) {
+  auto bag = BagType::Create(size_t(128));
+  for (uint64_t i = 0; i < kToInsert; ++i) bag->BufferedPush(Owner(i), i);
+  bag->WaitForBufferedPush();
+
+  auto visited = shad::Array<bool>::Create(kToInsert, false);
+  auto visitedID = visited->GetGlobalID();
+  auto visitLambda = [](const uint64_t &e,
+                        shad::Array<bool>::ObjectID &oid) {
+    bool value = true;
+    shad::Array<bool>::GetPtr(oid)->InsertAt(e, value);
+  };
+  bag->ForEachElement(visitLambda, visitedID);
+  for (uint64_t i = 0; i < kToInsert; ++i) ASSERT_TRUE(visited->At(i));
+  ASSERT_EQ(bag->Size(), kToInsert);
+
+  bag->Clear();
+  ASSERT_EQ(bag->Size(), 0);
+  shad::Array<bool>::Destroy(visitedID);
+  BagType::Destroy(bag->GetGlobalID());
+}
+
+TEST_F(BagTest, PopOrSteal) {
+  auto bag = BagType::Create();
+  // Everything is pushed to the last locality.
+  shad::rt::Locality last(shad::rt::numLocalities() - 1);
+  for (uint64_t i = 0; i < kToInsert; ++i) bag->BufferedPush(last, i);
+  bag->WaitForBufferedPush();
+
+  std::vector<uint64_t> popped;
+  uint64_t element;
+  while (bag->PopOrSteal(&element)) popped.push_back(element);
+  ASSERT_EQ(popped.size(), kToInsert);
+  std::sort(popped.begin(), popped.end());
+  for (uint64_t i = 0; i < kToInsert; ++i) ASSERT_EQ(popped[i], i);
+  ASSERT_EQ(bag->Size(), 0);
+  BagType::Destroy(bag->GetGlobalID());
+}
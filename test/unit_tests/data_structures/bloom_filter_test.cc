@@ -0,0 +1,121 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/data_structures/bloom_filter.h"
+#include "shad/runtime/runtime.h"
+
+static const size_t kToInsert = 20000;
+static const double kFalsePositiveRate = 0.01;
+
+class BloomFilterTest : public ::testing::Test {
+ public:
+  using FilterType = shad::BloomFilter<uint64_t>;
+
+  // Fraction of the never-inserted keys [kToInsert, 2 * kToInsert)
+  // reported as present.
+  static double MeasureFalsePositives(FilterType *filter) {
+    size_t positives = 0;
+    for (uint64_t i = kToInsert; i < 2 * kToInsert; ++i)
+      if (filter->MayContain(i)) ++positives;
+    return static_cast<double>(positives) / kToInsert;
+  }
+};
+
+TEST_F(BloomFilterTest, InsertAndQuery) {
+  auto filter = FilterType::Create(kToInsert, kFalsePositiveRate);
+  for (uint64_t i = 0; i < kToInsert; ++i) filter->Insert(i);
+  for (uint64_t i = 0; i < kToInsert; ++i) ASSERT_TRUE(filter->MayContain(i));
+  ASSERT_LT(MeasureFalsePositives(filter.get()), 3 * kFalsePositiveRate);
+  filter->Clear();
+  ASSERT_LT(MeasureFalsePositives(filter.get()), 1e-9);
+  FilterType::Destroy(filter->GetGlobalID());
+}
+
+TEST_F(BloomFilterTest, AsyncAndBufferedInsert) {
+  auto filter = FilterType::Create(kToInsert, kFalsePositiveRate);
+  shad::rt::Handle handle;
+  for (uint64_t i = 0; i < kToInsert; ++i) {
+    switch (i % 3) {
+      case 0:
+        filter->AsyncInsert(handle, i);
+        break;
+      case 1:
+        filter->BufferedInsert(i);
+        break;
+      default:
+        filter->BufferedAsyncInsert(handle, i);
+    }
+  }
+  shad::rt::waitForCompletion(handle);
+  filter->WaitForBufferedInsert();
+  for (uint64_t i = 0; i < kToInsert; ++i) ASSERT_TRUE(filter->MayContain(i));
+  FilterType::Destroy(filter->GetGlobalID());
+}
+
+TEST_F(BloomFilterTest, BatchedQuery) {
+  auto filter = FilterType::Create(kToInsert, kFalsePositiveRate);
+  for (uint64_t i = 0; i < kToInsert; i += 2) filter->BufferedInsert(i);
+  filter->WaitForBufferedInsert();
+
+  std::vector<uint64_t> keys(kToInsert);
+  for (uint64_t i = 0; i < kToInsert; ++i) keys[i] = i;
+  std::unique_ptr<bool[]> results(new bool[kToInsert]);
+  filter->MayContain(keys.data(), kToInsert, results.get());
+  size_t positives = 0;
+  for (uint64_t i = 0; i < kToInsert; ++i) {
+    ASSERT_EQ(results[i], filter->MayContain(i));
+    if (i % 2 == 0) {
+      ASSERT_TRUE(results[i]);
+    }
+    positives += results[i];
+  }
+  ASSERT_LT(positives, kToInsert / 2 + 3 * kFalsePositiveRate * kToInsert);
+  FilterType::Destroy(filter->GetGlobalID());
+}
+
+TEST_F(BloomFilterTest, Replicate) {
+  auto filter = FilterType::Create(kToInsert, kFalsePositiveRate);
+  for (uint64_t i = 0; i < kToInsert; ++i) filter->BufferedInsert(i);
+  filter->WaitForBufferedInsert();
+  double before = MeasureFalsePositives(filter.get());
+
+  filter->Replicate();
+  for (uint64_t i = 0; i < kToInsert; ++i) ASSERT_TRUE(filter->MayContain(i));
+  ASSERT_EQ(MeasureFalsePositives(filter.get()), before);
+
+  std::vector<uint64_t> keys(kToInsert);
+  for (uint64_t i = 0; i < kToInsert; ++i) keys[i] = i;
+  std::unique_ptr<bool[]> results(new bool[kToInsert]);
+  filter->MayContain(keys.data(), kToInsert, results.get());
+  for (uint64_t i = 0; i < kToInsert; ++i) ASSERT_TRUE(results[i]);
+
+  filter->DropReplicas();
+  for (uint64_t i = 0; i < kToInsert; ++i) ASSERT_TRUE(filter->MayContain(i));
+  FilterType::Destroy(filter->GetGlobalID());
+}
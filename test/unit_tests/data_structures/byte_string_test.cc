@@ -0,0 +1,161 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/data_structures/byte_string.h"
+#include "shad/data_structures/hashmap.h"
+#include "shad/data_structures/local_hashmap.h"
+#include "shad/runtime/runtime.h"
+
+static const size_t kToInsert = 10000;
+
+class ByteStringTest : public ::testing::Test {
+ public:
+  using HashmapType = shad::Hashmap<shad::ByteString, shad::ByteString>;
+  using LocalHashmapType =
+      shad::LocalHashmap<shad::ByteString, shad::ByteString>;
+
+  // Keys alternate between inline and arena-allocated payloads.
+  static std::string Key(size_t i) {
+    std::string key = "k" + std::to_string(i);
+    if (i % 2) key += std::string(40 + i % 7, 'x');
+    return key;
+  }
+
+  static std::string Value(size_t i) {
+    return std::string(i % 64, 'a' + i % 26) + std::to_string(i);
+  }
+};
+
+TEST_F(ByteStringTest, InlineAndArenaStorage) {
+  shad::ByteString empty;
+  ASSERT_TRUE(empty.empty());
+  ASSERT_TRUE(empty.IsInline());
+
+  shad::ByteString small("small");
+  ASSERT_TRUE(small.IsInline());
+  ASSERT_EQ(small.size(), 5);
+  ASSERT_EQ(small.str(), "small");
+
+  std::string longStr(1000, 'z');
+  shad::ByteString large(longStr);
+  ASSERT_FALSE(large.IsInline());
+  ASSERT_EQ(large.str(), longStr);
+
+  ASSERT_EQ(small, shad::ByteString(std::string("small")));
+  ASSERT_NE(small, large);
+  ASSERT_TRUE(shad::ByteString("abc") < shad::ByteString("abd"));
+  ASSERT_TRUE(shad::ByteString("ab") < shad::ByteString("abc"));
+  ASSERT_EQ(shad::MemCmp<shad::ByteString>()(&large, &large), false);
+}
+
+TEST_F(ByteStringTest, SerializeDeserialize) {
+  std::vector<shad::ByteString> strings = {shad::ByteString(""),
+                                           shad::ByteString("inline"),
+                                           shad::ByteString(Key(1))};
+  size_t size = 0;
+  for (auto &s : strings) size += s.SerializedSize();
+  std::vector<uint8_t> buffer(size);
+  uint8_t *next = buffer.data();
+  for (auto &s : strings) next = s.Serialize(next);
+  ASSERT_EQ(next, buffer.data() + size);
+
+  const uint8_t *cursor = buffer.data();
+  for (auto &s : strings) {
+    auto res = shad::ByteString::Deserialize(&cursor);
+    ASSERT_EQ(res, s);
+    ASSERT_EQ(res.HashPrefix(), s.HashPrefix());
+  }
+}
+
+TEST_F(ByteStringTest, HashUsesStoredPrefix) {
+  shad::ByteString s(Key(1));
+  static_assert(!shad::is_std_hashable<shad::ByteString>::value,
+                "shad::hash must select the ByteString specialization");
+  ASSERT_EQ(shad::hash<shad::ByteString>{}(s), s.HashPrefix());
+  ASSERT_EQ(std::hash<shad::ByteString>{}(s), s.HashPrefix());
+}
+
+TEST_F(ByteStringTest, LocalHashmapInsertLookup) {
+  LocalHashmapType map(kToInsert / 128);
+  for (size_t i = 0; i < kToInsert; ++i) {
+    map.Insert(shad::ByteString(Key(i)), shad::ByteString(Value(i)));
+  }
+  ASSERT_EQ(map.Size(), kToInsert);
+  for (size_t i = 0; i < kToInsert; ++i) {
+    shad::ByteString value;
+    ASSERT_TRUE(map.Lookup(shad::ByteString(Key(i)), &value));
+    ASSERT_EQ(value.str(), Value(i));
+  }
+  shad::ByteString value;
+  ASSERT_FALSE(map.Lookup(shad::ByteString("missing"), &value));
+}
+
+TEST_F(ByteStringTest, HashmapInsertLookupErase) {
+  auto mapPtr = HashmapType::Create(kToInsert);
+  for (size_t i = 0; i < kToInsert; ++i) {
+    mapPtr->Insert(shad::ByteString(Key(i)), shad::ByteString(Value(i)));
+  }
+  ASSERT_EQ(mapPtr->Size(), kToInsert);
+  for (size_t i = 0; i < kToInsert; ++i) {
+    shad::ByteString value;
+    ASSERT_TRUE(mapPtr->Lookup(shad::ByteString(Key(i)), &value));
+    ASSERT_EQ(value.str(), Value(i));
+  }
+  for (size_t i = 0; i < kToInsert; i += 2) {
+    mapPtr->Erase(shad::ByteString(Key(i)));
+  }
+  ASSERT_EQ(mapPtr->Size(), kToInsert / 2);
+  for (size_t i = 0; i < kToInsert; ++i) {
+    shad::ByteString value;
+    ASSERT_EQ(mapPtr->Lookup(shad::ByteString(Key(i)), &value), i % 2 == 1);
+  }
+  HashmapType::Destroy(mapPtr->GetGlobalID());
+}
+
+TEST_F(ByteStringTest, HashmapBufferedInsert) {
+  auto mapPtr = HashmapType::Create(kToInsert);
+  shad::rt::Handle handle;
+  for (size_t i = 0; i < kToInsert; ++i) {
+    if (i % 2)
+      mapPtr->BufferedInsert(shad::ByteString(Key(i)),
+                             shad::ByteString(Value(i)));
+    else
+      mapPtr->BufferedAsyncInsert(handle, shad::ByteString(Key(i)),
+                                  shad::ByteString(Value(i)));
+  }
+  shad::rt::waitForCompletion(handle);
+  mapPtr->WaitForBufferedInsert();
+  ASSERT_EQ(mapPtr->Size(), kToInsert);
+  for (size_t i = 0; i < kToInsert; ++i) {
+    shad::ByteString value;
+    ASSERT_TRUE(mapPtr->Lookup(shad::ByteString(Key(i)), &value));
+    ASSERT_EQ(value.str(), Value(i));
+  }
+  HashmapType::Destroy(mapPtr->GetGlobalID());
+}
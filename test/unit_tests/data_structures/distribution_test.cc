@@ -0,0 +1,97 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/data_structures/distribution.h"
+
+static const size_t kDistributionSize = 10001;
+static const uint32_t kNumLocalities = 7;
+
+// Every position has exactly one owner, Owner() and GlobalPosition() are
+// inverse functions, and runs are stored contiguously.
+template <typename DistributionT>
+static void CheckDistribution(const DistributionT &distribution) {
+  std::vector<std::vector<bool>> seen(kNumLocalities);
+  size_t totalSize = 0;
+  for (uint32_t loc = 0; loc < kNumLocalities; ++loc) {
+    seen[loc].resize(distribution.LocalSize(loc), false);
+    totalSize += distribution.LocalSize(loc);
+  }
+  ASSERT_EQ(totalSize, kDistributionSize);
+
+  for (size_t pos = 0; pos < kDistributionSize; ++pos) {
+    auto owner = distribution.Owner(pos);
+    uint32_t loc = static_cast<uint32_t>(owner.first);
+    ASSERT_LT(loc, kNumLocalities);
+    ASSERT_LT(owner.second, seen[loc].size());
+    ASSERT_FALSE(seen[loc][owner.second]);
+    seen[loc][owner.second] = true;
+    ASSERT_EQ(distribution.GlobalPosition(loc, owner.second), pos);
+
+    size_t run = distribution.RunLength(pos);
+    ASSERT_GE(run, 1);
+    if (pos + run - 1 < kDistributionSize) {
+      auto last = distribution.Owner(pos + run - 1);
+      ASSERT_EQ(last.first, owner.first);
+      ASSERT_EQ(last.second, owner.second + run - 1);
+    }
+  }
+}
+
+TEST(DistributionTest, Block) {
+  shad::BlockDistribution distribution;
+  distribution.Init(kDistributionSize, kNumLocalities);
+  CheckDistribution(distribution);
+  ASSERT_EQ(distribution.RunLength(0), distribution.LocalSize(0));
+}
+
+TEST(DistributionTest, Cyclic) {
+  shad::CyclicDistribution distribution;
+  distribution.Init(kDistributionSize, kNumLocalities);
+  CheckDistribution(distribution);
+  ASSERT_EQ(static_cast<uint32_t>(distribution.Owner(8).first), 1);
+}
+
+TEST(DistributionTest, BlockCyclic) {
+  for (size_t blockSize : {1lu, 3lu, 64lu, 5000lu}) {
+    shad::BlockCyclicDistribution distribution(blockSize);
+    distribution.Init(kDistributionSize, kNumLocalities);
+    CheckDistribution(distribution);
+  }
+}
+
+TEST(DistributionTest, Explicit) {
+  shad::ExplicitDistribution distribution;
+  distribution.Init(kDistributionSize, kNumLocalities);
+  CheckDistribution(distribution);
+
+  std::vector<size_t> sizes = {5000, 1, 0, 2000, 3000, 0, 0};
+  distribution.SetLocalSizes(sizes.data(), kNumLocalities);
+  CheckDistribution(distribution);
+  ASSERT_EQ(static_cast<uint32_t>(distribution.Owner(5000).first), 1);
+  ASSERT_EQ(static_cast<uint32_t>(distribution.Owner(5001).first), 3);
+}
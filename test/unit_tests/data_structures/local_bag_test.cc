@@ -0,0 +1,115 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/data_structures/local_bag.h"
+#include "shad/runtime/runtime.h"
+
+class LocalBagTest : public ::testing::Test {
+ public:
+  static constexpr uint64_t kToInsert = 10000;
+  static constexpr uint64_t kSegmentSize = 64;
+  static constexpr uint64_t kNumTasks = 16;
+
+  static void ParallelPush(const std::tuple<shad::LocalBag<uint64_t> *> &t,
+                           size_t i) {
+    auto bagPtr = std::get<0>(t);
+    for (uint64_t e = i; e < kToInsert; e += kNumTasks) bagPtr->Push(e);
+  }
+};
+
+TEST_F(LocalBagTest, PushPop) {
+  shad::LocalBag<uint64_t> bag(kSegmentSize);
+  uint64_t element;
+  ASSERT_FALSE(bag.Pop(&element));
+
+  std::vector<uint64_t> batch(kToInsert / 2);
+  for (uint64_t i = 0; i < kToInsert / 2; ++i) batch[i] = i;
+  bag.Push(batch.data(), batch.size());
+  for (uint64_t i = kToInsert / 2; i < kToInsert; ++i) bag.Push(i);
+  ASSERT_EQ(bag.Size(), kToInsert);
+
+  std::vector<uint64_t> popped(kToInsert + 1);
+  size_t numPopped = bag.Pop(popped.data(), 100);
+  ASSERT_EQ(numPopped, 100);
+  while (bag.Pop(&popped[numPopped])) ++numPopped;
+  ASSERT_EQ(numPopped, kToInsert);
+  ASSERT_EQ(bag.Size(), 0);
+  popped.pop_back();
+  std::sort(popped.begin(), popped.end());
+  for (uint64_t i = 0; i < kToInsert; ++i) ASSERT_EQ(popped[i], i);
+
+  bag.Push(42);
+  bag.Clear();
+  ASSERT_EQ(bag.Size(), 0);
+  ASSERT_FALSE(bag.Pop(&element));
+}
+
+TEST_F(LocalBagTest, ConcurrentPushPop) {
+  shad::LocalBag<uint64_t> bag(kSegmentSize);
+  shad::rt::forEachAt(shad::rt::thisLocality(), ParallelPush,
+                      std::make_tuple(&bag), kNumTasks);
+  ASSERT_EQ(bag.Size(), kToInsert);
+
+  std::vector<std::atomic<uint32_t>> seen(kToInsert);
+  for (auto &s : seen) s = 0;
+  auto popLambda =
+      [](const std::tuple<shad::LocalBag<uint64_t> *,
+                          std::atomic<uint32_t> *> &t,
+         size_t) {
+        uint64_t element;
+        while (std::get<0>(t)->Pop(&element)) ++std::get<1>(t)[element];
+      };
+  shad::rt::forEachAt(shad::rt::thisLocality(), popLambda,
+                      std::make_tuple(&bag, seen.data()), kNumTasks);
+  for (uint64_t i = 0; i < kToInsert; ++i) ASSERT_EQ(seen[i], 1);
+}
+
+TEST_F(LocalBagTest, ForEachElement) {
+  shad::LocalBag<uint64_t> bag(kSegmentSize);
+  for (uint64_t i = 0; i < kToInsert; ++i) bag.Push(i);
+  uint64_t element;
+  for (uint64_t i = 0; i < 10; ++i) bag.Pop(&element);
+
+  std::atomic<uint64_t> sum(0);
+  std::atomic<uint64_t> *sumPtr = &sum;
+  auto sumLambda = [](const uint64_t &e, std::atomic<uint64_t> *&sum) {
+    *sum += e;
+  };
+  bag.ForEachElement(sumLambda, sumPtr);
+  ASSERT_EQ(sum, kToInsert * (kToInsert - 1) / 2 - 45);
+
+  sum = 0;
+  shad::rt::Handle handle;
+  auto asyncSumLambda = [](shad::rt::Handle &, const uint64_t &e,
+                           std::atomic<uint64_t> *&sum) { *sum += e; };
+  bag.AsyncForEachElement(handle, asyncSumLambda, sumPtr);
+  shad::rt::waitForCompletion(handle);
+  ASSERT_EQ(sum, kToInsert * (kToInsert - 1) / 2 - 45);
+}
@@ -0,0 +1,143 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/data_structures/local_bitmap_set.h"
+#include "shad/runtime/runtime.h"
+
+class LocalBitmapSetTest : public ::testing::Test {
+ public:
+  using SetType = shad::LocalBitmapSet<uint64_t>;
+  static constexpr uint64_t kDenseSize = 1 << 18;
+  static constexpr uint64_t kSparseSize = 10000;
+
+  // Elements spread over a wide domain: mostly array containers.
+  static std::set<uint64_t> SparseElements(unsigned seed) {
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<uint64_t> dist(0, 1ull << 28);
+    std::set<uint64_t> res;
+    while (res.size() < kSparseSize) res.insert(dist(gen));
+    return res;
+  }
+
+  static void Fill(SetType *set, const std::set<uint64_t> &elements) {
+    for (auto e : elements) ASSERT_TRUE(set->Insert(e));
+    ASSERT_EQ(set->Size(), elements.size());
+  }
+
+  static void Check(SetType *set, const std::set<uint64_t> &expected) {
+    ASSERT_EQ(set->Size(), expected.size());
+    for (auto e : expected) ASSERT_TRUE(set->Find(e));
+    std::vector<uint64_t> visited;
+    std::vector<uint64_t> *visitedPtr = &visited;
+    shad::rt::Lock lock;
+    shad::rt::Lock *lockPtr = &lock;
+    auto collectLambda = [](const uint64_t &e, std::vector<uint64_t> *&v,
+                            shad::rt::Lock *&lock) {
+      std::lock_guard<shad::rt::Lock> _(*lock);
+      v->push_back(e);
+    };
+    set->ForEachElement(collectLambda, visitedPtr, lockPtr);
+    std::sort(visited.begin(), visited.end());
+    ASSERT_TRUE(std::equal(visited.begin(), visited.end(), expected.begin(),
+                           expected.end()));
+  }
+};
+
+TEST_F(LocalBitmapSetTest, InsertFindErase) {
+  SetType set;
+  auto elements = SparseElements(1);
+  Fill(&set, elements);
+  for (auto e : elements) ASSERT_FALSE(set.Insert(e));
+  ASSERT_FALSE(set.Find(1ull << 29));
+
+  size_t i = 0;
+  std::set<uint64_t> remaining;
+  for (auto e : elements) {
+    if (i++ % 2)
+      set.Erase(e);
+    else
+      remaining.insert(e);
+  }
+  set.Erase(1ull << 29);
+  Check(&set, remaining);
+
+  set.Clear();
+  ASSERT_EQ(set.Size(), 0);
+  ASSERT_FALSE(set.Find(*remaining.begin()));
+}
+
+TEST_F(LocalBitmapSetTest, DenseDomain) {
+  SetType set;
+  auto insertLambda = [](const std::tuple<SetType *> &t, size_t i) {
+    for (uint64_t e = i; e < kDenseSize; e += 64) std::get<0>(t)->Insert(e);
+  };
+  shad::rt::forEachAt(shad::rt::thisLocality(), insertLambda,
+                      std::make_tuple(&set), 64);
+  ASSERT_EQ(set.Size(), kDenseSize);
+  for (uint64_t e = 0; e < kDenseSize; e += 7) ASSERT_TRUE(set.Find(e));
+  ASSERT_FALSE(set.Find(kDenseSize));
+  // Less than one byte per element (a hashed set needs more than eight).
+  ASSERT_LT(set.MemoryUsage(), kDenseSize / 4);
+
+  for (uint64_t e = 0; e < kDenseSize; ++e)
+    if (e % 1024) set.Erase(e);
+  set.Compact();
+  ASSERT_EQ(set.Size(), kDenseSize / 1024);
+  for (uint64_t e = 0; e < kDenseSize; e += 1024) ASSERT_TRUE(set.Find(e));
+  ASSERT_FALSE(set.Find(1));
+}
+
+TEST_F(LocalBitmapSetTest, IntersectAndUnion) {
+  // Mix dense and sparse chunks on both sides.
+  std::set<uint64_t> lhs = SparseElements(2), rhs = SparseElements(3);
+  for (uint64_t e = 0; e < 2 * 65536; e += 4) lhs.insert(e);
+  for (uint64_t e = 65536; e < 3 * 65536; e += 6) rhs.insert(e);
+  for (uint64_t e = 0; e < 20000; e += 5) rhs.insert(e);
+  SetType lhsSet, rhsSet;
+  Fill(&lhsSet, lhs);
+  Fill(&rhsSet, rhs);
+
+  std::set<uint64_t> expected;
+  std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                        std::inserter(expected, expected.end()));
+  ASSERT_EQ(lhsSet.IntersectionSize(rhsSet), expected.size());
+  SetType result;
+  lhsSet.Intersect(rhsSet, &result);
+  Check(&result, expected);
+
+  expected.clear();
+  std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                 std::inserter(expected, expected.end()));
+  rhsSet.Union(lhsSet, &result);
+  Check(&result, expected);
+}
@@ -0,0 +1,125 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/data_structures/local_map.h"
+#include "shad/runtime/runtime.h"
+
+class LocalMapTest : public ::testing::Test {
+ public:
+  static constexpr uint64_t kToInsert = 4096;
+  using MapType = shad::LocalMap<uint64_t, uint64_t>;
+
+  static void InsertFun(const std::tuple<MapType *> &args, size_t i) {
+    std::get<0>(args)->Insert(i * 2, i + 11);
+  }
+};
+
+TEST_F(LocalMapTest, InsertLookupTest) {
+  MapType map;
+  for (uint64_t i = 0; i < kToInsert; ++i) {
+    ASSERT_TRUE(map.Insert(i * 2, i + 11));
+  }
+  ASSERT_EQ(map.Size(), kToInsert);
+  for (uint64_t i = 0; i < kToInsert; ++i) {
+    uint64_t value;
+    ASSERT_TRUE(map.Lookup(i * 2, &value));
+    ASSERT_EQ(value, i + 11);
+    ASSERT_FALSE(map.Lookup(i * 2 + 1, &value));
+  }
+  // Overwrite.
+  ASSERT_FALSE(map.Insert(0, 42));
+  uint64_t value;
+  ASSERT_TRUE(map.Lookup(0, &value));
+  ASSERT_EQ(value, 42);
+  ASSERT_EQ(map.Size(), kToInsert);
+}
+
+TEST_F(LocalMapTest, ParallelInsertTest) {
+  MapType map;
+  shad::rt::forEachAt(shad::rt::thisLocality(), InsertFun,
+                      std::make_tuple(&map), kToInsert);
+  ASSERT_EQ(map.Size(), kToInsert);
+  uint64_t previous = 0;
+  uint64_t count = 0;
+  map.ForEachEntry(
+      [](const uint64_t &key, uint64_t &value, uint64_t &previous,
+         uint64_t &count) {
+        if (count > 0) {
+          ASSERT_LT(previous, key);
+        }
+        ASSERT_EQ(value, key / 2 + 11);
+        previous = key;
+        ++count;
+      },
+      previous, count);
+  ASSERT_EQ(count, kToInsert);
+}
+
+TEST_F(LocalMapTest, EraseTest) {
+  MapType map;
+  shad::rt::Handle handle;
+  for (uint64_t i = 0; i < kToInsert; ++i) {
+    map.AsyncInsert(handle, i, i);
+  }
+  shad::rt::waitForCompletion(handle);
+  for (uint64_t i = 0; i < kToInsert; i += 2) {
+    map.AsyncErase(handle, i);
+  }
+  shad::rt::waitForCompletion(handle);
+  ASSERT_EQ(map.Size(), kToInsert / 2);
+  for (uint64_t i = 0; i < kToInsert; ++i) {
+    uint64_t value;
+    ASSERT_EQ(map.Lookup(i, &value), i % 2 == 1);
+  }
+  map.Clear();
+  ASSERT_EQ(map.Size(), 0);
+  uint64_t value;
+  ASSERT_FALSE(map.Lookup(1, &value));
+}
+
+TEST_F(LocalMapTest, LowerBoundAndRangeTest) {
+  MapType map;
+  for (uint64_t i = 0; i < kToInsert; ++i) {
+    map.Insert(i * 10, i);
+  }
+  uint64_t key, value;
+  ASSERT_TRUE(map.LowerBound(15, &key, &value));
+  ASSERT_EQ(key, 20);
+  ASSERT_EQ(value, 2);
+  ASSERT_TRUE(map.LowerBound(20, &key, &value));
+  ASSERT_EQ(key, 20);
+  ASSERT_FALSE(map.LowerBound(kToInsert * 10, &key, &value));
+
+  uint64_t sum = 0;
+  map.ForEachInRange(
+      100, 200,
+      [](const uint64_t &, uint64_t &value, uint64_t &sum) { sum += value; },
+      sum);
+  ASSERT_EQ(sum, 10 + 11 + 12 + 13 + 14 + 15 + 16 + 17 + 18 + 19);
+}
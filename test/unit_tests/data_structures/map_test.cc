@@ -0,0 +1,122 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/data_structures/map.h"
+#include "shad/runtime/runtime.h"
+
+class MapTest : public ::testing::Test {
+ public:
+  static constexpr uint64_t kToInsert = 10000;
+  using MapType = shad::Map<uint64_t, uint64_t>;
+
+  static void CheckAll(MapType::ShadMapPtr mapPtr) {
+    for (uint64_t i = 0; i < kToInsert; ++i) {
+      uint64_t value;
+      ASSERT_TRUE(mapPtr->Lookup(i * 3, &value));
+      ASSERT_EQ(value, i + 11);
+    }
+  }
+};
+
+TEST_F(MapTest, InsertLookupTest) {
+  auto mapPtr = MapType::Create(0lu, kToInsert * 3);
+  for (uint64_t i = 0; i < kToInsert; ++i) {
+    mapPtr->Insert(i * 3, i + 11);
+  }
+  ASSERT_EQ(mapPtr->Size(), kToInsert);
+  CheckAll(mapPtr);
+  uint64_t value;
+  ASSERT_FALSE(mapPtr->Lookup(1, &value));
+  MapType::Destroy(mapPtr->GetGlobalID());
+}
+
+TEST_F(MapTest, BufferedInsertEraseTest) {
+  auto mapPtr = MapType::Create();
+  shad::rt::Handle handle;
+  for (uint64_t i = 0; i < kToInsert; ++i) {
+    if (i % 2)
+      mapPtr->BufferedInsert(i * 3, i + 11);
+    else
+      mapPtr->BufferedAsyncInsert(handle, i * 3, i + 11);
+  }
+  shad::rt::waitForCompletion(handle);
+  mapPtr->WaitForBufferedInsert();
+  ASSERT_EQ(mapPtr->Size(), kToInsert);
+  CheckAll(mapPtr);
+  for (uint64_t i = 0; i < kToInsert; i += 2) {
+    mapPtr->AsyncErase(handle, i * 3);
+  }
+  shad::rt::waitForCompletion(handle);
+  ASSERT_EQ(mapPtr->Size(), kToInsert / 2);
+  MapType::Destroy(mapPtr->GetGlobalID());
+}
+
+TEST_F(MapTest, LowerBoundTest) {
+  auto mapPtr = MapType::Create(0lu, kToInsert * 3);
+  for (uint64_t i = 0; i < kToInsert; ++i) {
+    mapPtr->Insert(i * 3, i + 11);
+  }
+  uint64_t key, value;
+  ASSERT_TRUE(mapPtr->LowerBound(4, &key, &value));
+  ASSERT_EQ(key, 6);
+  ASSERT_EQ(value, 13);
+  ASSERT_FALSE(mapPtr->LowerBound(kToInsert * 3, &key, &value));
+  MapType::Destroy(mapPtr->GetGlobalID());
+}
+
+TEST_F(MapTest, RangeAndRebalanceTest) {
+  auto mapPtr = MapType::Create();
+  for (uint64_t i = 0; i < kToInsert; ++i) {
+    mapPtr->Insert(i * 3, i + 11);
+  }
+  mapPtr->Rebalance();
+  ASSERT_EQ(mapPtr->Size(), kToInsert);
+  CheckAll(mapPtr);
+
+  std::atomic<uint64_t> count(0);
+  auto countPtr = &count;
+  mapPtr->ForEachInRange(
+      30, 300,
+      [](const uint64_t &key, uint64_t &, std::atomic<uint64_t> *&count) {
+        ASSERT_GE(key, 30);
+        ASSERT_LT(key, 300);
+        ++(*count);
+      },
+      countPtr);
+  ASSERT_EQ(count.load(), 90);
+
+  count = 0;
+  mapPtr->ForEachEntry(
+      [](const uint64_t &, uint64_t &, std::atomic<uint64_t> *&count) {
+        ++(*count);
+      },
+      countPtr);
+  ASSERT_EQ(count.load(), kToInsert);
+  MapType::Destroy(mapPtr->GetGlobalID());
+}
@@ -327,3 +327,42 @@ TEST_F(SetTest, AsyncForEachElement) {
   shad::rt::waitForCompletion(handle);
   shad::Set<Entry>::Destroy(oid);
 }
+
+static const uint64_t kAlgebraSize = 4096;
+
+TEST_F(SetTest, SetAlgebra) {
+  using IntSet = shad::Set<uint64_t>;
+  auto lhs = IntSet::Create(kAlgebraSize);
+  auto rhs = IntSet::Create(kAlgebraSize);
+  for (uint64_t i = 0; i < kAlgebraSize; ++i) {
+    lhs->BufferedInsert(i);
+    rhs->BufferedInsert(i + kAlgebraSize / 2);
+  }
+  lhs->WaitForBufferedInsert();
+  rhs->WaitForBufferedInsert();
+
+  auto unionSet = lhs->Union(rhs);
+  auto intersectSet = lhs->Intersect(rhs);
+  auto differenceSet = lhs->Difference(rhs);
+  ASSERT_EQ(unionSet->Size(), kAlgebraSize + kAlgebraSize / 2);
+  ASSERT_EQ(intersectSet->Size(), kAlgebraSize / 2);
+  ASSERT_EQ(differenceSet->Size(), kAlgebraSize / 2);
+
+  unionSet->ForEachElement([](const uint64_t &element) {
+    ASSERT_LT(element, kAlgebraSize + kAlgebraSize / 2);
+  });
+  intersectSet->ForEachElement([](const uint64_t &element) {
+    ASSERT_GE(element, kAlgebraSize / 2);
+    ASSERT_LT(element, kAlgebraSize);
+  });
+  differenceSet->ForEachElement(
+      [](const uint64_t &element) { ASSERT_LT(element, kAlgebraSize / 2); });
+  auto reverseDifferenceSet = rhs->Difference(lhs);
+  auto selfIntersectSet = lhs->Intersect(lhs);
+  ASSERT_TRUE(reverseDifferenceSet->Find(kAlgebraSize));
+  ASSERT_EQ(selfIntersectSet->Size(), kAlgebraSize);
+
+  for (auto set : {lhs, rhs, unionSet, intersectSet, differenceSet,
+                   reverseDifferenceSet, selfIntersectSet})
+    IntSet::Destroy(set->GetGlobalID());
+}
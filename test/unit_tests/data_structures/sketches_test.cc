@@ -0,0 +1,121 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "shad/data_structures/one_per_locality.h"
+#include "shad/data_structures/sketches.h"
+#include "shad/runtime/runtime.h"
+
+static const size_t kNumElements = 100000;
+
+class SketchesTest : public ::testing::Test {
+ public:
+  using HLLType = shad::HyperLogLog<uint64_t>;
+  using CMSType = shad::CountMinSketch<uint64_t>;
+  using TopKType = shad::TopK<uint64_t>;
+
+  // Each locality inserts its share of [0, kNumElements), in parallel.
+  template <typename SketchT>
+  static void InsertRange(
+      const std::shared_ptr<shad::OnePerLocality<SketchT>> &sketch) {
+    using OPLT = shad::OnePerLocality<SketchT>;
+    auto insertLambda = [](const typename OPLT::ObjectID &oid, size_t i) {
+      auto ptr = OPLT::GetPtr(oid);
+      size_t P = shad::rt::numLocalities();
+      size_t L = static_cast<uint32_t>(shad::rt::thisLocality());
+      for (size_t e = i * P + L; e < kNumElements; e += 64 * P)
+        (*ptr)->Insert(e);
+    };
+    for (auto &loc : shad::rt::allLocalities())
+      shad::rt::forEachAt(loc, insertLambda, sketch->GetGlobalID(), 64);
+  }
+};
+
+TEST_F(SketchesTest, HyperLogLog) {
+  auto sketch = shad::OnePerLocality<HLLType>::Create(size_t(14));
+  InsertRange(sketch);
+  // Duplicates do not change the estimate.
+  InsertRange(sketch);
+  double estimate = shad::MergeSketches(sketch).Estimate();
+  ASSERT_LT(std::fabs(estimate - kNumElements), 0.05 * kNumElements);
+
+  HLLType small;
+  for (uint64_t i = 0; i < 100; ++i) small.Insert(i % 10);
+  ASSERT_NEAR(small.Estimate(), 10, 1);
+  shad::OnePerLocality<HLLType>::Destroy(sketch->GetGlobalID());
+}
+
+TEST_F(SketchesTest, CountMinSketch) {
+  auto sketch = shad::OnePerLocality<CMSType>::Create(size_t(8192), size_t(4));
+  InsertRange(sketch);
+  auto heavyLambda = [](const shad::OnePerLocality<CMSType>::ObjectID &oid) {
+    auto ptr = shad::OnePerLocality<CMSType>::GetPtr(oid);
+    (*ptr)->Insert(kNumElements, 1000);
+  };
+  shad::rt::executeOnAll(heavyLambda, sketch->GetGlobalID());
+
+  shad::AllMergeSketches(sketch);
+  size_t P = shad::rt::numLocalities();
+  auto checkLambda = [](const shad::OnePerLocality<CMSType>::ObjectID &oid) {
+    auto &cms = *(*shad::OnePerLocality<CMSType>::GetPtr(oid)).operator->();
+    size_t P = shad::rt::numLocalities();
+    ASSERT_EQ(cms.TotalCount(), kNumElements + 1000 * P);
+    ASSERT_GE(cms.Estimate(kNumElements), 1000 * P);
+    double bound = std::exp(1.0) / 8192 * cms.TotalCount();
+    for (uint64_t i = 0; i < kNumElements; i += 97) {
+      ASSERT_GE(cms.Estimate(i), 1);
+      ASSERT_LE(cms.Estimate(i), 1 + 2 * bound);
+    }
+  };
+  shad::rt::executeOnAll(checkLambda, sketch->GetGlobalID());
+  ASSERT_EQ((*sketch)->TotalCount(), kNumElements + 1000 * P);
+  shad::OnePerLocality<CMSType>::Destroy(sketch->GetGlobalID());
+}
+
+TEST_F(SketchesTest, TopK) {
+  auto sketch = shad::OnePerLocality<TopKType>::Create(size_t(4));
+  InsertRange(sketch);
+  // Elements 0..3 are heavy hitters, with decreasing frequency.
+  auto heavyLambda = [](const shad::OnePerLocality<TopKType>::ObjectID &oid,
+                        size_t) {
+    auto ptr = shad::OnePerLocality<TopKType>::GetPtr(oid);
+    for (uint64_t e = 0; e < 4; ++e)
+      for (size_t j = 0; j < 100 * (4 - e); ++j) (*ptr)->Insert(e);
+  };
+  for (auto &loc : shad::rt::allLocalities())
+    shad::rt::forEachAt(loc, heavyLambda, sketch->GetGlobalID(), 4);
+
+  auto entries = shad::MergeSketches(sketch).Entries();
+  ASSERT_EQ(entries.size(), 4);
+  for (uint64_t e = 0; e < 4; ++e) {
+    ASSERT_EQ(entries[e].element, e);
+    ASSERT_GE(entries[e].count, 400 * (4 - e) * shad::rt::numLocalities());
+  }
+  shad::OnePerLocality<TopKType>::Destroy(sketch->GetGlobalID());
+}
@@ -24,9 +24,13 @@
 
 #include <algorithm>
 #include <type_traits>
+#include <vector>
 
 #include "gtest/gtest.h"
 
+#include "shad/core/algorithm.h"
+#include "shad/core/execution.h"
+#include "shad/core/numeric.h"
 #include "shad/data_structures/vector.h"
 
 class VectorTest : public ::testing::Test {
@@ -80,6 +84,37 @@ TEST_F(VectorTest, Capacity) {
   shad::Vector<int>::Destroy(vectorPtr->GetGlobalID());
 }
 
+TEST_F(VectorTest, BulkReserveAndResize) {
+  auto vectorPtr = shad::Vector<int>::Create(0);
+
+  vectorPtr->Reserve(kNumElements * 10);
+  ASSERT_GE(vectorPtr->Capacity(), kNumElements * 10);
+  ASSERT_EQ(vectorPtr->Size(), 0);
+
+  vectorPtr->Resize(kNumElements * 20);
+  ASSERT_EQ(vectorPtr->Size(), kNumElements * 20);
+  ASSERT_GE(vectorPtr->Capacity(), kNumElements * 20);
+
+  for (size_t i = 0; i < kNumElements * 20; i += kNumElements) {
+    ASSERT_EQ(vectorPtr->At(i), 0);
+  }
+
+  std::vector<int> values(kNumElements);
+  std::generate(values.begin(), values.end(), GenerateSequence<int>(0));
+  vectorPtr->InsertAt(kNumElements * 15, values.begin(), values.end());
+  for (size_t i = 0; i < kNumElements; ++i) {
+    ASSERT_EQ(vectorPtr->At(kNumElements * 15 + i), i);
+  }
+
+  vectorPtr->Clear();
+  ASSERT_EQ(vectorPtr->Capacity(), 0);
+  vectorPtr->PushBack(42);
+  ASSERT_EQ(vectorPtr->Size(), 1);
+  ASSERT_EQ(vectorPtr->At(0), 42);
+
+  shad::Vector<int>::Destroy(vectorPtr->GetGlobalID());
+}
+
 TEST_F(VectorTest, SingleElementInsert) {
   auto vectorPtr = shad::Vector<int>::Create(0);
 
@@ -154,6 +189,44 @@ TEST_F(VectorTest, PushBack) {
   shad::Vector<int>::Destroy(vectorPtr->GetGlobalID());
 }
 
+TEST_F(VectorTest, BlockOverwrite) {
+  auto vectorPtr = shad::Vector<int>::Create(100);
+  std::vector<int> input(5, 42);
+
+  vectorPtr->InsertAt(10, input.begin(), input.end());
+  ASSERT_EQ(vectorPtr->Size(), 100);
+  for (size_t i = 10; i < 15; i++) {
+    ASSERT_EQ(vectorPtr->At(i), 42);
+  }
+  shad::Vector<int>::Destroy(vectorPtr->GetGlobalID());
+}
+
+TEST_F(VectorTest, BufferedPushBack) {
+  using VectorT = shad::Vector<size_t>;
+  auto vectorPtr = VectorT::Create(0);
+  const size_t kToAppend = 3 * (1024 << 6) / sizeof(size_t) + 17;
+
+  shad::rt::forEachOnAll(
+      [](const VectorT::ObjectID &oid, size_t i) {
+        VectorT::GetPtr(oid)->BufferedPushBack(i);
+      },
+      vectorPtr->GetGlobalID(), kToAppend);
+  vectorPtr->WaitForBufferedPushBack();
+  ASSERT_EQ(vectorPtr->Size(), kToAppend);
+
+  std::vector<size_t> values(kToAppend);
+  shad::rt::Handle handle;
+  for (size_t i = 0; i < kToAppend; i++) {
+    vectorPtr->AsyncAt(handle, i, &values[i]);
+  }
+  shad::rt::waitForCompletion(handle);
+  std::sort(values.begin(), values.end());
+  for (size_t i = 0; i < kToAppend; i++) {
+    ASSERT_EQ(values[i], i);
+  }
+  VectorT::Destroy(vectorPtr->GetGlobalID());
+}
+
 TEST_F(VectorTest, InsertAndAsyncAt) {
   auto edsPtr = shad::Vector<size_t>::Create(kNumElements);
   for (size_t i = 0; i < kNumElements; i++) {
@@ -430,3 +503,137 @@ TEST_F(VectorTest, AsyncInsertAsyncForEachInRangeAndAsyncGet) {
     ASSERT_EQ(values[i], i + 1 + (3 * kNumElements));
   }
 }
+
+TEST_F(VectorTest, Iterators) {
+  using VectorT = shad::Vector<int>;
+  const size_t kSize = kNumElements * 20;
+  auto vectorPtr = VectorT::Create(kSize);
+  shad::rt::Handle handle;
+  for (size_t i = 0; i < kSize; ++i)
+    vectorPtr->AsyncInsertAt(handle, i, static_cast<int>(i % 1000));
+  shad::rt::waitForCompletion(handle);
+
+  auto begin = vectorPtr->begin();
+  auto end = vectorPtr->end();
+  ASSERT_EQ(std::distance(begin, end), kSize);
+
+  std::vector<int> copy(kSize);
+  std::copy(begin, end, copy.begin());
+  std::vector<int> transformed(kSize);
+  std::transform(begin, end, transformed.begin(), [](int v) { return v + 1; });
+  for (size_t i = 0; i < kSize; ++i) {
+    ASSERT_EQ(copy[i], i % 1000);
+    ASSERT_EQ(transformed[i], i % 1000 + 1);
+  }
+
+  // 42 appears once every 1000 elements: find returns each match in order.
+  size_t matches = 0;
+  for (auto found = std::find(begin, end, 42); found != end;
+       found = std::find(found + 1, end, 42)) {
+    ASSERT_EQ(std::distance(begin, found), matches * 1000 + 42);
+    ++matches;
+  }
+  ASSERT_EQ(matches, (kSize - 42 + 999) / 1000);
+  ASSERT_EQ(std::count(begin, end, 42), matches);
+
+  VectorT::Destroy(vectorPtr->GetGlobalID());
+}
+
+TEST_F(VectorTest, DistributedIteratorTraits) {
+  using VectorT = shad::Vector<int>;
+  using itr_traits = shad::distributed_iterator_traits<VectorT::iterator>;
+  auto vectorPtr = VectorT::Create(kNumElements * 10);
+
+  auto begin = vectorPtr->begin();
+  auto end = vectorPtr->end();
+
+  // The local ranges cover the whole Vector exactly once, each one at the
+  // global position of its first element.
+  size_t localElements = 0;
+  auto localities = itr_traits::localities(begin, end);
+  for (auto loc = localities.begin(); loc != localities.end(); ++loc) {
+    size_t localSize = 0;
+    shad::rt::executeAtWithRet(
+        loc,
+        [](const std::pair<VectorT::iterator, VectorT::iterator> &args,
+           size_t *result) {
+          auto lrange = itr_traits::local_range(args.first, args.second);
+          *result = std::distance(lrange.begin(), lrange.end());
+          for (auto itr = lrange.begin(); itr != lrange.end(); ++itr) {
+            auto gitr =
+                itr_traits::iterator_from_local(args.first, args.second, itr);
+            *itr = std::distance(args.first, gitr);
+          }
+        },
+        std::make_pair(begin, end), &localSize);
+    localElements += localSize;
+  }
+  ASSERT_EQ(localElements, kNumElements * 10);
+  for (size_t i = 0; i < kNumElements * 10; ++i) {
+    ASSERT_EQ(vectorPtr->At(i), i);
+  }
+
+  using ra_traits =
+      shad::distributed_random_access_iterator_trait<VectorT::iterator>;
+  size_t distributed = 0;
+  for (auto &piece : ra_traits::distribution(begin + 3, end - 3)) {
+    ASSERT_GT(piece.second, 0);
+    distributed += piece.second;
+  }
+  ASSERT_EQ(distributed, kNumElements * 10 - 6);
+
+  VectorT::Destroy(vectorPtr->GetGlobalID());
+}
+
+TEST_F(VectorTest, Algorithms) {
+  using VectorT = shad::Vector<int>;
+  const size_t kSize = kNumElements * 10;
+  auto vectorPtr = VectorT::Create(kSize);
+  auto begin = vectorPtr->begin();
+  auto end = vectorPtr->end();
+
+  shad::fill(shad::distributed_parallel_tag{}, begin, end, 1);
+  ASSERT_EQ(shad::count(shad::distributed_parallel_tag{}, begin, end, 1),
+            kSize);
+
+  shad::for_each(shad::distributed_parallel_tag{}, begin, end,
+                 [](int &v) { v *= 3; });
+  ASSERT_EQ(shad::reduce(shad::distributed_parallel_tag{}, begin, end, 0),
+            kSize * 3);
+  ASSERT_TRUE(shad::all_of(shad::distributed_sequential_tag{}, begin, end,
+                           [](int v) { return v == 3; }));
+
+  shad::rt::Handle handle;
+  for (size_t i = 0; i < kSize; ++i)
+    vectorPtr->AsyncInsertAt(handle, i, static_cast<int>(i % 1000));
+  shad::rt::waitForCompletion(handle);
+
+  // Output lands at the position of its input.
+  auto reversedPtr = VectorT::Create(kSize);
+  auto transformedPtr = VectorT::Create(kSize);
+  shad::reverse_copy(begin, end, reversedPtr->begin());
+  shad::transform(shad::distributed_parallel_tag{}, begin, end,
+                  transformedPtr->begin(), [](int v) { return v + 1; });
+  for (size_t i = 0; i < kSize; ++i) {
+    ASSERT_EQ(reversedPtr->At(kSize - 1 - i), i % 1000);
+    ASSERT_EQ(transformedPtr->At(i), i % 1000 + 1);
+  }
+
+  // 42 appears once every 1000 elements: find returns each match in order.
+  size_t matches = 0;
+  for (auto found = shad::find(shad::distributed_parallel_tag{}, begin, end,
+                               42);
+       found != end;
+       found = shad::find(shad::distributed_parallel_tag{}, found + 1, end,
+                          42)) {
+    ASSERT_EQ(std::distance(begin, found), matches * 1000 + 42);
+    ++matches;
+  }
+  ASSERT_EQ(matches, (kSize - 42 + 999) / 1000);
+  ASSERT_EQ(*shad::max_element(shad::distributed_parallel_tag{}, begin, end),
+            999);
+
+  VectorT::Destroy(reversedPtr->GetGlobalID());
+  VectorT::Destroy(transformedPtr->GetGlobalID());
+  VectorT::Destroy(vectorPtr->GetGlobalID());
+}
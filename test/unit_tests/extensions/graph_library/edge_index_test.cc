@@ -22,6 +22,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <atomic>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -424,3 +426,49 @@ TEST_F(EdgeIndexTest, AsyncInsertAsyncForeachEdgeTest) {
   shad::rt::waitForCompletion(handle);
   EIType::Destroy(oid);
 }
+
+static std::atomic<size_t> commonNeighbors(0);
+
+TEST_F(EdgeIndexTest, IntersectNeighborsTest) {
+  auto eidxPtr = EIType::Create(kToInsert);
+  auto oid = eidxPtr->GetGlobalID();
+  shad::rt::forEachOnAll(
+      [](const EIType::ObjectID &oid, size_t i) {
+        auto eiptr = EIType::GetPtr(oid);
+        size_t nsize = std::max<size_t>(i % kMaxNLSize, 1);
+        for (size_t j = 0; j < nsize; j++) {
+          eiptr->Insert(i, i + j);
+        }
+      },
+      oid, kToInsert);
+  size_t expected = 0;
+  commonNeighbors = 0;
+  shad::rt::Handle handle;
+  for (size_t u = 0; u < kToInsert - 1; u++) {
+    size_t v = u + 1;
+    size_t uEnd = u + std::max<size_t>(u % kMaxNLSize, 1);
+    size_t vEnd = v + std::max<size_t>(v % kMaxNLSize, 1);
+    size_t end = std::min(uEnd, vEnd);
+    expected += end > v ? end - v : 0;
+    eidxPtr->AsyncIntersectNeighbors(
+        handle, u, v,
+        [](shad::rt::Handle &, const uint64_t &u, const uint64_t &v,
+           const int &w) {
+          ASSERT_TRUE(w > u && w >= v);
+          commonNeighbors++;
+        });
+  }
+  shad::rt::waitForCompletion(handle);
+  ASSERT_EQ(commonNeighbors.load(), expected);
+
+  // N(kMaxNLSize - 1) is a superset of N(kMaxNLSize + 2).
+  commonNeighbors = 0;
+  eidxPtr->IntersectNeighbors(
+      kMaxNLSize - 1, kMaxNLSize + 2,
+      [](const uint64_t &, const uint64_t &v, const int &w) {
+        ASSERT_TRUE(w >= v && w < v + 2);
+        commonNeighbors++;
+      });
+  ASSERT_EQ(commonNeighbors.load(), 2);
+  EIType::Destroy(oid);
+}
@@ -0,0 +1,95 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+//                                     SHAD
+//
+//      The Scalable High-performance Algorithms and Data Structure Library
+//
+//===----------------------------------------------------------------------===//
+//
+// Copyright 2018 Battelle Memorial Institute
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "shad/extensions/graph_library/intersection.h"
+
+class IntersectionTest : public ::testing::Test {
+ public:
+  void SetUp() {
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<uint64_t> dist(0, 1 << 14);
+    small_.resize(kSmallSize);
+    large_.resize(kLargeSize);
+    for (auto &x : small_) x = dist(gen);
+    for (auto &x : large_) x = dist(gen);
+    for (auto v : {&small_, &large_}) {
+      std::sort(v->begin(), v->end());
+      v->erase(std::unique(v->begin(), v->end()), v->end());
+    }
+    std::set_intersection(small_.begin(), small_.end(), large_.begin(),
+                          large_.end(), std::back_inserter(expected_));
+  }
+
+  static constexpr size_t kSmallSize = 100;
+  static constexpr size_t kLargeSize = 8000;
+  std::vector<uint64_t> small_;
+  std::vector<uint64_t> large_;
+  std::vector<uint64_t> expected_;
+};
+
+TEST_F(IntersectionTest, KernelsTest) {
+  std::vector<std::vector<uint64_t>> results(4);
+  std::vector<size_t> counts(4);
+  auto collector = [&](size_t k) {
+    return [&, k](const uint64_t &x) { results[k].push_back(x); };
+  };
+  const uint64_t *s = small_.data(), *l = large_.data();
+  size_t ns = small_.size(), nl = large_.size();
+  counts[0] = shad::MergeIntersect(s, ns, l, nl, collector(0));
+  counts[1] = shad::GallopingIntersect(s, ns, l, nl, collector(1));
+  counts[2] = shad::BlockIntersect(s, ns, l, nl, collector(2));
+  counts[3] = shad::IntersectSorted(s, ns, l, nl, collector(3));
+  for (size_t k = 0; k < results.size(); ++k) {
+    ASSERT_EQ(counts[k], expected_.size());
+    ASSERT_EQ(results[k], expected_);
+  }
+}
+
+TEST_F(IntersectionTest, SymmetryAndEdgeCasesTest) {
+  std::vector<uint64_t> res;
+  auto collect = [&](const uint64_t &x) { res.push_back(x); };
+  size_t count = shad::IntersectSorted(large_.data(), large_.size(),
+                                       small_.data(), small_.size(), collect);
+  ASSERT_EQ(count, expected_.size());
+  ASSERT_EQ(res, expected_);
+
+  res.clear();
+  count = shad::BlockIntersect(large_.data(), large_.size(), large_.data(),
+                               large_.size(), collect);
+  ASSERT_EQ(count, large_.size());
+  ASSERT_EQ(res, large_);
+
+  ASSERT_EQ(shad::IntersectSorted(small_.data(), 0lu, large_.data(),
+                                  large_.size(), collect),
+            0);
+  ASSERT_EQ(shad::GallopingIntersect(small_.data(), small_.size(),
+                                     large_.data(), 0lu, collect),
+            0);
+}